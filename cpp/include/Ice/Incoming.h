@@ -5,6 +5,7 @@
 #ifndef ICE_INCOMING_H
 #define ICE_INCOMING_H
 
+#include <IceUtil/Time.h>
 #include <Ice/InstanceF.h>
 #include <Ice/ConnectionIF.h>
 #include <Ice/ServantLocatorF.h>
@@ -19,6 +20,13 @@
 
 #include <deque>
 
+namespace Ice
+{
+
+class ObjectAdapterI;
+
+}
+
 #ifdef ICE_CPP11_MAPPING
 
 namespace Ice
@@ -60,6 +68,19 @@ protected:
 namespace IceInternal
 {
 
+//
+// The request context entry which carries the time remaining before the
+// deadline of a twoway invocation, in milliseconds. The time is relative
+// so the deadline doesn't depend on the clocks of the client and server.
+//
+extern const char* const deadlineContextKey;
+
+//
+// Return the deadline of the request dispatched by the calling thread, as
+// a monotonic time, or IceUtil::Time() if the request has no deadline.
+//
+IceUtil::Time getDispatchDeadline();
+
 class ICE_API IncomingBase : private IceUtil::noncopyable
 {
 public:
@@ -96,6 +117,7 @@ protected:
     void warning(const std::string&) const;
 
     bool servantLocatorFinished(bool);
+    void finishAdmitted();
 
     void handleException(const std::exception&, bool);
     void handleException(const std::string&, bool);
@@ -131,6 +153,12 @@ protected:
     //
     ResponseHandler* _responseHandler;
 
+    //
+    // The object adapter which admitted the dispatch if it has admission
+    // control enabled, it's notified once the response is sent.
+    //
+    Ice::ObjectAdapterI* _admittedBy;
+
 #ifdef ICE_CPP11_MAPPING
     using DispatchInterceptorCallbacks = std::deque<std::pair<std::function<bool()>,
                                                               std::function<bool(std::exception_ptr)>>>;
@@ -177,7 +205,7 @@ public:
         _format = format;
     }
 
-    void invoke(const ServantManagerPtr&, Ice::InputStream*);
+    void invoke(const ServantManagerPtr&, Ice::InputStream*, Ice::ObjectAdapterI*, const IceUtil::Time&);
 
     // Inlined for speed optimization.
     void skipReadParams()
@@ -208,6 +236,9 @@ public:
 
 private:
 
+    void dispatch();
+    void reject(const std::string&);
+
     friend class IncomingAsync;
 
     Ice::InputStream* _is;
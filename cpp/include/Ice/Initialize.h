@@ -939,6 +939,15 @@ ICE_API Identity stringToIdentity(const std::string& str);
  */
 ICE_API std::string identityToString(const Identity& id, ToStringMode mode = ICE_ENUM(ToStringMode, Unicode));
 
+/**
+ * Obtains the time remaining before the deadline of the request dispatched by the calling thread. A
+ * request has a deadline if the client enables Ice.PropagateDeadline and invokes the operation with an
+ * invocation timeout. The invocations made by the calling thread time out no later than the deadline.
+ * @return The remaining time in milliseconds, 0 if the deadline expired, or -1 if the calling thread
+ * isn't dispatching a request or if the request has no deadline.
+ */
+ICE_API Int getDispatchRemainingTime();
+
 }
 
 namespace IceInternal
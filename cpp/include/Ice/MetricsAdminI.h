@@ -10,6 +10,9 @@
 #include <Ice/Initialize.h>
 
 #include <Ice/Metrics.h>
+#include <Ice/UniquePtr.h>
+
+#include <IceUtil/Atomic.h>
 
 #ifdef _MSC_VER
 #  define ICE_CPP11_COMPILER_REGEXP
@@ -41,6 +44,91 @@ template<typename T> class MetricsHelperT;
 namespace IceInternal
 {
 
+//
+// A latency histogram with log-linear buckets in the spirit of HDR
+// histograms: each power of two is split in 8 linear sub-buckets, the
+// relative error of a reported latency is therefore at most 12.5%.
+//
+// Samples are recorded without locking in a shard selected by the
+// calling thread and the shards are only aggregated when the histogram
+// is read, this keeps threads dispatching or invoking concurrently from
+// contending on the same counters.
+//
+class ICE_API LatencyHistogram : private IceUtil::noncopyable
+{
+public:
+
+    LatencyHistogram();
+    ~LatencyHistogram();
+
+    //
+    // Record a latency, in microseconds.
+    //
+    void add(Ice::Long);
+
+    //
+    // Add the bucket counts of this histogram to the given vector.
+    //
+    void getCounts(std::vector<Ice::Long>&) const;
+
+    static IceMX::MetricsHistogram toMetricsHistogram(const std::string&, const std::vector<Ice::Long>&);
+
+private:
+
+    struct Shard;
+
+    Shard* getShard();
+    void drain(Shard*, size_t);
+
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+    std::atomic<Shard*> _shards[8];
+#else
+    Shard* _shards[8];
+#endif
+    std::vector<Ice::Long> _drained;
+    mutable IceUtil::Mutex _mutex;
+};
+
+//
+// Maps of the following metrics record a latency histogram by default,
+// the Histogram property of the map allows to change this.
+//
+template<class MetricsType> struct LatencyHistogramDefault
+{
+    static const int value = 0;
+};
+
+template<> struct LatencyHistogramDefault<IceMX::DispatchMetrics>
+{
+    static const int value = 1;
+};
+
+template<> struct LatencyHistogramDefault<IceMX::InvocationMetrics>
+{
+    static const int value = 1;
+};
+
+template<> struct LatencyHistogramDefault<IceMX::RemoteMetrics>
+{
+    static const int value = 1;
+};
+
+template<> struct LatencyHistogramDefault<IceMX::CollocatedMetrics>
+{
+    static const int value = 1;
+};
+
+//
+// The histogram of the maps of the following metrics records the values
+// sampled by their observers instead of the lifetime of the entries.
+//
+template<class MetricsType> struct LatencyHistogramSampled
+{
+    static const bool value = false;
+};
+
+typedef std::map<std::string, std::vector<Ice::Long> > LatencyHistogramCounts;
+
 class ICE_API MetricsMapI;
 ICE_DEFINE_PTR(MetricsMapIPtr, MetricsMapI);
 
@@ -108,6 +196,7 @@ public:
     virtual IceMX::MetricsFailuresSeq getFailures() = 0;
     virtual IceMX::MetricsFailures getFailures(const std::string&) = 0;
     virtual IceMX::MetricsMap getMetrics() const = 0;
+    virtual void getHistograms(const std::string&, LatencyHistogramCounts&) const = 0;
 
     virtual MetricsMapIPtr clone() const = 0;
 
@@ -170,6 +259,10 @@ public:
         EntryT(MetricsMapTPtr map, const TPtr& object, const typename std::list<EntryTPtr>::iterator& p) :
             _map(map), _object(object), _detachedPos(p)
         {
+            if(_map->_histogram)
+            {
+                _histogram.reset(new LatencyHistogram());
+            }
         }
 
         ~EntryT()
@@ -185,7 +278,7 @@ public:
         void
         failed(const std::string& exceptionName)
         {
-            IceUtil::Mutex::Lock sync(*_map);
+            IceUtil::Mutex::Lock sync(_mutex);
             ++_object->failures;
             ++_failures[exceptionName];
         }
@@ -221,6 +314,11 @@ public:
         void
         detach(Ice::Long lifetime)
         {
+            if(_histogram && !LatencyHistogramSampled<T>::value)
+            {
+                _histogram->add(lifetime);
+            }
+
             IceUtil::Mutex::Lock sync(*_map);
             _object->totalLifetime += lifetime;
             if(--_object->current == 0)
@@ -233,10 +331,23 @@ public:
             }
         }
 
+        void
+        sample(Ice::Long value)
+        {
+            if(_histogram && LatencyHistogramSampled<T>::value)
+            {
+                _histogram->add(value);
+            }
+        }
+
+        //
+        // Updates only lock the entry, not the whole map: attach, detach
+        // and the map readers lock the map first and then the entry.
+        //
         template<typename Function> void
         execute(Function func)
         {
-            IceUtil::Mutex::Lock sync(*_map);
+            IceUtil::Mutex::Lock sync(_mutex);
             func(_object);
         }
 
@@ -253,14 +364,41 @@ public:
         {
             IceMX::MetricsFailures f;
             f.id = _object->id;
+            IceUtil::Mutex::Lock sync(_mutex);
             f.failures = _failures;
             return f;
         }
 
+        void
+        getHistograms(const std::string& subMap, LatencyHistogramCounts& histograms) const
+        {
+            if(subMap.empty())
+            {
+                if(_histogram)
+                {
+                    _histogram->getCounts(histograms[_object->id]);
+                }
+                return;
+            }
+
+            std::string::size_type pos = subMap.find('/');
+            typename std::map<std::string, std::pair<MetricsMapIPtr, SubMapMember> >::const_iterator p =
+                _subMaps.find(subMap.substr(0, pos));
+            if(p != _subMaps.end())
+            {
+                p->second.first->getHistograms(pos == std::string::npos ? std::string() : subMap.substr(pos + 1),
+                                               histograms);
+            }
+        }
+
         IceMX::MetricsPtr
         clone() const
         {
-            TPtr metrics = ICE_DYNAMIC_CAST(T, _object->ice_clone());
+            TPtr metrics;
+            {
+                IceUtil::Mutex::Lock sync(_mutex);
+                metrics = ICE_DYNAMIC_CAST(T, _object->ice_clone());
+            }
             for(typename std::map<std::string, std::pair<MetricsMapIPtr, SubMapMember> >::const_iterator p =
                     _subMaps.begin(); p != _subMaps.end(); ++p)
             {
@@ -278,6 +416,7 @@ public:
         void
         attach(const IceMX::MetricsHelperT<T>& helper)
         {
+            IceUtil::Mutex::Lock sync(_mutex);
             ++_object->total;
             ++_object->current;
             helper.initMetrics(_object);
@@ -289,12 +428,17 @@ public:
         IceMX::StringIntDict _failures;
         std::map<std::string, std::pair<MetricsMapIPtr, SubMapMember> > _subMaps;
         typename std::list<EntryTPtr>::iterator _detachedPos;
+        IceInternal::UniquePtr<LatencyHistogram> _histogram;
+        IceUtil::Mutex _mutex;
     };
 
     MetricsMapT(const std::string& mapPrefix,
                 const Ice::PropertiesPtr& properties,
                 const std::map<std::string, std::pair<SubMapMember, MetricsMapFactoryPtr> >& subMaps) :
-        MetricsMapI(mapPrefix, properties), _destroyed(false)
+        MetricsMapI(mapPrefix, properties),
+        _histogram(properties->getPropertyAsIntWithDefault(mapPrefix + "Histogram",
+                                                           LatencyHistogramDefault<MetricsType>::value) > 0),
+        _destroyed(false)
     {
         std::vector<std::string> subMapNames;
         typename std::map<std::string, std::pair<SubMapMember, MetricsMapFactoryPtr> >::const_iterator p;
@@ -327,6 +471,7 @@ public:
 #endif
         MetricsMapI(other),
         IceUtil::Mutex(),
+        _histogram(other._histogram),
         _destroyed(false)
     {
     }
@@ -360,6 +505,16 @@ public:
         return objects;
     }
 
+    virtual void
+    getHistograms(const std::string& subMap, LatencyHistogramCounts& histograms) const
+    {
+        Lock sync(*this);
+        for(typename std::map<std::string, EntryTPtr>::const_iterator p = _objects.begin(); p != _objects.end(); ++p)
+        {
+            p->second->getHistograms(subMap, histograms);
+        }
+    }
+
     virtual IceMX::MetricsFailuresSeq
     getFailures()
     {
@@ -551,6 +706,7 @@ private:
 
     friend class EntryT;
 
+    const bool _histogram;
     bool _destroyed;
     std::map<std::string, EntryTPtr> _objects;
     std::list<EntryTPtr> _detachedQueue;
@@ -598,6 +754,7 @@ public:
     IceMX::MetricsView getMetrics();
     IceMX::MetricsFailuresSeq getFailures(const std::string&);
     IceMX::MetricsFailures getFailures(const std::string&, const std::string&);
+    IceMX::MetricsHistogramSeq getHistograms(const std::string&);
 
     std::vector<std::string> getMaps() const;
 
@@ -681,6 +838,7 @@ public:
     virtual IceMX::MetricsView getMetricsView(std::string, Ice::Long&, const ::Ice::Current&);
     virtual IceMX::MetricsFailuresSeq getMapMetricsFailures(std::string, std::string, const ::Ice::Current&);
     virtual IceMX::MetricsFailures getMetricsFailures(std::string, std::string, std::string, const ::Ice::Current&);
+    virtual IceMX::MetricsHistogramSeq getMetricsHistograms(std::string, std::string, const ::Ice::Current&);
 #else
     virtual void enableMetricsView(const std::string&, const ::Ice::Current&);
     virtual void disableMetricsView(const std::string&, const ::Ice::Current&);
@@ -689,9 +847,16 @@ public:
                                                             const ::Ice::Current&);
     virtual IceMX::MetricsFailures getMetricsFailures(const std::string&, const std::string&, const std::string&,
                                                       const ::Ice::Current&);
+    virtual IceMX::MetricsHistogramSeq getMetricsHistograms(const std::string&, const std::string&,
+                                                            const ::Ice::Current&);
 #endif
     std::vector<MetricsMapIPtr> getMaps(const std::string&) const;
 
+    //
+    // Returns the maps of the enabled views indexed by map name and view name.
+    //
+    std::map<std::string, std::map<std::string, MetricsMapIPtr> > getViewMaps() const;
+
     const Ice::LoggerPtr& getLogger() const;
 
 private:
@@ -419,6 +419,15 @@ public:
         }
     }
 
+    void
+    sample(::Ice::Long value)
+    {
+        for(typename EntrySeqType::const_iterator p = _objects.begin(); p != _objects.end(); ++p)
+        {
+            (*p)->sample(value);
+        }
+    }
+
     template<typename Function> void
     forEach(const Function& func)
     {
@@ -47,6 +47,62 @@ protected:
     virtual void handleInvokeResponse(bool, OutgoingAsyncBase*) const = 0;
 };
 
+//
+// The operation, mode, context and encoded parameters of a request,
+// marshaled once and sent with the same request to many proxies, for
+// example to forward an event to the subscribers of a topic. The
+// connections of the invocations share the encoded body and only write
+// the header of each request before it.
+//
+class ICE_API EncodedRequest
+#ifndef ICE_CPP11_MAPPING
+    : public IceUtil::Shared
+#endif
+{
+public:
+
+    EncodedRequest(const Ice::CommunicatorPtr&, const std::string&, Ice::OperationMode,
+                   const std::pair<const Ice::Byte*, const Ice::Byte*>&, const Ice::Context&);
+
+    const std::string& operation() const
+    {
+        return _operation;
+    }
+
+    Ice::OperationMode mode() const
+    {
+        return _mode;
+    }
+
+    const Ice::Context& context() const
+    {
+        return _context;
+    }
+
+    //
+    // The marshaled operation, mode, context and parameters.
+    //
+    const std::vector<Ice::Byte>& body() const
+    {
+        return _body;
+    }
+
+private:
+
+    friend class OutgoingAsync;
+
+    const std::string _operation;
+    const Ice::OperationMode _mode;
+    const Ice::Context _context;
+
+    //
+    // The parameters start at the _params offset of the body, the body
+    // has no parameters if the encapsulation is empty.
+    //
+    std::vector<Ice::Byte> _body;
+    size_t _params;
+};
+
 //
 // Base class for handling asynchronous invocations. This class is
 // responsible for the handling of the output stream and the child
@@ -108,7 +164,12 @@ public:
 
     void attachRemoteObserver(const Ice::ConnectionInfoPtr& c, const Ice::EndpointPtr& endpt, Ice::Int requestId)
     {
-        const Ice::Int size = static_cast<Ice::Int>(_os.b.size() - headerSize - 4);
+        size_t sz = _os.b.size() - headerSize - 4;
+        if(_encodedRequest)
+        {
+            sz += _encodedRequest->body().size();
+        }
+        const Ice::Int size = static_cast<Ice::Int>(sz);
         _childObserver.attach(getObserver().getRemoteObserver(c, endpt, requestId, size));
     }
 
@@ -128,6 +189,15 @@ public:
         return &_is;
     }
 
+    //
+    // The shared encoded body sent after the request in the output
+    // stream, null if the output stream holds the whole request.
+    //
+    const EncodedRequestPtr& getEncodedRequest() const
+    {
+        return _encodedRequest;
+    }
+
 protected:
 
     OutgoingAsyncBase(const InstancePtr&);
@@ -174,6 +244,7 @@ protected:
 
     Ice::OutputStream _os;
     Ice::InputStream _is;
+    EncodedRequestPtr _encodedRequest;
 
     CancellationHandlerPtr _cancellationHandler;
 
@@ -222,6 +293,7 @@ protected:
     ~ProxyOutgoingAsyncBase();
 
     void invokeImpl(bool);
+    void updateDeadline();
     bool sentImpl(bool);
     bool exceptionImpl(const Ice::Exception&);
     bool responseImpl(bool, bool);
@@ -232,6 +304,19 @@ protected:
     RequestHandlerPtr _handler;
     Ice::OperationMode _mode;
 
+    //
+    // The invocation timeout of the proxy, reduced to the time remaining
+    // before the deadline of the dispatch which makes the invocation.
+    //
+    int _invocationTimeout;
+
+    //
+    // The deadline propagated with the request context and the position
+    // of the remaining time in the request, updated on retries.
+    //
+    IceUtil::Time _deadline;
+    size_t _deadlinePos;
+
 private:
 
     int _cnt;
@@ -248,6 +333,7 @@ public:
     OutgoingAsync(const Ice::ObjectPrxPtr&, bool);
 
     void prepare(const std::string&, Ice::OperationMode, const Ice::Context&);
+    void prepare(const EncodedRequestPtr&);
 
     virtual bool sent();
     virtual bool response();
@@ -297,6 +383,12 @@ protected:
 #endif
 
     bool _synchronous;
+
+private:
+
+    void prepareHeader(const std::string&, Ice::OperationMode, const Ice::Context&);
+    void prepareContext(std::string&, std::string&);
+    void copyEncodedRequest();
 };
 
 }
@@ -15,12 +15,14 @@ class OutgoingAsyncBase;
 class OutgoingAsync;
 class ProxyOutgoingAsyncBase;
 class CommunicatorFlushBatchAsync;
+class EncodedRequest;
 
 #ifdef ICE_CPP11_MAPPING
 using OutgoingAsyncBasePtr = ::std::shared_ptr<OutgoingAsyncBase>;
 using OutgoingAsyncPtr = ::std::shared_ptr<OutgoingAsync>;
 using ProxyOutgoingAsyncBasePtr = ::std::shared_ptr<ProxyOutgoingAsyncBase>;
 using CommunicatorFlushBatchAsyncPtr = ::std::shared_ptr<CommunicatorFlushBatchAsync>;
+using EncodedRequestPtr = ::std::shared_ptr<EncodedRequest>;
 #else
 ICE_API IceUtil::Shared* upCast(OutgoingAsyncBase*);
 typedef IceInternal::Handle<OutgoingAsyncBase> OutgoingAsyncBasePtr;
@@ -33,6 +35,9 @@ typedef IceInternal::Handle<ProxyOutgoingAsyncBase> ProxyOutgoingAsyncBasePtr;
 
 ICE_API IceUtil::Shared* upCast(CommunicatorFlushBatchAsync*);
 typedef IceInternal::Handle<CommunicatorFlushBatchAsync> CommunicatorFlushBatchAsyncPtr;
+
+ICE_API IceUtil::Shared* upCast(EncodedRequest*);
+typedef IceInternal::Handle<EncodedRequest> EncodedRequestPtr;
 #endif
 }
 
@@ -50,6 +50,16 @@ const ::Ice::Byte replyMsg = 2;
 const ::Ice::Byte validateConnectionMsg = 3;
 const ::Ice::Byte closeConnectionMsg = 4;
 
+//
+// The flow control credit message, an extension of the Ice protocol.
+// The message body is the credit granted to the peer in bytes (Int). A
+// client configured with Ice.FlowControl asks for credit with a zero
+// credit message once the connection is validated, an object adapter
+// configured with <adapter>.FlowControl.Window only sends credit to the
+// clients which asked for it.
+//
+const ::Ice::Byte creditMsg = 5;
+
 //
 // The request header, batch request header and reply header.
 //
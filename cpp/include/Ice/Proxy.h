@@ -2371,6 +2371,11 @@ public:
 
     /// \cond INTERNAL
     bool _iceI_end_ice_invoke(::std::pair<const ::Ice::Byte*, const ::Ice::Byte*>&, const ::Ice::AsyncResultPtr&);
+
+    ::Ice::AsyncResultPtr _iceI_begin_ice_invoke(const ::IceInternal::EncodedRequestPtr&,
+                                                 const ::IceInternal::CallbackBasePtr&,
+                                                 const ::Ice::LocalObjectPtr&,
+                                                 bool = false);
     /// \endcond
 
     /**
@@ -0,0 +1,482 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/AsyncLoggerI.h>
+#include <Ice/LoggerI.h>
+#include <IceUtil/Time.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string.h>
+
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+#   include <atomic>
+#endif
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <pthread.h>
+#endif
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+namespace
+{
+
+struct QueuedMessage
+{
+    LoggerPtr logger;
+    LogMessage message;
+};
+
+void
+moveMessage(LogMessage& to, LogMessage& from)
+{
+    to.type = from.type;
+    to.timestamp = from.timestamp;
+    to.traceCategory.swap(from.traceCategory);
+    to.message.swap(from.message);
+}
+
+bool
+olderThan(const QueuedMessage& lhs, const QueuedMessage& rhs)
+{
+    return lhs.message.timestamp < rhs.message.timestamp;
+}
+
+size_t
+threadHash()
+{
+    //
+    // Hash the calling thread ID, the multiplication spreads the bits of
+    // thread IDs which are usually aligned addresses.
+    //
+#ifdef _WIN32
+    size_t h = static_cast<size_t>(GetCurrentThreadId());
+#else
+    pthread_t self = pthread_self();
+    size_t h = 0;
+    memcpy(&h, &self, sizeof(self) < sizeof(h) ? sizeof(self) : sizeof(h));
+#endif
+    h ^= h >> 16;
+    h *= 0x45d9f3b;
+    h ^= h >> 16;
+    return h;
+}
+
+}
+
+//
+// A bounded ring buffer with multiple producers and a single consumer.
+// With C++11 atomics, the ring buffer is lock-free: each cell carries a
+// sequence number which tells producers and the consumer whether the
+// cell is free or holds a message.
+//
+class IceInternal::AsyncLogger::Ring : private IceUtil::noncopyable
+{
+public:
+
+    Ring(size_t capacity) :
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+        _cells(capacity),
+        _enqueuePos(0),
+        _dequeuePos(0),
+#else
+        _entries(capacity),
+        _head(0),
+        _count(0),
+#endif
+        _mask(capacity - 1)
+    {
+        assert((capacity & _mask) == 0);
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+        for(size_t i = 0; i < capacity; ++i)
+        {
+            _cells[i].sequence.store(i, memory_order_relaxed);
+        }
+#endif
+    }
+
+    bool
+    push(const LoggerPtr& logger, LogMessage& message)
+    {
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+        Cell* cell;
+        size_t pos = _enqueuePos.load(memory_order_relaxed);
+        while(true)
+        {
+            cell = &_cells[pos & _mask];
+            size_t seq = cell->sequence.load(memory_order_acquire);
+            ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos);
+            if(diff == 0)
+            {
+                if(_enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if(diff < 0)
+            {
+                return false; // Full
+            }
+            else
+            {
+                pos = _enqueuePos.load(memory_order_relaxed);
+            }
+        }
+        cell->entry.logger = logger;
+        moveMessage(cell->entry.message, message);
+        cell->sequence.store(pos + 1, memory_order_release);
+        return true;
+#else
+        IceUtil::Mutex::Lock sync(_mutex);
+        if(_count == _entries.size())
+        {
+            return false; // Full
+        }
+        QueuedMessage& entry = _entries[(_head + _count) & _mask];
+        entry.logger = logger;
+        moveMessage(entry.message, message);
+        ++_count;
+        return true;
+#endif
+    }
+
+    //
+    // Must be called by a single consumer at a time.
+    //
+    void
+    popAll(vector<QueuedMessage>& entries)
+    {
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+        while(true)
+        {
+            Cell& cell = _cells[_dequeuePos & _mask];
+            if(cell.sequence.load(memory_order_acquire) != _dequeuePos + 1)
+            {
+                return;
+            }
+            entries.push_back(QueuedMessage());
+            entries.back().logger.swap(cell.entry.logger);
+            moveMessage(entries.back().message, cell.entry.message);
+            cell.sequence.store(_dequeuePos + _mask + 1, memory_order_release);
+            ++_dequeuePos;
+        }
+#else
+        IceUtil::Mutex::Lock sync(_mutex);
+        for(; _count > 0; --_count)
+        {
+            QueuedMessage& entry = _entries[_head];
+            entries.push_back(QueuedMessage());
+            entries.back().logger = entry.logger;
+            entry.logger = 0;
+            moveMessage(entries.back().message, entry.message);
+            _head = (_head + 1) & _mask;
+        }
+#endif
+    }
+
+    //
+    // Must be called by a single consumer at a time.
+    //
+    bool
+    empty()
+    {
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+        return _cells[_dequeuePos & _mask].sequence.load(memory_order_acquire) != _dequeuePos + 1;
+#else
+        IceUtil::Mutex::Lock sync(_mutex);
+        return _count == 0;
+#endif
+    }
+
+private:
+
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+    struct Cell
+    {
+        atomic<size_t> sequence;
+        QueuedMessage entry;
+    };
+
+    vector<Cell> _cells;
+    atomic<size_t> _enqueuePos;
+    size_t _dequeuePos;
+#else
+    IceUtil::Mutex _mutex;
+    vector<QueuedMessage> _entries;
+    size_t _head;
+    size_t _count;
+#endif
+    const size_t _mask;
+};
+
+IceInternal::AsyncLogger::AsyncLogger(const LoggerPtr& logger, int queueSize) :
+    IceUtil::Thread("Ice.AsyncLogger"),
+    _logger(logger),
+    _destroyed(0),
+    _waiting(0),
+    _dropped(0)
+{
+    //
+    // Each ring buffer holds a power of two share of the queue size.
+    //
+    size_t capacity = 16;
+    while(capacity * shardCount < static_cast<size_t>(queueSize))
+    {
+        capacity *= 2;
+    }
+
+    for(size_t i = 0; i < shardCount; ++i)
+    {
+        _rings[i] = new Ring(capacity);
+    }
+}
+
+IceInternal::AsyncLogger::~AsyncLogger()
+{
+    for(size_t i = 0; i < shardCount; ++i)
+    {
+        delete _rings[i];
+    }
+}
+
+void
+IceInternal::AsyncLogger::destroy()
+{
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+        _destroyed.exchange(1);
+        _monitor.notify();
+    }
+    getThreadControl().join();
+
+    //
+    // Write the messages queued after the writer thread's last drain.
+    //
+    drain();
+}
+
+void
+IceInternal::AsyncLogger::run()
+{
+    while(true)
+    {
+        if(drain())
+        {
+            continue;
+        }
+
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+        if(_destroyed.load() > 0)
+        {
+            break;
+        }
+
+        //
+        // Tell logging threads to wake us up and check again the ring
+        // buffers in case a message was queued before the flag was set.
+        // The timed wait guards against a missed wake-up.
+        //
+        _waiting.exchange(1);
+        if(empty())
+        {
+            _monitor.timedWait(IceUtil::Time::seconds(1));
+        }
+        _waiting.exchange(0);
+    }
+}
+
+void
+IceInternal::AsyncLogger::log(const LoggerPtr& logger, LogMessage& message)
+{
+    if(_destroyed.load() > 0)
+    {
+        write(logger, message);
+        return;
+    }
+
+    if(!_rings[threadHash() % shardCount]->push(logger, message))
+    {
+        _dropped.fetch_add(1);
+        return;
+    }
+
+    if(_waiting.load() > 0)
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+        if(_waiting.exchange(0) > 0)
+        {
+            _monitor.notify();
+        }
+    }
+
+    //
+    // If the queue was destroyed while the message was queued, the
+    // writer thread might be gone, write it now.
+    //
+    if(_destroyed.load() > 0)
+    {
+        drain();
+    }
+}
+
+bool
+IceInternal::AsyncLogger::drain()
+{
+    IceUtil::Mutex::Lock sync(_drainMutex);
+
+    vector<QueuedMessage> entries;
+    for(size_t i = 0; i < shardCount; ++i)
+    {
+        _rings[i]->popAll(entries);
+    }
+
+    //
+    // Report dropped messages at most once per second, the writer thread
+    // wakes up at least once per second.
+    //
+    int dropped = 0;
+    if(_dropped.load() > 0)
+    {
+        IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        if(_destroyed.load() > 0 || now - _lastDroppedReport >= IceUtil::Time::seconds(1))
+        {
+            dropped = _dropped.exchange(0);
+            _lastDroppedReport = now;
+        }
+    }
+
+    if(entries.empty() && dropped == 0)
+    {
+        return false;
+    }
+
+    //
+    // Messages from different ring buffers are written in time-stamp
+    // order, messages from the same thread keep their order.
+    //
+    stable_sort(entries.begin(), entries.end(), olderThan);
+    for(vector<QueuedMessage>::const_iterator p = entries.begin(); p != entries.end(); ++p)
+    {
+        write(p->logger, p->message);
+    }
+
+    if(dropped > 0)
+    {
+        ostringstream os;
+        os << "asynchronous logger queue is full: " << dropped << " message" << (dropped > 1 ? "s" : "")
+           << " dropped (Ice.LogAsync.QueueSize)";
+        LogMessage message = { ICE_ENUM(LogMessageType, WarningMessage), IceUtil::Time::now().toMicroSeconds(), "",
+                               os.str() };
+        write(_logger, message);
+    }
+    return true;
+}
+
+bool
+IceInternal::AsyncLogger::empty()
+{
+    IceUtil::Mutex::Lock sync(_drainMutex);
+    for(size_t i = 0; i < shardCount; ++i)
+    {
+        if(!_rings[i]->empty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+IceInternal::AsyncLogger::write(const LoggerPtr& logger, const LogMessage& message)
+{
+    //
+    // The file and console logger writes the message with the time stamp
+    // of the logging thread, other loggers time-stamp messages when they
+    // are written.
+    //
+    LoggerIPtr loggerI = ICE_DYNAMIC_CAST(LoggerI, logger);
+    if(loggerI)
+    {
+        loggerI->log(message);
+        return;
+    }
+
+    switch(message.type)
+    {
+        case ICE_ENUM(LogMessageType, PrintMessage):
+        {
+            logger->print(message.message);
+            break;
+        }
+        case ICE_ENUM(LogMessageType, TraceMessage):
+        {
+            logger->trace(message.traceCategory, message.message);
+            break;
+        }
+        case ICE_ENUM(LogMessageType, WarningMessage):
+        {
+            logger->warning(message.message);
+            break;
+        }
+        case ICE_ENUM(LogMessageType, ErrorMessage):
+        {
+            logger->error(message.message);
+            break;
+        }
+    }
+}
+
+IceInternal::AsyncLoggerI::AsyncLoggerI(const AsyncLoggerPtr& queue, const LoggerPtr& logger) :
+    _queue(queue),
+    _logger(logger)
+{
+}
+
+void
+IceInternal::AsyncLoggerI::print(const string& message)
+{
+    log(ICE_ENUM(LogMessageType, PrintMessage), "", message);
+}
+
+void
+IceInternal::AsyncLoggerI::trace(const string& category, const string& message)
+{
+    log(ICE_ENUM(LogMessageType, TraceMessage), category, message);
+}
+
+void
+IceInternal::AsyncLoggerI::warning(const string& message)
+{
+    log(ICE_ENUM(LogMessageType, WarningMessage), "", message);
+}
+
+void
+IceInternal::AsyncLoggerI::error(const string& message)
+{
+    log(ICE_ENUM(LogMessageType, ErrorMessage), "", message);
+}
+
+string
+IceInternal::AsyncLoggerI::getPrefix()
+{
+    return _logger->getPrefix();
+}
+
+LoggerPtr
+IceInternal::AsyncLoggerI::cloneWithPrefix(const string& prefix)
+{
+    return ICE_MAKE_SHARED(AsyncLoggerI, _queue, _logger->cloneWithPrefix(prefix));
+}
+
+void
+IceInternal::AsyncLoggerI::log(LogMessageType type, const string& category, const string& message)
+{
+    LogMessage logMessage = { type, IceUtil::Time::now().toMicroSeconds(), category, message };
+    _queue->log(_logger, logMessage);
+}
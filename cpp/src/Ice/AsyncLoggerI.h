@@ -0,0 +1,108 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_ASYNC_LOGGER_I_H
+#define ICE_ASYNC_LOGGER_I_H
+
+#include <IceUtil/Thread.h>
+#include <IceUtil/Monitor.h>
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Atomic.h>
+#include <IceUtil/Time.h>
+#include <Ice/Logger.h>
+#include <Ice/RemoteLogger.h>
+
+namespace IceInternal
+{
+
+//
+// The queue and writer thread of the asynchronous logger, enabled with
+// Ice.LogAsync. Messages are time-stamped by the logging thread and
+// queued in one of several bounded ring buffers, the ring buffer is
+// picked using the logging thread ID. The writer thread drains the ring
+// buffers and forwards the messages to the underlying loggers, in
+// time-stamp order.
+//
+// The queue holds at most Ice.LogAsync.QueueSize messages, messages
+// logged while the ring buffer of the logging thread is full are
+// dropped and the writer thread reports how many were dropped.
+//
+class AsyncLogger : public IceUtil::Thread
+{
+public:
+
+    AsyncLogger(const Ice::LoggerPtr&, int);
+    virtual ~AsyncLogger();
+
+    //
+    // Write all the queued messages and stop the writer thread. Once
+    // destroyed, messages are written by the logging thread.
+    //
+    void destroy();
+
+    virtual void run();
+
+    void log(const Ice::LoggerPtr&, Ice::LogMessage&);
+
+private:
+
+    class Ring;
+
+    bool drain();
+    bool empty();
+    void write(const Ice::LoggerPtr&, const Ice::LogMessage&);
+
+    const Ice::LoggerPtr _logger;
+
+    static const size_t shardCount = 8;
+    Ring* _rings[shardCount];
+
+    //
+    // The ring buffers have a single consumer, either the writer thread
+    // or, once destroyed, the logging threads.
+    //
+    IceUtil::Mutex _drainMutex;
+    IceUtil::Time _lastDroppedReport;
+
+    IceUtil::Monitor<IceUtil::Mutex> _monitor;
+    IceUtilInternal::Atomic _destroyed;
+    IceUtilInternal::Atomic _waiting;
+    IceUtilInternal::Atomic _dropped;
+};
+typedef IceUtil::Handle<AsyncLogger> AsyncLoggerPtr;
+
+//
+// The logger installed with Ice.LogAsync, it queues the messages for the
+// underlying logger with the asynchronous logger queue.
+//
+class AsyncLoggerI : public Ice::Logger
+{
+public:
+
+    AsyncLoggerI(const AsyncLoggerPtr&, const Ice::LoggerPtr&);
+
+    virtual void print(const std::string&);
+    virtual void trace(const std::string&, const std::string&);
+    virtual void warning(const std::string&);
+    virtual void error(const std::string&);
+    virtual std::string getPrefix();
+    virtual Ice::LoggerPtr cloneWithPrefix(const std::string&);
+
+    const Ice::LoggerPtr& getLogger() const
+    {
+        return _logger;
+    }
+
+private:
+
+    void log(Ice::LogMessageType, const std::string&, const std::string&);
+
+    const AsyncLoggerPtr _queue;
+    const Ice::LoggerPtr _logger;
+};
+ICE_DEFINE_PTR(AsyncLoggerIPtr, AsyncLoggerI);
+
+}
+
+#endif
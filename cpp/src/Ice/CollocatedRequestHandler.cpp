@@ -27,8 +27,10 @@ public:
                    OutputStream* os,
                    const CollocatedRequestHandlerPtr& handler,
                    Int requestId,
-                   Int batchRequestNum) :
-        _outAsync(outAsync), _os(os), _handler(handler), _requestId(requestId), _batchRequestNum(batchRequestNum)
+                   Int batchRequestNum,
+                   const IceUtil::Time& received) :
+        _outAsync(outAsync), _os(os), _handler(handler), _requestId(requestId), _batchRequestNum(batchRequestNum),
+        _received(received)
     {
     }
 
@@ -37,7 +39,7 @@ public:
     {
         if(_handler->sentAsync(_outAsync.get()))
         {
-            _handler->invokeAll(_os, _requestId, _batchRequestNum);
+            _handler->invokeAll(_os, _requestId, _batchRequestNum, _received);
         }
     }
 
@@ -48,6 +50,7 @@ private:
     CollocatedRequestHandlerPtr _handler;
     Int _requestId;
     Int _batchRequestNum;
+    IceUtil::Time _received;
 };
 
 void
@@ -163,6 +166,12 @@ CollocatedRequestHandler::invokeAsyncRequest(OutgoingAsyncBase* outAsync, int ba
 
     outAsync->attachCollocatedObserver(_adapter, requestId);
 
+    //
+    // Queued requests are stamped with the time they were queued, for the
+    // object adapter admission control and the request deadline.
+    //
+    const IceUtil::Time received = IceUtil::Time::now(IceUtil::Time::Monotonic);
+
     if(!synchronous || !_response || _reference->getInvocationTimeout() > 0)
     {
         // Don't invoke from the user thread if async or invocation timeout is set
@@ -170,7 +179,8 @@ CollocatedRequestHandler::invokeAsyncRequest(OutgoingAsyncBase* outAsync, int ba
                                                                outAsync->getOs(),
                                                                ICE_SHARED_FROM_THIS,
                                                                requestId,
-                                                               batchRequestNum));
+                                                               batchRequestNum,
+                                                               received));
     }
     else if(_dispatcher)
     {
@@ -178,7 +188,8 @@ CollocatedRequestHandler::invokeAsyncRequest(OutgoingAsyncBase* outAsync, int ba
                                                                              outAsync->getOs(),
                                                                              ICE_SHARED_FROM_THIS,
                                                                              requestId,
-                                                                             batchRequestNum));
+                                                                             batchRequestNum,
+                                                                             received));
     }
     else // Optimization: directly call invokeAll if there's no dispatcher.
     {
@@ -191,7 +202,7 @@ CollocatedRequestHandler::invokeAsyncRequest(OutgoingAsyncBase* outAsync, int ba
         CollocatedRequestHandlerPtr self(ICE_SHARED_FROM_THIS);
         if(sentAsync(outAsync))
         {
-            invokeAll(outAsync->getOs(), requestId, batchRequestNum);
+            invokeAll(outAsync->getOs(), requestId, batchRequestNum, received);
         }
     }
     return AsyncStatusQueued;
@@ -303,7 +314,8 @@ CollocatedRequestHandler::sentAsync(OutgoingAsyncBase* outAsync)
 }
 
 void
-CollocatedRequestHandler::invokeAll(OutputStream* os, Int requestId, Int batchRequestNum)
+CollocatedRequestHandler::invokeAll(OutputStream* os, Int requestId, Int batchRequestNum,
+                                    const IceUtil::Time& received)
 {
     if(_traceLevels->protocol >= 1)
     {
@@ -353,7 +365,7 @@ CollocatedRequestHandler::invokeAll(OutputStream* os, Int requestId, Int batchRe
             }
 
             Incoming in(_reference->getInstance().get(), this, 0, _adapter, _response, 0, requestId);
-            in.invoke(servantManager, &is);
+            in.invoke(servantManager, &is, _adapter.get(), received);
             --invokeNum;
         }
     }
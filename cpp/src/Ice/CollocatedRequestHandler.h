@@ -58,7 +58,7 @@ public:
 
     bool sentAsync(OutgoingAsyncBase*);
 
-    void invokeAll(Ice::OutputStream*, Ice::Int, Ice::Int);
+    void invokeAll(Ice::OutputStream*, Ice::Int, Ice::Int, const IceUtil::Time&);
 
 #ifdef ICE_CPP11_MAPPING
     std::shared_ptr<CollocatedRequestHandler> shared_from_this()
@@ -12,6 +12,7 @@
 #include <Ice/DefaultsAndOverrides.h>
 #include <Ice/Transceiver.h>
 #include <Ice/ThreadPool.h>
+#include <Ice/DispatchLanes.h>
 #include <Ice/ACM.h>
 #include <Ice/ObjectAdapterI.h> // For getThreadPool() and getServantManager().
 #include <Ice/EndpointI.h>
@@ -67,8 +68,8 @@ public:
     DispatchCall(const ConnectionIPtr& connection, const ConnectionI::StartCallbackPtr& startCB,
                  const vector<ConnectionI::OutgoingMessage>& sentCBs, Byte compress, Int requestId,
                  Int invokeNum, const ServantManagerPtr& servantManager, const ObjectAdapterPtr& adapter,
-                 const OutgoingAsyncBasePtr& outAsync, const ICE_DELEGATE(HeartbeatCallback)& heartbeatCallback,
-                 InputStream& stream) :
+                 const IceUtil::Time& received, const OutgoingAsyncBasePtr& outAsync,
+                 const ICE_DELEGATE(HeartbeatCallback)& heartbeatCallback, InputStream& stream) :
         DispatchWorkItem(connection),
         _connection(connection),
         _startCB(startCB),
@@ -78,6 +79,7 @@ public:
         _invokeNum(invokeNum),
         _servantManager(servantManager),
         _adapter(adapter),
+        _received(received),
         _outAsync(outAsync),
         _heartbeatCallback(heartbeatCallback),
         _stream(stream.instance(), currentProtocolEncoding)
@@ -89,7 +91,7 @@ public:
     run()
     {
         _connection->dispatch(_startCB, _sentCBs, _compress, _requestId, _invokeNum, _servantManager, _adapter,
-                              _outAsync, _heartbeatCallback, _stream);
+                              _received, _outAsync, _heartbeatCallback, _stream);
     }
 
 private:
@@ -102,6 +104,7 @@ private:
     const Int _invokeNum;
     const ServantManagerPtr _servantManager;
     const ObjectAdapterPtr _adapter;
+    const IceUtil::Time _received;
     const OutgoingAsyncBasePtr _outAsync;
     const ICE_DELEGATE(HeartbeatCallback) _heartbeatCallback;
     InputStream _stream;
@@ -378,6 +381,12 @@ Ice::ConnectionI::OutgoingMessage::completed(const Ice::LocalException& ex)
     stream = 0;
 }
 
+size_t
+Ice::ConnectionI::OutgoingMessage::size() const
+{
+    return stream->b.size() + (body ? body->body().size() : 0);
+}
+
 void
 Ice::ConnectionI::start(const StartCallbackPtr& callback)
 {
@@ -417,6 +426,10 @@ Ice::ConnectionI::start(const StartCallbackPtr& callback)
         // We start out in holding state.
         //
         setState(StateHolding);
+        if(_flowControl)
+        {
+            sendCreditNow(0);
+        }
     }
     catch(const Ice::LocalException& ex)
     {
@@ -466,6 +479,27 @@ Ice::ConnectionI::hold()
     setState(StateHolding);
 }
 
+void
+Ice::ConnectionI::suspendReading()
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    if(_readSuspended++ == 0 && _state == StateActive)
+    {
+        _threadPool->unregister(ICE_SHARED_FROM_THIS, SocketOperationRead);
+    }
+}
+
+void
+Ice::ConnectionI::resumeReading()
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    assert(_readSuspended > 0);
+    if(--_readSuspended == 0 && _state == StateActive)
+    {
+        _threadPool->_register(ICE_SHARED_FROM_THIS, SocketOperationRead);
+    }
+}
+
 void
 Ice::ConnectionI::destroy(DestructionReason reason)
 {
@@ -507,7 +541,7 @@ Ice::ConnectionI::close(ConnectionClose mode) ICE_NOEXCEPT
         //
         // Wait until all outstanding requests have been completed.
         //
-        while(!_asyncRequests.empty())
+        while(!_asyncRequests.empty() || !_creditStreams.empty())
         {
             wait();
         }
@@ -673,7 +707,8 @@ Ice::ConnectionI::monitor(const IceUtil::Time& now, const ACMConfig& acm)
             setState(StateClosed, ConnectionTimeoutException(__FILE__, __LINE__));
         }
         else if(acm.close != ICE_ENUM(ACMClose, CloseOnInvocation) &&
-                _dispatchCount == 0 && _batchRequestQueue->isEmpty() && _asyncRequests.empty())
+                _dispatchCount == 0 && _batchRequestQueue->isEmpty() && _asyncRequests.empty() &&
+                _creditStreams.empty())
         {
             //
             // The connection is idle, close it.
@@ -751,7 +786,33 @@ Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compres
     try
     {
         OutgoingMessage message(out, os, compress, requestId);
-        status = sendMessage(message);
+        if(os->b[8] == validateConnectionMsg) // Heartbeats aren't flow-controlled.
+        {
+            status = sendMessage(message);
+        }
+        else if(_creditGranted && (!_creditStreams.empty() || (!response && _sendCredit <= 0)))
+        {
+            //
+            // Out of credit, the request is sent once the peer returns
+            // credit. Requests are sent in order so twoway requests also
+            // wait behind the requests waiting for credit.
+            //
+            _creditStreams.push_back(message);
+        }
+        else
+        {
+            if(!response && _flowControl)
+            {
+                //
+                // Requests sent before the peer granted credit are charged
+                // too, the peer returns credit for them once dispatched. The
+                // credit is bounded in case the peer never grants credit.
+                //
+                _sendCredit = static_cast<Int>(max(static_cast<Long>(_sendCredit) - static_cast<Long>(message.size()),
+                                                   -static_cast<Long>(0x7fffffff)));
+            }
+            status = sendMessage(message);
+        }
     }
     catch(const LocalException& ex)
     {
@@ -1246,6 +1307,44 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
         }
     }
 
+    //
+    // Requests waiting for credit aren't being sent, they're always
+    // removed.
+    //
+    for(deque<OutgoingMessage>::iterator o = _creditStreams.begin(); o != _creditStreams.end(); ++o)
+    {
+        if(o->outAsync.get() == outAsync.get())
+        {
+            if(o->requestId)
+            {
+                if(_asyncRequestsHint != _asyncRequests.end() && _asyncRequestsHint->first == o->requestId)
+                {
+                    _asyncRequestsHint = _asyncRequests.end();
+                }
+                _asyncRequests.erase(o->requestId);
+            }
+
+            if(dynamic_cast<const Ice::ConnectionTimeoutException*>(&ex))
+            {
+                setState(StateClosed, ex);
+            }
+            else
+            {
+                o->canceled(false);
+                _creditStreams.erase(o);
+                if(_creditStreams.empty())
+                {
+                    notifyAll(); // Notify threads blocked in close(false)
+                }
+                if(outAsync->exception(ex))
+                {
+                    outAsync->invokeExceptionAsync();
+                }
+            }
+            return;
+        }
+    }
+
     if(ICE_DYNAMIC_CAST(OutgoingAsync, outAsync))
     {
         if(_asyncRequestsHint != _asyncRequests.end())
@@ -1354,6 +1453,11 @@ Ice::ConnectionI::sendNoResponse()
             _exception->ice_throw();
         }
 
+        if(_receiveDispatches > 0)
+        {
+            returnCredit(1);
+        }
+
         if(_state == StateClosing && _dispatchCount == 0)
         {
             initiateShutdown();
@@ -1492,7 +1596,8 @@ Ice::ConnectionI::startAsync(SocketOperation operation)
                 _observer.startWrite(_writeStream);
             }
 
-            if(_transceiver->startWrite(_writeStream) && !_sendStreams.empty())
+            if(_transceiver->startWrite(_writeStream) && !_sendStreams.empty() &&
+               (!_sendStreams.front().body || _sendStreams.front().writingBody))
             {
                 // The whole message is written, assume it's sent now for at-most-once semantics.
                 _sendStreams.front().isSent = true;
@@ -1748,6 +1853,10 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
                 // We start out in holding state.
                 //
                 setState(StateHolding);
+                if(_flowControl)
+                {
+                    sendCreditNow(0);
+                }
                 if(_startCallback)
                 {
                     swap(_startCallback, startCB);
@@ -1775,16 +1884,18 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
                                                                               adapter,
                                                                               outAsync,
                                                                               heartbeatCallback,
+                                                                              sentCBs,
                                                                               dispatchCount));
                 }
 
                 if(readyOp & SocketOperationWrite)
                 {
                     newOp = static_cast<SocketOperation>(newOp | sendNextMessage(sentCBs));
-                    if(!sentCBs.empty())
-                    {
-                        ++dispatchCount;
-                    }
+                }
+
+                if(!sentCBs.empty())
+                {
+                    ++dispatchCount;
                 }
 
                 if(_state < StateClosed)
@@ -1845,21 +1956,60 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
         }
     }
 
+    //
+    // Requests are stamped with the time they were received, for the object
+    // adapter admission control and the request deadline. The requests of a
+    // batch are dispatched one after the other and wait for the previous
+    // ones, as do requests queued with a dispatcher or a dispatch lane.
+    //
+    const IceUtil::Time received = invokeNum > 0 ? IceUtil::Time::now(IceUtil::Time::Monotonic) : IceUtil::Time();
+
+    //
+    // Requests for an object adapter with dispatch lanes are queued with
+    // their lane, they're dispatched by the thread pool.
+    //
+    if(invokeNum > 0)
+    {
+        ObjectAdapterI* adapterI = dynamic_cast<ObjectAdapterI*>(adapter.get());
+        if(adapterI && adapterI->getDispatchLanes())
+        {
+            const DispatchLanesPtr& lanes = adapterI->getDispatchLanes();
+            const size_t lane = lanes->getLane(current.stream, invokeNum);
+            try
+            {
+                DispatchWorkItemPtr call = new DispatchCall(ICE_SHARED_FROM_THIS, ICE_NULLPTR,
+                                                            vector<OutgoingMessage>(), compress, requestId, invokeNum,
+                                                            servantManager, adapter, received, ICE_NULLPTR,
+                                                            ICE_NULLPTR, current.stream);
+                lanes->queue(_threadPool, ICE_SHARED_FROM_THIS, call, lane, received);
+            }
+            catch(const LocalException& ex)
+            {
+                invokeException(requestId, ex, invokeNum, false);
+            }
+            invokeNum = 0;
+            if(!startCB && sentCBs.empty() && !outAsync && !heartbeatCallback)
+            {
+                return;
+            }
+        }
+    }
+
 // dispatchFromThisThread dispatches to the correct DispatchQueue
 #ifdef ICE_SWIFT
     _threadPool->dispatchFromThisThread(new DispatchCall(ICE_SHARED_FROM_THIS, startCB, sentCBs, compress, requestId,
-                                                         invokeNum, servantManager, adapter, outAsync,
+                                                         invokeNum, servantManager, adapter, received, outAsync,
                                                          heartbeatCallback, current.stream));
 #else
     if(!_dispatcher) // Optimization, call dispatch() directly if there's no dispatcher.
     {
-        dispatch(startCB, sentCBs, compress, requestId, invokeNum, servantManager, adapter, outAsync, heartbeatCallback,
-                 current.stream);
+        dispatch(startCB, sentCBs, compress, requestId, invokeNum, servantManager, adapter, received, outAsync,
+                 heartbeatCallback, current.stream);
     }
     else
     {
         _threadPool->dispatchFromThisThread(new DispatchCall(ICE_SHARED_FROM_THIS, startCB, sentCBs, compress, requestId,
-                                                             invokeNum, servantManager, adapter, outAsync,
+                                                             invokeNum, servantManager, adapter, received, outAsync,
                                                              heartbeatCallback, current.stream));
 
     }
@@ -1869,7 +2019,8 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
 void
 ConnectionI::dispatch(const StartCallbackPtr& startCB, const vector<OutgoingMessage>& sentCBs,
                       Byte compress, Int requestId, Int invokeNum, const ServantManagerPtr& servantManager,
-                      const ObjectAdapterPtr& adapter, const OutgoingAsyncBasePtr& outAsync,
+                      const ObjectAdapterPtr& adapter, const IceUtil::Time& received,
+                      const OutgoingAsyncBasePtr& outAsync,
                       const ICE_DELEGATE(HeartbeatCallback)& heartbeatCallback, InputStream& stream)
 {
     int dispatchedCount = 0;
@@ -1951,7 +2102,7 @@ ConnectionI::dispatch(const StartCallbackPtr& startCB, const vector<OutgoingMess
     //
     if(invokeNum)
     {
-        invokeAll(stream, invokeNum, requestId, compress, servantManager, adapter);
+        invokeAll(stream, invokeNum, requestId, compress, servantManager, adapter, received);
 
         //
         // Don't increase count, the dispatch count is
@@ -2008,7 +2159,8 @@ Ice::ConnectionI::finished(ThreadPoolCurrent& current, bool close)
     // to call code that will potentially block (this avoids promoting a new leader and
     // unecessary thread creation, especially if this is called on shutdown).
     //
-    if(!_startCallback && _sendStreams.empty() && _asyncRequests.empty() && !_closeCallback && !_heartbeatCallback)
+    if(!_startCallback && _sendStreams.empty() && _creditStreams.empty() && _asyncRequests.empty() && !_closeCallback &&
+       !_heartbeatCallback)
     {
         finish(close);
         return;
@@ -2090,10 +2242,18 @@ Ice::ConnectionI::finish(bool close)
         {
             //
             // Return the stream to the outgoing call. This is important for
-            // retriable AMI calls which are not marshalled again.
+            // retriable AMI calls which are not marshalled again. The stream
+            // is already returned if the shared body is being written.
             //
             OutgoingMessage* message = &_sendStreams.front();
-            _writeStream.swap(*message->stream);
+            if(message->writingBody)
+            {
+                _writeStream.b.clear();
+            }
+            else
+            {
+                _writeStream.swap(*message->stream);
+            }
 
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
             //
@@ -2132,6 +2292,16 @@ Ice::ConnectionI::finish(bool close)
         _sendStreams.clear();
     }
 
+    for(deque<OutgoingMessage>::iterator o = _creditStreams.begin(); o != _creditStreams.end(); ++o)
+    {
+        o->completed(*_exception);
+        if(o->requestId) // Make sure finished isn't called twice.
+        {
+            _asyncRequests.erase(o->requestId);
+        }
+    }
+    _creditStreams.clear();
+
     for(map<Int, OutgoingAsyncBasePtr>::const_iterator q = _asyncRequests.begin(); q != _asyncRequests.end(); ++q)
     {
         if(q->second->exception(*_exception))
@@ -2276,10 +2446,20 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
     _asyncRequestsHint(_asyncRequests.end()),
     _messageSizeMax(adapter ? adapter->messageSizeMax() : _instance->messageSizeMax()),
     _batchRequestQueue(new BatchRequestQueue(instance, endpoint->datagram())),
+    _flowControl(connector && !endpoint->datagram() &&
+                 _instance->initializationData().properties->getPropertyAsInt("Ice.FlowControl") > 0),
+    _flowControlWindow(adapter && !endpoint->datagram() ? adapter->flowControlWindow() : 0),
+    _receiveWindow(0),
+    _receiveBytes(0),
+    _receiveDispatches(0),
+    _returnCredit(0),
+    _creditGranted(false),
+    _sendCredit(0),
     _readStream(_instance.get(), Ice::currentProtocolEncoding),
     _readHeader(false),
     _writeStream(_instance.get(), Ice::currentProtocolEncoding),
     _dispatchCount(0),
+    _readSuspended(0),
     _state(StateNotInitialized),
     _shutdownInitiated(false),
     _initialized(false),
@@ -2340,6 +2520,7 @@ Ice::ConnectionI::~ConnectionI()
     assert(_state == StateFinished);
     assert(_dispatchCount == 0);
     assert(_sendStreams.empty());
+    assert(_creditStreams.empty());
     assert(_asyncRequests.empty());
 }
 
@@ -2448,7 +2629,10 @@ Ice::ConnectionI::setState(State state)
                 {
                     return;
                 }
-                _threadPool->_register(ICE_SHARED_FROM_THIS, SocketOperationRead);
+                if(_readSuspended == 0)
+                {
+                    _threadPool->_register(ICE_SHARED_FROM_THIS, SocketOperationRead);
+                }
                 break;
             }
 
@@ -2588,6 +2772,15 @@ Ice::ConnectionI::initiateShutdown()
     {
         return;
     }
+
+    //
+    // The requests waiting for credit are sent before the close connection
+    // message, the shutdown is initiated once they're sent.
+    //
+    if(!_creditStreams.empty())
+    {
+        return;
+    }
     _shutdownInitiated = true;
 
     if(!_endpoint->datagram())
@@ -2655,6 +2848,102 @@ Ice::ConnectionI::sendHeartbeatNow()
     }
 }
 
+void
+Ice::ConnectionI::sendCreditNow(Int credit)
+{
+    assert(credit >= 0 && !_endpoint->datagram());
+
+    OutputStream os(_instance.get(), Ice::currentProtocolEncoding);
+    os.write(magic[0]);
+    os.write(magic[1]);
+    os.write(magic[2]);
+    os.write(magic[3]);
+    os.write(currentProtocol);
+    os.write(currentProtocolEncoding);
+    os.write(creditMsg);
+    os.write(static_cast<Byte>(0)); // Compression status (always zero for credit).
+    os.write(headerSize + static_cast<Int>(sizeof(Int))); // Message size.
+    os.write(credit);
+    os.i = os.b.begin();
+
+    OutgoingMessage message(&os, false);
+    sendMessage(message);
+}
+
+void
+Ice::ConnectionI::returnCredit(int dispatches)
+{
+    assert(_receiveWindow > 0 && dispatches <= _receiveDispatches);
+
+    //
+    // The dispatches of a batch complete independently, each completed
+    // dispatch returns its share of the bytes still being dispatched.
+    //
+    if(dispatches < _receiveDispatches)
+    {
+        Int credit = static_cast<Int>(static_cast<Long>(_receiveBytes) * dispatches / _receiveDispatches);
+        _receiveBytes -= credit;
+        _receiveDispatches -= dispatches;
+        _returnCredit += credit;
+    }
+    else
+    {
+        _returnCredit += _receiveBytes;
+        _receiveBytes = 0;
+        _receiveDispatches = 0;
+    }
+
+    //
+    // The credit is returned in chunks of half the window, or all at once
+    // when no flow-controlled dispatches are in progress: the sender might
+    // be waiting to send a request larger than the returned credit.
+    //
+    if(_returnCredit > 0 && (_receiveDispatches == 0 || _returnCredit >= _receiveWindow / 2) &&
+       _state < StateClosingPending && !_shutdownInitiated)
+    {
+        sendCreditNow(_returnCredit);
+        _returnCredit = 0;
+    }
+}
+
+void
+Ice::ConnectionI::sendCreditStreams(vector<OutgoingMessage>& callbacks)
+{
+    //
+    // A oneway or batch request is sent as long as there's credit left,
+    // the credit can become negative with a request larger than the
+    // credit left. This ensures requests larger than the window are
+    // eventually sent.
+    //
+    while(!_creditStreams.empty() && _state < StateClosingPending)
+    {
+        OutgoingMessage message = _creditStreams.front();
+        if(!message.requestId)
+        {
+            if(_sendCredit <= 0)
+            {
+                return;
+            }
+            _sendCredit -= static_cast<Int>(message.size());
+        }
+        _creditStreams.pop_front();
+
+        if(sendMessage(message) & AsyncStatusInvokeSentCallback)
+        {
+            callbacks.push_back(message);
+        }
+    }
+
+    if(_creditStreams.empty())
+    {
+        notifyAll(); // Notify threads blocked in close(false)
+        if(_state == StateClosing && _dispatchCount == 0)
+        {
+            initiateShutdown();
+        }
+    }
+}
+
 bool
 Ice::ConnectionI::initialize(SocketOperation operation)
 {
@@ -2820,7 +3109,14 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
     {
         // Message wasn't sent, empty the _writeStream, we're not going to send more data.
         OutgoingMessage* message = &_sendStreams.front();
-        _writeStream.swap(*message->stream);
+        if(message->writingBody)
+        {
+            _writeStream.b.clear();
+        }
+        else
+        {
+            _writeStream.swap(*message->stream);
+        }
         return SocketOperationNone;
     }
 
@@ -2829,13 +3125,34 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
     {
         while(true)
         {
+            OutgoingMessage* message = &_sendStreams.front();
+            if(message->body && !message->writingBody && message->stream)
+            {
+                //
+                // The request header is sent, return the stream to the
+                // request and send the shared body.
+                //
+                _writeStream.swap(*message->stream);
+                SocketOperation op = writeBody(*message);
+                if(op)
+                {
+                    return op;
+                }
+            }
+
             //
             // Notify the message that it was sent.
             //
-            OutgoingMessage* message = &_sendStreams.front();
             if(message->stream)
             {
-                _writeStream.swap(*message->stream);
+                if(message->writingBody)
+                {
+                    _writeStream.b.clear();
+                }
+                else
+                {
+                    _writeStream.swap(*message->stream);
+                }
                 if(message->sent())
                 {
                     callbacks.push_back(*message);
@@ -2901,7 +3218,7 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
                 //
                 // No compression, just fill in the message size.
                 //
-                Int sz = static_cast<Int>(message->stream->b.size());
+                Int sz = static_cast<Int>(message->size());
                 const Byte* p = reinterpret_cast<const Byte*>(&sz);
 #ifdef ICE_BIG_ENDIAN
                 reverse_copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
@@ -3041,7 +3358,7 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
         //
         // No compression, just fill in the message size.
         //
-        Int sz = static_cast<Int>(message.stream->b.size());
+        Int sz = static_cast<Int>(message.size());
         const Byte* p = reinterpret_cast<const Byte*>(&sz);
 #ifdef ICE_BIG_ENDIAN
         reverse_copy(p, p + sizeof(Int), message.stream->b.begin() + 10);
@@ -3060,6 +3377,14 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
             _observer.startWrite(*message.stream);
         }
         op = write(*message.stream);
+        if(!op && message.body)
+        {
+            if(_observer)
+            {
+                _observer.finishWrite(*message.stream);
+            }
+            op = writeBody(message);
+        }
         if(!op)
         {
             if(_observer)
@@ -3084,7 +3409,10 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
     }
 #endif
 
-    _writeStream.swap(*_sendStreams.back().stream);
+    if(!_sendStreams.back().writingBody)
+    {
+        _writeStream.swap(*_sendStreams.back().stream);
+    }
     scheduleTimeout(op);
     _threadPool->_register(ICE_SHARED_FROM_THIS, op);
     return AsyncStatusQueued;
@@ -3242,7 +3570,7 @@ SocketOperation
 Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& requestId, Byte& compress,
                                ServantManagerPtr& servantManager, ObjectAdapterPtr& adapter,
                                OutgoingAsyncBasePtr& outAsync, ICE_DELEGATE(HeartbeatCallback)& heartbeatCallback,
-                               int& dispatchCount)
+                               vector<OutgoingMessage>& sentCBs, int& dispatchCount)
 {
     assert(_state > StateNotValidated && _state < StateClosed);
 
@@ -3323,6 +3651,11 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
                     servantManager = _servantManager;
                     adapter = _adapter;
                     ++dispatchCount;
+                    if(_receiveWindow > 0 && requestId == 0)
+                    {
+                        _receiveBytes += static_cast<Int>(stream.b.size());
+                        ++_receiveDispatches;
+                    }
                 }
                 break;
             }
@@ -3346,6 +3679,15 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
                     servantManager = _servantManager;
                     adapter = _adapter;
                     dispatchCount += invokeNum;
+                    if(_receiveWindow > 0)
+                    {
+                        _receiveBytes += static_cast<Int>(stream.b.size());
+                        _receiveDispatches += invokeNum;
+                        if(invokeNum == 0)
+                        {
+                            returnCredit(0);
+                        }
+                    }
                 }
                 break;
             }
@@ -3434,6 +3776,35 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
                 break;
             }
 
+            case creditMsg:
+            {
+                traceRecv(stream, _logger, _traceLevels);
+                Int credit;
+                stream.read(credit);
+                if(credit < 0)
+                {
+                    throw ProtocolException(__FILE__, __LINE__, "invalid flow control credit");
+                }
+                else if(credit == 0)
+                {
+                    //
+                    // The peer asks for credit, it's only granted if the
+                    // object adapter has a flow control window.
+                    //
+                    if(_flowControlWindow > 0 && _receiveWindow == 0)
+                    {
+                        _receiveWindow = _flowControlWindow;
+                        sendCreditNow(_receiveWindow);
+                    }
+                    break;
+                }
+                _creditGranted = true;
+                _sendCredit = static_cast<Int>(min(static_cast<Long>(_sendCredit) + credit,
+                                                   static_cast<Long>(0x7fffffff)));
+                sendCreditStreams(sentCBs);
+                break;
+            }
+
             default:
             {
                 trace("received unknown message\n(invalid, closing connection)", stream, _logger, _traceLevels);
@@ -3457,18 +3828,27 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
         }
     }
 
-    return _state == StateHolding ? SocketOperationNone : SocketOperationRead;
+    //
+    // Stop reading if the connection is held or if a dispatch lane is full.
+    //
+    if(_state == StateHolding || (_state == StateActive && _readSuspended > 0))
+    {
+        return SocketOperationNone;
+    }
+    return SocketOperationRead;
 }
 
 void
 Ice::ConnectionI::invokeAll(InputStream& stream, Int invokeNum, Int requestId, Byte compress,
-                            const ServantManagerPtr& servantManager, const ObjectAdapterPtr& adapter)
+                            const ServantManagerPtr& servantManager, const ObjectAdapterPtr& adapter,
+                            const IceUtil::Time& received)
 {
     //
     // Note: In contrast to other private or protected methods, this
     // operation must be called *without* the mutex locked.
     //
 
+    ObjectAdapterI* adapterI = dynamic_cast<ObjectAdapterI*>(adapter.get());
     try
     {
         while(invokeNum > 0)
@@ -3484,7 +3864,7 @@ Ice::ConnectionI::invokeAll(InputStream& stream, Int invokeNum, Int requestId, B
             //
             // Dispatch the invocation.
             //
-            in.invoke(servantManager, &stream);
+            in.invoke(servantManager, &stream, adapterI, received);
 
             --invokeNum;
         }
@@ -3656,6 +4036,35 @@ ConnectionI::write(Buffer& buf)
     return op;
 }
 
+SocketOperation
+ConnectionI::writeBody(OutgoingMessage& message)
+{
+    //
+    // Send the shared body of a request after its header. The body is
+    // written from _writeStream without being copied, _writeStream keeps
+    // referencing it until it's sent.
+    //
+    const vector<Byte>& body = message.body->body();
+    Buffer buf(&body[0], &body[0] + body.size());
+    _writeStream.swapBuffer(buf);
+    message.writingBody = true;
+
+    if(_observer)
+    {
+        _observer.startWrite(_writeStream);
+    }
+    SocketOperation op = write(_writeStream);
+    if(!op)
+    {
+        if(_observer)
+        {
+            _observer.finishWrite(_writeStream);
+        }
+        _writeStream.b.clear();
+    }
+    return op;
+}
+
 void
 ConnectionI::reap()
 {
@@ -88,7 +88,7 @@ public:
     struct OutgoingMessage
     {
         OutgoingMessage(Ice::OutputStream* str, bool comp) :
-            stream(str), compress(comp), requestId(0), adopted(false)
+            stream(str), compress(comp), requestId(0), adopted(false), writingBody(false)
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
             , isSent(false), invokeSent(false), receivedReply(false)
 #endif
@@ -97,7 +97,8 @@ public:
 
         OutgoingMessage(const IceInternal::OutgoingAsyncBasePtr& o, Ice::OutputStream* str,
                         bool comp, int rid) :
-            stream(str), outAsync(o), compress(comp), requestId(rid), adopted(false)
+            stream(str), outAsync(o), body(o->getEncodedRequest()), compress(comp), requestId(rid), adopted(false),
+            writingBody(false)
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
             , isSent(false), invokeSent(false), receivedReply(false)
 #endif
@@ -108,12 +109,15 @@ public:
         void canceled(bool);
         bool sent();
         void completed(const Ice::LocalException&);
+        size_t size() const;
 
         Ice::OutputStream* stream;
         IceInternal::OutgoingAsyncBasePtr outAsync;
+        IceInternal::EncodedRequestPtr body; // The shared body written after the stream, if any.
         bool compress;
         int requestId;
         bool adopted;
+        bool writingBody;
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
         bool isSent;
         bool invokeSent;
@@ -151,6 +155,13 @@ public:
     void activate();
     void hold();
     void destroy(DestructionReason);
+
+    //
+    // Stop and resume reading requests, used by the dispatch lanes while
+    // a lane is full. Each suspension must be matched by a resumption.
+    //
+    void suspendReading();
+    void resumeReading();
     virtual void close(ConnectionClose) ICE_NOEXCEPT; // From Connection.
 
     bool isActiveOrHolding() const;
@@ -247,7 +258,7 @@ public:
     void exception(const LocalException&);
 
     void dispatch(const StartCallbackPtr&, const std::vector<OutgoingMessage>&, Byte, Int, Int,
-                  const IceInternal::ServantManagerPtr&, const ObjectAdapterPtr&,
+                  const IceInternal::ServantManagerPtr&, const ObjectAdapterPtr&, const IceUtil::Time&,
                   const IceInternal::OutgoingAsyncBasePtr&,
                   const ICE_DELEGATE(HeartbeatCallback)&, Ice::InputStream&);
     void finish(bool);
@@ -287,6 +298,9 @@ private:
 
     void initiateShutdown();
     void sendHeartbeatNow();
+    void sendCreditNow(Int);
+    void returnCredit(int);
+    void sendCreditStreams(std::vector<OutgoingMessage>&);
 
     bool initialize(IceInternal::SocketOperation = IceInternal::SocketOperationNone);
     bool validate(IceInternal::SocketOperation = IceInternal::SocketOperationNone);
@@ -300,10 +314,11 @@ private:
 
     IceInternal::SocketOperation parseMessage(Ice::InputStream&, Int&, Int&, Byte&,
                                               IceInternal::ServantManagerPtr&, ObjectAdapterPtr&,
-                                              IceInternal::OutgoingAsyncBasePtr&, ICE_DELEGATE(HeartbeatCallback)&, int&);
+                                              IceInternal::OutgoingAsyncBasePtr&, ICE_DELEGATE(HeartbeatCallback)&,
+                                              std::vector<OutgoingMessage>&, int&);
 
     void invokeAll(Ice::InputStream&, Int, Int, Byte,
-                   const IceInternal::ServantManagerPtr&, const ObjectAdapterPtr&);
+                   const IceInternal::ServantManagerPtr&, const ObjectAdapterPtr&, const IceUtil::Time&);
 
     void scheduleTimeout(IceInternal::SocketOperation status);
     void unscheduleTimeout(IceInternal::SocketOperation status);
@@ -313,6 +328,7 @@ private:
 
     IceInternal::SocketOperation read(IceInternal::Buffer&);
     IceInternal::SocketOperation write(IceInternal::Buffer&);
+    IceInternal::SocketOperation writeBody(OutgoingMessage&);
 
     void reap();
 
@@ -369,6 +385,23 @@ private:
 
     std::deque<OutgoingMessage> _sendStreams;
 
+    //
+    // Flow control of the oneway and batch requests. The sender asks for
+    // credit and the receiver grants credit in bytes to the sender, the
+    // sender queues its requests in _creditStreams once it runs out of
+    // credit. The receiver returns the credit of the requests as their
+    // dispatch completes.
+    //
+    const bool _flowControl; // True if the connection asks the peer for credit.
+    const Int _flowControlWindow; // The credit granted to peers which ask for it, 0 if disabled.
+    Int _receiveWindow; // The credit granted to the peer, 0 until the peer asks for credit.
+    Int _receiveBytes; // The size of the flow-controlled requests being dispatched.
+    int _receiveDispatches; // The number of flow-controlled dispatches in progress.
+    Int _returnCredit; // The credit not yet returned to the peer.
+    bool _creditGranted; // True once the peer granted credit.
+    Int _sendCredit; // The credit left, negative after using more than the credit granted.
+    std::deque<OutgoingMessage> _creditStreams;
+
     Ice::InputStream _readStream;
     bool _readHeader;
     Ice::OutputStream _writeStream;
@@ -376,6 +409,7 @@ private:
     Observer _observer;
 
     int _dispatchCount;
+    int _readSuspended; // The number of suspensions of reading, see suspendReading().
 
     State _state; // The current state.
     bool _shutdownInitiated;
@@ -0,0 +1,379 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/DispatchLanes.h>
+#include <Ice/ConnectionI.h>
+#include <Ice/InputStream.h>
+#include <Ice/Identity.h>
+#include <Ice/LocalException.h>
+#include <Ice/LoggerUtil.h>
+#include <Ice/Properties.h>
+#include <IceUtil/ThreadException.h>
+
+#include <algorithm>
+
+#ifndef _WIN32
+#   include <pthread.h>
+#endif
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+IceUtil::Shared* IceInternal::upCast(DispatchLanes* p) { return p; }
+
+namespace
+{
+
+const string defaultLaneName = "Default";
+const int defaultMaxQueued = 1000;
+
+//
+// The dispatch lane information of the request dispatched by the calling
+// thread.
+//
+#ifdef _WIN32
+DWORD dispatchLaneKey;
+#else
+pthread_key_t dispatchLaneKey;
+#endif
+
+class Init
+{
+public:
+
+    Init()
+    {
+#ifdef _WIN32
+        dispatchLaneKey = TlsAlloc();
+        if(dispatchLaneKey == TLS_OUT_OF_INDEXES)
+        {
+            throw IceUtil::ThreadSyscallException(__FILE__, __LINE__, GetLastError());
+        }
+#else
+        int err = pthread_key_create(&dispatchLaneKey, 0);
+        if(err != 0)
+        {
+            throw IceUtil::ThreadSyscallException(__FILE__, __LINE__, err);
+        }
+#endif
+    }
+
+    ~Init()
+    {
+#ifdef _WIN32
+        TlsFree(dispatchLaneKey);
+#else
+        pthread_key_delete(dispatchLaneKey);
+#endif
+    }
+};
+
+Init init;
+
+void
+setDispatchLaneInfo(const DispatchLaneInfo* info)
+{
+#ifdef _WIN32
+    TlsSetValue(dispatchLaneKey, const_cast<DispatchLaneInfo*>(info));
+#else
+    pthread_setspecific(dispatchLaneKey, info);
+#endif
+}
+
+class LaneScope : private IceUtil::noncopyable
+{
+public:
+
+    LaneScope(const DispatchLaneInfo& info) :
+        _previous(getDispatchLaneInfo())
+    {
+        setDispatchLaneInfo(&info);
+    }
+
+    ~LaneScope()
+    {
+        setDispatchLaneInfo(_previous);
+    }
+
+private:
+
+    const DispatchLaneInfo* _previous;
+};
+
+//
+// The work item queued with the thread pool for each queued request, it
+// dispatches the next request of the lanes.
+//
+class LaneDispatch : public DispatchWorkItem
+{
+public:
+
+    LaneDispatch(const DispatchLanesPtr& lanes) : _lanes(lanes)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _lanes->dispatch();
+    }
+
+private:
+
+    const DispatchLanesPtr _lanes;
+};
+
+}
+
+const DispatchLaneInfo*
+IceInternal::getDispatchLaneInfo()
+{
+#ifdef _WIN32
+    return static_cast<const DispatchLaneInfo*>(TlsGetValue(dispatchLaneKey));
+#else
+    return static_cast<const DispatchLaneInfo*>(pthread_getspecific(dispatchLaneKey));
+#endif
+}
+
+IceInternal::DispatchLanes::DispatchLanes(const string& name, const PropertiesPtr& properties,
+                                          const LoggerPtr& logger) :
+    _contextKey(properties->getProperty(name + ".LaneContext"))
+{
+    StringSeq names = properties->getPropertyAsList(name + ".Lanes");
+    if(find(names.begin(), names.end(), defaultLaneName) == names.end())
+    {
+        names.push_back(defaultLaneName);
+    }
+
+    for(StringSeq::const_iterator p = names.begin(); p != names.end(); ++p)
+    {
+        if(getLaneByName(*p) < _lanes.size())
+        {
+            Warning out(logger);
+            out << "object adapter `" << name << "': lane `" << *p << "' is listed twice in " << name << ".Lanes";
+            continue;
+        }
+
+        const string prefix = name + ".Lane." + *p;
+        Lane lane;
+        lane.name = *p;
+        lane.weight = properties->getPropertyAsIntWithDefault(prefix + ".Weight", 1);
+        lane.credit = 0;
+        if(lane.weight < 1)
+        {
+            Warning out(logger);
+            out << "object adapter `" << name << "': invalid value for " << prefix << ".Weight, using 1";
+            lane.weight = 1;
+        }
+
+        int maxQueued = properties->getPropertyAsIntWithDefault(prefix + ".MaxQueued", defaultMaxQueued);
+        if(maxQueued < 1)
+        {
+            Warning out(logger);
+            out << "object adapter `" << name << "': invalid value for " << prefix << ".MaxQueued, using "
+                << defaultMaxQueued;
+            maxQueued = defaultMaxQueued;
+        }
+        lane.maxQueued = static_cast<size_t>(maxQueued);
+
+        StringSeq operations = properties->getPropertyAsList(prefix + ".Operations");
+        for(StringSeq::const_iterator q = operations.begin(); q != operations.end(); ++q)
+        {
+            if(!_operations.insert(make_pair(*q, _lanes.size())).second)
+            {
+                Warning out(logger);
+                out << "object adapter `" << name << "': operation `" << *q << "' is assigned to more than one lane";
+            }
+        }
+
+        _lanes.push_back(lane);
+    }
+
+    _defaultLane = getLaneByName(defaultLaneName);
+}
+
+size_t
+IceInternal::DispatchLanes::getLane(InputStream& stream, Int invokeNum) const
+{
+    if(invokeNum > 1)
+    {
+        return _defaultLane; // Batch requests
+    }
+
+    //
+    // Read the operation and context of the request like the dispatch
+    // does, without unmarshaling the context if the lanes don't use it.
+    //
+    InputStream::Container::iterator start = stream.i;
+    size_t lane = _defaultLane;
+    try
+    {
+        Identity id;
+        stream.read(id);
+        vector<string> facetPath;
+        stream.read(facetPath);
+        string operation;
+        stream.read(operation, false);
+
+        map<string, size_t>::const_iterator p = _operations.find(operation);
+        if(p != _operations.end())
+        {
+            lane = p->second;
+        }
+
+        if(!_contextKey.empty())
+        {
+            Byte mode;
+            stream.read(mode);
+            Int sz = stream.readSize();
+            while(sz--)
+            {
+                string key;
+                string value;
+                stream.read(key);
+                stream.read(value);
+                if(key == _contextKey)
+                {
+                    size_t contextLane = getLaneByName(value);
+                    if(contextLane < _lanes.size())
+                    {
+                        lane = contextLane;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+    catch(const LocalException&)
+    {
+        //
+        // Malformed requests are queued with the default lane and
+        // rejected by the dispatch.
+        //
+    }
+    stream.i = start;
+    return lane;
+}
+
+void
+IceInternal::DispatchLanes::queue(const ThreadPoolPtr& threadPool, const ConnectionIPtr& connection,
+                                  const DispatchWorkItemPtr& call, size_t lane, const IceUtil::Time& received)
+{
+    assert(lane < _lanes.size());
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        QueuedDispatch dispatch = { call, received };
+        _lanes[lane].dispatches.push_back(dispatch);
+    }
+
+    try
+    {
+        threadPool->dispatch(new LaneDispatch(this));
+    }
+    catch(const LocalException&)
+    {
+        //
+        // Other requests might have been queued or dispatched since, remove
+        // the request we queued.
+        //
+        IceUtil::Mutex::Lock sync(*this);
+        deque<QueuedDispatch>& dispatches = _lanes[lane].dispatches;
+        for(deque<QueuedDispatch>::iterator p = dispatches.begin(); p != dispatches.end(); ++p)
+        {
+            if(p->call == call)
+            {
+                dispatches.erase(p);
+                break;
+            }
+        }
+        throw;
+    }
+
+    //
+    // The connection is suspended with the lane mutex locked, dispatch()
+    // can't resume it before it's suspended. Each suspension is matched by
+    // a resumption, a connection can be suspended by several lanes.
+    //
+    IceUtil::Mutex::Lock sync(*this);
+    if(_lanes[lane].dispatches.size() >= _lanes[lane].maxQueued)
+    {
+        connection->suspendReading();
+        _lanes[lane].suspended.push_back(connection);
+    }
+}
+
+void
+IceInternal::DispatchLanes::dispatch()
+{
+    DispatchWorkItemPtr call;
+    DispatchLaneInfo info;
+    ConnectionIPtr resumed;
+    {
+        IceUtil::Mutex::Lock sync(*this);
+
+        //
+        // Smooth weighted round-robin: each lane with queued requests
+        // earns its weight in credit, the lane with the most credit is
+        // picked and pays for the dispatch with the total weight of the
+        // lanes which competed for it.
+        //
+        Lane* next = 0;
+        int total = 0;
+        for(vector<Lane>::iterator p = _lanes.begin(); p != _lanes.end(); ++p)
+        {
+            if(!p->dispatches.empty())
+            {
+                p->credit += p->weight;
+                total += p->weight;
+                if(!next || p->credit > next->credit)
+                {
+                    next = &*p;
+                }
+            }
+        }
+        assert(next);
+        next->credit -= total;
+
+        call = next->dispatches.front().call;
+        info.lane = &next->name;
+        info.queueTime = IceUtil::Time::now(IceUtil::Time::Monotonic) - next->dispatches.front().queued;
+        next->dispatches.pop_front();
+        if(next->dispatches.empty())
+        {
+            next->credit = 0;
+        }
+
+        //
+        // Resume the reading of a suspended connection for each request
+        // dispatched while the lane is below its bound.
+        //
+        if(!next->suspended.empty() && next->dispatches.size() < next->maxQueued)
+        {
+            resumed = next->suspended.front();
+            next->suspended.pop_front();
+        }
+    }
+
+    if(resumed)
+    {
+        resumed->resumeReading();
+    }
+
+    LaneScope scope(info);
+    call->run();
+}
+
+size_t
+IceInternal::DispatchLanes::getLaneByName(const string& name) const
+{
+    for(size_t i = 0; i < _lanes.size(); ++i)
+    {
+        if(_lanes[i].name == name)
+        {
+            return i;
+        }
+    }
+    return _lanes.size();
+}
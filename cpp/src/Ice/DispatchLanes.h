@@ -0,0 +1,109 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_DISPATCH_LANES_H
+#define ICE_DISPATCH_LANES_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Time.h>
+#include <Ice/PropertiesF.h>
+#include <Ice/LoggerF.h>
+#include <Ice/DispatchLanesF.h>
+#include <Ice/ConnectionIF.h>
+#include <Ice/ThreadPool.h>
+
+#include <deque>
+#include <map>
+
+namespace IceInternal
+{
+
+//
+// The dispatch lane and queue time of the request dispatched by the
+// calling thread, for the dispatch metrics.
+//
+struct DispatchLaneInfo
+{
+    const std::string* lane;
+    IceUtil::Time queueTime;
+};
+
+//
+// Return the dispatch lane information of the request dispatched by the
+// calling thread, or null if the request wasn't queued with a lane.
+//
+const DispatchLaneInfo* getDispatchLaneInfo();
+
+//
+// The dispatch lanes of an object adapter, configured with the
+// <adapter>.Lanes property. Requests received over the adapter's
+// connections are queued in the lane of their operation or of their
+// <adapter>.LaneContext request context entry, instead of being
+// dispatched by the thread which read them. The thread pool dispatches
+// the queued requests in weighted round-robin order, each lane gets a
+// share of the dispatches proportional to its <adapter>.Lane.<name>.Weight
+// while it has requests queued.
+//
+// Requests which don't belong to a configured lane and batch requests
+// are queued in the Default lane.
+//
+// Each lane queues at most <adapter>.Lane.<name>.MaxQueued requests, a
+// connection which queues a request with a full lane stops reading
+// requests until the lane has room again.
+//
+class DispatchLanes : public IceUtil::Shared, private IceUtil::Mutex
+{
+public:
+
+    DispatchLanes(const std::string&, const Ice::PropertiesPtr&, const Ice::LoggerPtr&);
+
+    //
+    // Return the lane of the given requests. The stream is positioned at
+    // the start of the first request and left unchanged.
+    //
+    size_t getLane(Ice::InputStream&, Ice::Int) const;
+
+    //
+    // Queue the dispatch of a request received over the given connection
+    // with the given lane. The thread pool dispatches the request once it's
+    // its lane's turn. The connection stops reading if the lane is full.
+    //
+    void queue(const ThreadPoolPtr&, const Ice::ConnectionIPtr&, const DispatchWorkItemPtr&, size_t,
+               const IceUtil::Time&);
+
+    //
+    // Dispatch the next request, called by the thread pool.
+    //
+    void dispatch();
+
+private:
+
+    struct QueuedDispatch
+    {
+        DispatchWorkItemPtr call;
+        IceUtil::Time queued;
+    };
+
+    struct Lane
+    {
+        std::string name;
+        int weight;
+        int credit;
+        size_t maxQueued;
+        std::deque<QueuedDispatch> dispatches;
+        std::deque<Ice::ConnectionIPtr> suspended;
+    };
+
+    size_t getLaneByName(const std::string&) const;
+
+    std::vector<Lane> _lanes;
+    size_t _defaultLane;
+    std::string _contextKey;
+    std::map<std::string, size_t> _operations;
+};
+
+}
+
+#endif
@@ -5,7 +5,7 @@
 #include <Ice/Incoming.h>
 #include <Ice/IncomingAsync.h>
 #include <Ice/IncomingRequest.h>
-#include <Ice/ObjectAdapter.h>
+#include <Ice/ObjectAdapterI.h>
 #include <Ice/ServantLocator.h>
 #include <Ice/ServantManager.h>
 #include <Ice/Object.h>
@@ -18,8 +18,15 @@
 #include <Ice/ReplyStatus.h>
 #include <Ice/ResponseHandler.h>
 #include <Ice/StringUtil.h>
+#include <Ice/TracingObserverI.h>
+#include <IceUtil/InputUtil.h>
+#include <IceUtil/ThreadException.h>
 #include <typeinfo>
 
+#ifndef _WIN32
+#   include <pthread.h>
+#endif
+
 using namespace std;
 using namespace Ice;
 using namespace Ice::Instrumentation;
@@ -32,6 +39,106 @@ extern bool printStackTraces;
 
 }
 
+namespace
+{
+
+//
+// The deadline of the request dispatched by the calling thread.
+//
+#ifdef _WIN32
+DWORD dispatchDeadlineKey;
+#else
+pthread_key_t dispatchDeadlineKey;
+#endif
+
+class Init
+{
+public:
+
+    Init()
+    {
+#ifdef _WIN32
+        dispatchDeadlineKey = TlsAlloc();
+        if(dispatchDeadlineKey == TLS_OUT_OF_INDEXES)
+        {
+            throw IceUtil::ThreadSyscallException(__FILE__, __LINE__, GetLastError());
+        }
+#else
+        int err = pthread_key_create(&dispatchDeadlineKey, 0);
+        if(err != 0)
+        {
+            throw IceUtil::ThreadSyscallException(__FILE__, __LINE__, err);
+        }
+#endif
+    }
+
+    ~Init()
+    {
+#ifdef _WIN32
+        TlsFree(dispatchDeadlineKey);
+#else
+        pthread_key_delete(dispatchDeadlineKey);
+#endif
+    }
+};
+
+Init init;
+
+const IceUtil::Time*
+getCurrentDeadline()
+{
+#ifdef _WIN32
+    return static_cast<const IceUtil::Time*>(TlsGetValue(dispatchDeadlineKey));
+#else
+    return static_cast<const IceUtil::Time*>(pthread_getspecific(dispatchDeadlineKey));
+#endif
+}
+
+void
+setCurrentDeadline(const IceUtil::Time* deadline)
+{
+#ifdef _WIN32
+    TlsSetValue(dispatchDeadlineKey, const_cast<IceUtil::Time*>(deadline));
+#else
+    pthread_setspecific(dispatchDeadlineKey, deadline);
+#endif
+}
+
+//
+// Makes the deadline of a request the deadline of the calling thread, for
+// the lifetime of the scope.
+//
+class DeadlineScope : private IceUtil::noncopyable
+{
+public:
+
+    DeadlineScope(const IceUtil::Time& deadline) :
+        _previous(getCurrentDeadline())
+    {
+        setCurrentDeadline(&deadline);
+    }
+
+    ~DeadlineScope()
+    {
+        setCurrentDeadline(_previous);
+    }
+
+private:
+
+    const IceUtil::Time* _previous;
+};
+
+}
+
+const char* const IceInternal::deadlineContextKey = "_deadline";
+
+IceUtil::Time
+IceInternal::getDispatchDeadline()
+{
+    const IceUtil::Time* deadline = getCurrentDeadline();
+    return deadline ? *deadline : IceUtil::Time();
+}
+
 #ifdef ICE_CPP11_MAPPING
 Ice::MarshaledResult::MarshaledResult(const Ice::Current& current) :
     ostr(make_shared<Ice::OutputStream>(current.adapter->getCommunicator(), Ice::currentProtocolEncoding))
@@ -49,7 +156,8 @@ IceInternal::IncomingBase::IncomingBase(Instance* instance, ResponseHandler* res
     _compress(compress),
     _format(Ice::ICE_ENUM(FormatType, DefaultFormat)),
     _os(instance, Ice::currentProtocolEncoding),
-    _responseHandler(responseHandler)
+    _responseHandler(responseHandler),
+    _admittedBy(0)
 {
     _current.adapter = adapter;
 #ifdef ICE_CPP11_MAPPING
@@ -74,9 +182,11 @@ IceInternal::IncomingBase::IncomingBase(IncomingBase& other) :
     _format(other._format),
     _os(other._os.instance(), Ice::currentProtocolEncoding),
     _responseHandler(other._responseHandler),
+    _admittedBy(other._admittedBy),
     _interceptorCBs(other._interceptorCBs)
 {
     _observer.adopt(other._observer);
+    other._admittedBy = 0;
 }
 
 OutputStream*
@@ -179,6 +289,7 @@ IceInternal::IncomingBase::response(bool amd)
 
     _observer.detach();
     _responseHandler = 0;
+    finishAdmitted();
 }
 
 void
@@ -195,6 +306,7 @@ IceInternal::IncomingBase::exception(const std::exception& exc, bool amd)
     catch(const LocalException& ex)
     {
         _responseHandler->invokeException(_current.requestId, ex, 1, amd);  // Fatal invocation exception
+        finishAdmitted();
     }
 }
 
@@ -212,6 +324,7 @@ IceInternal::IncomingBase::exception(const string& msg, bool amd)
     catch(const LocalException& ex)
     {
         _responseHandler->invokeException(_current.requestId, ex, 1, amd);  // Fatal invocation exception
+        finishAdmitted();
     }
 }
 
@@ -294,6 +407,16 @@ IceInternal::IncomingBase::servantLocatorFinished(bool amd)
     return false;
 }
 
+void
+IceInternal::IncomingBase::finishAdmitted()
+{
+    if(_admittedBy)
+    {
+        _admittedBy->dispatchFinished();
+        _admittedBy = 0;
+    }
+}
+
 void
 IceInternal::IncomingBase::handleException(const std::exception& exc, bool amd)
 {
@@ -515,6 +638,7 @@ IceInternal::IncomingBase::handleException(const std::exception& exc, bool amd)
 
     _observer.detach();
     _responseHandler = 0;
+    finishAdmitted();
 }
 
 void
@@ -554,6 +678,7 @@ IceInternal::IncomingBase::handleException(const string& msg, bool amd)
 
     _observer.detach();
     _responseHandler = 0;
+    finishAdmitted();
 }
 
 IceInternal::Incoming::Incoming(Instance* instance, ResponseHandler* responseHandler, Ice::Connection* connection,
@@ -609,7 +734,8 @@ IceInternal::Incoming::startOver()
 }
 
 void
-IceInternal::Incoming::invoke(const ServantManagerPtr& servantManager, InputStream* stream)
+IceInternal::Incoming::invoke(const ServantManagerPtr& servantManager, InputStream* stream, ObjectAdapterI* adapter,
+                              const IceUtil::Time& received)
 {
     _is = stream;
 
@@ -664,6 +790,40 @@ IceInternal::Incoming::invoke(const ServantManagerPtr& servantManager, InputStre
         _observer.attach(obsv->getDispatchObserver(_current, static_cast<Int>(_is->i - start + encapsSize)));
     }
 
+    //
+    // Requests which carry a deadline are rejected once the deadline
+    // expired, the caller already gave up on the response. The remaining
+    // time is counted from the time the request was received if known.
+    //
+    IceUtil::Time deadline;
+    if(!_current.ctx.empty())
+    {
+        Context::const_iterator p = _current.ctx.find(deadlineContextKey);
+        IceUtil::Int64 remaining;
+        if(p != _current.ctx.end() && IceUtilInternal::stringToInt64(p->second, remaining) && remaining >= 0 &&
+           remaining <= 0x7fffffff)
+        {
+            IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            deadline = (received != IceUtil::Time() ? received : now) + IceUtil::Time::milliSeconds(remaining);
+            if(deadline <= now)
+            {
+                reject("dispatch rejected: the request deadline expired");
+                return;
+            }
+        }
+    }
+
+    if(adapter && adapter->hasAdmissionControl())
+    {
+        if(!adapter->admitDispatch(received))
+        {
+            reject("dispatch rejected by object adapter `" + adapter->getName() + "': request queued for longer than " +
+                   adapter->getName() + ".MaxQueueWait");
+            return;
+        }
+        _admittedBy = adapter;
+    }
+
     //
     // Don't put the code above into the try block below. Exceptions
     // in the code above are considered fatal, and must propagate to
@@ -729,7 +889,15 @@ IceInternal::Incoming::invoke(const ServantManagerPtr& servantManager, InputStre
         //
         // Dispatch in the incoming call
         //
-        _servant->_iceDispatch(*this, _current);
+        if(deadline != IceUtil::Time())
+        {
+            DeadlineScope deadlineScope(deadline);
+            dispatch();
+        }
+        else
+        {
+            dispatch();
+        }
 
         //
         // If the request was not dispatched asynchronously, send the response.
@@ -788,6 +956,55 @@ IceInternal::Incoming::invoke(const ServantManagerPtr& servantManager, InputStre
     }
 }
 
+void
+IceInternal::Incoming::dispatch()
+{
+    if(_observer && _is->instance()->getTracingObserver())
+    {
+        TraceScope traceScope(_observer.get());
+        _servant->_iceDispatch(*this, _current);
+    }
+    else
+    {
+        _servant->_iceDispatch(*this, _current);
+    }
+}
+
+void
+IceInternal::Incoming::reject(const string& reason)
+{
+    //
+    // The request isn't dispatched, it's rejected without the dispatch
+    // warning to not flood the log of an overloaded server. The failure
+    // is recorded with the dispatch metrics.
+    //
+    skipReadParams(); // Required for batch requests.
+    _observer.failed("::Ice::DispatchRejected");
+    try
+    {
+        if(_response)
+        {
+            _os.writeBlob(replyHdr, sizeof(replyHdr));
+            _os.write(_current.requestId);
+            _os.write(replyUnknownLocalException);
+            _os.write(reason, false);
+            _observer.reply(static_cast<Int>(_os.b.size() - headerSize - 4));
+            _responseHandler->sendResponse(_current.requestId, &_os, _compress, false);
+        }
+        else
+        {
+            _responseHandler->sendNoResponse();
+        }
+    }
+    catch(const LocalException& ex)
+    {
+        _responseHandler->invokeException(_current.requestId, ex, 1, false); // Fatal invocation exception
+    }
+
+    _observer.detach();
+    _responseHandler = 0;
+}
+
 const Current&
 IceInternal::IncomingRequest::getCurrent()
 {
@@ -130,6 +130,8 @@ IceInternal::IncomingAsync::kill(Incoming& in)
 {
     checkResponseSent();
     in._observer.adopt(_observer); // Give back the observer to incoming.
+    in._admittedBy = _admittedBy;
+    _admittedBy = 0;
 }
 
 void
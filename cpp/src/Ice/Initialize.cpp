@@ -9,6 +9,7 @@
 #include <Ice/LocalException.h>
 #include <Ice/LoggerI.h>
 #include <Ice/Instance.h>
+#include <Ice/Incoming.h>
 #include <Ice/PluginManagerI.h>
 #include <Ice/StringUtil.h>
 #include <IceUtil/Mutex.h>
@@ -652,3 +653,15 @@ Ice::identityToString(const Identity& ident, ToStringMode toStringMode)
         return escapeString(ident.category, "/", toStringMode) + '/' + escapeString(ident.name, "/", toStringMode);
     }
 }
+
+Int
+Ice::getDispatchRemainingTime()
+{
+    IceUtil::Time deadline = getDispatchDeadline();
+    if(deadline == IceUtil::Time())
+    {
+        return -1;
+    }
+    IceUtil::Time remaining = deadline - IceUtil::Time::now(IceUtil::Time::Monotonic);
+    return remaining > IceUtil::Time() ? static_cast<Int>(remaining.toMilliSeconds()) : 0;
+}
@@ -20,6 +20,9 @@
 #include <Ice/PropertiesI.h>
 #include <Ice/PropertiesAdminI.h>
 #include <Ice/LoggerI.h>
+#ifndef ICE_OS_UWP
+#   include <Ice/AsyncLoggerI.h>
+#endif
 #include <Ice/NetworkProxy.h>
 #include <Ice/EndpointFactoryManager.h>
 #include <Ice/IPEndpointI.h> // For EndpointHostResolver
@@ -33,8 +36,12 @@
 #include <Ice/PropertiesI.h>
 #include <Ice/Communicator.h>
 #include <Ice/InstrumentationI.h>
+#include <Ice/TracingObserverI.h>
 #include <Ice/ProtocolInstance.h>
 #include <Ice/LoggerAdminI.h>
+#ifndef ICE_OS_UWP
+#   include <Ice/OpenMetricsExporter.h>
+#endif
 #include <Ice/RegisterPluginsInit.h>
 #include <Ice/ObserverHelper.h>
 #include <Ice/Functional.h>
@@ -949,6 +956,7 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
     _batchAutoFlushSize(0),
     _classGraphDepthMax(0),
     _collectObjects(false),
+    _propagateDeadline(false),
     _toStringMode(ICE_ENUM(ToStringMode, Unicode)),
     _implicitContext(0),
     _stringConverter(Ice::getProcessStringConverter()),
@@ -1140,6 +1148,25 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
             }
         }
 
+#ifndef ICE_OS_UWP
+        if(_initData.properties->getPropertyAsInt("Ice.LogAsync") > 0)
+        {
+            //
+            // Queue the log messages and write them with a background thread,
+            // logging threads don't wait for the logger I/O.
+            //
+            Int queueSize = _initData.properties->getPropertyAsIntWithDefault("Ice.LogAsync.QueueSize", 4096);
+            if(queueSize < 1)
+            {
+                queueSize = 4096;
+            }
+            AsyncLoggerPtr asyncLogger = new AsyncLogger(_initData.logger, queueSize);
+            asyncLogger->start();
+            _asyncLogger = asyncLogger;
+            _initData.logger = ICE_MAKE_SHARED(AsyncLoggerI, _asyncLogger, _initData.logger);
+        }
+#endif
+
         const_cast<TraceLevelsPtr&>(_traceLevels) = new TraceLevels(_initData.properties);
 
         const_cast<DefaultsAndOverridesPtr&>(_defaultsAndOverrides) =
@@ -1212,6 +1239,7 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
         }
 
         const_cast<bool&>(_collectObjects) = _initData.properties->getPropertyAsInt("Ice.CollectObjects") > 0;
+        const_cast<bool&>(_propagateDeadline) = _initData.properties->getPropertyAsInt("Ice.PropagateDeadline") > 0;
 
         string toStringModeStr = _initData.properties->getPropertyWithDefault("Ice.ToStringMode", "Unicode");
         if(toStringModeStr == "ASCII")
@@ -1307,6 +1335,8 @@ IceInternal::Instance::~Instance()
     assert(!_clientThreadPool);
     assert(!_serverThreadPool);
     assert(!_endpointHostResolver);
+    assert(!_metricsExporter);
+    assert(!_asyncLogger);
     assert(!_retryQueue);
     assert(!_timer);
     assert(!_routerManager);
@@ -1439,9 +1469,39 @@ IceInternal::Instance::finishSetup(int& argc, const char* argv[], const Ice::Com
                 propsAdmin->addUpdateCallback(observer->getFacet());
 #endif
             }
+
+#ifndef ICE_OS_UWP
+            //
+            // Serve the metrics over HTTP if the OpenMetrics exporter is configured.
+            //
+            if(_initData.properties->getPropertyAsInt("IceMX.OpenMetrics.Port") > 0)
+            {
+                _metricsExporter = new OpenMetricsExporter(this, observer->getFacet());
+                try
+                {
+                    _metricsExporter->start();
+                }
+                catch(const IceUtil::Exception& ex)
+                {
+                    Error out(_initData.logger);
+                    out << "cannot create thread for metrics exporter:\n" << ex;
+                    _metricsExporter = 0;
+                    throw;
+                }
+            }
+#endif
         }
     }
 
+    //
+    // Record invocation and dispatch spans if tracing is enabled.
+    //
+    if(!_initData.properties->getProperty("IceMX.Tracing.File").empty())
+    {
+        _tracingObserver = ICE_MAKE_SHARED(TracingObserverI, _initData);
+        _initData.observer = _tracingObserver;
+    }
+
     //
     // Set observer updater
     //
@@ -1628,9 +1688,21 @@ IceInternal::Instance::destroy()
         _retryQueue->destroy(); // Must be called before destroying thread pools.
     }
 
+#ifndef ICE_OS_UWP
+    if(_metricsExporter)
+    {
+        _metricsExporter->destroy();
+        _metricsExporter->getThreadControl().join();
+    }
+#endif
+
     if(_initData.observer)
     {
-        CommunicatorObserverIPtr observer = ICE_DYNAMIC_CAST(CommunicatorObserverI, _initData.observer);
+        //
+        // The tracing observer wraps the metrics observer, if enabled.
+        //
+        CommunicatorObserverIPtr observer = ICE_DYNAMIC_CAST(CommunicatorObserverI,
+            _tracingObserver ? _tracingObserver->getDelegate() : _initData.observer);
         if(observer)
         {
             observer->destroy(); // Break cyclic reference counts. Don't clear _observer, it's immutable.
@@ -1727,6 +1799,25 @@ IceInternal::Instance::destroy()
         }
     }
 
+    //
+    // Write the remaining spans, all the invocations and dispatches are
+    // completed at this point.
+    //
+    if(_tracingObserver)
+    {
+        _tracingObserver->destroy();
+    }
+
+#ifndef ICE_OS_UWP
+    //
+    // Write the queued log messages, the logger writes synchronously from now on.
+    //
+    if(_asyncLogger)
+    {
+        _asyncLogger->destroy();
+    }
+#endif
+
     //
     // Destroy last so that a Logger plugin can receive all log/traces before its destruction.
     //
@@ -1745,6 +1836,8 @@ IceInternal::Instance::destroy()
         _serverThreadPool = 0;
         _clientThreadPool = 0;
         _endpointHostResolver = 0;
+        _metricsExporter = 0;
+        _asyncLogger = 0;
         _timer = 0;
 
         _referenceFactory = 0;
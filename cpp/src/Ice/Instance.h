@@ -57,6 +57,15 @@ ICE_DEFINE_PTR(MetricsAdminIPtr, MetricsAdminI);
 class RequestHandlerFactory;
 typedef IceUtil::Handle<RequestHandlerFactory> RequestHandlerFactoryPtr;
 
+class OpenMetricsExporter;
+typedef IceUtil::Handle<OpenMetricsExporter> OpenMetricsExporterPtr;
+
+class AsyncLogger;
+typedef IceUtil::Handle<AsyncLogger> AsyncLoggerPtr;
+
+class TracingObserverI;
+ICE_DEFINE_PTR(TracingObserverIPtr, TracingObserverI);
+
 //
 // Structure to track warnings for attempts to set socket buffer sizes
 //
@@ -105,6 +114,7 @@ public:
     size_t batchAutoFlushSize() const { return _batchAutoFlushSize; }
     size_t classGraphDepthMax() const { return _classGraphDepthMax; }
     bool collectObjects() const { return _collectObjects; }
+    bool propagateDeadline() const { return _propagateDeadline; }
     Ice::ToStringMode toStringMode() const { return _toStringMode; }
     const ACMConfig& clientACM() const;
     const ACMConfig& serverACM() const;
@@ -121,6 +131,11 @@ public:
         return _implicitContext;
     }
 
+    const TracingObserverIPtr& getTracingObserver() const
+    {
+        return _tracingObserver;
+    }
+
     void setDefaultLocator(const Ice::LocatorPrxPtr&);
     void setDefaultRouter(const Ice::RouterPrxPtr&);
 
@@ -174,6 +189,7 @@ private:
     const size_t _batchAutoFlushSize; // Immutable, not reset by destroy().
     const size_t _classGraphDepthMax; // Immutable, not reset by destroy().
     const bool _collectObjects; // Immutable, not reset by destroy().
+    const bool _propagateDeadline; // Immutable, not reset by destroy().
     const Ice::ToStringMode _toStringMode; // Immutable, not reset by destroy()
     ACMConfig _clientACM;
     ACMConfig _serverACM;
@@ -190,6 +206,9 @@ private:
     ThreadPoolPtr _clientThreadPool;
     ThreadPoolPtr _serverThreadPool;
     EndpointHostResolverPtr _endpointHostResolver;
+    OpenMetricsExporterPtr _metricsExporter;
+    AsyncLoggerPtr _asyncLogger;
+    TracingObserverIPtr _tracingObserver; // Immutable, not reset by destroy()
     RetryQueuePtr _retryQueue;
     TimerPtr _timer;
     EndpointFactoryManagerPtr _endpointFactoryManager;
@@ -10,6 +10,7 @@
 #include <Ice/LocalException.h>
 #include <Ice/Communicator.h>
 #include <Ice/LoggerUtil.h>
+#include <Ice/DispatchLanes.h>
 
 using namespace std;
 using namespace Ice;
@@ -223,13 +224,15 @@ public:
             add("facet", &DispatchHelper::getCurrent, &Current::facet);
             add("mode", &DispatchHelper::getMode);
             add("requestId", &DispatchHelper::getCurrent, &Current::requestId);
+            add("lane", &DispatchHelper::getLane);
 
             setDefault(&DispatchHelper::resolve);
         }
     };
     static Attributes attributes;
 
-    DispatchHelper(const Current& current, int size) : _current(current), _size(size)
+    DispatchHelper(const Current& current, int size) :
+        _current(current), _size(size), _lane(getDispatchLaneInfo())
     {
     }
 
@@ -241,6 +244,10 @@ public:
     virtual void initMetrics(const DispatchMetricsPtr& v) const
     {
         v->size += _size;
+        if(_lane)
+        {
+            v->queueTime = (v->queueTime ? *v->queueTime : 0) + _lane->queueTime.toMicroSeconds();
+        }
     }
 
     string resolve(const string& attribute) const
@@ -262,6 +269,12 @@ public:
         return _current.requestId == 0 ? "oneway" : "twoway";
     }
 
+    string
+    getLane() const
+    {
+        return _lane ? *_lane->lane : string();
+    }
+
     const string&
     getId() const
     {
@@ -336,6 +349,7 @@ private:
 
     const Current& _current;
     const int _size;
+    const DispatchLaneInfo* _lane;
     mutable string _id;
     mutable EndpointInfoPtr _endpointInfo;
 };
@@ -14,6 +14,9 @@
 #include <Ice/Functional.h>
 #include <Ice/Properties.h>
 #include <Ice/Comparable.h>
+#include <Ice/Connection.h>
+#include <Ice/ObjectAdapter.h>
+#include <Ice/ObjectAdapterFactory.h>
 #include <iterator>
 
 using namespace std;
@@ -42,7 +45,7 @@ public:
         {
 #ifdef ICE_CPP11_MAPPING
             LocatorInfo::RequestPtr request = this;
-            _locatorInfo->getLocator()->findObjectByIdAsync(
+            _locatorInfo->getLookupLocator()->findObjectByIdAsync(
                 _reference->getIdentity(),
                 [request](const ObjectPrxPtr& object)
                 {
@@ -60,7 +63,7 @@ public:
                     }
                 });
 #else
-            _locatorInfo->getLocator()->begin_findObjectById(
+            _locatorInfo->getLookupLocator()->begin_findObjectById(
                 _reference->getIdentity(),
                 newCallback_Locator_findObjectById(static_cast<LocatorInfo::Request*>(this),
                                                    &LocatorInfo::Request::response,
@@ -89,7 +92,7 @@ public:
         {
 #ifdef ICE_CPP11_MAPPING
             LocatorInfo::RequestPtr request = this;
-            _locatorInfo->getLocator()->findAdapterByIdAsync(_reference->getAdapterId(),
+            _locatorInfo->getLookupLocator()->findAdapterByIdAsync(_reference->getAdapterId(),
                 [request](const shared_ptr<Ice::ObjectPrx>& object)
                 {
                     request->response(object);
@@ -106,7 +109,7 @@ public:
                     }
                 });
 #else
-            _locatorInfo->getLocator()->begin_findAdapterById(
+            _locatorInfo->getLookupLocator()->begin_findAdapterById(
                 _reference->getAdapterId(),
                 newCallback_Locator_findAdapterById(static_cast<LocatorInfo::Request*>(this),
                                                     &LocatorInfo::Request::response,
@@ -120,10 +123,119 @@ public:
     }
 };
 
+//
+// The locator cache observer removes the adapters and objects changed
+// on the locator from the locator cache.
+//
+class LocatorCacheObserverI : public Ice::LocatorCacheObserver
+{
+public:
+
+    LocatorCacheObserverI(const InstancePtr& instance, const LocatorTablePtr& table) :
+        _instance(instance),
+        _table(table)
+    {
+    }
+
+    virtual void
+    adaptersChanged(ICE_IN(StringSeq) ids, const Current&)
+    {
+        for(StringSeq::const_iterator p = ids.begin(); p != ids.end(); ++p)
+        {
+            vector<EndpointIPtr> endpoints = _table->removeAdapterEndpoints(*p);
+            if(!endpoints.empty() && _instance->traceLevels()->location >= 2)
+            {
+                Trace out(_instance->initializationData().logger, _instance->traceLevels()->locationCat);
+                out << "removed endpoints for changed adapter from locator cache\nadapter = " << *p;
+            }
+        }
+    }
+
+    virtual void
+    objectsChanged(ICE_IN(IdentitySeq) ids, const Current&)
+    {
+        for(IdentitySeq::const_iterator p = ids.begin(); p != ids.end(); ++p)
+        {
+            ReferencePtr ref = _table->removeObjectReference(*p);
+            if(ref && _instance->traceLevels()->location >= 2)
+            {
+                Trace out(_instance->initializationData().logger, _instance->traceLevels()->locationCat);
+                out << "removed changed well-known object from locator cache\nobject = "
+                    << Ice::identityToString(*p, _instance->toStringMode());
+            }
+        }
+    }
+
+private:
+
+    const InstancePtr _instance;
+    const LocatorTablePtr _table;
+};
+
+#ifndef ICE_CPP11_MAPPING
+class SubscribeCallback : public IceUtil::Shared
+{
+public:
+
+    SubscribeCallback(const LocatorInfoPtr& locatorInfo, const ConnectionPtr& connection) :
+        _locatorInfo(locatorInfo),
+        _connection(connection)
+    {
+    }
+
+    void
+    connected(const ConnectionPtr& connection)
+    {
+        _locatorInfo->subscribeConnected(connection);
+    }
+
+    void
+    response()
+    {
+        _locatorInfo->subscribeResponse(_connection);
+    }
+
+    void
+    exception(const Ice::Exception& ex)
+    {
+        _locatorInfo->subscribeException(_connection, ex);
+    }
+
+private:
+
+    const LocatorInfoPtr _locatorInfo;
+    const ConnectionPtr _connection;
+};
+typedef IceUtil::Handle<SubscribeCallback> SubscribeCallbackPtr;
+
+class CloseCallbackI : public Ice::CloseCallback
+{
+public:
+
+    CloseCallbackI(const LocatorInfoPtr& locatorInfo) : _locatorInfo(locatorInfo)
+    {
+    }
+
+    virtual void
+    closed(const ConnectionPtr& connection)
+    {
+        _locatorInfo->connectionClosed(connection);
+    }
+
+private:
+
+    const LocatorInfoPtr _locatorInfo;
+};
+#endif
+
 }
 
 IceInternal::LocatorManager::LocatorManager(const Ice::PropertiesPtr& properties) :
     _background(properties->getPropertyAsInt("Ice.BackgroundLocatorCacheUpdates") > 0),
+    _subscribe(properties->getPropertyAsInt("Ice.LocatorCacheSubscription") > 0),
+    _cacheSizeMax(properties->getPropertyAsInt("Ice.LocatorCacheSizeMax")),
+    _cacheRefreshAhead(properties->getPropertyAsInt("Ice.LocatorCacheRefreshAhead")),
+    _cacheNegativeTimeout(properties->getPropertyAsInt("Ice.LocatorCacheNegativeTimeout")),
     _tableHint(_table.end())
 {
 }
@@ -188,13 +300,16 @@ IceInternal::LocatorManager::get(const LocatorPrxPtr& loc)
         {
             t = _locatorTables.insert(_locatorTables.begin(),
                                       pair<const pair<Identity, EncodingVersion>, LocatorTablePtr>(
-                                          locatorKey, new LocatorTable()));
+                                          locatorKey, new LocatorTable(_cacheSizeMax,
+                                                                       _cacheRefreshAhead,
+                                                                       _cacheNegativeTimeout)));
         }
 
         _tableHint = _table.insert(_tableHint,
                                    pair<const LocatorPrxPtr, LocatorInfoPtr>(locator,
                                                                           new LocatorInfo(locator, t->second,
-                                                                                          _background)));
+                                                                                          _background,
+                                                                                          _subscribe)));
     }
     else
     {
@@ -204,7 +319,10 @@ IceInternal::LocatorManager::get(const LocatorPrxPtr& loc)
     return _tableHint->second;
 }
 
-IceInternal::LocatorTable::LocatorTable()
+IceInternal::LocatorTable::LocatorTable(int sizeMax, int refreshAhead, int negativeTimeout) :
+    _sizeMax(static_cast<size_t>(max(sizeMax, 0))),
+    _refreshAhead(max(refreshAhead, 0)),
+    _negativeTimeout(IceUtil::Time::seconds(max(negativeTimeout, 0)))
 {
 }
 
@@ -214,11 +332,16 @@ IceInternal::LocatorTable::clear()
      IceUtil::Mutex::Lock sync(*this);
 
      _adapterEndpointsMap.clear();
+     _adapterLRU.clear();
      _objectMap.clear();
+     _objectLRU.clear();
+     _adapterNotFoundMap.clear();
+     _objectNotFoundMap.clear();
 }
 
 bool
-IceInternal::LocatorTable::getAdapterEndpoints(const string& adapter, int ttl, vector<EndpointIPtr>& endpoints)
+IceInternal::LocatorTable::getAdapterEndpoints(const string& adapter, int ttl, vector<EndpointIPtr>& endpoints,
+                                               bool& refresh)
 {
     if(ttl == 0) // No locator cache.
     {
@@ -227,12 +350,13 @@ IceInternal::LocatorTable::getAdapterEndpoints(const string& adapter, int ttl, v
 
     IceUtil::Mutex::Lock sync(*this);
 
-    map<string, pair<IceUtil::Time, vector<EndpointIPtr> > >::iterator p = _adapterEndpointsMap.find(adapter);
+    map<string, AdapterEndpoints>::iterator p = _adapterEndpointsMap.find(adapter);
 
     if(p != _adapterEndpointsMap.end())
     {
-        endpoints = p->second.second;
-        return checkTTL(p->second.first, ttl);
+        endpoints = p->second.endpoints;
+        _adapterLRU.splice(_adapterLRU.begin(), _adapterLRU, p->second.lru);
+        return checkTTL(p->second.time, ttl, refresh);
     }
     return false;
 }
@@ -242,16 +366,34 @@ IceInternal::LocatorTable::addAdapterEndpoints(const string& adapter, const vect
 {
     IceUtil::Mutex::Lock sync(*this);
 
-    map<string, pair<IceUtil::Time, vector<EndpointIPtr> > >::iterator p = _adapterEndpointsMap.find(adapter);
+    _adapterNotFoundMap.erase(adapter);
+
+    map<string, AdapterEndpoints>::iterator p = _adapterEndpointsMap.find(adapter);
 
     if(p != _adapterEndpointsMap.end())
     {
-        p->second = make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), endpoints);
+        p->second.time = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        p->second.endpoints = endpoints;
+        _adapterLRU.splice(_adapterLRU.begin(), _adapterLRU, p->second.lru);
     }
     else
     {
-        _adapterEndpointsMap.insert(
-            make_pair(adapter, make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), endpoints)));
+        _adapterLRU.push_front(adapter);
+
+        AdapterEndpoints entry;
+        entry.time = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        entry.endpoints = endpoints;
+        entry.lru = _adapterLRU.begin();
+        _adapterEndpointsMap.insert(make_pair(adapter, entry));
+
+        //
+        // Evict the least recently used entry if the cache is full.
+        //
+        if(_sizeMax > 0 && _adapterEndpointsMap.size() > _sizeMax)
+        {
+            _adapterEndpointsMap.erase(_adapterLRU.back());
+            _adapterLRU.pop_back();
+        }
     }
 }
 
@@ -260,21 +402,48 @@ IceInternal::LocatorTable::removeAdapterEndpoints(const string& adapter)
 {
     IceUtil::Mutex::Lock sync(*this);
 
-    map<string, pair<IceUtil::Time, vector<EndpointIPtr> > >::iterator p = _adapterEndpointsMap.find(adapter);
+    _adapterNotFoundMap.erase(adapter);
+
+    map<string, AdapterEndpoints>::iterator p = _adapterEndpointsMap.find(adapter);
     if(p == _adapterEndpointsMap.end())
     {
         return vector<EndpointIPtr>();
     }
 
-    vector<EndpointIPtr> endpoints = p->second.second;
+    vector<EndpointIPtr> endpoints = p->second.endpoints;
 
+    _adapterLRU.erase(p->second.lru);
     _adapterEndpointsMap.erase(p);
 
     return endpoints;
 }
 
 bool
-IceInternal::LocatorTable::getObjectReference(const Identity& id, int ttl, ReferencePtr& ref)
+IceInternal::LocatorTable::isAdapterNotFound(const string& adapter)
+{
+    if(_negativeTimeout == IceUtil::Time()) // No negative caching.
+    {
+        return false;
+    }
+
+    IceUtil::Mutex::Lock sync(*this);
+    return checkNotFound(_adapterNotFoundMap, adapter);
+}
+
+void
+IceInternal::LocatorTable::addAdapterNotFound(const string& adapter)
+{
+    if(_negativeTimeout == IceUtil::Time()) // No negative caching.
+    {
+        return;
+    }
+
+    IceUtil::Mutex::Lock sync(*this);
+    addNotFound(_adapterNotFoundMap, adapter);
+}
+
+bool
+IceInternal::LocatorTable::getObjectReference(const Identity& id, int ttl, ReferencePtr& ref, bool& refresh)
 {
     if(ttl == 0) // No locator cache
     {
@@ -283,12 +452,13 @@ IceInternal::LocatorTable::getObjectReference(const Identity& id, int ttl, Refer
 
     IceUtil::Mutex::Lock sync(*this);
 
-    map<Identity, pair<IceUtil::Time, ReferencePtr> >::iterator p = _objectMap.find(id);
+    map<Identity, ObjectReference>::iterator p = _objectMap.find(id);
 
     if(p != _objectMap.end())
     {
-        ref = p->second.second;
-        return checkTTL(p->second.first, ttl);
+        ref = p->second.reference;
+        _objectLRU.splice(_objectLRU.begin(), _objectLRU, p->second.lru);
+        return checkTTL(p->second.time, ttl, refresh);
     }
     return false;
 }
@@ -298,16 +468,64 @@ IceInternal::LocatorTable::addObjectReference(const Identity& id, const Referenc
 {
     IceUtil::Mutex::Lock sync(*this);
 
-    map<Identity, pair<IceUtil::Time, ReferencePtr> >::iterator p = _objectMap.find(id);
+    _objectNotFoundMap.erase(id);
+
+    map<Identity, ObjectReference>::iterator p = _objectMap.find(id);
 
     if(p != _objectMap.end())
     {
-        p->second = make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), ref);
+        p->second.time = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        p->second.reference = ref;
+        _objectLRU.splice(_objectLRU.begin(), _objectLRU, p->second.lru);
     }
     else
     {
-        _objectMap.insert(make_pair(id, make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), ref)));
+        _objectLRU.push_front(id);
+
+        ObjectReference entry;
+        entry.time = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        entry.reference = ref;
+        entry.lru = _objectLRU.begin();
+        _objectMap.insert(make_pair(id, entry));
+
+        //
+        // Evict the least recently used entry if the cache is full.
+        //
+        if(_sizeMax > 0 && _objectMap.size() > _sizeMax)
+        {
+            _objectMap.erase(_objectLRU.back());
+            _objectLRU.pop_back();
+        }
+    }
+}
+
+vector<string>
+IceInternal::LocatorTable::getAdapterIds()
+{
+    IceUtil::Mutex::Lock sync(*this);
+
+    vector<string> ids;
+    ids.reserve(_adapterEndpointsMap.size());
+    for(map<string, AdapterEndpoints>::const_iterator p = _adapterEndpointsMap.begin();
+        p != _adapterEndpointsMap.end(); ++p)
+    {
+        ids.push_back(p->first);
+    }
+    return ids;
+}
+
+vector<Identity>
+IceInternal::LocatorTable::getObjectIds()
+{
+    IceUtil::Mutex::Lock sync(*this);
+
+    vector<Identity> ids;
+    ids.reserve(_objectMap.size());
+    for(map<Identity, ObjectReference>::const_iterator p = _objectMap.begin(); p != _objectMap.end(); ++p)
+    {
+        ids.push_back(p->first);
     }
+    return ids;
 }
 
 ReferencePtr
@@ -315,29 +533,114 @@ IceInternal::LocatorTable::removeObjectReference(const Identity& id)
 {
     IceUtil::Mutex::Lock sync(*this);
 
-    map<Identity, pair<IceUtil::Time, ReferencePtr> >::iterator p = _objectMap.find(id);
+    _objectNotFoundMap.erase(id);
+
+    map<Identity, ObjectReference>::iterator p = _objectMap.find(id);
     if(p == _objectMap.end())
     {
         return 0;
     }
 
-    ReferencePtr ref = p->second.second;
+    ReferencePtr ref = p->second.reference;
+    _objectLRU.erase(p->second.lru);
     _objectMap.erase(p);
     return ref;
 }
 
 bool
-IceInternal::LocatorTable::checkTTL(const IceUtil::Time& time, int ttl) const
+IceInternal::LocatorTable::isObjectNotFound(const Identity& id)
+{
+    if(_negativeTimeout == IceUtil::Time()) // No negative caching.
+    {
+        return false;
+    }
+
+    IceUtil::Mutex::Lock sync(*this);
+    return checkNotFound(_objectNotFoundMap, id);
+}
+
+void
+IceInternal::LocatorTable::addObjectNotFound(const Identity& id)
+{
+    if(_negativeTimeout == IceUtil::Time()) // No negative caching.
+    {
+        return;
+    }
+
+    IceUtil::Mutex::Lock sync(*this);
+    addNotFound(_objectNotFoundMap, id);
+}
+
+bool
+IceInternal::LocatorTable::checkTTL(const IceUtil::Time& time, int ttl, bool& refresh) const
 {
     assert(ttl != 0);
+    refresh = false;
     if (ttl < 0) // TTL = infinite
     {
         return true;
     }
     else
     {
-        return IceUtil::Time::now(IceUtil::Time::Monotonic) - time <= IceUtil::Time::seconds(ttl);
+        IceUtil::Time age = IceUtil::Time::now(IceUtil::Time::Monotonic) - time;
+        if(age > IceUtil::Time::seconds(ttl))
+        {
+            return false;
+        }
+
+        //
+        // Refresh the entry in the background if it's about to expire.
+        //
+        refresh = _refreshAhead > 0 &&
+            age.toMicroSeconds() * 100 >= IceUtil::Time::seconds(ttl).toMicroSeconds() * _refreshAhead;
+        return true;
+    }
+}
+
+template<typename K> bool
+IceInternal::LocatorTable::checkNotFound(map<K, IceUtil::Time>& notFoundMap, const K& key)
+{
+    typename map<K, IceUtil::Time>::iterator p = notFoundMap.find(key);
+    if(p == notFoundMap.end())
+    {
+        return false;
+    }
+    else if(IceUtil::Time::now(IceUtil::Time::Monotonic) - p->second <= _negativeTimeout)
+    {
+        return true;
+    }
+    notFoundMap.erase(p);
+    return false;
+}
+
+template<typename K> void
+IceInternal::LocatorTable::addNotFound(map<K, IceUtil::Time>& notFoundMap, const K& key)
+{
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    if(_sizeMax > 0 && notFoundMap.size() >= _sizeMax && notFoundMap.find(key) == notFoundMap.end())
+    {
+        //
+        // Purge the expired entries when the cache is full, the lookup
+        // isn't cached if there are still too many entries.
+        //
+        typename map<K, IceUtil::Time>::iterator p = notFoundMap.begin();
+        while(p != notFoundMap.end())
+        {
+            if(now - p->second > _negativeTimeout)
+            {
+                notFoundMap.erase(p++);
+            }
+            else
+            {
+                ++p;
+            }
+        }
+        if(notFoundMap.size() >= _sizeMax)
+        {
+            return;
+        }
     }
+    notFoundMap[key] = now;
 }
 
 void
@@ -483,10 +786,15 @@ IceInternal::LocatorInfo::Request::exception(const Ice::Exception& ex)
     }
 }
 
-IceInternal::LocatorInfo::LocatorInfo(const LocatorPrxPtr& locator, const LocatorTablePtr& table, bool background) :
+IceInternal::LocatorInfo::LocatorInfo(const LocatorPrxPtr& locator,
+                                      const LocatorTablePtr& table,
+                                      bool background,
+                                      bool subscribe) :
     _locator(locator),
+    _lookupLocator(subscribe ? locator->ice_connectionId("Ice.LocatorCache") : locator),
     _table(table),
-    _background(background)
+    _background(background),
+    _subscriptionState(subscribe ? SubscriptionNone : SubscriptionUnsupported)
 {
     assert(_locator);
     assert(_table);
@@ -499,6 +807,12 @@ IceInternal::LocatorInfo::destroy()
 
     _locatorRegistry = 0;
     _table->clear();
+
+    _subscriptionState = SubscriptionUnsupported;
+    _instance = 0;
+    _observerAdapter = 0;
+    _observer = 0;
+    _subscribedConnection = 0;
 }
 
 bool
@@ -556,34 +870,60 @@ IceInternal::LocatorInfo::getEndpoints(const ReferencePtr& ref,
     vector<EndpointIPtr> endpoints;
     if(!ref->isWellKnown())
     {
-        if(!_table->getAdapterEndpoints(ref->getAdapterId(), ttl, endpoints))
+        if(ttl != 0 && _table->isAdapterNotFound(ref->getAdapterId()))
+        {
+            getEndpointsNotFound(ref, callback);
+            return;
+        }
+
+        bool refresh = false;
+        if(!_table->getAdapterEndpoints(ref->getAdapterId(), ttl, endpoints, refresh))
         {
             if(_background && !endpoints.empty())
             {
+                subscribe(ref);
                 getAdapterRequest(ref)->addCallback(ref, wellKnownRef, ttl, 0);
             }
             else
             {
+                subscribe(ref);
                 getAdapterRequest(ref)->addCallback(ref, wellKnownRef, ttl, callback);
                 return;
             }
         }
+        else if(refresh)
+        {
+            refreshEndpoints(ref, wellKnownRef, ttl);
+        }
     }
     else
     {
+        if(ttl != 0 && _table->isObjectNotFound(ref->getIdentity()))
+        {
+            getEndpointsNotFound(ref, callback);
+            return;
+        }
+
         ReferencePtr r;
-        if(!_table->getObjectReference(ref->getIdentity(), ttl, r))
+        bool refresh = false;
+        if(!_table->getObjectReference(ref->getIdentity(), ttl, r, refresh))
         {
             if(_background && r)
             {
+                subscribe(ref);
                 getObjectRequest(ref)->addCallback(ref, 0, ttl, 0);
             }
             else
             {
+                subscribe(ref);
                 getObjectRequest(ref)->addCallback(ref, 0, ttl, callback);
                 return;
             }
         }
+        else if(refresh)
+        {
+            refreshEndpoints(ref, 0, ttl);
+        }
 
         if(!r->isIndirect())
         {
@@ -649,6 +989,262 @@ IceInternal::LocatorInfo::clearCache(const ReferencePtr& ref)
     }
 }
 
+void
+IceInternal::LocatorInfo::subscribeConnected(const ConnectionPtr& connection)
+{
+    if(!connection)
+    {
+        //
+        // The locator is collocated, there's no connection to receive
+        // the notifications.
+        //
+        IceUtil::Mutex::Lock sync(*this);
+        if(_subscriptionState == SubscriptionPending)
+        {
+            _subscriptionState = SubscriptionUnsupported;
+        }
+        return;
+    }
+
+    InstancePtr instance;
+    ObjectAdapterPtr observerAdapter;
+    LocatorCacheObserverPrxPtr observer;
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        if(_subscriptionState != SubscriptionPending)
+        {
+            return;
+        }
+        instance = _instance;
+        observerAdapter = _observerAdapter;
+        observer = _observer;
+    }
+
+    try
+    {
+        //
+        // The observer is added to an object adapter without endpoints,
+        // the locator calls it back over the connection of the
+        // subscription. The subscription is pending so no other thread
+        // creates the object adapter.
+        //
+        if(!observerAdapter)
+        {
+            observerAdapter = instance->objectAdapterFactory()->createObjectAdapter("", ICE_NULLPTR);
+            observer = ICE_UNCHECKED_CAST(LocatorCacheObserverPrx,
+                                          observerAdapter->addWithUUID(ICE_MAKE_SHARED(LocatorCacheObserverI,
+                                                                                       instance,
+                                                                                       _table)));
+            observerAdapter->activate();
+
+            IceUtil::Mutex::Lock sync(*this);
+            if(_subscriptionState == SubscriptionPending)
+            {
+                _observerAdapter = observerAdapter;
+                _observer = observer;
+            }
+        }
+        connection->setAdapter(observerAdapter);
+
+        //
+        // Subscribe with the adapters already cached or being looked up,
+        // the adapters looked up afterwards are added to the subscription
+        // by the locator.
+        //
+        StringSeq adapterIds = _table->getAdapterIds();
+        IdentitySeq objectIds = _table->getObjectIds();
+        {
+            IceUtil::Mutex::Lock sync(*this);
+            for(map<string, RequestPtr>::const_iterator p = _adapterRequests.begin(); p != _adapterRequests.end(); ++p)
+            {
+                adapterIds.push_back(p->first);
+            }
+            for(map<Identity, RequestPtr>::const_iterator p = _objectRequests.begin(); p != _objectRequests.end(); ++p)
+            {
+                objectIds.push_back(p->first);
+            }
+        }
+
+        LocatorCachePrxPtr locatorCache =
+            ICE_UNCHECKED_CAST(LocatorCachePrx, _lookupLocator->ice_facet("LocatorCache")->ice_fixed(connection));
+#ifdef ICE_CPP11_MAPPING
+        LocatorInfoPtr self = this;
+        locatorCache->subscribeAsync(observer, adapterIds, objectIds,
+            [self, connection]()
+            {
+                self->subscribeResponse(connection);
+            },
+            [self, connection](exception_ptr e)
+            {
+                try
+                {
+                    rethrow_exception(e);
+                }
+                catch(const Exception& ex)
+                {
+                    self->subscribeException(connection, ex);
+                }
+            });
+#else
+        SubscribeCallbackPtr cb = new SubscribeCallback(this, connection);
+        locatorCache->begin_subscribe(observer, adapterIds, objectIds,
+                                      newCallback_LocatorCache_subscribe(cb,
+                                                                         &SubscribeCallback::response,
+                                                                         &SubscribeCallback::exception));
+#endif
+    }
+    catch(const Ice::Exception& ex)
+    {
+        subscribeException(connection, ex);
+    }
+}
+
+void
+IceInternal::LocatorInfo::subscribeResponse(const ConnectionPtr& connection)
+{
+    InstancePtr instance;
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        if(_subscriptionState != SubscriptionPending)
+        {
+            return;
+        }
+        _subscriptionState = SubscriptionActive;
+        _subscribedConnection = connection;
+        instance = _instance;
+    }
+
+    if(instance->traceLevels()->location >= 1)
+    {
+        Trace out(instance->initializationData().logger, instance->traceLevels()->locationCat);
+        out << "subscribed locator cache with locator\nlocator = " << _locator->ice_toString();
+    }
+
+    //
+    // Keep the connection open, the notifications sent while it's
+    // closed are lost.
+    //
+    connection->setACM(IceUtil::None, ICE_ENUM(ACMClose, CloseOff), ICE_ENUM(ACMHeartbeat, HeartbeatAlways));
+#ifdef ICE_CPP11_MAPPING
+    LocatorInfoPtr self = this;
+    connection->setCloseCallback([self](ConnectionPtr con)
+    {
+        self->connectionClosed(con);
+    });
+#else
+    connection->setCloseCallback(new CloseCallbackI(this));
+#endif
+}
+
+void
+IceInternal::LocatorInfo::subscribeException(const ConnectionPtr&, const Ice::Exception& ex)
+{
+    InstancePtr instance;
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        if(_subscriptionState != SubscriptionPending)
+        {
+            return;
+        }
+
+        //
+        // If the locator doesn't provide the LocatorCache facet, don't
+        // try again. Otherwise, the subscription is retried with the
+        // next locator request.
+        //
+        if(dynamic_cast<const RequestFailedException*>(&ex))
+        {
+            _subscriptionState = SubscriptionUnsupported;
+        }
+        else
+        {
+            _subscriptionState = SubscriptionNone;
+        }
+        instance = _instance;
+    }
+
+    if(instance->traceLevels()->location >= 1)
+    {
+        Trace out(instance->initializationData().logger, instance->traceLevels()->locationCat);
+        out << "couldn't subscribe locator cache with locator\nlocator = " << _locator->ice_toString() << "\n";
+        out << "reason = " << ex;
+    }
+}
+
+void
+IceInternal::LocatorInfo::connectionClosed(const ConnectionPtr& connection)
+{
+    InstancePtr instance;
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        if(_subscriptionState != SubscriptionActive || connection != _subscribedConnection)
+        {
+            return;
+        }
+        _subscriptionState = SubscriptionNone;
+        _subscribedConnection = 0;
+        instance = _instance;
+    }
+
+    //
+    // Notifications might have been missed, clear the cache. The cache
+    // is subscribed again with the next locator request.
+    //
+    _table->clear();
+
+    if(instance->traceLevels()->location >= 1)
+    {
+        Trace out(instance->initializationData().logger, instance->traceLevels()->locationCat);
+        out << "locator cache subscription connection closed, cleared locator cache\nlocator = "
+            << _locator->ice_toString();
+    }
+}
+
+void
+IceInternal::LocatorInfo::subscribe(const ReferencePtr& ref)
+{
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        if(_subscriptionState != SubscriptionNone)
+        {
+            return;
+        }
+        _subscriptionState = SubscriptionPending;
+        _instance = ref->getInstance();
+    }
+
+    try
+    {
+#ifdef ICE_CPP11_MAPPING
+        LocatorInfoPtr self = this;
+        _lookupLocator->ice_getConnectionAsync(
+            [self](ConnectionPtr connection)
+            {
+                self->subscribeConnected(connection);
+            },
+            [self](exception_ptr e)
+            {
+                try
+                {
+                    rethrow_exception(e);
+                }
+                catch(const Exception& ex)
+                {
+                    self->subscribeException(ICE_NULLPTR, ex);
+                }
+            });
+#else
+        _lookupLocator->begin_ice_getConnection(newCallback_Object_ice_getConnection(new SubscribeCallback(this, 0),
+                                                                                     &SubscribeCallback::connected,
+                                                                                     &SubscribeCallback::exception));
+#endif
+    }
+    catch(const Ice::Exception& ex)
+    {
+        subscribeException(ICE_NULLPTR, ex);
+    }
+}
+
 void
 IceInternal::LocatorInfo::getEndpointsException(const ReferencePtr& ref, const Ice::Exception& exc)
 {
@@ -708,6 +1304,82 @@ IceInternal::LocatorInfo::getEndpointsException(const ReferencePtr& ref, const I
     }
 }
 
+void
+IceInternal::LocatorInfo::getEndpointsNotFound(const ReferencePtr& ref, const GetEndpointsCallbackPtr& callback)
+{
+    if(ref->getInstance()->traceLevels()->location >= 2)
+    {
+        Trace out(ref->getInstance()->initializationData().logger, ref->getInstance()->traceLevels()->locationCat);
+        if(ref->isWellKnown())
+        {
+            out << "found unknown well-known object in locator cache\nobject = "
+                << Ice::identityToString(ref->getIdentity(), ref->getInstance()->toStringMode());
+        }
+        else
+        {
+            out << "found unknown adapter in locator cache\nadapter = " << ref->getAdapterId();
+        }
+    }
+
+    try
+    {
+        if(ref->isWellKnown())
+        {
+            getEndpointsException(ref, ObjectNotFoundException());
+        }
+        else
+        {
+            getEndpointsException(ref, AdapterNotFoundException());
+        }
+    }
+    catch(const Ice::LocalException& ex)
+    {
+        if(callback)
+        {
+            callback->setException(ex);
+        }
+    }
+}
+
+void
+IceInternal::LocatorInfo::refreshEndpoints(const ReferencePtr& ref, const ReferencePtr& wellKnownRef, int ttl)
+{
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        if(ref->isWellKnown() ? _objectRequests.find(ref->getIdentity()) != _objectRequests.end() :
+                                _adapterRequests.find(ref->getAdapterId()) != _adapterRequests.end())
+        {
+            return; // Already being refreshed.
+        }
+    }
+
+    if(ref->getInstance()->traceLevels()->location >= 2)
+    {
+        Trace out(ref->getInstance()->initializationData().logger, ref->getInstance()->traceLevels()->locationCat);
+        out << "refreshing locator cache entry about to expire\n";
+        if(ref->isWellKnown())
+        {
+            out << "well-known proxy = " << ref->toString();
+        }
+        else
+        {
+            out << "adapter = " << ref->getAdapterId();
+        }
+    }
+
+    //
+    // The cached endpoints are still used while the request is pending.
+    //
+    if(ref->isWellKnown())
+    {
+        getObjectRequest(ref)->addCallback(ref, 0, ttl, 0);
+    }
+    else
+    {
+        getAdapterRequest(ref)->addCallback(ref, wellKnownRef, ttl, 0);
+    }
+}
+
 void
 IceInternal::LocatorInfo::getEndpointsTrace(const ReferencePtr& ref,
                                             const vector<EndpointIPtr>& endpoints,
@@ -865,6 +1537,7 @@ IceInternal::LocatorInfo::finishRequest(const ReferencePtr& ref,
         else if(notRegistered) // If the adapter isn't registered anymore, remove it from the cache.
         {
             _table->removeAdapterEndpoints(ref->getAdapterId());
+            _table->addAdapterNotFound(ref->getAdapterId());
         }
 
         IceUtil::Mutex::Lock sync(*this);
@@ -880,6 +1553,7 @@ IceInternal::LocatorInfo::finishRequest(const ReferencePtr& ref,
         else if(notRegistered) // If the well-known object isn't registered anymore, remove it from the cache.
         {
             _table->removeObjectReference(ref->getIdentity());
+            _table->addObjectNotFound(ref->getIdentity());
         }
 
         IceUtil::Mutex::Lock sync(*this);
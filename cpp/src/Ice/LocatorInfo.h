@@ -15,10 +15,15 @@
 #include <Ice/Identity.h>
 #include <Ice/EndpointIF.h>
 #include <Ice/PropertiesF.h>
+#include <Ice/ConnectionF.h>
+#include <Ice/ObjectAdapterF.h>
+#include <Ice/InstanceF.h>
 #include <Ice/Version.h>
 
 #include <Ice/UniquePtr.h>
 
+#include <list>
+
 namespace IceInternal
 {
 
@@ -39,6 +44,10 @@ public:
 private:
 
     const bool _background;
+    const bool _subscribe;
+    const int _cacheSizeMax;
+    const int _cacheRefreshAhead;
+    const int _cacheNegativeTimeout;
 
 #ifdef ICE_CPP11_MAPPING
     using LocatorInfoTable = std::map<std::shared_ptr<Ice::LocatorPrx>,
@@ -57,24 +66,63 @@ class LocatorTable : public IceUtil::Shared, public IceUtil::Mutex
 {
 public:
 
-    LocatorTable();
+    LocatorTable(int, int, int);
 
     void clear();
 
-    bool getAdapterEndpoints(const std::string&, int, ::std::vector<EndpointIPtr>&);
+    //
+    // Returns false if the entry isn't cached or expired. The last
+    // argument is set to true if the entry is about to expire and
+    // should be refreshed.
+    //
+    bool getAdapterEndpoints(const std::string&, int, ::std::vector<EndpointIPtr>&, bool&);
     void addAdapterEndpoints(const std::string&, const ::std::vector<EndpointIPtr>&);
     ::std::vector<EndpointIPtr> removeAdapterEndpoints(const std::string&);
+    ::std::vector<std::string> getAdapterIds();
+    ::std::vector<Ice::Identity> getObjectIds();
+
+    bool isAdapterNotFound(const std::string&);
+    void addAdapterNotFound(const std::string&);
 
-    bool getObjectReference(const Ice::Identity&, int, ReferencePtr&);
+    bool getObjectReference(const Ice::Identity&, int, ReferencePtr&, bool&);
     void addObjectReference(const Ice::Identity&, const ReferencePtr&);
     ReferencePtr removeObjectReference(const Ice::Identity&);
 
+    bool isObjectNotFound(const Ice::Identity&);
+    void addObjectNotFound(const Ice::Identity&);
+
 private:
 
-    bool checkTTL(const IceUtil::Time&, int) const;
+    bool checkTTL(const IceUtil::Time&, int, bool&) const;
+
+    template<typename K> bool checkNotFound(std::map<K, IceUtil::Time>&, const K&);
+    template<typename K> void addNotFound(std::map<K, IceUtil::Time>&, const K&);
+
+    struct AdapterEndpoints
+    {
+        IceUtil::Time time;
+        std::vector<EndpointIPtr> endpoints;
+        std::list<std::string>::iterator lru;
+    };
+
+    struct ObjectReference
+    {
+        IceUtil::Time time;
+        ReferencePtr reference;
+        std::list<Ice::Identity>::iterator lru;
+    };
+
+    const size_t _sizeMax; // The maximum number of entries of each map, 0 if unbounded.
+    const int _refreshAhead; // The percentage of the TTL after which an entry is refreshed, 0 if disabled.
+    const IceUtil::Time _negativeTimeout; // How long unknown adapters and objects are cached.
 
-    std::map<std::string, std::pair<IceUtil::Time, std::vector<EndpointIPtr> > > _adapterEndpointsMap;
-    std::map<Ice::Identity, std::pair<IceUtil::Time, ReferencePtr> > _objectMap;
+    std::map<std::string, AdapterEndpoints> _adapterEndpointsMap;
+    std::list<std::string> _adapterLRU; // Most recently used first.
+    std::map<Ice::Identity, ObjectReference> _objectMap;
+    std::list<Ice::Identity> _objectLRU; // Most recently used first.
+
+    std::map<std::string, IceUtil::Time> _adapterNotFoundMap;
+    std::map<Ice::Identity, IceUtil::Time> _objectNotFoundMap;
 };
 
 class LocatorInfo : public IceUtil::Shared, public IceUtil::Mutex
@@ -137,7 +185,7 @@ public:
     };
     typedef IceUtil::Handle<Request> RequestPtr;
 
-    LocatorInfo(const Ice::LocatorPrxPtr&, const LocatorTablePtr&, bool);
+    LocatorInfo(const Ice::LocatorPrxPtr&, const LocatorTablePtr&, bool, bool);
 
     void destroy();
 
@@ -151,6 +199,17 @@ public:
         //
         return _locator;
     }
+
+    //
+    // The locator used to look up adapters and objects. If the locator
+    // cache is subscribed, the lookups and the notifications use a
+    // dedicated connection so the settings of the application's locator
+    // connection aren't changed.
+    //
+    const Ice::LocatorPrxPtr& getLookupLocator() const
+    {
+        return _lookupLocator;
+    }
     Ice::LocatorRegistryPrxPtr getLocatorRegistry();
 
     void getEndpoints(const ReferencePtr& ref, int ttl, const GetEndpointsCallbackPtr& cb)
@@ -161,9 +220,18 @@ public:
 
     void clearCache(const ReferencePtr&);
 
+    void subscribeConnected(const Ice::ConnectionPtr&);
+    void subscribeResponse(const Ice::ConnectionPtr&);
+    void subscribeException(const Ice::ConnectionPtr&, const Ice::Exception&);
+    void connectionClosed(const Ice::ConnectionPtr&);
+
 private:
 
+    void subscribe(const ReferencePtr&);
+
     void getEndpointsException(const ReferencePtr&, const Ice::Exception&);
+    void getEndpointsNotFound(const ReferencePtr&, const GetEndpointsCallbackPtr&);
+    void refreshEndpoints(const ReferencePtr&, const ReferencePtr&, int);
     void getEndpointsTrace(const ReferencePtr&, const std::vector<EndpointIPtr>&, bool);
     void trace(const std::string&, const ReferencePtr&, const std::vector<EndpointIPtr>&);
     void trace(const std::string&, const ReferencePtr&, const ReferencePtr&);
@@ -176,10 +244,30 @@ private:
     friend class RequestCallback;
 
     const Ice::LocatorPrxPtr _locator;
+    const Ice::LocatorPrxPtr _lookupLocator;
     Ice::LocatorRegistryPrxPtr _locatorRegistry;
     const LocatorTablePtr _table;
     const bool _background;
 
+    //
+    // The subscription of the locator cache with the LocatorCache facet
+    // of the locator, enabled with the Ice.LocatorCacheSubscription
+    // property. The locator notifies the observer of the changes of the
+    // cached adapters and objects over the subscribed connection.
+    //
+    enum SubscriptionState
+    {
+        SubscriptionNone,
+        SubscriptionPending,
+        SubscriptionActive,
+        SubscriptionUnsupported
+    };
+    SubscriptionState _subscriptionState;
+    InstancePtr _instance;
+    Ice::ObjectAdapterPtr _observerAdapter;
+    Ice::LocatorCacheObserverPrxPtr _observer;
+    Ice::ConnectionPtr _subscribedConnection;
+
     std::map<std::string, RequestPtr> _adapterRequests;
     std::map<Ice::Identity, RequestPtr> _objectRequests;
 };
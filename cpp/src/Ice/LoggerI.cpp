@@ -98,26 +98,19 @@ Ice::LoggerI::print(const string& message)
 void
 Ice::LoggerI::trace(const string& category, const string& message)
 {
-    string s = "-- " + IceUtil::Time::now().toDateTime() + " " + _formattedPrefix;
-    if(!category.empty())
-    {
-        s += category + ": ";
-    }
-    s += message;
-
-    write(s, true);
+    write(ICE_ENUM(LogMessageType, TraceMessage), IceUtil::Time::now(), category, message);
 }
 
 void
 Ice::LoggerI::warning(const string& message)
 {
-    write("-! " + IceUtil::Time::now().toDateTime() + " " + _formattedPrefix + "warning: " + message, true);
+    write(ICE_ENUM(LogMessageType, WarningMessage), IceUtil::Time::now(), "", message);
 }
 
 void
 Ice::LoggerI::error(const string& message)
 {
-    write("!! " + IceUtil::Time::now().toDateTime() + " " + _formattedPrefix + "error: " + message, true);
+    write(ICE_ENUM(LogMessageType, ErrorMessage), IceUtil::Time::now(), "", message);
 }
 
 string
@@ -133,6 +126,51 @@ Ice::LoggerI::cloneWithPrefix(const std::string& prefix)
     return ICE_MAKE_SHARED(LoggerI, prefix, _file, _convert, _sizeMax);
 }
 
+void
+Ice::LoggerI::log(const LogMessage& message)
+{
+    if(message.type == ICE_ENUM(LogMessageType, PrintMessage))
+    {
+        write(message.message, false);
+    }
+    else
+    {
+        write(message.type, IceUtil::Time::microSeconds(message.timestamp), message.traceCategory, message.message);
+    }
+}
+
+void
+Ice::LoggerI::write(LogMessageType type, const IceUtil::Time& timestamp, const string& category,
+                    const string& message)
+{
+    string s;
+    switch(type)
+    {
+        case ICE_ENUM(LogMessageType, TraceMessage):
+        {
+            s = "-- " + timestamp.toDateTime() + " " + _formattedPrefix;
+            if(!category.empty())
+            {
+                s += category + ": ";
+            }
+            break;
+        }
+        case ICE_ENUM(LogMessageType, WarningMessage):
+        {
+            s = "-! " + timestamp.toDateTime() + " " + _formattedPrefix + "warning: ";
+            break;
+        }
+        default:
+        {
+            s = "!! " + timestamp.toDateTime() + " " + _formattedPrefix + "error: ";
+            break;
+        }
+    }
+    s += message;
+
+    write(s, true);
+}
+
 void
 Ice::LoggerI::write(const string& message, bool indent)
 {
@@ -6,6 +6,7 @@
 #define ICE_LOGGER_I_H
 
 #include <Ice/Logger.h>
+#include <Ice/RemoteLogger.h>
 #include <Ice/StringConverter.h>
 #include <fstream>
 
@@ -26,8 +27,15 @@ public:
     virtual std::string getPrefix();
     virtual LoggerPtr cloneWithPrefix(const std::string&);
 
+    //
+    // Write a message logged earlier, used by the asynchronous logger to
+    // write the time stamp of the logging thread.
+    //
+    void log(const LogMessage&);
+
 private:
 
+    void write(LogMessageType, const IceUtil::Time&, const std::string&, const std::string&);
     void write(const std::string&, bool);
 
     const std::string _prefix;
@@ -25,6 +25,9 @@ ifeq ($(os),Linux)
 ifeq ($(shell pkg-config --exists libsystemd 2> /dev/null && echo yes),yes)
 Ice_cppflags                            += -DICE_USE_SYSTEMD $(shell pkg-config --cflags libsystemd)
 endif
+ifeq ($(shell pkg-config --exists zlib 2> /dev/null && echo yes),yes)
+Ice_cppflags                            += -DICE_HAS_ZLIB $(shell pkg-config --cflags zlib)
+endif
 endif
 
 Ice[iphoneos]_excludes                  := $(wildcard $(addprefix $(currentdir)/,Tcp*.cpp))
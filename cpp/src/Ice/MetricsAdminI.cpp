@@ -13,6 +13,10 @@
 
 #include <IceUtil/StringUtil.h>
 
+#ifndef _WIN32
+#   include <pthread.h>
+#endif
+
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
@@ -28,6 +32,7 @@ const string suffixes[] =
     "Accept.*",
     "Reject.*",
     "RetainDetached",
+    "Histogram",
     "Map.*",
 };
 
@@ -66,6 +71,82 @@ validateProperties(const string& prefix, const PropertiesPtr& properties)
     }
 }
 
+//
+// Latencies are recorded in microseconds, the histogram covers latencies
+// up to 2^36 microseconds (about 19 hours), larger latencies are recorded
+// in the last bucket.
+//
+const size_t histogramSubBucketBits = 3;
+const size_t histogramSubBuckets = 1 << histogramSubBucketBits;
+const size_t histogramMaxBits = 36;
+const size_t histogramBuckets = (histogramMaxBits - histogramSubBucketBits + 1) * histogramSubBuckets;
+const size_t histogramShards = 8;
+
+//
+// Shard counters are drained into the histogram 64-bit counters before
+// they can overflow.
+//
+const int histogramDrainThreshold = 1 << 30;
+
+size_t
+histogramBucket(Ice::Long value)
+{
+    if(value < static_cast<Ice::Long>(histogramSubBuckets))
+    {
+        return value < 0 ? 0 : static_cast<size_t>(value);
+    }
+
+    const Ice::Long maxValue = (static_cast<Ice::Long>(1) << histogramMaxBits) - 1;
+    if(value > maxValue)
+    {
+        value = maxValue;
+    }
+
+    //
+    // Compute the position of the highest bit, the bucket is given by this
+    // magnitude and by the next histogramSubBucketBits bits.
+    //
+    size_t magnitude = histogramSubBucketBits;
+    for(Ice::Long v = value >> (histogramSubBucketBits + 1); v > 0; v >>= 1)
+    {
+        ++magnitude;
+    }
+    size_t subBucket = static_cast<size_t>(value >> (magnitude - histogramSubBucketBits)) & (histogramSubBuckets - 1);
+    return (magnitude - histogramSubBucketBits + 1) * histogramSubBuckets + subBucket;
+}
+
+Ice::Long
+histogramUpperBound(size_t bucket)
+{
+    if(bucket < histogramSubBuckets)
+    {
+        return static_cast<Ice::Long>(bucket) + 1;
+    }
+    size_t magnitude = bucket / histogramSubBuckets + histogramSubBucketBits - 1;
+    Ice::Long subBucket = static_cast<Ice::Long>(bucket % histogramSubBuckets);
+    return (static_cast<Ice::Long>(histogramSubBuckets) + subBucket + 1) << (magnitude - histogramSubBucketBits);
+}
+
+size_t
+histogramShard()
+{
+    //
+    // Hash the calling thread ID, the multiplication spreads the bits of
+    // thread IDs which are usually aligned addresses.
+    //
+#ifdef _WIN32
+    size_t h = static_cast<size_t>(GetCurrentThreadId());
+#else
+    pthread_t self = pthread_self();
+    size_t h = 0;
+    memcpy(&h, &self, sizeof(self) < sizeof(h) ? sizeof(self) : sizeof(h));
+#endif
+    h ^= h >> 16;
+    h *= 0x45d9f3b;
+    h ^= h >> 16;
+    return h % histogramShards;
+}
+
 vector<MetricsMapI::RegExpPtr>
 parseRule(const PropertiesPtr& properties, const string& name)
 {
@@ -87,6 +168,125 @@ parseRule(const PropertiesPtr& properties, const string& name)
 
 }
 
+struct LatencyHistogram::Shard
+{
+    IceUtilInternal::Atomic counts[histogramBuckets];
+};
+
+LatencyHistogram::LatencyHistogram() : _drained(histogramBuckets, 0)
+{
+    assert(sizeof(_shards) / sizeof(*_shards) == histogramShards);
+    for(size_t i = 0; i < histogramShards; ++i)
+    {
+        _shards[i] = 0;
+    }
+}
+
+LatencyHistogram::~LatencyHistogram()
+{
+    for(size_t i = 0; i < histogramShards; ++i)
+    {
+        Shard* shard = _shards[i];
+        delete shard;
+    }
+}
+
+void
+LatencyHistogram::add(Ice::Long latency)
+{
+    size_t bucket = histogramBucket(latency);
+    Shard* shard = getShard();
+    if(shard->counts[bucket]++ >= histogramDrainThreshold)
+    {
+        drain(shard, bucket);
+    }
+}
+
+void
+LatencyHistogram::getCounts(vector<Ice::Long>& counts) const
+{
+    if(counts.empty())
+    {
+        counts.resize(histogramBuckets, 0);
+    }
+    assert(counts.size() == histogramBuckets);
+
+    IceUtil::Mutex::Lock sync(_mutex);
+    for(size_t i = 0; i < histogramShards; ++i)
+    {
+        const Shard* shard = _shards[i];
+        if(shard)
+        {
+            for(size_t j = 0; j < histogramBuckets; ++j)
+            {
+                counts[j] += shard->counts[j].load();
+            }
+        }
+    }
+    for(size_t j = 0; j < histogramBuckets; ++j)
+    {
+        counts[j] += _drained[j];
+    }
+}
+
+MetricsHistogram
+LatencyHistogram::toMetricsHistogram(const string& id, const vector<Ice::Long>& counts)
+{
+    MetricsHistogram histogram;
+    histogram.id = id;
+    histogram.count = 0;
+    for(size_t i = 0; i < counts.size(); ++i)
+    {
+        if(counts[i] > 0)
+        {
+            histogram.bounds.push_back(histogramUpperBound(i));
+            histogram.counts.push_back(counts[i]);
+            histogram.count += counts[i];
+        }
+    }
+    return histogram;
+}
+
+LatencyHistogram::Shard*
+LatencyHistogram::getShard()
+{
+    //
+    // Shards are allocated on first use, a histogram only updated by a
+    // few threads doesn't pay for all of its shards.
+    //
+    size_t i = histogramShard();
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+    Shard* shard = _shards[i].load(std::memory_order_acquire);
+    if(!shard)
+    {
+        Shard* newShard = new Shard(); // Value-initialization zeroes the counters.
+        if(_shards[i].compare_exchange_strong(shard, newShard, std::memory_order_acq_rel))
+        {
+            shard = newShard;
+        }
+        else
+        {
+            delete newShard;
+        }
+    }
+    return shard;
+#else
+    IceUtil::Mutex::Lock sync(_mutex);
+    if(!_shards[i])
+    {
+        _shards[i] = new Shard();
+    }
+    return _shards[i];
+#endif
+}
+
+void
+LatencyHistogram::drain(Shard* shard, size_t bucket)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    _drained[bucket] += shard->counts[bucket].exchange(0);
+}
+
 MetricsMapI::RegExp::RegExp(const string& attribute, const string& regexp) : _attribute(attribute)
 {
 #ifdef __MINGW32__
@@ -364,6 +564,24 @@ MetricsViewI::getFailures(const string& mapName, const string& id)
     return MetricsFailures();
 }
 
+MetricsHistogramSeq
+MetricsViewI::getHistograms(const string& mapPath)
+{
+    MetricsHistogramSeq histograms;
+    string::size_type pos = mapPath.find('/');
+    map<string, MetricsMapIPtr>::const_iterator p = _maps.find(mapPath.substr(0, pos));
+    if(p != _maps.end())
+    {
+        LatencyHistogramCounts counts;
+        p->second->getHistograms(pos == string::npos ? string() : mapPath.substr(pos + 1), counts);
+        for(LatencyHistogramCounts::const_iterator q = counts.begin(); q != counts.end(); ++q)
+        {
+            histograms.push_back(LatencyHistogram::toMetricsHistogram(q->first, q->second));
+        }
+    }
+    return histograms;
+}
+
 vector<string>
 MetricsViewI::getMaps() const
 {
@@ -612,6 +830,22 @@ MetricsAdminI::getMetricsFailures(const string& viewName, const string& map, con
     return MetricsFailures();
 }
 
+MetricsHistogramSeq
+#ifdef ICE_CPP11_MAPPING
+MetricsAdminI::getMetricsHistograms(string viewName, string map, const Current&)
+#else
+MetricsAdminI::getMetricsHistograms(const string& viewName, const string& map, const Current&)
+#endif
+{
+    Lock sync(*this);
+    MetricsViewIPtr view = getMetricsView(viewName);
+    if(view)
+    {
+        return view->getHistograms(map);
+    }
+    return MetricsHistogramSeq();
+}
+
 vector<MetricsMapIPtr>
 MetricsAdminI::getMaps(const string& mapName) const
 {
@@ -628,6 +862,22 @@ MetricsAdminI::getMaps(const string& mapName) const
     return maps;
 }
 
+std::map<string, std::map<string, MetricsMapIPtr> >
+MetricsAdminI::getViewMaps() const
+{
+    Lock sync(*this);
+    std::map<string, std::map<string, MetricsMapIPtr> > maps;
+    for(std::map<string, MetricsViewIPtr>::const_iterator p = _views.begin(); p != _views.end(); ++p)
+    {
+        vector<string> names = p->second->getMaps();
+        for(vector<string>::const_iterator q = names.begin(); q != names.end(); ++q)
+        {
+            maps[*q][p->first] = p->second->getMap(*q);
+        }
+    }
+    return maps;
+}
+
 const LoggerPtr&
 MetricsAdminI::getLogger() const
 {
@@ -22,6 +22,7 @@
 #include <Ice/Locator.h>
 #include <Ice/LoggerUtil.h>
 #include <Ice/ThreadPool.h>
+#include <Ice/DispatchLanes.h>
 #include <Ice/Communicator.h>
 #include <Ice/Router.h>
 #include <Ice/DefaultsAndOverrides.h>
@@ -98,16 +99,28 @@ Ice::ObjectAdapterI::activate()
         //
         if(_state != StateUninitialized)
         {
+            if(_state == StateHeld)
+            {
+                _state = StateActive;
+            }
+
+            //
+            // The connections remain held if too many dispatches are in
+            // progress, see updateThrottling().
+            //
+            if(!_throttled)
+            {
 #ifdef ICE_CPP11_MAPPING
-            for_each(_incomingConnectionFactories.begin(), _incomingConnectionFactories.end(),
-                [](const IncomingConnectionFactoryPtr& factory)
-                {
-                    factory->activate();
-                });
+                for_each(_incomingConnectionFactories.begin(), _incomingConnectionFactories.end(),
+                    [](const IncomingConnectionFactoryPtr& factory)
+                    {
+                        factory->activate();
+                    });
 #else
-            for_each(_incomingConnectionFactories.begin(), _incomingConnectionFactories.end(),
-                     Ice::voidMemFun(&IncomingConnectionFactory::activate));
+                for_each(_incomingConnectionFactories.begin(), _incomingConnectionFactories.end(),
+                         Ice::voidMemFun(&IncomingConnectionFactory::activate));
 #endif
+            }
             return;
         }
 
@@ -159,6 +172,8 @@ Ice::ObjectAdapterI::activate()
         IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(*this);
         assert(_state == StateActivating);
 
+        if(!_throttled)
+        {
 #ifdef ICE_CPP11_MAPPING
             for_each(_incomingConnectionFactories.begin(), _incomingConnectionFactories.end(),
                 [](const IncomingConnectionFactoryPtr& factory)
@@ -166,9 +181,10 @@ Ice::ObjectAdapterI::activate()
                     factory->activate();
                 });
 #else
-        for_each(_incomingConnectionFactories.begin(), _incomingConnectionFactories.end(),
-                 Ice::voidMemFun(&IncomingConnectionFactory::activate));
+            for_each(_incomingConnectionFactories.begin(), _incomingConnectionFactories.end(),
+                     Ice::voidMemFun(&IncomingConnectionFactory::activate));
 #endif
+        }
         _state = StateActive;
         notifyAll();
     }
@@ -883,6 +899,35 @@ Ice::ObjectAdapterI::decDirectCount()
     }
 }
 
+bool
+Ice::ObjectAdapterI::admitDispatch(const IceUtil::Time& received)
+{
+    //
+    // Reject requests which waited too long before being dispatched, the
+    // client most likely already gave up on them.
+    //
+    if(_maxQueueWait > IceUtil::Time() && received != IceUtil::Time() &&
+       IceUtil::Time::now(IceUtil::Time::Monotonic) - received > _maxQueueWait)
+    {
+        return false;
+    }
+
+    if(_maxDispatches > 0 && _dispatchCount.fetch_add(1) + 1 == _maxDispatches)
+    {
+        updateThrottling();
+    }
+    return true;
+}
+
+void
+Ice::ObjectAdapterI::dispatchFinished()
+{
+    if(_maxDispatches > 0 && _dispatchCount.fetch_sub(1) - 1 == _resumeDispatches)
+    {
+        updateThrottling();
+    }
+}
+
 ThreadPoolPtr
 Ice::ObjectAdapterI::getThreadPool() const
 {
@@ -946,7 +991,12 @@ Ice::ObjectAdapterI::ObjectAdapterI(const InstancePtr& instance, const Communica
     _name(name),
     _directCount(0),
     _noConfig(noConfig),
-    _messageSizeMax(0)
+    _messageSizeMax(0),
+    _flowControlWindow(0),
+    _maxDispatches(0),
+    _resumeDispatches(0),
+    _dispatchCount(0),
+    _throttled(false)
 {
 }
 
@@ -1021,6 +1071,32 @@ Ice::ObjectAdapterI::initialize(const RouterPrxPtr& router)
             }
         }
 
+        {
+            Int num = properties->getPropertyAsInt(_name + ".FlowControl.Window");
+            if(num > 0)
+            {
+                const_cast<Int&>(_flowControlWindow) = num > 0x7fffffff / 1024 ? 0x7fffffff : num * 1024;
+            }
+        }
+
+        //
+        // Once the maximum number of dispatches is reached, the incoming
+        // connections are held until the number of dispatches in progress
+        // drops by a quarter.
+        //
+        const int maxDispatches = properties->getPropertyAsInt(_name + ".MaxDispatches");
+        if(maxDispatches > 0)
+        {
+            const_cast<int&>(_maxDispatches) = maxDispatches;
+            const_cast<int&>(_resumeDispatches) = maxDispatches - 1 - maxDispatches / 4;
+        }
+
+        const int maxQueueWait = properties->getPropertyAsInt(_name + ".MaxQueueWait");
+        if(maxQueueWait > 0)
+        {
+            const_cast<IceUtil::Time&>(_maxQueueWait) = IceUtil::Time::milliSeconds(maxQueueWait);
+        }
+
         int threadPoolSize = properties->getPropertyAsInt(_name + ".ThreadPool.Size");
         int threadPoolSizeMax = properties->getPropertyAsInt(_name + ".ThreadPool.SizeMax");
         bool hasPriority = properties->getProperty(_name + ".ThreadPool.ThreadPriority") != "";
@@ -1034,6 +1110,24 @@ Ice::ObjectAdapterI::initialize(const RouterPrxPtr& router)
             _threadPool = new ThreadPool(_instance, _name + ".ThreadPool", 0);
         }
 
+        //
+        // Dispatch lanes reorder the requests received over a connection,
+        // they can't be used with a serialized thread pool.
+        //
+        if(!properties->getProperty(_name + ".Lanes").empty())
+        {
+            if(getThreadPool()->serialize())
+            {
+                Warning out(_instance->initializationData().logger);
+                out << "object adapter `" << _name << "': " << _name << ".Lanes is ignored, the adapter thread pool "
+                    << "serializes the dispatch of requests";
+            }
+            else
+            {
+                _dispatchLanes = new DispatchLanes(_name, properties, _instance->initializationData().logger);
+            }
+        }
+
         if(!router)
         {
             const_cast<RouterPrxPtr&>(router) = ICE_UNCHECKED_CAST(RouterPrx,
@@ -1444,6 +1538,57 @@ ObjectAdapterI::updateLocatorRegistry(const IceInternal::LocatorInfoPtr& locator
     }
 }
 
+void
+Ice::ObjectAdapterI::updateThrottling()
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(*this);
+    if(_state >= StateDeactivating)
+    {
+        return;
+    }
+
+    //
+    // The dispatch count might have changed since the threshold was
+    // crossed, the decision is made with the current count.
+    //
+    const int dispatchCount = _dispatchCount.load();
+    const bool throttled = _throttled ? dispatchCount > _resumeDispatches : dispatchCount >= _maxDispatches;
+    if(throttled == _throttled)
+    {
+        return;
+    }
+    _throttled = throttled;
+
+    if(_instance->traceLevels()->network >= 1)
+    {
+        Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+        out << (_throttled ? "holding" : "resuming") << " incoming connections of object adapter `" << _name
+            << "'\n" << dispatchCount << " dispatches in progress, " << _name << ".MaxDispatches is "
+            << _maxDispatches;
+    }
+
+    //
+    // The connections of a held adapter are activated again by activate().
+    //
+    if(_state != StateActive)
+    {
+        return;
+    }
+
+    for(vector<IncomingConnectionFactoryPtr>::const_iterator p = _incomingConnectionFactories.begin();
+        p != _incomingConnectionFactories.end(); ++p)
+    {
+        if(_throttled)
+        {
+            (*p)->hold();
+        }
+        else
+        {
+            (*p)->activate();
+        }
+    }
+}
+
 bool
 Ice::ObjectAdapterI::filterProperties(StringSeq& unknownProps)
 {
@@ -1455,6 +1600,7 @@ Ice::ObjectAdapterI::filterProperties(StringSeq& unknownProps)
         "ACM.Timeout",
         "AdapterId",
         "Endpoints",
+        "FlowControl.Window",
         "Locator",
         "Locator.EncodingVersion",
         "Locator.EndpointSelection",
@@ -1462,6 +1608,10 @@ Ice::ObjectAdapterI::filterProperties(StringSeq& unknownProps)
         "Locator.PreferSecure",
         "Locator.CollocationOptimized",
         "Locator.Router",
+        "LaneContext",
+        "Lanes",
+        "MaxDispatches",
+        "MaxQueueWait",
         "MessageSizeMax",
         "PublishedEndpoints",
         "ReplicaGroupId",
@@ -1520,6 +1670,22 @@ Ice::ObjectAdapterI::filterProperties(StringSeq& unknownProps)
             }
         }
 
+        //
+        // <adapter>.Lane.<name>.Operations, <adapter>.Lane.<name>.Weight and
+        // <adapter>.Lane.<name>.MaxQueued
+        //
+        if(!valid && p->first.compare(0, prefix.size() + 5, prefix + "Lane.") == 0)
+        {
+            string::size_type pos = p->first.rfind('.');
+            if(pos > prefix.size() + 5 && (p->first.compare(pos, string::npos, ".Operations") == 0 ||
+                                           p->first.compare(pos, string::npos, ".Weight") == 0 ||
+                                           p->first.compare(pos, string::npos, ".MaxQueued") == 0))
+            {
+                noProps = false;
+                valid = true;
+            }
+        }
+
         if(!valid && addUnknown)
         {
             unknownProps.push_back(p->first);
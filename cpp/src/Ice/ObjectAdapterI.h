@@ -8,6 +8,8 @@
 #include <IceUtil/Shared.h>
 #include <IceUtil/RecMutex.h>
 #include <IceUtil/Monitor.h>
+#include <IceUtil/Atomic.h>
+#include <IceUtil/Time.h>
 #include <Ice/ObjectAdapter.h>
 #include <Ice/InstanceF.h>
 #include <Ice/ObjectAdapterFactoryF.h>
@@ -20,6 +22,7 @@
 #include <Ice/EndpointIF.h>
 #include <Ice/LocatorInfoF.h>
 #include <Ice/ThreadPoolF.h>
+#include <Ice/DispatchLanesF.h>
 #include <Ice/OutgoingAsyncF.h>
 #include <Ice/Exception.h>
 #include <Ice/BuiltinSequences.h>
@@ -99,12 +102,37 @@ public:
     void incDirectCount();
     void decDirectCount();
 
+    //
+    // Admission control, configured with <adapter>.MaxDispatches and
+    // <adapter>.MaxQueueWait. A dispatch is admitted before the servant
+    // is called, dispatchFinished must be called once the response of
+    // an admitted dispatch is sent.
+    //
+    bool hasAdmissionControl() const
+    {
+        return _maxDispatches > 0 || _maxQueueWait > IceUtil::Time();
+    }
+    bool admitDispatch(const IceUtil::Time&);
+    void dispatchFinished();
+
+    //
+    // The dispatch lanes configured with <adapter>.Lanes, or null. The
+    // lanes are immutable once the adapter is created.
+    //
+    const IceInternal::DispatchLanesPtr& getDispatchLanes() const { return _dispatchLanes; }
+
     IceInternal::ThreadPoolPtr getThreadPool() const;
     IceInternal::ServantManagerPtr getServantManager() const;
     IceInternal::ACMConfig getACM() const;
     void setAdapterOnConnection(const Ice::ConnectionIPtr&);
     size_t messageSizeMax() const { return _messageSizeMax; }
 
+    //
+    // The flow control credit in bytes granted to the peers of the incoming
+    // connections, configured with <adapter>.FlowControl.Window, or 0.
+    //
+    Int flowControlWindow() const { return _flowControlWindow; }
+
     ObjectAdapterI(const IceInternal::InstancePtr&, const CommunicatorPtr&,
                    const IceInternal::ObjectAdapterFactoryPtr&, const std::string&, bool);
     virtual ~ObjectAdapterI();
@@ -122,6 +150,7 @@ private:
     std::vector<IceInternal::EndpointIPtr> computePublishedEndpoints();
     void updateLocatorRegistry(const IceInternal::LocatorInfoPtr&, const Ice::ObjectPrxPtr&);
     bool filterProperties(Ice::StringSeq&);
+    void updateThrottling();
 
     enum State
     {
@@ -139,6 +168,7 @@ private:
     CommunicatorPtr _communicator;
     IceInternal::ObjectAdapterFactoryPtr _objectAdapterFactory;
     IceInternal::ThreadPoolPtr _threadPool;
+    IceInternal::DispatchLanesPtr _dispatchLanes;
     IceInternal::ACMConfig _acm;
     IceInternal::ServantManagerPtr _servantManager;
     const std::string _name;
@@ -152,6 +182,13 @@ private:
     int _directCount; // The number of direct proxies dispatching on this object adapter.
     bool _noConfig;
     size_t _messageSizeMax;
+    const Int _flowControlWindow;
+
+    const int _maxDispatches;
+    const int _resumeDispatches;
+    const IceUtil::Time _maxQueueWait;
+    IceUtilInternal::Atomic _dispatchCount; // The number of admitted dispatches in progress.
+    bool _throttled; // True if the incoming connections are held because of _maxDispatches.
 };
 
 }
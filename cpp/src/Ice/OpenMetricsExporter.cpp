@@ -0,0 +1,721 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/OpenMetricsExporter.h>
+#include <Ice/HttpParser.h>
+#include <Ice/LocalException.h>
+#include <Ice/LoggerUtil.h>
+#include <Ice/Properties.h>
+
+#include <IceUtil/StringUtil.h>
+
+#include <iomanip>
+
+#ifndef _WIN32
+#   include <poll.h>
+#endif
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+using namespace IceMX;
+
+namespace
+{
+
+const size_t maxRequestSize = 8 * 1024;
+
+//
+// A metrics sample: the metrics object and the view and parent
+// metrics ID used for its labels.
+//
+struct Sample
+{
+    const string* view;
+    const string* parent;
+    MetricsPtr metrics;
+};
+
+//
+// A field of a metrics class rendered as a metric family. The family
+// name is the map metric name followed by the field suffix. Counter
+// samples get the "_total" suffix required by OpenMetrics. The samples
+// of an optional field are only written if the field is set.
+//
+struct Field
+{
+    const char* suffix;
+    const char* type;
+    bool microseconds;
+    Ice::Long (*value)(const MetricsPtr&);
+    bool (*isSet)(const MetricsPtr&); // Null if the field isn't optional.
+};
+
+Ice::Long total(const MetricsPtr& m) { return m->total; }
+Ice::Long current(const MetricsPtr& m) { return m->current; }
+Ice::Long totalLifetime(const MetricsPtr& m) { return m->totalLifetime; }
+Ice::Long failures(const MetricsPtr& m) { return m->failures; }
+
+const Field metricsFields[] =
+{
+    { "", "counter", false, total },
+    { "_current", "gauge", false, current },
+    { "_lifetime_seconds", "counter", true, totalLifetime },
+    { "_failures", "counter", false, failures }
+};
+
+Ice::Long
+dispatchUserException(const MetricsPtr& m)
+{
+    return dynamic_cast<DispatchMetrics*>(m.get())->userException;
+}
+
+Ice::Long
+dispatchSize(const MetricsPtr& m)
+{
+    return dynamic_cast<DispatchMetrics*>(m.get())->size;
+}
+
+Ice::Long
+dispatchReplySize(const MetricsPtr& m)
+{
+    return dynamic_cast<DispatchMetrics*>(m.get())->replySize;
+}
+
+Ice::Long
+dispatchQueueTime(const MetricsPtr& m)
+{
+    return *dynamic_cast<DispatchMetrics*>(m.get())->queueTime;
+}
+
+bool
+dispatchHasQueueTime(const MetricsPtr& m)
+{
+    return dynamic_cast<DispatchMetrics*>(m.get())->queueTime ? true : false;
+}
+
+const Field dispatchFields[] =
+{
+    { "_user_exceptions", "counter", false, dispatchUserException },
+    { "_size_bytes", "counter", false, dispatchSize },
+    { "_reply_size_bytes", "counter", false, dispatchReplySize },
+    { "_queue_seconds", "counter", true, dispatchQueueTime, dispatchHasQueueTime }
+};
+
+Ice::Long
+invocationRetry(const MetricsPtr& m)
+{
+    return dynamic_cast<InvocationMetrics*>(m.get())->retry;
+}
+
+Ice::Long
+invocationUserException(const MetricsPtr& m)
+{
+    return dynamic_cast<InvocationMetrics*>(m.get())->userException;
+}
+
+const Field invocationFields[] =
+{
+    { "_retries", "counter", false, invocationRetry },
+    { "_user_exceptions", "counter", false, invocationUserException }
+};
+
+Ice::Long
+childInvocationSize(const MetricsPtr& m)
+{
+    return dynamic_cast<ChildInvocationMetrics*>(m.get())->size;
+}
+
+Ice::Long
+childInvocationReplySize(const MetricsPtr& m)
+{
+    return dynamic_cast<ChildInvocationMetrics*>(m.get())->replySize;
+}
+
+const Field childInvocationFields[] =
+{
+    { "_size_bytes", "counter", false, childInvocationSize },
+    { "_reply_size_bytes", "counter", false, childInvocationReplySize }
+};
+
+Ice::Long
+connectionReceivedBytes(const MetricsPtr& m)
+{
+    return dynamic_cast<ConnectionMetrics*>(m.get())->receivedBytes;
+}
+
+Ice::Long
+connectionSentBytes(const MetricsPtr& m)
+{
+    return dynamic_cast<ConnectionMetrics*>(m.get())->sentBytes;
+}
+
+const Field connectionFields[] =
+{
+    { "_received_bytes", "counter", false, connectionReceivedBytes },
+    { "_sent_bytes", "counter", false, connectionSentBytes }
+};
+
+Ice::Long
+threadInUseForIO(const MetricsPtr& m)
+{
+    return dynamic_cast<ThreadMetrics*>(m.get())->inUseForIO;
+}
+
+Ice::Long
+threadInUseForUser(const MetricsPtr& m)
+{
+    return dynamic_cast<ThreadMetrics*>(m.get())->inUseForUser;
+}
+
+Ice::Long
+threadInUseForOther(const MetricsPtr& m)
+{
+    return dynamic_cast<ThreadMetrics*>(m.get())->inUseForOther;
+}
+
+const Field threadFields[] =
+{
+    { "_in_use_for_io", "gauge", false, threadInUseForIO },
+    { "_in_use_for_user", "gauge", false, threadInUseForUser },
+    { "_in_use_for_other", "gauge", false, threadInUseForOther }
+};
+
+//
+// Convert a map name such as "ConnectionEstablishment" to a metric
+// name component such as "connection_establishment".
+//
+string
+toMetricName(const string& name)
+{
+    string result;
+    for(string::const_iterator p = name.begin(); p != name.end(); ++p)
+    {
+        if(IceUtilInternal::isAlpha(*p) || IceUtilInternal::isDigit(*p))
+        {
+            if(*p >= 'A' && *p <= 'Z')
+            {
+                if(p != name.begin())
+                {
+                    result += '_';
+                }
+                result += static_cast<char>(*p - 'A' + 'a');
+            }
+            else
+            {
+                result += *p;
+            }
+        }
+        else
+        {
+            result += '_';
+        }
+    }
+    return result;
+}
+
+void
+writeLabelValue(ostream& os, const string& value)
+{
+    os << '"';
+    for(string::const_iterator p = value.begin(); p != value.end(); ++p)
+    {
+        switch(*p)
+        {
+        case '\\':
+            os << "\\\\";
+            break;
+        case '"':
+            os << "\\\"";
+            break;
+        case '\n':
+            os << "\\n";
+            break;
+        default:
+            os << *p;
+            break;
+        }
+    }
+    os << '"';
+}
+
+void
+writeLabels(ostream& os, const string& view, const string& parentLabel, const string* parent, const string& id)
+{
+    os << "{view=";
+    writeLabelValue(os, view);
+    if(parent)
+    {
+        os << ',' << parentLabel << '=';
+        writeLabelValue(os, *parent);
+    }
+    os << ",id=";
+    writeLabelValue(os, id);
+}
+
+void
+writeSeconds(ostream& os, Ice::Long microseconds)
+{
+    os << microseconds / 1000000 << '.' << setw(6) << setfill('0') << microseconds % 1000000 << setfill(' ');
+}
+
+void
+writeFields(ostream& os, const string& name, const string& parentLabel, const vector<Sample>& samples,
+            const Field* fields, size_t count)
+{
+    for(const Field* field = fields; field != fields + count; ++field)
+    {
+        vector<Sample>::const_iterator p = samples.begin();
+        if(field->isSet)
+        {
+            while(p != samples.end() && !field->isSet(p->metrics))
+            {
+                ++p;
+            }
+            if(p == samples.end())
+            {
+                continue;
+            }
+        }
+
+        const string family = name + field->suffix;
+        const bool counter = string(field->type) == "counter";
+        os << "# TYPE " << family << ' ' << field->type << '\n';
+        for(; p != samples.end(); ++p)
+        {
+            if(field->isSet && !field->isSet(p->metrics))
+            {
+                continue;
+            }
+            os << family << (counter ? "_total" : "");
+            writeLabels(os, *p->view, parentLabel, p->parent, p->metrics->id);
+            os << "} ";
+            if(field->microseconds)
+            {
+                writeSeconds(os, field->value(p->metrics));
+            }
+            else
+            {
+                os << field->value(p->metrics);
+            }
+            os << '\n';
+        }
+    }
+}
+
+void
+writeSamples(ostream& os, const string& name, const string& parentLabel, const vector<Sample>& samples)
+{
+    if(samples.empty())
+    {
+        return;
+    }
+
+    writeFields(os, name, parentLabel, samples, metricsFields, sizeof(metricsFields) / sizeof(*metricsFields));
+
+    //
+    // All the metrics of a map have the same type.
+    //
+    Metrics* metrics = samples.front().metrics.get();
+    if(dynamic_cast<DispatchMetrics*>(metrics))
+    {
+        writeFields(os, name, parentLabel, samples, dispatchFields, sizeof(dispatchFields) / sizeof(*dispatchFields));
+    }
+    else if(dynamic_cast<InvocationMetrics*>(metrics))
+    {
+        writeFields(os, name, parentLabel, samples, invocationFields,
+                    sizeof(invocationFields) / sizeof(*invocationFields));
+    }
+    else if(dynamic_cast<ChildInvocationMetrics*>(metrics))
+    {
+        writeFields(os, name, parentLabel, samples, childInvocationFields,
+                    sizeof(childInvocationFields) / sizeof(*childInvocationFields));
+    }
+    else if(dynamic_cast<ConnectionMetrics*>(metrics))
+    {
+        writeFields(os, name, parentLabel, samples, connectionFields,
+                    sizeof(connectionFields) / sizeof(*connectionFields));
+    }
+    else if(dynamic_cast<ThreadMetrics*>(metrics))
+    {
+        writeFields(os, name, parentLabel, samples, threadFields, sizeof(threadFields) / sizeof(*threadFields));
+    }
+}
+
+void
+writeHistograms(ostream& os, const string& name, const map<string, MetricsMapIPtr>& maps, const string& subMap)
+{
+    bool first = true;
+    const string family = name + "_duration_seconds";
+    for(map<string, MetricsMapIPtr>::const_iterator p = maps.begin(); p != maps.end(); ++p)
+    {
+        LatencyHistogramCounts counts;
+        p->second->getHistograms(subMap, counts);
+        for(LatencyHistogramCounts::const_iterator q = counts.begin(); q != counts.end(); ++q)
+        {
+            if(first)
+            {
+                os << "# TYPE " << family << " histogram\n";
+                first = false;
+            }
+
+            MetricsHistogram histogram = LatencyHistogram::toMetricsHistogram(q->first, q->second);
+            Ice::Long cumulative = 0;
+            for(size_t i = 0; i < histogram.bounds.size(); ++i)
+            {
+                cumulative += histogram.counts[i];
+                os << family << "_bucket";
+                writeLabels(os, p->first, "", 0, q->first);
+                os << ",le=\"";
+                writeSeconds(os, histogram.bounds[i]);
+                os << "\"} " << cumulative << '\n';
+            }
+            os << family << "_bucket";
+            writeLabels(os, p->first, "", 0, q->first);
+            os << ",le=\"+Inf\"} " << histogram.count << '\n';
+            os << family << "_count";
+            writeLabels(os, p->first, "", 0, q->first);
+            os << "} " << histogram.count << '\n';
+        }
+    }
+}
+
+//
+// Render the metrics of the given map for all the views. Families must
+// be contiguous so each family is rendered for all the views before
+// moving to the next.
+//
+string
+renderMap(const string& mapName, const map<string, MetricsMapIPtr>& maps)
+{
+    const string name = "ice_" + toMetricName(mapName);
+
+    vector<pair<string, MetricsMap> > snapshots;
+    for(map<string, MetricsMapIPtr>::const_iterator p = maps.begin(); p != maps.end(); ++p)
+    {
+        snapshots.push_back(make_pair(p->first, p->second->getMetrics()));
+    }
+
+    ostringstream os;
+    vector<Sample> samples;
+    for(vector<pair<string, MetricsMap> >::const_iterator p = snapshots.begin(); p != snapshots.end(); ++p)
+    {
+        for(MetricsMap::const_iterator q = p->second.begin(); q != p->second.end(); ++q)
+        {
+            Sample sample = { &p->first, 0, *q };
+            samples.push_back(sample);
+        }
+    }
+    writeSamples(os, name, "", samples);
+    writeHistograms(os, name, maps, "");
+
+    //
+    // Invocation metrics are the only metrics with sub-maps, the remote
+    // and collocated metrics are labelled with the invocation metrics ID.
+    //
+    if(!samples.empty() && dynamic_cast<InvocationMetrics*>(samples.front().metrics.get()))
+    {
+        const string parentLabel = toMetricName(mapName);
+        const char* subMaps[] = { "Remote", "Collocated" };
+        for(size_t i = 0; i < sizeof(subMaps) / sizeof(*subMaps); ++i)
+        {
+            vector<Sample> subSamples;
+            for(vector<Sample>::const_iterator p = samples.begin(); p != samples.end(); ++p)
+            {
+                InvocationMetrics* invocation = dynamic_cast<InvocationMetrics*>(p->metrics.get());
+                const MetricsMap& subMap = i == 0 ? invocation->remotes : invocation->collocated;
+                for(MetricsMap::const_iterator q = subMap.begin(); q != subMap.end(); ++q)
+                {
+                    Sample sample = { p->view, &invocation->id, *q };
+                    subSamples.push_back(sample);
+                }
+            }
+            const string subName = name + "_" + toMetricName(subMaps[i]);
+            writeSamples(os, subName, parentLabel, subSamples);
+            writeHistograms(os, subName, maps, subMaps[i]);
+        }
+    }
+    return os.str();
+}
+
+}
+
+IceInternal::OpenMetricsExporter::OpenMetricsExporter(const InstancePtr& instance, const MetricsAdminIPtr& metrics) :
+    IceUtil::Thread("Ice.OpenMetricsExporter"),
+    _metrics(metrics),
+    _logger(instance->initializationData().logger),
+    _path(instance->initializationData().properties->getPropertyWithDefault("IceMX.OpenMetrics.Path", "/metrics")),
+    _timeout(instance->initializationData().properties->getPropertyAsIntWithDefault("IceMX.OpenMetrics.Timeout",
+                                                                                    10000)),
+    _fd(INVALID_SOCKET),
+    _fdIntrRead(INVALID_SOCKET),
+    _fdIntrWrite(INVALID_SOCKET)
+{
+    const PropertiesPtr& properties = instance->initializationData().properties;
+
+    //
+    // The metrics are served without authentication, only listen on the
+    // loopback interface unless another interface is configured.
+    //
+    const string host = properties->getPropertyWithDefault("IceMX.OpenMetrics.Host", "localhost");
+    const int port = properties->getPropertyAsInt("IceMX.OpenMetrics.Port");
+
+    Address addr = getAddressForServer(host, port, instance->protocolSupport(), instance->preferIPv6(), true);
+    _fd = createServerSocket(false, addr, instance->protocolSupport());
+    try
+    {
+        setBlock(_fd, false);
+#ifndef _WIN32
+        setReuseAddress(_fd, true);
+#endif
+        doBind(_fd, addr);
+        doListen(_fd, SOMAXCONN);
+
+        SOCKET fds[2];
+        createPipe(fds);
+        _fdIntrRead = fds[0];
+        _fdIntrWrite = fds[1];
+    }
+    catch(...)
+    {
+        closeSocketNoThrow(_fd);
+        throw;
+    }
+}
+
+IceInternal::OpenMetricsExporter::~OpenMetricsExporter()
+{
+    closeSocketNoThrow(_fd);
+    closeSocketNoThrow(_fdIntrRead);
+    closeSocketNoThrow(_fdIntrWrite);
+}
+
+void
+IceInternal::OpenMetricsExporter::destroy()
+{
+    char c = 0;
+    while(true)
+    {
+#ifdef _WIN32
+        if(::send(_fdIntrWrite, &c, 1, 0) == SOCKET_ERROR)
+#else
+        if(::write(_fdIntrWrite, &c, 1) == SOCKET_ERROR)
+#endif
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+
+            throw Ice::SocketException(__FILE__, __LINE__, IceInternal::getSocketErrno());
+        }
+        break;
+    }
+}
+
+void
+IceInternal::OpenMetricsExporter::run()
+{
+    while(true)
+    {
+        try
+        {
+            if(!wait(_fd, false, -1))
+            {
+                break;
+            }
+        }
+        catch(const Ice::SocketException& ex)
+        {
+            Error out(_logger);
+            out << "metrics exporter failed to wait for HTTP connections, the exporter is stopped:\n" << ex;
+            break;
+        }
+
+        SOCKET fd;
+        try
+        {
+            fd = doAccept(_fd);
+        }
+        catch(const Ice::SocketException& ex)
+        {
+            if(!wouldBlock())
+            {
+                Warning out(_logger);
+                out << "metrics exporter failed to accept HTTP connection:\n" << ex;
+            }
+            continue;
+        }
+
+        try
+        {
+            serve(fd);
+        }
+        catch(const std::exception& ex)
+        {
+            Warning out(_logger);
+            out << "metrics exporter failed to serve HTTP request:\n" << ex;
+        }
+        closeSocketNoThrow(fd);
+    }
+}
+
+void
+IceInternal::OpenMetricsExporter::serve(SOCKET fd)
+{
+    setBlock(fd, false);
+
+    //
+    // Read the request header, the request body if any is ignored.
+    //
+    HttpParserPtr parser = new HttpParser();
+    string request;
+    const Byte* end = 0;
+    while(!end)
+    {
+        if(request.size() >= maxRequestSize || !wait(fd, false, _timeout))
+        {
+            return;
+        }
+
+        char buf[1024];
+#ifdef _WIN32
+        ssize_t ret = ::recv(fd, buf, static_cast<int>(sizeof(buf)), 0);
+#else
+        ssize_t ret = ::recv(fd, buf, sizeof(buf), 0);
+#endif
+        if(ret == 0)
+        {
+            return;
+        }
+        else if(ret == SOCKET_ERROR)
+        {
+            if(interrupted() || wouldBlock())
+            {
+                continue;
+            }
+            return;
+        }
+        request.append(buf, static_cast<size_t>(ret));
+
+        const Byte* begin = reinterpret_cast<const Byte*>(request.data());
+        end = parser->isCompleteMessage(begin, begin + request.size());
+    }
+
+    string status;
+    try
+    {
+        const Byte* begin = reinterpret_cast<const Byte*>(request.data());
+        if(!parser->parse(begin, end) || parser->type() != HttpParser::TypeRequest)
+        {
+            status = "400 Bad Request";
+        }
+        else if(parser->method() != "GET")
+        {
+            status = "405 Method Not Allowed";
+        }
+        else if(parser->uri().substr(0, parser->uri().find('?')) != _path)
+        {
+            status = "404 Not Found";
+        }
+    }
+    catch(const WebSocketException&)
+    {
+        status = "400 Bad Request";
+    }
+
+    if(!status.empty())
+    {
+        write(fd, "HTTP/1.1 " + status + "\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+        return;
+    }
+
+    //
+    // The response isn't sent with a content length, it's delimited by
+    // the closure of the connection. This allows to send each map once
+    // rendered.
+    //
+    if(!write(fd, "HTTP/1.1 200 OK\r\n"
+                  "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+                  "Connection: close\r\n\r\n"))
+    {
+        return;
+    }
+
+    map<string, map<string, MetricsMapIPtr> > maps = _metrics->getViewMaps();
+    for(map<string, map<string, MetricsMapIPtr> >::const_iterator p = maps.begin(); p != maps.end(); ++p)
+    {
+        if(!write(fd, renderMap(p->first, p->second)))
+        {
+            return;
+        }
+    }
+    write(fd, "# EOF\n");
+}
+
+bool
+IceInternal::OpenMetricsExporter::write(SOCKET fd, const string& data)
+{
+    const char* buf = data.data();
+    size_t length = data.size();
+    while(length > 0)
+    {
+#ifdef _WIN32
+        ssize_t ret = ::send(fd, buf, static_cast<int>(length), 0);
+#else
+        ssize_t ret = ::send(fd, buf, length, 0);
+#endif
+        if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+
+            if(wouldBlock() && wait(fd, true, _timeout))
+            {
+                continue;
+            }
+            return false;
+        }
+        buf += ret;
+        length -= static_cast<size_t>(ret);
+    }
+    return true;
+}
+
+bool
+IceInternal::OpenMetricsExporter::wait(SOCKET fd, bool forWrite, int timeout)
+{
+    //
+    // Wait for the socket to be ready, returns false on timeout or if
+    // the exporter is destroyed.
+    //
+    struct pollfd fds[2];
+    fds[0].fd = fd;
+    fds[0].events = forWrite ? POLLOUT : POLLIN;
+    fds[0].revents = 0;
+    fds[1].fd = _fdIntrRead;
+    fds[1].events = POLLIN;
+    fds[1].revents = 0;
+
+    while(true)
+    {
+#ifdef _WIN32
+        int ret = WSAPoll(fds, 2, timeout);
+#else
+        int ret = ::poll(fds, 2, timeout);
+#endif
+        if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+
+            throw Ice::SocketException(__FILE__, __LINE__, IceInternal::getSocketErrno());
+        }
+        return ret > 0 && fds[1].revents == 0;
+    }
+}
@@ -0,0 +1,55 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_OPEN_METRICS_EXPORTER_H
+#define ICE_OPEN_METRICS_EXPORTER_H
+
+#include <IceUtil/Thread.h>
+#include <Ice/Instance.h>
+#include <Ice/LoggerF.h>
+#include <Ice/MetricsAdminI.h>
+#include <Ice/Network.h>
+
+namespace IceInternal
+{
+
+//
+// Serves the metrics of the enabled IceMX views over HTTP using the
+// OpenMetrics text format, which allows Prometheus and compatible
+// monitoring systems to scrape Ice processes directly. The exporter
+// is enabled by setting IceMX.OpenMetrics.Port.
+//
+// Requests are served one at a time by the exporter thread. The
+// response is rendered one metrics map at a time and sent as it is
+// rendered, the full set of views is never copied.
+//
+class OpenMetricsExporter : public IceUtil::Thread
+{
+public:
+
+    OpenMetricsExporter(const InstancePtr&, const MetricsAdminIPtr&);
+    virtual ~OpenMetricsExporter();
+
+    void destroy();
+
+    virtual void run();
+
+private:
+
+    void serve(SOCKET);
+    bool write(SOCKET, const std::string&);
+    bool wait(SOCKET, bool, int);
+
+    const MetricsAdminIPtr _metrics;
+    const Ice::LoggerPtr _logger;
+    const std::string _path;
+    const int _timeout;
+    SOCKET _fd;
+    SOCKET _fdIntrRead;
+    SOCKET _fdIntrWrite;
+};
+
+}
+
+#endif
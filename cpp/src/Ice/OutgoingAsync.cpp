@@ -10,20 +10,90 @@
 #include <Ice/LocalException.h>
 #include <Ice/ReplyStatus.h>
 #include <Ice/ImplicitContextI.h>
+#include <Ice/Incoming.h>
+#include <Ice/TracingObserverI.h>
 #include <Ice/ThreadPool.h>
 #include <Ice/RetryQueue.h>
 #include <Ice/ConnectionFactory.h>
 #include <Ice/ObjectAdapterFactory.h>
 #include <Ice/LoggerUtil.h>
+#include <Ice/TraceLevels.h>
+
+#include <sstream>
+#include <iomanip>
 
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
 
+namespace
+{
+
+//
+// The time remaining before the deadline is written with a fixed width,
+// padded with spaces, so it can be updated in place when the request is
+// sent again.
+//
+string
+formatDeadline(IceUtil::Int64 remaining)
+{
+    ostringstream os;
+    os << setw(10) << max(remaining, static_cast<IceUtil::Int64>(0));
+    return os.str();
+}
+
+//
+// Write the context with the trace and deadline context entries. The
+// deadline entry of a context forwarded from a dispatch is removed if
+// the invocation doesn't propagate its own deadline, it's no longer
+// accurate.
+//
+void
+writeContext(OutputStream& os, const Context& context, const string& traceParent, const string& deadline,
+             size_t& deadlinePos)
+{
+    Context ctx(context);
+    if(!traceParent.empty())
+    {
+        ctx["traceparent"] = traceParent;
+    }
+    if(deadline.empty())
+    {
+        ctx.erase(deadlineContextKey);
+        os.write(ctx);
+        return;
+    }
+
+    ctx[deadlineContextKey] = deadline;
+    os.writeSize(static_cast<Int>(ctx.size()));
+    for(Context::const_iterator p = ctx.begin(); p != ctx.end(); ++p)
+    {
+        os.write(p->first);
+        if(p->first == deadlineContextKey)
+        {
+            os.write(p->second, false);
+            deadlinePos = os.b.size() - p->second.size();
+        }
+        else
+        {
+            os.write(p->second);
+        }
+    }
+}
+
+bool
+hasDeadline(const Context& context)
+{
+    return !context.empty() && context.find(deadlineContextKey) != context.end();
+}
+
+}
+
 #ifndef ICE_CPP11_MAPPING
 IceUtil::Shared* IceInternal::upCast(OutgoingAsyncBase* p) { return p; }
 IceUtil::Shared* IceInternal::upCast(ProxyOutgoingAsyncBase* p) { return p; }
 IceUtil::Shared* IceInternal::upCast(OutgoingAsync* p) { return p; }
+IceUtil::Shared* IceInternal::upCast(EncodedRequest* p) { return p; }
 #endif
 
 const unsigned char OutgoingAsyncBase::OK = 0x1;
@@ -598,7 +668,7 @@ ProxyOutgoingAsyncBase::exception(const Exception& exc)
     }
 
     _cachedConnection = 0;
-    if(_proxy->_getReference()->getInvocationTimeout() == -2)
+    if(_invocationTimeout == -2)
     {
         _instance->timer()->cancel(ICE_SHARED_FROM_THIS);
     }
@@ -626,7 +696,7 @@ ProxyOutgoingAsyncBase::exception(const Exception& exc)
 void
 ProxyOutgoingAsyncBase::cancelable(const CancellationHandlerPtr& handler)
 {
-    if(_proxy->_getReference()->getInvocationTimeout() == -2 && _cachedConnection)
+    if(_invocationTimeout == -2 && _cachedConnection)
     {
         const int timeout = _cachedConnection->timeout();
         if(timeout > 0)
@@ -704,6 +774,8 @@ ProxyOutgoingAsyncBase::ProxyOutgoingAsyncBase(const ObjectPrxPtr& prx) :
     OutgoingAsyncBase(prx->_getReference()->getInstance()),
     _proxy(prx),
     _mode(ICE_ENUM(OperationMode, Normal)),
+    _invocationTimeout(prx->_getReference()->getInvocationTimeout()),
+    _deadlinePos(0),
     _cnt(0),
     _sent(false)
 {
@@ -720,15 +792,15 @@ ProxyOutgoingAsyncBase::invokeImpl(bool userThread)
     {
         if(userThread)
         {
-            int invocationTimeout = _proxy->_getReference()->getInvocationTimeout();
-            if(invocationTimeout > 0)
+            if(_invocationTimeout > 0)
             {
-                _instance->timer()->schedule(ICE_SHARED_FROM_THIS, IceUtil::Time::milliSeconds(invocationTimeout));
+                _instance->timer()->schedule(ICE_SHARED_FROM_THIS, IceUtil::Time::milliSeconds(_invocationTimeout));
             }
         }
         else
         {
             _observer.retried();
+            updateDeadline();
         }
 
         while(true)
@@ -778,6 +850,7 @@ ProxyOutgoingAsyncBase::invokeImpl(bool userThread)
                 else
                 {
                     _observer.retried();
+                    updateDeadline();
                 }
             }
         }
@@ -799,13 +872,28 @@ ProxyOutgoingAsyncBase::invokeImpl(bool userThread)
     }
 }
 
+void
+ProxyOutgoingAsyncBase::updateDeadline()
+{
+    //
+    // The request is sent again, the remaining time propagated with the
+    // request context is updated.
+    //
+    if(_deadlinePos > 0)
+    {
+        IceUtil::Time remaining = _deadline - IceUtil::Time::now(IceUtil::Time::Monotonic);
+        const string value = formatDeadline(remaining.toMilliSeconds());
+        copy(value.begin(), value.end(), _os.b.begin() + _deadlinePos);
+    }
+}
+
 bool
 ProxyOutgoingAsyncBase::sentImpl(bool done)
 {
     _sent = true;
     if(done)
     {
-        if(_proxy->_getReference()->getInvocationTimeout() != -1)
+        if(_invocationTimeout != -1)
         {
             _instance->timer()->cancel(ICE_SHARED_FROM_THIS);
         }
@@ -816,7 +904,7 @@ ProxyOutgoingAsyncBase::sentImpl(bool done)
 bool
 ProxyOutgoingAsyncBase::exceptionImpl(const Exception& ex)
 {
-    if(_proxy->_getReference()->getInvocationTimeout() != -1)
+    if(_invocationTimeout != -1)
     {
         _instance->timer()->cancel(ICE_SHARED_FROM_THIS);
     }
@@ -826,7 +914,7 @@ ProxyOutgoingAsyncBase::exceptionImpl(const Exception& ex)
 bool
 ProxyOutgoingAsyncBase::responseImpl(bool ok, bool invoke)
 {
-    if(_proxy->_getReference()->getInvocationTimeout() != -1)
+    if(_invocationTimeout != -1)
     {
         _instance->timer()->cancel(ICE_SHARED_FROM_THIS);
     }
@@ -836,7 +924,7 @@ ProxyOutgoingAsyncBase::responseImpl(bool ok, bool invoke)
 void
 ProxyOutgoingAsyncBase::runTimerTask()
 {
-    if(_proxy->_getReference()->getInvocationTimeout() == -2)
+    if(_invocationTimeout == -2)
     {
         cancel(ConnectionTimeoutException(__FILE__, __LINE__));
     }
@@ -846,6 +934,24 @@ ProxyOutgoingAsyncBase::runTimerTask()
     }
 }
 
+EncodedRequest::EncodedRequest(const CommunicatorPtr& communicator, const string& operation, OperationMode mode,
+                               const pair<const Byte*, const Byte*>& inParams, const Context& context) :
+    _operation(operation),
+    _mode(mode),
+    _context(context)
+{
+    OutputStream os(communicator);
+    os.write(operation, false);
+    os.write(static_cast<Byte>(mode));
+    os.write(context);
+    _params = os.b.size();
+    if(inParams.second > inParams.first)
+    {
+        os.writeEncapsulation(inParams.first, static_cast<Int>(inParams.second - inParams.first));
+    }
+    _body.assign(os.b.begin(), os.b.end());
+}
+
 OutgoingAsync::OutgoingAsync(const ObjectPrxPtr& prx, bool synchronous) :
     ProxyOutgoingAsyncBase(prx),
     _encoding(getCompatibleEncoding(prx->_getReference()->getEncoding())),
@@ -854,7 +960,7 @@ OutgoingAsync::OutgoingAsync(const ObjectPrxPtr& prx, bool synchronous) :
 }
 
 void
-OutgoingAsync::prepare(const string& operation, OperationMode mode, const Context& context)
+OutgoingAsync::prepareHeader(const string& operation, OperationMode mode, const Context& context)
 {
     checkSupportedProtocol(getCompatibleProtocol(_proxy->_getReference()->getProtocol()));
 
@@ -895,11 +1001,65 @@ OutgoingAsync::prepare(const string& operation, OperationMode mode, const Contex
         string facet = ref->getFacet();
         _os.write(&facet, &facet + 1);
     }
+}
+
+void
+OutgoingAsync::prepareContext(string& traceParent, string& deadline)
+{
+    Reference* ref = _proxy->_getReference().get();
+
+    //
+    // The request context carries the trace context of the invocation
+    // when tracing is enabled.
+    //
+    if(_observer && ref->getInstance()->getTracingObserver())
+    {
+        traceParent = TracingObserverI::getTraceParent(_observer.get());
+    }
+
+    //
+    // An invocation made while dispatching a request with a deadline
+    // doesn't outlive the deadline, its invocation timeout is reduced to
+    // the time remaining before the deadline. With Ice.PropagateDeadline,
+    // the request context of twoway invocations also carries the time
+    // remaining before the invocation times out.
+    //
+    if(_invocationTimeout != -2)
+    {
+        const IceUtil::Time dispatchDeadline = getDispatchDeadline();
+        if(dispatchDeadline != IceUtil::Time())
+        {
+            IceUtil::Time remaining = dispatchDeadline - IceUtil::Time::now(IceUtil::Time::Monotonic);
+            int timeout = max(static_cast<int>(remaining.toMilliSeconds()), 1); // Expired, time out right away.
+            if(_invocationTimeout < 0 || timeout < _invocationTimeout)
+            {
+                _invocationTimeout = timeout;
+            }
+        }
+
+        if(_invocationTimeout > 0 && ref->getMode() == Reference::ModeTwoway && ref->getInstance()->propagateDeadline())
+        {
+            _deadline = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::milliSeconds(_invocationTimeout);
+            deadline = formatDeadline(_invocationTimeout);
+        }
+    }
+}
+
+void
+OutgoingAsync::prepare(const string& operation, OperationMode mode, const Context& context)
+{
+    prepareHeader(operation, mode, context);
 
     _os.write(operation, false);
 
     _os.write(static_cast<Byte>(_mode));
 
+    string traceParent;
+    string deadline;
+    prepareContext(traceParent, deadline);
+
+    Reference* ref = _proxy->_getReference().get();
+
 #if defined(_MSC_VER) && (_MSC_VER <= 1600)
     //
     // COMPILERFIX v90 and v100 get confused with namespaces and we need to
@@ -915,7 +1075,14 @@ OutgoingAsync::prepare(const string& operation, OperationMode mode, const Contex
         //
         // Explicit context
         //
-        _os.write(context);
+        if(traceParent.empty() && deadline.empty() && !hasDeadline(context))
+        {
+            _os.write(context);
+        }
+        else
+        {
+            writeContext(_os, context, traceParent, deadline, _deadlinePos);
+        }
     }
     else
     {
@@ -924,7 +1091,21 @@ OutgoingAsync::prepare(const string& operation, OperationMode mode, const Contex
         //
         const ImplicitContextIPtr& implicitContext = ref->getInstance()->getImplicitContext();
         const Context& prxContext = ref->getContext()->getValue();
-        if(implicitContext == 0)
+        if(!traceParent.empty() || !deadline.empty() || hasDeadline(prxContext) ||
+           (implicitContext && implicitContext->containsKey(deadlineContextKey)))
+        {
+            Context ctx;
+            if(implicitContext == 0)
+            {
+                ctx = prxContext;
+            }
+            else
+            {
+                implicitContext->combine(prxContext, ctx);
+            }
+            writeContext(_os, ctx, traceParent, deadline, _deadlinePos);
+        }
+        else if(implicitContext == 0)
         {
             _os.write(prxContext);
         }
@@ -935,6 +1116,71 @@ OutgoingAsync::prepare(const string& operation, OperationMode mode, const Contex
     }
 }
 
+void
+OutgoingAsync::prepare(const EncodedRequestPtr& request)
+{
+    prepareHeader(request->_operation, request->_mode, request->_context);
+
+    string traceParent;
+    string deadline;
+    prepareContext(traceParent, deadline);
+
+    Reference* ref = _proxy->_getReference().get();
+    const bool emptyParams = request->_params == request->_body.size();
+    if(!traceParent.empty() || !deadline.empty() || hasDeadline(request->_context))
+    {
+        //
+        // The context carries the trace or deadline context of this
+        // invocation, it's marshaled again and the encoded parameters
+        // are copied.
+        //
+        _os.write(request->_operation, false);
+        _os.write(static_cast<Byte>(_mode));
+        writeContext(_os, request->_context, traceParent, deadline, _deadlinePos);
+        if(!emptyParams)
+        {
+            _os.writeBlob(&request->_body[request->_params], request->_body.size() - request->_params);
+        }
+    }
+    else if(emptyParams || (ref->getMode() != Reference::ModeTwoway && ref->getMode() != Reference::ModeOneway) ||
+            ref->getInstance()->traceLevels()->protocol >= 1)
+    {
+        //
+        // Batch requests and datagrams are sent as a whole and protocol
+        // tracing reads the whole request, the encoded body is copied.
+        //
+        _os.writeBlob(&request->_body[0], request->_body.size());
+    }
+    else
+    {
+        //
+        // The stream only holds the request header, the connection
+        // sends the shared encoded body after it.
+        //
+        _encodedRequest = request;
+    }
+
+    if(emptyParams)
+    {
+        _os.writeEmptyEncapsulation(_encoding);
+    }
+}
+
+void
+OutgoingAsync::copyEncodedRequest()
+{
+    //
+    // Copy the shared encoded body after the request header for the
+    // invocations which need the whole request in the stream.
+    //
+    if(_encodedRequest)
+    {
+        const vector<Byte>& body = _encodedRequest->body();
+        _os.writeBlob(&body[0], body.size());
+        _encodedRequest = ICE_NULLPTR;
+    }
+}
+
 bool
 OutgoingAsync::sent()
 {
@@ -1092,12 +1338,17 @@ AsyncStatus
 OutgoingAsync::invokeRemote(const ConnectionIPtr& connection, bool compress, bool response)
 {
     _cachedConnection = connection;
+    if(compress)
+    {
+        copyEncodedRequest(); // The request is compressed as a whole.
+    }
     return connection->sendAsyncRequest(ICE_SHARED_FROM_THIS, compress, response, 0);
 }
 
 AsyncStatus
 OutgoingAsync::invokeCollocated(CollocatedRequestHandler* handler)
 {
+    copyEncodedRequest(); // The request is dispatched from the stream.
     return handler->invokeAsyncRequest(this, 0, _synchronous);
 }
 
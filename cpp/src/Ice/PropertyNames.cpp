@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ./config/PropertyNames.xml, Fri Sep  6 18:11:04 2019
+// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Oct 19 18:32:35 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -59,6 +59,14 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.ThreadPool.Serialize", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.Admin.MaxDispatches", false, 0),
+    IceInternal::Property("Ice.Admin.MaxQueueWait", false, 0),
+    IceInternal::Property("Ice.Admin.Lanes", false, 0),
+    IceInternal::Property("Ice.Admin.Lane.*.Operations", false, 0),
+    IceInternal::Property("Ice.Admin.Lane.*.Weight", false, 0),
+    IceInternal::Property("Ice.Admin.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("Ice.Admin.LaneContext", false, 0),
+    IceInternal::Property("Ice.Admin.FlowControl.Window", false, 0),
     IceInternal::Property("Ice.Admin.MessageSizeMax", false, 0),
     IceInternal::Property("Ice.Admin.DelayCreation", false, 0),
     IceInternal::Property("Ice.Admin.Enabled", false, 0),
@@ -112,12 +120,19 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Default.Timeout", false, 0),
     IceInternal::Property("Ice.EventLog.Source", false, 0),
     IceInternal::Property("Ice.FactoryAssemblies", false, 0),
+    IceInternal::Property("Ice.FlowControl", false, 0),
     IceInternal::Property("Ice.HTTPProxyHost", false, 0),
     IceInternal::Property("Ice.HTTPProxyPort", false, 0),
     IceInternal::Property("Ice.ImplicitContext", false, 0),
     IceInternal::Property("Ice.InitPlugins", false, 0),
     IceInternal::Property("Ice.IPv4", false, 0),
     IceInternal::Property("Ice.IPv6", false, 0),
+    IceInternal::Property("Ice.LocatorCacheNegativeTimeout", false, 0),
+    IceInternal::Property("Ice.LocatorCacheRefreshAhead", false, 0),
+    IceInternal::Property("Ice.LocatorCacheSizeMax", false, 0),
+    IceInternal::Property("Ice.LocatorCacheSubscription", false, 0),
+    IceInternal::Property("Ice.LogAsync", false, 0),
+    IceInternal::Property("Ice.LogAsync.QueueSize", false, 0),
     IceInternal::Property("Ice.LogFile", false, 0),
     IceInternal::Property("Ice.LogFile.SizeMax", false, 0),
     IceInternal::Property("Ice.LogStdErr.Convert", false, 0),
@@ -138,6 +153,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.PrintProcessId", false, 0),
     IceInternal::Property("Ice.PrintStackTraces", false, 0),
     IceInternal::Property("Ice.ProgramName", false, 0),
+    IceInternal::Property("Ice.PropagateDeadline", false, 0),
     IceInternal::Property("Ice.RetryIntervals", false, 0),
     IceInternal::Property("Ice.ServerIdleTime", false, 0),
     IceInternal::Property("Ice.SOCKSProxyHost", false, 0),
@@ -174,6 +190,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.TCP.Backlog", false, 0),
     IceInternal::Property("Ice.TCP.RcvSize", false, 0),
     IceInternal::Property("Ice.TCP.SndSize", false, 0),
+    IceInternal::Property("Ice.WS.PerMessageDeflate", false, 0),
     IceInternal::Property("Ice.UseApplicationClassLoader", false, 0),
     IceInternal::Property("Ice.UseOSLog", false, 0),
     IceInternal::Property("Ice.UseSyslog", false, 0),
@@ -202,6 +219,12 @@ const IceInternal::Property IceMXPropsData[] =
     IceInternal::Property("IceMX.Metrics.*.Accept", false, 0),
     IceInternal::Property("IceMX.Metrics.*.Reject", false, 0),
     IceInternal::Property("IceMX.Metrics.*", false, 0),
+    IceInternal::Property("IceMX.OpenMetrics.Host", false, 0),
+    IceInternal::Property("IceMX.OpenMetrics.Path", false, 0),
+    IceInternal::Property("IceMX.OpenMetrics.Port", false, 0),
+    IceInternal::Property("IceMX.OpenMetrics.Timeout", false, 0),
+    IceInternal::Property("IceMX.Tracing.File", false, 0),
+    IceInternal::Property("IceMX.Tracing.Sampling", false, 0),
 };
 
 const IceInternal::PropertyArray
@@ -246,6 +269,14 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.MaxDispatches", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.MaxQueueWait", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Lanes", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.LaneContext", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.FlowControl.Window", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.MessageSizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ACM.Timeout", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ACM.Heartbeat", false, 0),
@@ -283,6 +314,14 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.MaxDispatches", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.MaxQueueWait", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Lanes", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.LaneContext", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.FlowControl.Window", false, 0),
     IceInternal::Property("IceDiscovery.Reply.MessageSizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ACM.Timeout", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ACM.Heartbeat", false, 0),
@@ -320,6 +359,14 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.MaxDispatches", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.MaxQueueWait", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Lanes", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.LaneContext", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.FlowControl.Window", false, 0),
     IceInternal::Property("IceDiscovery.Locator.MessageSizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Lookup", false, 0),
     IceInternal::Property("IceDiscovery.Timeout", false, 0),
@@ -373,6 +420,14 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.MaxDispatches", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.MaxQueueWait", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Lanes", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.LaneContext", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.FlowControl.Window", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.MessageSizeMax", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ACM.Timeout", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ACM.Heartbeat", false, 0),
@@ -410,6 +465,14 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.MaxDispatches", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.MaxQueueWait", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Lanes", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.LaneContext", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.FlowControl.Window", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.MessageSizeMax", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Lookup", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Timeout", false, 0),
@@ -507,6 +570,14 @@ const IceInternal::Property IceBridgePropsData[] =
     IceInternal::Property("IceBridge.Source.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceBridge.Source.MaxDispatches", false, 0),
+    IceInternal::Property("IceBridge.Source.MaxQueueWait", false, 0),
+    IceInternal::Property("IceBridge.Source.Lanes", false, 0),
+    IceInternal::Property("IceBridge.Source.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceBridge.Source.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceBridge.Source.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceBridge.Source.LaneContext", false, 0),
+    IceInternal::Property("IceBridge.Source.FlowControl.Window", false, 0),
     IceInternal::Property("IceBridge.Source.MessageSizeMax", false, 0),
     IceInternal::Property("IceBridge.Target.Endpoints", false, 0),
     IceInternal::Property("IceBridge.InstanceName", false, 0),
@@ -562,6 +633,14 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.MaxDispatches", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.MaxQueueWait", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.Lanes", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.LaneContext", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.FlowControl.Window", false, 0),
     IceInternal::Property("IceGridAdmin.Server.MessageSizeMax", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Address", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Interface", false, 0),
@@ -602,6 +681,14 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.MaxDispatches", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.MaxQueueWait", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Lanes", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.LaneContext", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.FlowControl.Window", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.MessageSizeMax", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ACM.Timeout", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ACM.Heartbeat", false, 0),
@@ -639,6 +726,14 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.MaxDispatches", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.MaxQueueWait", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Lanes", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.LaneContext", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.FlowControl.Window", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.MessageSizeMax", false, 0),
     IceInternal::Property("IceGridAdmin.Trace.Observers", false, 0),
     IceInternal::Property("IceGridAdmin.Trace.SaveToRegistry", false, 0),
@@ -686,6 +781,14 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.MaxQueueWait", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Lanes", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.LaneContext", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.FlowControl.Window", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.InstanceName", false, 0),
     IceInternal::Property("IceGrid.Node.ACM.Timeout", false, 0),
@@ -724,6 +827,14 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Node.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Node.MaxQueueWait", false, 0),
+    IceInternal::Property("IceGrid.Node.Lanes", false, 0),
+    IceInternal::Property("IceGrid.Node.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceGrid.Node.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceGrid.Node.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceGrid.Node.LaneContext", false, 0),
+    IceInternal::Property("IceGrid.Node.FlowControl.Window", false, 0),
     IceInternal::Property("IceGrid.Node.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.Node.AllowRunningServersAsRoot", false, 0),
     IceInternal::Property("IceGrid.Node.AllowEndpointsOverride", false, 0),
@@ -733,9 +844,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.Name", false, 0),
     IceInternal::Property("IceGrid.Node.Output", false, 0),
     IceInternal::Property("IceGrid.Node.ProcessorSocketCount", false, 0),
+    IceInternal::Property("IceGrid.Node.PrestartServers", false, 0),
     IceInternal::Property("IceGrid.Node.PrintServersReady", false, 0),
     IceInternal::Property("IceGrid.Node.PropertiesOverride", false, 0),
     IceInternal::Property("IceGrid.Node.RedirectErrToOut", false, 0),
+    IceInternal::Property("IceGrid.Node.ReportServerLoad", false, 0),
     IceInternal::Property("IceGrid.Node.Trace.Activator", false, 0),
     IceInternal::Property("IceGrid.Node.Trace.Adapter", false, 0),
     IceInternal::Property("IceGrid.Node.Trace.Admin", false, 0),
@@ -802,7 +915,17 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.MaxQueueWait", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Lanes", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.LaneContext", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.FlowControl.Window", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionObserverPageSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionObserverWindow", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.ConnectionCached", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.PreferSecure", false, 0),
@@ -849,6 +972,14 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.MaxQueueWait", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Lanes", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.LaneContext", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.FlowControl.Window", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.CryptPasswords", false, 0),
     IceInternal::Property("IceGrid.Registry.DefaultTemplates", false, 0),
@@ -888,6 +1019,14 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.MaxQueueWait", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Lanes", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.LaneContext", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.FlowControl.Window", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Enabled", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Address", false, 0),
@@ -930,6 +1069,14 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.MaxQueueWait", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Lanes", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.LaneContext", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.FlowControl.Window", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.LMDB.MapSize", false, 0),
     IceInternal::Property("IceGrid.Registry.LMDB.Path", false, 0),
@@ -984,6 +1131,14 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.MaxQueueWait", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Lanes", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.LaneContext", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.FlowControl.Window", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionFilters", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ACM.Timeout", false, 0),
@@ -1022,6 +1177,14 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.MaxQueueWait", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Lanes", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Lane.*.Operations", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Lane.*.Weight", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.LaneContext", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.FlowControl.Window", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.EndpointSelection", false, 0),
@@ -1093,6 +1256,14 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IcePatch2.MaxDispatches", false, 0),
+    IceInternal::Property("IcePatch2.MaxQueueWait", false, 0),
+    IceInternal::Property("IcePatch2.Lanes", false, 0),
+    IceInternal::Property("IcePatch2.Lane.*.Operations", false, 0),
+    IceInternal::Property("IcePatch2.Lane.*.Weight", false, 0),
+    IceInternal::Property("IcePatch2.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("IcePatch2.LaneContext", false, 0),
+    IceInternal::Property("IcePatch2.FlowControl.Window", false, 0),
     IceInternal::Property("IcePatch2.MessageSizeMax", false, 0),
     IceInternal::Property("IcePatch2.Directory", false, 0),
     IceInternal::Property("IcePatch2.InstanceName", false, 0),
@@ -1226,6 +1397,14 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.ThreadPool.Serialize", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("Glacier2.Client.MaxDispatches", false, 0),
+    IceInternal::Property("Glacier2.Client.MaxQueueWait", false, 0),
+    IceInternal::Property("Glacier2.Client.Lanes", false, 0),
+    IceInternal::Property("Glacier2.Client.Lane.*.Operations", false, 0),
+    IceInternal::Property("Glacier2.Client.Lane.*.Weight", false, 0),
+    IceInternal::Property("Glacier2.Client.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("Glacier2.Client.LaneContext", false, 0),
+    IceInternal::Property("Glacier2.Client.FlowControl.Window", false, 0),
     IceInternal::Property("Glacier2.Client.MessageSizeMax", false, 0),
     IceInternal::Property("Glacier2.Client.AlwaysBatch", false, 0),
     IceInternal::Property("Glacier2.Client.Buffered", false, 0),
@@ -1301,6 +1480,14 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.ThreadPool.Serialize", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("Glacier2.Server.MaxDispatches", false, 0),
+    IceInternal::Property("Glacier2.Server.MaxQueueWait", false, 0),
+    IceInternal::Property("Glacier2.Server.Lanes", false, 0),
+    IceInternal::Property("Glacier2.Server.Lane.*.Operations", false, 0),
+    IceInternal::Property("Glacier2.Server.Lane.*.Weight", false, 0),
+    IceInternal::Property("Glacier2.Server.Lane.*.MaxQueued", false, 0),
+    IceInternal::Property("Glacier2.Server.LaneContext", false, 0),
+    IceInternal::Property("Glacier2.Server.FlowControl.Window", false, 0),
     IceInternal::Property("Glacier2.Server.MessageSizeMax", false, 0),
     IceInternal::Property("Glacier2.Server.AlwaysBatch", false, 0),
     IceInternal::Property("Glacier2.Server.Buffered", false, 0),
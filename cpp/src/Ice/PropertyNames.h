@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ./config/PropertyNames.xml, Fri Sep  6 18:11:04 2019
+// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Oct 19 18:32:35 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -531,6 +531,25 @@ IceProxy::Ice::Object::_iceI_begin_ice_invoke(const string& operation,
     return result;
 }
 
+AsyncResultPtr
+IceProxy::Ice::Object::_iceI_begin_ice_invoke(const EncodedRequestPtr& request,
+                                              const ::IceInternal::CallbackBasePtr& del,
+                                              const ::Ice::LocalObjectPtr& cookie,
+                                              bool sync)
+{
+    OutgoingAsyncPtr result = new CallbackOutgoing(this, ice_invoke_name, del, cookie, sync);
+    try
+    {
+        result->prepare(request);
+        result->invoke(request->operation());
+    }
+    catch(const Exception& ex)
+    {
+        result->abort(ex);
+    }
+    return result;
+}
+
 bool
 IceProxy::Ice::Object::_iceI_end_ice_invoke(pair<const Byte*, const Byte*>& outEncaps, const AsyncResultPtr& result)
 {
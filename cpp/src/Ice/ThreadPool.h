@@ -110,6 +110,11 @@ public:
 
     std::string prefix() const;
 
+    bool serialize() const
+    {
+        return _serialize;
+    }
+
 #ifdef ICE_SWIFT
     dispatch_queue_t getDispatchQueue() const ICE_NOEXCEPT;
 #endif
@@ -62,6 +62,8 @@ getMessageTypeAsString(Byte type)
             return "close connection";
         case validateConnectionMsg:
             return "validate connection";
+        case creditMsg:
+            return "credit";
         default:
             return "unknown";
     }
@@ -361,6 +363,14 @@ printMessage(ostream& s, InputStream& stream)
         break;
     }
 
+    case creditMsg:
+    {
+        Int credit;
+        stream.read(credit);
+        s << "\ncredit = " << credit;
+        break;
+    }
+
     default:
     {
         break;
@@ -0,0 +1,900 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/TracingObserverI.h>
+#include <Ice/LocalException.h>
+#include <Ice/LoggerUtil.h>
+#include <Ice/Properties.h>
+#include <Ice/Proxy.h>
+#include <Ice/ObjectAdapter.h>
+#include <Ice/Endpoint.h>
+#include <IceUtil/FileUtil.h>
+#include <IceUtil/Random.h>
+#include <IceUtil/Time.h>
+
+#include <sstream>
+
+#ifndef _WIN32
+#   include <pthread.h>
+#endif
+
+using namespace std;
+using namespace Ice;
+using namespace Ice::Instrumentation;
+using namespace IceInternal;
+
+namespace
+{
+
+const char* const traceParentKey = "traceparent";
+
+//
+// Spans queued while the writer thread is busy are dropped past this
+// limit.
+//
+const size_t maxQueuedSpans = 10000;
+
+//
+// The trace context of the dispatch running in the calling thread.
+//
+#ifdef _WIN32
+DWORD currentSpanKey;
+#else
+pthread_key_t currentSpanKey;
+#endif
+
+class Init
+{
+public:
+
+    Init()
+    {
+#ifdef _WIN32
+        currentSpanKey = TlsAlloc();
+        if(currentSpanKey == TLS_OUT_OF_INDEXES)
+        {
+            throw IceUtil::ThreadSyscallException(__FILE__, __LINE__, GetLastError());
+        }
+#else
+        int err = pthread_key_create(&currentSpanKey, 0);
+        if(err != 0)
+        {
+            throw IceUtil::ThreadSyscallException(__FILE__, __LINE__, err);
+        }
+#endif
+    }
+
+    ~Init()
+    {
+#ifdef _WIN32
+        TlsFree(currentSpanKey);
+#else
+        pthread_key_delete(currentSpanKey);
+#endif
+    }
+};
+
+Init init;
+
+const SpanContext*
+getCurrentSpan()
+{
+#ifdef _WIN32
+    return static_cast<const SpanContext*>(TlsGetValue(currentSpanKey));
+#else
+    return static_cast<const SpanContext*>(pthread_getspecific(currentSpanKey));
+#endif
+}
+
+void
+setCurrentSpan(const SpanContext* context)
+{
+#ifdef _WIN32
+    TlsSetValue(currentSpanKey, const_cast<SpanContext*>(context));
+#else
+    pthread_setspecific(currentSpanKey, context);
+#endif
+}
+
+//
+// The MurmurHash3 finalizer, a bijection which spreads the bits of
+// the span counter.
+//
+unsigned int
+mix(unsigned int h)
+{
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+void
+appendHex(string& s, unsigned int v)
+{
+    static const char* hex = "0123456789abcdef";
+    for(int i = 28; i >= 0; i -= 4)
+    {
+        s += hex[(v >> i) & 0xF];
+    }
+}
+
+bool
+isHex(const string& s, size_t pos, size_t len)
+{
+    for(size_t i = pos; i < pos + len; ++i)
+    {
+        if(!((s[i] >= '0' && s[i] <= '9') || (s[i] >= 'a' && s[i] <= 'f')))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//
+// Parse a W3C traceparent value: version-traceid-parentid-flags.
+//
+bool
+parseTraceParent(const string& value, SpanContext& context)
+{
+    if(value.size() < 55 || value[2] != '-' || value[35] != '-' || value[52] != '-' ||
+       !isHex(value, 0, 2) || !isHex(value, 3, 32) || !isHex(value, 36, 16) || !isHex(value, 53, 2) ||
+       value.compare(0, 2, "ff") == 0 || (value.size() > 55 && value[55] != '-'))
+    {
+        return false;
+    }
+
+    context.traceId = value.substr(3, 32);
+    context.spanId = value.substr(36, 16);
+    if(context.traceId == string(32, '0') || context.spanId == string(16, '0'))
+    {
+        return false;
+    }
+
+    char flags = value[54];
+    context.sampled = ((flags >= 'a' ? flags - 'a' + 10 : flags - '0') & 0x1) != 0;
+    return true;
+}
+
+void
+writeJson(ostream& os, const string& value)
+{
+    os << '"';
+    for(string::const_iterator p = value.begin(); p != value.end(); ++p)
+    {
+        switch(*p)
+        {
+            case '"':
+            {
+                os << "\\\"";
+                break;
+            }
+            case '\\':
+            {
+                os << "\\\\";
+                break;
+            }
+            case '\n':
+            {
+                os << "\\n";
+                break;
+            }
+            case '\r':
+            {
+                os << "\\r";
+                break;
+            }
+            case '\t':
+            {
+                os << "\\t";
+                break;
+            }
+            default:
+            {
+                unsigned char c = static_cast<unsigned char>(*p);
+                if(c < 0x20)
+                {
+                    static const char* hex = "0123456789abcdef";
+                    os << "\\u00" << hex[c >> 4] << hex[c & 0xF];
+                }
+                else
+                {
+                    os << *p;
+                }
+                break;
+            }
+        }
+    }
+    os << '"';
+}
+
+}
+
+namespace IceInternal
+{
+
+class SpanWriter : public IceUtil::Thread, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    SpanWriter(const string& file, const LoggerPtr& logger) :
+        IceUtil::Thread("Ice.SpanWriter"),
+        _logger(logger),
+        _destroyed(false),
+        _dropped(0)
+    {
+        _out.open(IceUtilInternal::streamFilename(file).c_str(), fstream::out | fstream::app);
+        if(!_out.is_open())
+        {
+            throw InitializationException(__FILE__, __LINE__, "IceMX.Tracing: cannot open `" + file + "'");
+        }
+    }
+
+    void
+    add(const string& span)
+    {
+        Lock sync(*this);
+        if(_destroyed)
+        {
+            return;
+        }
+
+        if(_queue.size() >= maxQueuedSpans)
+        {
+            ++_dropped;
+            return;
+        }
+
+        _queue.push_back(span);
+        if(_queue.size() == 1)
+        {
+            notify();
+        }
+    }
+
+    void
+    destroy()
+    {
+        {
+            Lock sync(*this);
+            _destroyed = true;
+            notify();
+        }
+        getThreadControl().join();
+    }
+
+    virtual void
+    run()
+    {
+        while(true)
+        {
+            vector<string> spans;
+            size_t dropped;
+            bool destroyed;
+            {
+                Lock sync(*this);
+                while(_queue.empty() && !_destroyed)
+                {
+                    wait();
+                }
+                spans.swap(_queue);
+                dropped = _dropped;
+                _dropped = 0;
+                destroyed = _destroyed;
+            }
+
+            for(vector<string>::const_iterator p = spans.begin(); p != spans.end(); ++p)
+            {
+                _out << *p << '\n';
+            }
+            _out.flush();
+
+            if(dropped > 0)
+            {
+                Warning out(_logger);
+                out << "IceMX.Tracing: " << dropped << " span" << (dropped > 1 ? "s" : "")
+                    << " dropped, the span file is not written fast enough";
+            }
+
+            if(destroyed)
+            {
+                break;
+            }
+        }
+        _out.close();
+    }
+
+private:
+
+    const LoggerPtr _logger;
+    ofstream _out;
+    vector<string> _queue;
+    bool _destroyed;
+    size_t _dropped;
+};
+
+//
+// The state shared by the invocation and dispatch spans. Only sampled
+// spans record their events and attributes.
+//
+class TraceSpan : private IceUtil::noncopyable
+{
+public:
+
+    TraceSpan(const SpanWriterPtr& writer, const char* kind, const string& name, const SpanContext& context,
+              const string& parentSpanId) :
+        _writer(writer),
+        _kind(kind),
+        _name(name),
+        _context(context),
+        _parentSpanId(parentSpanId),
+        _start(IceUtil::Time::now().toMicroSeconds())
+    {
+    }
+
+    const SpanContext&
+    getContext() const
+    {
+        return _context;
+    }
+
+    void
+    start()
+    {
+        if(_context.sampled)
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            _start = IceUtil::Time::now().toMicroSeconds();
+        }
+    }
+
+    void
+    event(const char* name)
+    {
+        if(_context.sampled)
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            _events.push_back(make_pair(name, IceUtil::Time::now().toMicroSeconds()));
+        }
+    }
+
+    void
+    attribute(const char* name, const string& value)
+    {
+        if(_context.sampled)
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            _attributes << ",\"" << name << "\":";
+            writeJson(_attributes, value);
+        }
+    }
+
+    void
+    attribute(const char* name, Ice::Long value)
+    {
+        if(_context.sampled)
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            _attributes << ",\"" << name << "\":" << value;
+        }
+    }
+
+    void
+    error(const string& message)
+    {
+        if(_context.sampled)
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            _error = message;
+        }
+    }
+
+    void
+    finish()
+    {
+        if(!_context.sampled)
+        {
+            return;
+        }
+
+        Ice::Long end = IceUtil::Time::now().toMicroSeconds();
+        ostringstream os;
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            os << "{\"traceId\":\"" << _context.traceId << "\",\"spanId\":\"" << _context.spanId << "\"";
+            if(!_parentSpanId.empty())
+            {
+                os << ",\"parentSpanId\":\"" << _parentSpanId << "\"";
+            }
+            os << ",\"name\":";
+            writeJson(os, _name);
+            os << ",\"kind\":\"" << _kind << "\"";
+            os << ",\"startTimeUnixNano\":" << _start << "000,\"endTimeUnixNano\":" << end << "000";
+
+            string attributes = _attributes.str();
+            os << ",\"attributes\":{" << (attributes.empty() ? attributes : attributes.substr(1)) << "}";
+
+            os << ",\"events\":[";
+            for(vector<pair<const char*, Ice::Long> >::const_iterator p = _events.begin(); p != _events.end(); ++p)
+            {
+                if(p != _events.begin())
+                {
+                    os << ",";
+                }
+                os << "{\"name\":\"" << p->first << "\",\"timeUnixNano\":" << p->second << "000}";
+            }
+            os << "]";
+
+            if(_error.empty())
+            {
+                os << ",\"status\":{\"code\":\"OK\"}}";
+            }
+            else
+            {
+                os << ",\"status\":{\"code\":\"ERROR\",\"message\":";
+                writeJson(os, _error);
+                os << "}}";
+            }
+        }
+        _writer->add(os.str());
+    }
+
+private:
+
+    const SpanWriterPtr _writer;
+    const char* _kind;
+    const string _name;
+    const SpanContext _context;
+    const string _parentSpanId;
+
+    IceUtil::Mutex _mutex;
+    Ice::Long _start;
+    vector<pair<const char*, Ice::Long> > _events;
+    ostringstream _attributes;
+    string _error;
+};
+
+class InvocationSpan : public InvocationObserver, public TraceSpan
+#ifdef ICE_CPP11_MAPPING
+                     , public std::enable_shared_from_this<InvocationSpan>
+#endif
+{
+public:
+
+    InvocationSpan(const SpanWriterPtr& writer, const ObjectPrxPtr& proxy, const string& operation,
+                   const SpanContext& context, const string& parentSpanId, const InvocationObserverPtr& delegate) :
+        TraceSpan(writer, "CLIENT", operation, context, parentSpanId),
+        _proxy(proxy),
+        _delegate(delegate)
+    {
+    }
+
+    virtual void
+    attach()
+    {
+        start();
+        if(_delegate)
+        {
+            _delegate->attach();
+        }
+    }
+
+    virtual void
+    detach()
+    {
+        if(getContext().sampled && _proxy)
+        {
+            attribute("ice.proxy", _proxy->ice_toString());
+        }
+        finish();
+        if(_delegate)
+        {
+            _delegate->detach();
+        }
+    }
+
+    virtual void
+    failed(const string& exceptionName)
+    {
+        error(exceptionName);
+        if(_delegate)
+        {
+            _delegate->failed(exceptionName);
+        }
+    }
+
+    virtual void
+    retried()
+    {
+        event("retry");
+        if(_delegate)
+        {
+            _delegate->retried();
+        }
+    }
+
+    virtual void
+    userException()
+    {
+        error("user exception");
+        if(_delegate)
+        {
+            _delegate->userException();
+        }
+    }
+
+    virtual RemoteObserverPtr getRemoteObserver(const ConnectionInfoPtr&, const EndpointPtr&, Int, Int);
+    virtual CollocatedObserverPtr getCollocatedObserver(const ObjectAdapterPtr&, Int, Int);
+
+private:
+
+    const ObjectPrxPtr _proxy;
+    const InvocationObserverPtr _delegate;
+};
+ICE_DEFINE_PTR(InvocationSpanPtr, InvocationSpan);
+
+//
+// Records the sending of the request and the reception of the reply as
+// events of the invocation span.
+//
+template<typename O> class ChildSpanT : public O
+{
+public:
+
+    typedef typename ICE_INTERNAL_HANDLE<O> ObserverPtrType;
+
+    ChildSpanT(const InvocationSpanPtr& parent, const ObserverPtrType& delegate) :
+        _parent(parent),
+        _delegate(delegate)
+    {
+    }
+
+    virtual void
+    attach()
+    {
+        _parent->event("sent");
+        if(_delegate)
+        {
+            _delegate->attach();
+        }
+    }
+
+    virtual void
+    detach()
+    {
+        if(_delegate)
+        {
+            _delegate->detach();
+        }
+    }
+
+    virtual void
+    failed(const string& exceptionName)
+    {
+        if(_delegate)
+        {
+            _delegate->failed(exceptionName);
+        }
+    }
+
+    virtual void
+    reply(Int size)
+    {
+        _parent->event("reply");
+        _parent->attribute("ice.replySize", size);
+        if(_delegate)
+        {
+            _delegate->reply(size);
+        }
+    }
+
+private:
+
+    const InvocationSpanPtr _parent;
+    const ObserverPtrType _delegate;
+};
+
+RemoteObserverPtr
+InvocationSpan::getRemoteObserver(const ConnectionInfoPtr& connection, const EndpointPtr& endpoint, Int requestId,
+                                  Int size)
+{
+    RemoteObserverPtr delegate;
+    if(_delegate)
+    {
+        delegate = _delegate->getRemoteObserver(connection, endpoint, requestId, size);
+    }
+
+    if(!getContext().sampled)
+    {
+        return delegate;
+    }
+
+    if(endpoint)
+    {
+        attribute("ice.endpoint", endpoint->toString());
+    }
+    attribute("ice.requestSize", size);
+    return ICE_MAKE_SHARED(ChildSpanT<RemoteObserver>, ICE_SHARED_FROM_THIS, delegate);
+}
+
+CollocatedObserverPtr
+InvocationSpan::getCollocatedObserver(const ObjectAdapterPtr& adapter, Int requestId, Int size)
+{
+    CollocatedObserverPtr delegate;
+    if(_delegate)
+    {
+        delegate = _delegate->getCollocatedObserver(adapter, requestId, size);
+    }
+
+    if(!getContext().sampled)
+    {
+        return delegate;
+    }
+
+    if(adapter)
+    {
+        attribute("ice.collocated", adapter->getName());
+    }
+    attribute("ice.requestSize", size);
+    return ICE_MAKE_SHARED(ChildSpanT<CollocatedObserver>, ICE_SHARED_FROM_THIS, delegate);
+}
+
+class DispatchSpan : public DispatchObserver, public TraceSpan
+{
+public:
+
+    DispatchSpan(const SpanWriterPtr& writer, const Current& current, Int size, const SpanContext& context,
+                 const string& parentSpanId, const DispatchObserverPtr& delegate) :
+        TraceSpan(writer, "SERVER", current.operation, context, parentSpanId),
+        _delegate(delegate)
+    {
+        if(context.sampled)
+        {
+            attribute("ice.identity", identityToString(current.id));
+            if(!current.facet.empty())
+            {
+                attribute("ice.facet", current.facet);
+            }
+            if(current.adapter)
+            {
+                attribute("ice.adapter", current.adapter->getName());
+            }
+            attribute("ice.requestSize", size);
+        }
+    }
+
+    virtual void
+    attach()
+    {
+        start();
+        if(_delegate)
+        {
+            _delegate->attach();
+        }
+    }
+
+    virtual void
+    detach()
+    {
+        finish();
+        if(_delegate)
+        {
+            _delegate->detach();
+        }
+    }
+
+    virtual void
+    failed(const string& exceptionName)
+    {
+        error(exceptionName);
+        if(_delegate)
+        {
+            _delegate->failed(exceptionName);
+        }
+    }
+
+    virtual void
+    userException()
+    {
+        error("user exception");
+        if(_delegate)
+        {
+            _delegate->userException();
+        }
+    }
+
+    virtual void
+    reply(Int size)
+    {
+        event("reply");
+        attribute("ice.replySize", size);
+        if(_delegate)
+        {
+            _delegate->reply(size);
+        }
+    }
+
+private:
+
+    const DispatchObserverPtr _delegate;
+};
+
+}
+
+IceInternal::TracingObserverI::TracingObserverI(const InitializationData& initData) :
+    _delegate(initData.observer),
+    _sampling(initData.properties->getPropertyAsIntWithDefault("IceMX.Tracing.Sampling", 1)),
+    _ids(0),
+    _traces(0)
+{
+    IceUtilInternal::generateRandom(reinterpret_cast<char*>(_seed), sizeof(_seed));
+
+    _writer = new SpanWriter(initData.properties->getProperty("IceMX.Tracing.File"), initData.logger);
+    _writer->start();
+}
+
+void
+IceInternal::TracingObserverI::setObserverUpdater(const ObserverUpdaterPtr& updater)
+{
+    if(_delegate)
+    {
+        _delegate->setObserverUpdater(updater);
+    }
+}
+
+ObserverPtr
+IceInternal::TracingObserverI::getConnectionEstablishmentObserver(const EndpointPtr& endpt, const string& connector)
+{
+    return _delegate ? _delegate->getConnectionEstablishmentObserver(endpt, connector) : ICE_NULLPTR;
+}
+
+ObserverPtr
+IceInternal::TracingObserverI::getEndpointLookupObserver(const EndpointPtr& endpt)
+{
+    return _delegate ? _delegate->getEndpointLookupObserver(endpt) : ICE_NULLPTR;
+}
+
+ConnectionObserverPtr
+IceInternal::TracingObserverI::getConnectionObserver(const ConnectionInfoPtr& con,
+                                                     const EndpointPtr& endpt,
+                                                     ConnectionState state,
+                                                     const ConnectionObserverPtr& observer)
+{
+    return _delegate ? _delegate->getConnectionObserver(con, endpt, state, observer) : ICE_NULLPTR;
+}
+
+ThreadObserverPtr
+IceInternal::TracingObserverI::getThreadObserver(const string& parent,
+                                                 const string& id,
+                                                 ThreadState state,
+                                                 const ThreadObserverPtr& observer)
+{
+    return _delegate ? _delegate->getThreadObserver(parent, id, state, observer) : ICE_NULLPTR;
+}
+
+InvocationObserverPtr
+IceInternal::TracingObserverI::getInvocationObserver(const ObjectPrxPtr& proxy, const string& op, const Context& ctx)
+{
+    InvocationObserverPtr delegate;
+    if(_delegate)
+    {
+        delegate = _delegate->getInvocationObserver(proxy, op, ctx);
+    }
+
+    //
+    // The parent is the dispatch running in this thread if any. Otherwise,
+    // it's the trace context of the explicit request context, which is
+    // for example forwarded by Glacier2.
+    //
+    const SpanContext* parent = getCurrentSpan();
+    SpanContext remote;
+    if(!parent)
+    {
+        Context::const_iterator p = ctx.find(traceParentKey);
+        if(p != ctx.end() && parseTraceParent(p->second, remote))
+        {
+            parent = &remote;
+        }
+    }
+
+    SpanContext context;
+    newSpan(context, parent);
+    return ICE_MAKE_SHARED(InvocationSpan, _writer, proxy, op, context, parent ? parent->spanId : string(), delegate);
+}
+
+DispatchObserverPtr
+IceInternal::TracingObserverI::getDispatchObserver(const Current& current, Int size)
+{
+    DispatchObserverPtr delegate;
+    if(_delegate)
+    {
+        delegate = _delegate->getDispatchObserver(current, size);
+    }
+
+    const SpanContext* parent = 0;
+    SpanContext remote;
+    Context::const_iterator p = current.ctx.find(traceParentKey);
+    if(p != current.ctx.end() && parseTraceParent(p->second, remote))
+    {
+        parent = &remote;
+    }
+
+    SpanContext context;
+    newSpan(context, parent);
+    return ICE_MAKE_SHARED(DispatchSpan, _writer, current, size, context, parent ? parent->spanId : string(), delegate);
+}
+
+void
+IceInternal::TracingObserverI::destroy()
+{
+    _writer->destroy();
+}
+
+string
+IceInternal::TracingObserverI::getTraceParent(const InvocationObserverPtr& observer)
+{
+    InvocationSpan* span = dynamic_cast<InvocationSpan*>(observer.get());
+    if(!span)
+    {
+        return string();
+    }
+
+    const SpanContext& context = span->getContext();
+    return "00-" + context.traceId + "-" + context.spanId + (context.sampled ? "-01" : "-00");
+}
+
+void
+IceInternal::TracingObserverI::newSpan(SpanContext& context, const SpanContext* parent)
+{
+    unsigned int id = static_cast<unsigned int>(_ids.fetch_add(1));
+    if(parent)
+    {
+        context.traceId = parent->traceId;
+        context.sampled = parent->sampled;
+    }
+    else
+    {
+        //
+        // Start a new trace, the sampling decision is made here and
+        // propagated to all the spans of the trace.
+        //
+        unsigned int now = static_cast<unsigned int>(IceUtil::Time::now().toSeconds());
+        context.traceId.reserve(32);
+        appendHex(context.traceId, mix(_seed[2] ^ now));
+        appendHex(context.traceId, mix(_seed[3] ^ id));
+        appendHex(context.traceId, mix(_seed[0] + id));
+        appendHex(context.traceId, mix(_seed[1] ^ ~id));
+        unsigned int trace = static_cast<unsigned int>(_traces.fetch_add(1));
+        context.sampled = _sampling > 0 && trace % static_cast<unsigned int>(_sampling) == 0;
+    }
+
+    context.spanId.reserve(16);
+    appendHex(context.spanId, mix(_seed[0] ^ id));
+    appendHex(context.spanId, mix(_seed[1] + id));
+}
+
+IceInternal::TraceScope::TraceScope(const DispatchObserverPtr& observer) :
+    _observer(observer),
+    _span(dynamic_cast<DispatchSpan*>(observer.get())),
+    _previous(0)
+{
+    if(_span)
+    {
+        _span->event("servant.start");
+        _previous = getCurrentSpan();
+        setCurrentSpan(&_span->getContext());
+    }
+}
+
+IceInternal::TraceScope::~TraceScope()
+{
+    if(_span)
+    {
+        setCurrentSpan(_previous);
+        _span->event("servant.end");
+    }
+}
@@ -0,0 +1,135 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_TRACING_OBSERVER_I_H
+#define ICE_TRACING_OBSERVER_I_H
+
+#include <IceUtil/Thread.h>
+#include <IceUtil/Monitor.h>
+#include <IceUtil/Atomic.h>
+#include <Ice/Instrumentation.h>
+#include <Ice/Initialize.h>
+#include <Ice/ObserverHelper.h>
+
+#include <fstream>
+
+namespace IceInternal
+{
+
+//
+// The trace context of a span. It's propagated to the target of
+// invocations with the "traceparent" request context entry, using the
+// W3C trace context format.
+//
+struct SpanContext
+{
+    std::string traceId;
+    std::string spanId;
+    bool sampled;
+};
+
+class SpanWriter;
+typedef IceUtil::Handle<SpanWriter> SpanWriterPtr;
+
+class DispatchSpan;
+
+//
+// A communicator observer which records a span for each invocation and
+// dispatch, enabled with IceMX.Tracing.File. The invocations made by a
+// servant from the dispatch thread are children of the dispatch span
+// and a dispatch is a child of the invocation which sent the request.
+//
+// Sampling is decided when a trace starts, one out of every
+// IceMX.Tracing.Sampling traces is recorded. The decision is
+// propagated with the trace context so all the spans of a trace are
+// either recorded or not.
+//
+// Spans are written to the file by a background thread, one JSON
+// object per line, using the OpenTelemetry span field names.
+//
+class TracingObserverI : public Ice::Instrumentation::CommunicatorObserver
+{
+public:
+
+    TracingObserverI(const Ice::InitializationData&);
+
+    virtual void setObserverUpdater(const Ice::Instrumentation::ObserverUpdaterPtr&);
+
+    virtual Ice::Instrumentation::ObserverPtr getConnectionEstablishmentObserver(const Ice::EndpointPtr&,
+                                                                                 const std::string&);
+
+    virtual Ice::Instrumentation::ObserverPtr getEndpointLookupObserver(const Ice::EndpointPtr&);
+
+    virtual Ice::Instrumentation::ConnectionObserverPtr
+    getConnectionObserver(const Ice::ConnectionInfoPtr&,
+                          const Ice::EndpointPtr&,
+                          Ice::Instrumentation::ConnectionState,
+                          const Ice::Instrumentation::ConnectionObserverPtr&);
+
+    virtual Ice::Instrumentation::ThreadObserverPtr getThreadObserver(const std::string&, const std::string&,
+                                                                      Ice::Instrumentation::ThreadState,
+                                                                      const Ice::Instrumentation::ThreadObserverPtr&);
+
+    virtual Ice::Instrumentation::InvocationObserverPtr getInvocationObserver(const Ice::ObjectPrxPtr&,
+                                                                              const std::string&,
+                                                                              const Ice::Context&);
+
+    virtual Ice::Instrumentation::DispatchObserverPtr getDispatchObserver(const Ice::Current&, Ice::Int);
+
+    //
+    // Write the remaining spans and close the span file.
+    //
+    void destroy();
+
+    //
+    // Return the observer this observer forwards to, the metrics observer
+    // or the application observer if any.
+    //
+    const Ice::Instrumentation::CommunicatorObserverPtr& getDelegate() const
+    {
+        return _delegate;
+    }
+
+    //
+    // Return the trace context to propagate with the request of the given
+    // invocation, or an empty string if the invocation isn't traced.
+    //
+    static std::string getTraceParent(const Ice::Instrumentation::InvocationObserverPtr&);
+
+private:
+
+    void newSpan(SpanContext&, const SpanContext*);
+
+    const Ice::Instrumentation::CommunicatorObserverPtr _delegate;
+    const int _sampling;
+    SpanWriterPtr _writer;
+
+    unsigned int _seed[4];
+    IceUtilInternal::Atomic _ids;
+    IceUtilInternal::Atomic _traces;
+};
+ICE_DEFINE_PTR(TracingObserverIPtr, TracingObserverI);
+
+//
+// Makes the trace context of a dispatch the parent of the invocations
+// made by the servant from the dispatch thread, for the lifetime of
+// the scope.
+//
+class TraceScope : private IceUtil::noncopyable
+{
+public:
+
+    TraceScope(const Ice::Instrumentation::DispatchObserverPtr&);
+    ~TraceScope();
+
+private:
+
+    const Ice::Instrumentation::DispatchObserverPtr _observer;
+    DispatchSpan* _span;
+    const SpanContext* _previous;
+};
+
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include <Ice/ProtocolInstance.h>
 #include <Ice/HttpParser.h>
 #include <Ice/Communicator.h>
+#include <Ice/Properties.h>
 #include <Ice/LoggerUtil.h>
 #include <Ice/Buffer.h>
 #include <Ice/LocalException.h>
@@ -25,6 +26,15 @@ typedef unsigned short uint16_t;
 
 #include <climits>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define ICE_WS_SSE2_MASK
+#endif
+
+#ifdef ICE_HAS_ZLIB
+#   include <zlib.h>
+#endif
+
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
@@ -49,6 +59,7 @@ using namespace IceInternal;
 #define OP_RES_0xE  0xE     // Reserved
 #define OP_RES_0xF  0xF     // Reserved
 #define FLAG_FINAL  0x80    // Last frame
+#define FLAG_RSV1   0x40    // Compressed message (permessage-deflate)
 #define FLAG_MASKED 0x80    // Payload is masked
 
 #define CLOSURE_NORMAL         1000
@@ -61,6 +72,136 @@ namespace
 
 const string _iceProtocol = "ice.zeroc.com";
 const string _wsUUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+const string _deflateExtension = "permessage-deflate";
+
+//
+// Messages smaller than this size are never compressed.
+//
+const size_t _deflateMinSize = 100;
+
+//
+// Apply the 32-bit masking key to sz bytes of payload. The offset is the
+// position of the first byte in the frame payload, it determines which byte
+// of the key is used first. The source and destination can be the same to
+// unmask in place.
+//
+// The payload is masked 16 bytes at a time with SSE2 when available and 8
+// bytes at a time otherwise, with the key replicated to the block size.
+// memcpy is used for the word loads and stores since neither buffer is
+// guaranteed to be aligned.
+//
+void
+applyMask(Byte* dest, const Byte* src, size_t sz, const unsigned char* mask, size_t offset)
+{
+    Byte key[16];
+    for(size_t n = 0; n < sizeof(key); ++n)
+    {
+        key[n] = mask[(offset + n) % 4];
+    }
+
+#ifdef ICE_WS_SSE2_MASK
+    const __m128i key128 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+    for(; sz >= sizeof(key); sz -= sizeof(key), src += sizeof(key), dest += sizeof(key))
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), _mm_xor_si128(v, key128));
+    }
+#endif
+
+    Long key64;
+    memcpy(&key64, key, sizeof(key64));
+    for(; sz >= sizeof(key64); sz -= sizeof(key64), src += sizeof(key64), dest += sizeof(key64))
+    {
+        Long v;
+        memcpy(&v, src, sizeof(v));
+        v ^= key64;
+        memcpy(dest, &v, sizeof(v));
+    }
+
+    //
+    // The blocks above are a multiple of the key size so the remaining
+    // bytes still start with the first byte of the rotated key.
+    //
+    for(size_t n = 0; n < sz; ++n)
+    {
+        dest[n] = src[n] ^ key[n];
+    }
+}
+
+bool
+perMessageDeflateEnabled(ICE_MAYBE_UNUSED const ProtocolInstancePtr& instance)
+{
+#ifdef ICE_HAS_ZLIB
+    return instance->properties()->getPropertyAsIntWithDefault("Ice.WS.PerMessageDeflate", 0) > 0;
+#else
+    return false;
+#endif
+}
+
+//
+// Parse a permessage-deflate element of the Sec-WebSocket-Extensions header
+// field. Returns false if the element is for another extension, throws if
+// the element is malformed.
+//
+bool
+parseDeflateParams(const string& extension, map<string, string>& params)
+{
+    vector<string> tokens;
+    if(!IceUtilInternal::splitString(extension, ";", tokens) || tokens.empty())
+    {
+        throw WebSocketException("invalid value `" + extension + "' for WebSocket extension");
+    }
+
+    if(IceUtilInternal::toLower(IceUtilInternal::trim(tokens[0])) != _deflateExtension)
+    {
+        return false;
+    }
+
+    for(vector<string>::const_iterator p = tokens.begin() + 1; p != tokens.end(); ++p)
+    {
+        string name = *p;
+        string value;
+        string::size_type pos = name.find('=');
+        if(pos != string::npos)
+        {
+            value = IceUtilInternal::trim(name.substr(pos + 1));
+            name = name.substr(0, pos);
+            if(value.size() >= 2 && value[0] == '"' && value[value.size() - 1] == '"')
+            {
+                value = value.substr(1, value.size() - 2);
+            }
+        }
+        name = IceUtilInternal::toLower(IceUtilInternal::trim(name));
+        if(params.find(name) != params.end())
+        {
+            throw WebSocketException("duplicate parameter `" + name + "' for WebSocket extension");
+        }
+        params[name] = value;
+    }
+    return true;
+}
+
+//
+// Returns the value of a *_max_window_bits parameter or -1 if it's invalid.
+//
+int
+parseWindowBits(const string& value)
+{
+    int bits = 0;
+    if(value.empty() || value.size() > 2)
+    {
+        return -1;
+    }
+    for(string::const_iterator p = value.begin(); p != value.end(); ++p)
+    {
+        if(!IceUtilInternal::isDigit(*p))
+        {
+            return -1;
+        }
+        bits = bits * 10 + (*p - '0');
+    }
+    return bits >= 8 && bits <= 15 ? bits : -1;
+}
 
 //
 // Rename to avoid conflict with OS 10.10 htonll
@@ -229,8 +370,21 @@ IceInternal::WSTransceiver::initialize(Buffer& readBuffer, Buffer& writeBuffer)
                     << "Upgrade: websocket\r\n"
                     << "Connection: Upgrade\r\n"
                     << "Sec-WebSocket-Protocol: " << _iceProtocol << "\r\n"
-                    << "Sec-WebSocket-Version: 13\r\n"
-                    << "Sec-WebSocket-Key: ";
+                    << "Sec-WebSocket-Version: 13\r\n";
+
+                //
+                // Offer the permessage-deflate extension. We don't keep the
+                // compression context across messages in either direction,
+                // which bounds the per-connection memory once the message is
+                // sent or received.
+                //
+                if(_deflateEnabled)
+                {
+                    out << "Sec-WebSocket-Extensions: " << _deflateExtension
+                        << "; client_no_context_takeover; server_no_context_takeover\r\n";
+                }
+
+                out << "Sec-WebSocket-Key: ";
 
                 //
                 // The value for Sec-WebSocket-Key is a 16-byte random number,
@@ -373,7 +527,7 @@ IceInternal::WSTransceiver::initialize(Buffer& readBuffer, Buffer& writeBuffer)
         _state = StateOpened;
         _nextState = StateOpened;
 
-        if(_readI < _readBuffer.i)
+        if(hasBufferedRead())
         {
             _delegate->getNativeInfo()->ready(SocketOperationRead, true);
         }
@@ -483,6 +637,10 @@ IceInternal::WSTransceiver::close()
     {
         _readBuffer.b.clear();
     }
+    if(!_writePending)
+    {
+        _deflateBuffer.b.clear();
+    }
 }
 
 SocketOperation
@@ -519,7 +677,7 @@ IceInternal::WSTransceiver::write(Buffer& buf)
             }
             else if(_incoming && !buf.b.empty() && _writeState == WriteStatePayload)
             {
-                SocketOperation s = _delegate->write(buf);
+                SocketOperation s = _delegate->write(_writeDeflated ? _deflateBuffer : buf);
                 if(s)
                 {
                     return s;
@@ -569,7 +727,7 @@ IceInternal::WSTransceiver::read(Buffer& buf)
     //
     if(buf.i == buf.b.end())
     {
-        if(_readI < _readBuffer.i)
+        if(hasBufferedRead())
         {
             _delegate->getNativeInfo()->ready(SocketOperationRead, true);
         }
@@ -617,7 +775,7 @@ IceInternal::WSTransceiver::read(Buffer& buf)
 
     if(buf.i == buf.b.end())
     {
-        if(_readI < _readBuffer.i)
+        if(hasBufferedRead())
         {
             _delegate->getNativeInfo()->ready(SocketOperationRead, true);
         }
@@ -660,18 +818,19 @@ IceInternal::WSTransceiver::startWrite(Buffer& buf)
 
     if(preWrite(buf))
     {
+        Buffer& payload = _writeDeflated ? _deflateBuffer : buf;
         if(_writeBuffer.i < _writeBuffer.b.end())
         {
             if(_delegate->startWrite(_writeBuffer))
             {
-                return buf.b.size() == _writePayloadLength; // Return true only if we've written the whole buffer.
+                return payload.b.size() == _writePayloadLength; // Return true only if we've written the whole buffer.
             }
             return false;
         }
         else
         {
             assert(_incoming);
-            return _delegate->startWrite(buf);
+            return _delegate->startWrite(payload);
         }
     }
     else
@@ -699,14 +858,15 @@ IceInternal::WSTransceiver::finishWrite(Buffer& buf)
         return;
     }
 
+    Buffer& payload = _writeDeflated ? _deflateBuffer : buf;
     if(_writeBuffer.i < _writeBuffer.b.end())
     {
         _delegate->finishWrite(_writeBuffer);
     }
-    else if(!buf.b.empty() && buf.i != buf.b.end())
+    else if(!payload.b.empty() && payload.i != payload.b.end())
     {
         assert(_incoming);
-        _delegate->finishWrite(buf);
+        _delegate->finishWrite(payload);
     }
 
     if(_state == StateClosed)
@@ -862,12 +1022,22 @@ IceInternal::WSTransceiver::WSTransceiver(const ProtocolInstancePtr& instance, c
     _readOpCode(0),
     _readHeaderLength(0),
     _readPayloadLength(0),
+    _readDeflated(false),
+    _readFrameOffset(0),
+    _readUnmasked(0),
     _writeState(WriteStateHeader),
     _writeBufferSize(16 * 1024),
+    _writeDeflated(false),
     _readPending(false),
     _writePending(false),
     _closingInitiator(false),
-    _closingReason(CLOSURE_NORMAL)
+    _closingReason(CLOSURE_NORMAL),
+    _deflateEnabled(perMessageDeflateEnabled(instance)),
+    _deflateNegotiated(false)
+#ifdef ICE_HAS_ZLIB
+    , _deflateStream(0),
+    _inflateStream(0)
+#endif
 {
     //
     // Use 1KB read and 16KB write buffer sizes. We use 16KB for the
@@ -890,12 +1060,22 @@ IceInternal::WSTransceiver::WSTransceiver(const ProtocolInstancePtr& instance, c
     _readOpCode(0),
     _readHeaderLength(0),
     _readPayloadLength(0),
+    _readDeflated(false),
+    _readFrameOffset(0),
+    _readUnmasked(0),
     _writeState(WriteStateHeader),
     _writeBufferSize(1024),
+    _writeDeflated(false),
     _readPending(false),
     _writePending(false),
     _closingInitiator(false),
-    _closingReason(CLOSURE_NORMAL)
+    _closingReason(CLOSURE_NORMAL),
+    _deflateEnabled(perMessageDeflateEnabled(instance)),
+    _deflateNegotiated(false)
+#ifdef ICE_HAS_ZLIB
+    , _deflateStream(0),
+    _inflateStream(0)
+#endif
 {
     //
     // Use 1KB read and write buffer sizes.
@@ -904,6 +1084,18 @@ IceInternal::WSTransceiver::WSTransceiver(const ProtocolInstancePtr& instance, c
 
 IceInternal::WSTransceiver::~WSTransceiver()
 {
+#ifdef ICE_HAS_ZLIB
+    if(_deflateStream)
+    {
+        deflateEnd(_deflateStream);
+        delete _deflateStream;
+    }
+    if(_inflateStream)
+    {
+        inflateEnd(_inflateStream);
+        delete _inflateStream;
+    }
+#endif
 }
 
 void
@@ -996,6 +1188,20 @@ IceInternal::WSTransceiver::handleRequest(Buffer& responseBuffer)
         throw WebSocketException("invalid value `" + key + "' for WebSocket key");
     }
 
+    //
+    // "Optionally, a |Sec-WebSocket-Extensions| header field, with a
+    //  list of values indicating which extensions the client would like
+    //  to speak."
+    //
+    // permessage-deflate is the only extension we support, other offers
+    // are ignored.
+    //
+    string extensions;
+    if(_deflateEnabled && _parser->getHeader("Sec-WebSocket-Extensions", val, false))
+    {
+        extensions = acceptDeflateOffer(val);
+    }
+
     //
     // Retain the target resource.
     //
@@ -1012,6 +1218,10 @@ IceInternal::WSTransceiver::handleRequest(Buffer& responseBuffer)
     {
         out << "Sec-WebSocket-Protocol: " << _iceProtocol << "\r\n";
     }
+    if(!extensions.empty())
+    {
+        out << "Sec-WebSocket-Extensions: " << extensions << "\r\n";
+    }
 
     //
     // The response includes:
@@ -1129,6 +1339,260 @@ IceInternal::WSTransceiver::handleResponse()
     {
         throw WebSocketException("invalid value `" + val + "' for Sec-WebSocket-Accept");
     }
+
+    //
+    // "If the response includes a |Sec-WebSocket-Extensions| header
+    //  field and this header field indicates the use of an extension
+    //  that was not present in the client's handshake (the server has
+    //  indicated an extension not requested by the client), the client
+    //  MUST _Fail the WebSocket Connection_."
+    //
+    if(_parser->getHeader("Sec-WebSocket-Extensions", val, false))
+    {
+        checkDeflateResponse(val);
+    }
+}
+
+string
+IceInternal::WSTransceiver::acceptDeflateOffer(const string& offers)
+{
+    vector<string> elements;
+    if(!IceUtilInternal::splitString(offers, ",", elements))
+    {
+        throw WebSocketException("invalid value `" + offers + "' for WebSocket extensions");
+    }
+
+    //
+    // Accept the first permessage-deflate offer with parameters we can
+    // honor, offers are ordered by preference.
+    //
+    for(vector<string>::const_iterator p = elements.begin(); p != elements.end(); ++p)
+    {
+        map<string, string> params;
+        if(!parseDeflateParams(*p, params))
+        {
+            continue;
+        }
+
+        int windowBits = 15;
+        bool accept = true;
+        for(map<string, string>::const_iterator q = params.begin(); q != params.end() && accept; ++q)
+        {
+            if(q->first == "server_max_window_bits")
+            {
+                //
+                // zlib doesn't support a window of 256 bytes for raw deflate streams.
+                //
+                windowBits = parseWindowBits(q->second);
+                accept = windowBits > 8;
+            }
+            else if(q->first == "client_max_window_bits")
+            {
+                //
+                // Optional value, we always inflate with the largest window.
+                //
+                accept = q->second.empty() || parseWindowBits(q->second) > 0;
+            }
+            else if(q->first != "server_no_context_takeover" && q->first != "client_no_context_takeover")
+            {
+                accept = false;
+            }
+        }
+
+        if(accept)
+        {
+            initDeflate(windowBits);
+
+            ostringstream os;
+            os << _deflateExtension << "; server_no_context_takeover; client_no_context_takeover";
+            if(params.find("server_max_window_bits") != params.end())
+            {
+                os << "; server_max_window_bits=" << windowBits;
+            }
+            return os.str();
+        }
+    }
+    return "";
+}
+
+void
+IceInternal::WSTransceiver::checkDeflateResponse(const string& response)
+{
+    map<string, string> params;
+    if(!_deflateEnabled || !parseDeflateParams(response, params))
+    {
+        throw WebSocketException("unexpected value `" + response + "' for WebSocket extensions");
+    }
+
+    int windowBits = 15;
+    for(map<string, string>::const_iterator p = params.begin(); p != params.end(); ++p)
+    {
+        if(p->first == "client_max_window_bits")
+        {
+            windowBits = parseWindowBits(p->second);
+            if(windowBits <= 8)
+            {
+                throw WebSocketException("unsupported value `" + p->second + "' for client_max_window_bits");
+            }
+        }
+        else if(p->first == "server_max_window_bits")
+        {
+            if(parseWindowBits(p->second) < 0)
+            {
+                throw WebSocketException("invalid value `" + p->second + "' for server_max_window_bits");
+            }
+        }
+        else if(p->first != "server_no_context_takeover" && p->first != "client_no_context_takeover")
+        {
+            throw WebSocketException("unexpected parameter `" + p->first + "' for WebSocket extension");
+        }
+    }
+    initDeflate(windowBits);
+}
+
+void
+IceInternal::WSTransceiver::initDeflate(ICE_MAYBE_UNUSED int windowBits)
+{
+#ifdef ICE_HAS_ZLIB
+    assert(!_deflateStream && !_inflateStream);
+
+    int level = _instance->properties()->getPropertyAsIntWithDefault("Ice.Compression.Level", 1);
+    if(level < 1)
+    {
+        level = 1;
+    }
+    else if(level > 9)
+    {
+        level = 9;
+    }
+
+    //
+    // Negative window bits select raw deflate streams without zlib header.
+    //
+    _deflateStream = new z_stream;
+    memset(_deflateStream, 0, sizeof(z_stream));
+    if(deflateInit2(_deflateStream, level, Z_DEFLATED, -windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        delete _deflateStream;
+        _deflateStream = 0;
+        throw WebSocketException("unable to initialize permessage-deflate compression");
+    }
+
+    _inflateStream = new z_stream;
+    memset(_inflateStream, 0, sizeof(z_stream));
+    if(inflateInit2(_inflateStream, -15) != Z_OK)
+    {
+        delete _inflateStream;
+        _inflateStream = 0;
+        throw WebSocketException("unable to initialize permessage-deflate decompression");
+    }
+
+    _deflateNegotiated = true;
+#else
+    assert(false); // permessage-deflate is never offered or accepted without zlib.
+#endif
+}
+
+bool
+IceInternal::WSTransceiver::deflateMessage(ICE_MAYBE_UNUSED const Buffer& buf)
+{
+#ifdef ICE_HAS_ZLIB
+    if(buf.b.size() < _deflateMinSize)
+    {
+        return false;
+    }
+
+    //
+    // No context takeover, each message is compressed independently.
+    //
+    deflateReset(_deflateStream);
+    _deflateStream->next_in = const_cast<Bytef*>(buf.b.begin());
+    _deflateStream->avail_in = static_cast<uInt>(buf.b.size());
+
+    _deflateBuffer.b.resize(static_cast<size_t>(deflateBound(_deflateStream, static_cast<uLong>(buf.b.size()))) + 16);
+    _deflateStream->next_out = _deflateBuffer.b.begin();
+    _deflateStream->avail_out = static_cast<uInt>(_deflateBuffer.b.size());
+
+    //
+    // The sync flush appends an empty stored block, 0x00 0x00 0xff 0xff,
+    // which RFC 7692 requires to remove from the payload.
+    //
+    int rc = deflate(_deflateStream, Z_SYNC_FLUSH);
+    while(rc == Z_OK && _deflateStream->avail_out == 0)
+    {
+        size_t pos = _deflateBuffer.b.size();
+        _deflateBuffer.b.resize(pos + 1024);
+        _deflateStream->next_out = _deflateBuffer.b.begin() + pos;
+        _deflateStream->avail_out = 1024;
+        rc = deflate(_deflateStream, Z_SYNC_FLUSH);
+    }
+
+    size_t sz = static_cast<size_t>(_deflateStream->total_out);
+    if(rc != Z_OK || sz < 4 || sz - 4 >= buf.b.size())
+    {
+        //
+        // Send the message uncompressed if compression failed or didn't
+        // reduce its size.
+        //
+        return false;
+    }
+
+    _deflateBuffer.b.resize(sz - 4);
+    _deflateBuffer.i = _deflateBuffer.b.begin();
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool
+IceInternal::WSTransceiver::inflatePayload(ICE_MAYBE_UNUSED Buffer& buf)
+{
+#ifdef ICE_HAS_ZLIB
+    //
+    // Unmask the buffered payload bytes that haven't been unmasked yet,
+    // _readUnmasked bytes following _readI are already unmasked.
+    //
+    size_t available = min(static_cast<size_t>(_readBuffer.i - _readI), _readPayloadLength);
+    if(_incoming && _readUnmasked < available)
+    {
+        applyMask(_readI + _readUnmasked, _readI + _readUnmasked, available - _readUnmasked, _readMask,
+                  _readFrameOffset + _readUnmasked);
+        _readUnmasked = available;
+    }
+
+    _inflateStream->next_in = _readI;
+    _inflateStream->avail_in = static_cast<uInt>(available);
+    _inflateStream->next_out = buf.i;
+    _inflateStream->avail_out = static_cast<uInt>(buf.b.end() - buf.i);
+
+    //
+    // Z_BUF_ERROR only indicates that no progress was possible.
+    //
+    int rc = inflate(_inflateStream, Z_SYNC_FLUSH);
+    if(rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR)
+    {
+        throw ProtocolException(__FILE__, __LINE__, "invalid compressed WebSocket payload");
+    }
+    else if(rc == Z_STREAM_END)
+    {
+        //
+        // The peer ended the message with a final deflate block.
+        //
+        inflateReset(_inflateStream);
+    }
+
+    size_t consumed = available - static_cast<size_t>(_inflateStream->avail_in);
+    buf.i = _inflateStream->next_out;
+    _readI += consumed;
+    _readUnmasked -= consumed;
+    _readFrameOffset += consumed;
+    _readPayloadLength -= consumed;
+    return buf.i < buf.b.end();
+#else
+    assert(false); // permessage-deflate is never negotiated without zlib.
+    return false;
+#endif
 }
 
 bool
@@ -1166,6 +1630,16 @@ IceInternal::WSTransceiver::preRead(Buffer& buf)
                     throw ProtocolException(__FILE__, __LINE__, "invalid data frame, no FIN on previous frame");
                 }
                 _readLastFrame = (ch & FLAG_FINAL) == FLAG_FINAL;
+
+                //
+                // The RSV1 bit is set on the first frame of a message compressed
+                // with the permessage-deflate extension.
+                //
+                _readDeflated = (ch & FLAG_RSV1) == FLAG_RSV1;
+                if(_readDeflated && !_deflateNegotiated)
+                {
+                    throw ProtocolException(__FILE__, __LINE__, "invalid data frame, RSV1 set without extension");
+                }
             }
             else if(_readOpCode == OP_CONT)
             {
@@ -1173,6 +1647,10 @@ IceInternal::WSTransceiver::preRead(Buffer& buf)
                 {
                     throw ProtocolException(__FILE__, __LINE__, "invalid continuation frame, previous frame FIN set");
                 }
+                else if((ch & FLAG_RSV1) == FLAG_RSV1)
+                {
+                    throw ProtocolException(__FILE__, __LINE__, "invalid continuation frame, RSV1 set");
+                }
                 _readLastFrame = (ch & FLAG_FINAL) == FLAG_FINAL;
             }
 
@@ -1276,9 +1754,11 @@ IceInternal::WSTransceiver::preRead(Buffer& buf)
                 {
                     throw ProtocolException(__FILE__, __LINE__, "payload length is 0");
                 }
-                _readState = ReadStatePayload;
+                _readState = _readDeflated ? ReadStateDeflatedPayload : ReadStatePayload;
                 assert(buf.i != buf.b.end());
                 _readFrameStart = buf.i;
+                _readFrameOffset = 0;
+                _readUnmasked = 0;
                 break;
             }
             case OP_CLOSE: // Connection close
@@ -1412,6 +1892,63 @@ IceInternal::WSTransceiver::preRead(Buffer& buf)
             //
             return buf.i < buf.b.end() && n < _readPayloadLength;
         }
+
+        if(_readState == ReadStateDeflatedPayload)
+        {
+            //
+            // The compressed payload is read in the internal buffer and inflated
+            // in the message buffer, how much of the message buffer the payload
+            // fills is only known once it's inflated. Make room for reading
+            // more of the payload first.
+            //
+            if(_readI == _readBuffer.i)
+            {
+                _readBuffer.b.resize(_readBufferSize);
+                _readI = _readBuffer.i = _readBuffer.b.begin();
+            }
+            else if(_readBuffer.i == _readBuffer.b.end() && _readI != _readBuffer.b.begin())
+            {
+                size_t available = static_cast<size_t>(_readBuffer.i - _readI);
+                memmove(&_readBuffer.b[0], _readI, available);
+                _readI = _readBuffer.b.begin();
+                _readBuffer.i = _readI + available;
+            }
+            _readStart = _readBuffer.i;
+
+            if(buf.b.empty() || buf.i == buf.b.end())
+            {
+                return false;
+            }
+
+            if(!inflatePayload(buf))
+            {
+                //
+                // The message buffer is full, the inflater might still hold
+                // inflated data for the next message.
+                //
+                return false;
+            }
+            else if(_readPayloadLength > 0)
+            {
+                return true; // Read the remaining of the payload.
+            }
+            else if(_readLastFrame)
+            {
+                //
+                // The message is fully inflated, reset the inflater since the
+                // peer doesn't keep the compression context across messages.
+                //
+#ifdef ICE_HAS_ZLIB
+                inflateReset(_inflateStream);
+#endif
+                _readDeflated = false;
+            }
+
+            //
+            // We've read the payload of the frame, we're ready to read a new frame.
+            //
+            _readState = ReadStateOpcode;
+        }
     }
 }
 
@@ -1434,11 +1971,8 @@ IceInternal::WSTransceiver::postRead(Buffer& buf)
         //
         // Unmask the data we just read.
         //
-        IceInternal::Buffer::Container::iterator p = _readStart;
-        for(size_t n = static_cast<size_t>(_readStart - _readFrameStart); p < buf.i; ++p, ++n)
-        {
-            *p ^= _readMask[n % 4];
-        }
+        applyMask(_readStart, _readStart, static_cast<size_t>(buf.i - _readStart), _readMask,
+                  static_cast<size_t>(_readStart - _readFrameStart));
     }
 
     _readPayloadLength -= static_cast<size_t>(buf.i - _readStart);
@@ -1466,7 +2000,15 @@ IceInternal::WSTransceiver::preWrite(Buffer& buf)
             }
 
             assert(buf.i == buf.b.begin());
-            prepareWriteHeader(OP_DATA, buf.b.size());
+            _writeDeflated = _deflateNegotiated && deflateMessage(buf);
+            if(_writeDeflated)
+            {
+                prepareWriteHeader(static_cast<Byte>(OP_DATA | FLAG_RSV1), _deflateBuffer.b.size());
+            }
+            else
+            {
+                prepareWriteHeader(OP_DATA, buf.b.size());
+            }
 
             _writeState = WriteStatePayload;
         }
@@ -1533,9 +2075,10 @@ IceInternal::WSTransceiver::preWrite(Buffer& buf)
         // for writing. For incoming connections, we just copy the start of the
         // message in the internal buffer after the header. If the message is
         // larger, the reminder is sent directly from the message buffer to avoid
-        // copying.
+        // copying. If the message is compressed, the compressed payload is
+        // written instead of the message buffer.
         //
-
+        Buffer& payload = _writeDeflated ? _deflateBuffer : buf;
         if(!_incoming && (_writePayloadLength == 0 || _writeBuffer.i == _writeBuffer.b.end()))
         {
             if(_writeBuffer.i == _writeBuffer.b.end())
@@ -1543,12 +2086,11 @@ IceInternal::WSTransceiver::preWrite(Buffer& buf)
                 _writeBuffer.i = _writeBuffer.b.begin();
             }
 
-            size_t n = static_cast<size_t>(buf.i - buf.b.begin());
-            for(; n < buf.b.size() && _writeBuffer.i < _writeBuffer.b.end(); ++_writeBuffer.i, ++n)
-            {
-                *_writeBuffer.i = buf.b[n] ^ _writeMask[n % 4];
-            }
-            _writePayloadLength = n;
+            size_t n = static_cast<size_t>(payload.i - payload.b.begin());
+            size_t sz = min(payload.b.size() - n, static_cast<size_t>(_writeBuffer.b.end() - _writeBuffer.i));
+            applyMask(_writeBuffer.i, payload.b.begin() + n, sz, _writeMask, n);
+            _writeBuffer.i += sz;
+            _writePayloadLength = n + sz;
             if(_writeBuffer.i < _writeBuffer.b.end())
             {
                 _writeBuffer.b.resize(static_cast<size_t>(_writeBuffer.i - _writeBuffer.b.begin()));
@@ -1558,10 +2100,10 @@ IceInternal::WSTransceiver::preWrite(Buffer& buf)
         else if(_writePayloadLength == 0)
         {
             size_t n = min(static_cast<size_t>(_writeBuffer.b.end() - _writeBuffer.i),
-                           static_cast<size_t>(buf.b.end() - buf.i));
-            memcpy(_writeBuffer.i, buf.i, n);
+                           static_cast<size_t>(payload.b.end() - payload.i));
+            memcpy(_writeBuffer.i, payload.i, n);
             _writeBuffer.i += n;
-            buf.i += n;
+            payload.i += n;
             _writePayloadLength = n;
             if(_writeBuffer.i < _writeBuffer.b.end())
             {
@@ -1635,14 +2177,24 @@ IceInternal::WSTransceiver::postWrite(Buffer& buf)
         }
     }
 
-    if((!_incoming || buf.i == buf.b.begin()) && _writePayloadLength > 0)
+    Buffer& payload = _writeDeflated ? _deflateBuffer : buf;
+    if((!_incoming || payload.i == payload.b.begin()) && _writePayloadLength > 0)
     {
         if(_writeBuffer.i == _writeBuffer.b.end())
         {
-            buf.i = buf.b.begin() + _writePayloadLength;
+            payload.i = payload.b.begin() + _writePayloadLength;
         }
     }
 
+    if(_writeDeflated && payload.i == payload.b.end())
+    {
+        //
+        // The compressed payload is written, so is the message.
+        //
+        buf.i = buf.b.end();
+        _writeDeflated = false;
+    }
+
     if(buf.b.empty() || buf.i == buf.b.end())
     {
         _writeState = WriteStateHeader;
@@ -1693,6 +2245,17 @@ IceInternal::WSTransceiver::readBuffered(IceInternal::Buffer::Container::size_ty
     return true;
 }
 
+bool
+IceInternal::WSTransceiver::hasBufferedRead() const
+{
+    //
+    // Data is available without reading from the delegate if it's already
+    // buffered or if the inflater might hold inflated data that didn't fit
+    // in the message buffer.
+    //
+    return _readI < _readBuffer.i || (_readState == ReadStateDeflatedPayload && _readPayloadLength == 0);
+}
+
 void
 IceInternal::WSTransceiver::prepareWriteHeader(Byte opCode, IceInternal::Buffer::Container::size_type payloadLength)
 {
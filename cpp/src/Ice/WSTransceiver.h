@@ -13,6 +13,10 @@
 #include <Ice/Network.h>
 #include <Ice/Buffer.h>
 
+#ifdef ICE_HAS_ZLIB
+struct z_stream_s;
+#endif
+
 namespace IceInternal
 {
 
@@ -63,6 +67,13 @@ private:
 
     bool readBuffered(Buffer::Container::size_type);
     void prepareWriteHeader(Ice::Byte, Buffer::Container::size_type);
+    bool hasBufferedRead() const;
+
+    std::string acceptDeflateOffer(const std::string&);
+    void checkDeflateResponse(const std::string&);
+    void initDeflate(int);
+    bool deflateMessage(const Buffer&);
+    bool inflatePayload(Buffer&);
 
     friend class WSConnector;
     friend class WSAcceptor;
@@ -99,6 +110,7 @@ private:
         ReadStateHeader,
         ReadStateControlFrame,
         ReadStatePayload,
+        ReadStateDeflatedPayload,
     };
 
     ReadState _readState;
@@ -113,6 +125,9 @@ private:
     Buffer::Container::iterator _readStart;
     Buffer::Container::iterator _readFrameStart;
     unsigned char _readMask[4];
+    bool _readDeflated;
+    size_t _readFrameOffset;
+    size_t _readUnmasked;
 
     enum WriteState
     {
@@ -126,6 +141,7 @@ private:
     const Buffer::Container::size_type _writeBufferSize;
     unsigned char _writeMask[4];
     size_t _writePayloadLength;
+    bool _writeDeflated;
 
     bool _readPending;
     bool _writePending;
@@ -134,6 +150,18 @@ private:
     int _closingReason;
 
     std::vector<Ice::Byte> _pingPayload;
+
+    //
+    // permessage-deflate extension (RFC 7692) state, the extension is
+    // only negotiated if Ice.WS.PerMessageDeflate is enabled.
+    //
+    const bool _deflateEnabled;
+    bool _deflateNegotiated;
+    Buffer _deflateBuffer;
+#ifdef ICE_HAS_ZLIB
+    z_stream_s* _deflateStream;
+    z_stream_s* _inflateStream;
+#endif
 };
 
 }
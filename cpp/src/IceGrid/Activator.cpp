@@ -36,6 +36,16 @@
 #   include <grp.h> // for setgroups
 #endif
 
+//
+// posix_spawn is used if the file actions to close the file descriptors
+// of the node and to change the working directory are supported.
+//
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34))
+#   define ICE_GRID_POSIX_SPAWN
+#   include <spawn.h>
+extern char** environ;
+#endif
+
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
@@ -102,6 +112,83 @@ reportChildError(int err, int fd, const char* cannot, const char* name, const Tr
 
 #endif
 
+#ifdef ICE_GRID_POSIX_SPAWN
+//
+// Launch the server with posix_spawn, this doesn't copy the address space
+// of the node like fork. The server inherits the given file descriptor
+// and the node environment merged with the server environment. Returns 0
+// on success or the error code.
+//
+int
+spawnServer(pid_t& pid, const StringSeq& args, const string& pwd, const StringSeq& envs, int fd)
+{
+    //
+    // The server variables replace the node variables with the same
+    // name, a variable without value is removed like with putenv.
+    //
+    map<string, string> serverEnvs;
+    for(StringSeq::const_iterator p = envs.begin(); p != envs.end(); ++p)
+    {
+        serverEnvs[p->substr(0, p->find('='))] = *p;
+    }
+    StringSeq environment;
+    for(char** e = environ; *e != 0; ++e)
+    {
+        string var = *e;
+        if(serverEnvs.find(var.substr(0, var.find('='))) == serverEnvs.end())
+        {
+            environment.push_back(var);
+        }
+    }
+    for(map<string, string>::const_iterator p = serverEnvs.begin(); p != serverEnvs.end(); ++p)
+    {
+        if(p->second.find('=') != string::npos)
+        {
+            environment.push_back(p->second);
+        }
+    }
+
+    IceInternal::ArgVector av(args);
+    IceInternal::ArgVector env(environment);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+
+    //
+    // The server inherits the file descriptor as file descriptor 3, the
+    // other file descriptors of the node, except for the standard input,
+    // output and error, are closed.
+    //
+    posix_spawn_file_actions_adddup2(&actions, fd, 3);
+    posix_spawn_file_actions_addclosefrom_np(&actions, 4);
+    if(!pwd.empty())
+    {
+        posix_spawn_file_actions_addchdir_np(&actions, pwd.c_str());
+    }
+
+    //
+    // Unblock signals blocked by IceUtil::CtrlCHandler and assign a new
+    // process group to the server.
+    //
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t sigs;
+    pthread_sigmask(SIG_SETMASK, 0, &sigs);
+    sigdelset(&sigs, SIGHUP);
+    sigdelset(&sigs, SIGINT);
+    sigdelset(&sigs, SIGTERM);
+    posix_spawnattr_setsigmask(&attr, &sigs);
+    posix_spawnattr_setpgroup(&attr, 0);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETPGROUP);
+
+    int err = posix_spawnp(&pid, av.argv[0], &actions, &attr, av.argv, env.argv);
+
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+    return err;
+}
+#endif
+
 string
 signalToString(int signal)
 {
@@ -716,6 +803,70 @@ Activator::activate(const string& name,
         groups.resize(NGROUPS_MAX);
     }
 
+#ifdef ICE_GRID_POSIX_SPAWN
+    //
+    // Use posix_spawn if the server runs with the uid and gid of the node
+    // and if the node doesn't run as root, there's no need to change the
+    // uid, gid and supplementary groups of the server process. The server
+    // executable is searched with the PATH of the node so fork is used if
+    // the server environment sets PATH.
+    //
+    bool spawn = getuid() != 0 && uid == getuid() && gid == getgid();
+    if(spawn && path.find('/') == string::npos)
+    {
+        for(StringSeq::const_iterator p = envs.begin(); p != envs.end(); ++p)
+        {
+            if(p->compare(0, 5, "PATH=") == 0 || *p == "PATH")
+            {
+                spawn = false;
+                break;
+            }
+        }
+    }
+
+    if(spawn)
+    {
+        int fds[2];
+        if(pipe(fds) != 0)
+        {
+            throw SyscallException(__FILE__, __LINE__, getSystemErrno());
+        }
+
+        pid_t pid;
+        int err = spawnServer(pid, args, pwd, envs, fds[1]);
+        close(fds[1]);
+        if(err != 0)
+        {
+            close(fds[0]);
+
+            ostringstream os;
+            os << "cannot execute `" << args[0] << "'";
+            if(!pwd.empty())
+            {
+                os << " in working directory `" << pwd << "'";
+            }
+            os << ": " << IceUtilInternal::errorToString(err);
+
+            Ice::Warning out(_traceLevels->logger);
+            out << "server activation failed for `" << name << "':\n" << os.str();
+            throw runtime_error(os.str());
+        }
+
+        Process process;
+        process.pid = pid;
+        process.pipeFd = fds[0];
+        process.server = server;
+        _processes.insert(make_pair(name, process));
+
+        int flags = fcntl(process.pipeFd, F_GETFL);
+        flags |= O_NONBLOCK;
+        fcntl(process.pipeFd, F_SETFL, flags);
+
+        setInterrupt();
+        return pid;
+    }
+#endif
+
     int fds[2];
     if(pipe(fds) != 0)
     {
@@ -286,6 +286,17 @@ AdapterCache::get(const string& id) const
     return entry;
 }
 
+AdapterEntryPtr
+AdapterCache::getFromSnapshot(const string& id) const
+{
+    AdapterEntryPtr entry = getSnapshotImpl(id);
+    if(!entry)
+    {
+        throw AdapterNotExistException(id);
+    }
+    return entry;
+}
+
 void
 AdapterCache::removeServerAdapter(const string& id)
 {
@@ -419,6 +430,12 @@ ServerAdapterEntry::getLocatorAdapterInfo(LocatorAdapterInfoSeq& adapters, int&
     getLocatorAdapterInfo(adapters);
 }
 
+float
+ServerAdapterEntry::getDispatchScore() const
+{
+    return _server->getDispatchScore();
+}
+
 float
 ServerAdapterEntry::getLeastLoadedNodeLoad(LoadSample loadSample) const
 {
@@ -647,6 +664,7 @@ ReplicaGroupEntry::getLocatorAdapterInfo(LocatorAdapterInfoSeq& adapters, int& n
 {
     vector<ServerAdapterEntryPtr> replicas;
     bool adaptive = false;
+    bool latency = false;
     LoadSample loadSample = LoadSample1;
     {
         Lock sync(*this);
@@ -683,6 +701,11 @@ ReplicaGroupEntry::getLocatorAdapterInfo(LocatorAdapterInfoSeq& adapters, int& n
             loadSample = _loadSample;
             adaptive = true;
         }
+        else if(LatencyLoadBalancingPolicyPtr::dynamicCast(_loadBalancing))
+        {
+            replicas = _replicas;
+            latency = true;
+        }
         else if(OrderedLoadBalancingPolicyPtr::dynamicCast(_loadBalancing))
         {
             replicas = _replicas;
@@ -714,6 +737,30 @@ ReplicaGroupEntry::getLocatorAdapterInfo(LocatorAdapterInfoSeq& adapters, int& n
             replicas.clear();
             transform(rl.begin(), rl.end(), back_inserter(replicas), TransformToReplica());
         }
+        else if(latency)
+        {
+            //
+            // Power of two choices: each position is given to the replica
+            // with the lowest dispatch score of two replicas picked at
+            // random from the remaining replicas. Unlike sorting by score,
+            // this doesn't send all the requests to the same replica
+            // between two load reports. This must also be done outside the
+            // synchronization block since the score of each replica locks
+            // its server entry.
+            //
+            for(size_t i = 0; i + 1 < replicas.size(); ++i)
+            {
+                size_t remaining = replicas.size() - i;
+                size_t first = i + IceUtilInternal::random(static_cast<int>(remaining));
+                size_t second = i + (first - i + 1 + IceUtilInternal::random(static_cast<int>(remaining - 1))) %
+                    remaining;
+                if(replicas[second]->getDispatchScore() < replicas[first]->getDispatchScore())
+                {
+                    first = second;
+                }
+                swap(replicas[i], replicas[first]);
+            }
+        }
 
         //
         // Retrieve the proxy of each adapter from the server. The adapter
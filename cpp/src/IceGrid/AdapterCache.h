@@ -100,6 +100,7 @@ public:
     virtual AdapterPrx getProxy(const std::string&, bool) const;
 
     void getLocatorAdapterInfo(LocatorAdapterInfoSeq&) const;
+    float getDispatchScore() const;
     const std::string& getReplicaGroupId() const { return _replicaGroupId; }
     int getPriority() const;
 
@@ -160,6 +161,7 @@ public:
     void addReplicaGroup(const ReplicaGroupDescriptor&, const std::string&);
 
     AdapterEntryPtr get(const std::string&) const;
+    AdapterEntryPtr getFromSnapshot(const std::string&) const;
 
     void removeServerAdapter(const std::string&);
     void removeReplicaGroup(const std::string&);
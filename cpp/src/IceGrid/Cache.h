@@ -7,6 +7,8 @@
 
 #include <IceUtil/Mutex.h>
 #include <IceUtil/Shared.h>
+#include <IceUtil/Atomic.h>
+#include <IceUtil/Thread.h>
 #include <IceGrid/Util.h>
 #include <IceGrid/TraceLevels.h>
 
@@ -29,9 +31,37 @@ class Cache : public IceUtil::Monitor<IceUtil::Mutex>
     typedef IceUtil::Handle<Value> ValuePtr;
     typedef std::map<Key, ValuePtr> ValueMap;
 
+    //
+    // An immutable copy of the cache entries.
+    //
+    class Snapshot : public IceUtil::Shared
+    {
+    public:
+
+        Snapshot(const ValueMap& e) : entries(e)
+        {
+        }
+
+        const ValueMap entries;
+    };
+    typedef IceUtil::Handle<Snapshot> SnapshotPtr;
+
+    //
+    // A published snapshot and the number of lookups reading it.
+    //
+    struct SnapshotSlot
+    {
+        SnapshotSlot() : readers(0)
+        {
+        }
+
+        SnapshotPtr snapshot;
+        IceUtilInternal::Atomic readers;
+    };
+
 public:
 
-    Cache() : _entriesHint(_entries.end())
+    Cache() : _entriesHint(_entries.end()), _snapshotStale(false), _snapshotSlot(0)
     {
     }
 
@@ -54,6 +84,36 @@ public:
         removeImpl(key);
     }
 
+    //
+    // Publish a snapshot of the entries if they changed since the last
+    // publication. This is called once at the end of an update, lookups
+    // from the snapshot don't see the entries added or removed until then.
+    //
+    void
+    publishSnapshot()
+    {
+        Lock sync(*this);
+        if(!_snapshotStale)
+        {
+            return;
+        }
+
+        //
+        // Wait for the lookups still reading the snapshot published before
+        // the current one, the lookups which start now use the current
+        // snapshot or retry with the new one.
+        //
+        int next = 1 - _snapshotSlot.load();
+        SnapshotSlot& slot = _snapshotSlots[next];
+        while(slot.readers.load() > 0)
+        {
+            IceUtil::ThreadControl::yield();
+        }
+        slot.snapshot = new Snapshot(_entries);
+        _snapshotSlot.exchange(next);
+        _snapshotStale = false;
+    }
+
     void
     setTraceLevels(const TraceLevelsPtr& traceLevels)
     {
@@ -92,11 +152,49 @@ protected:
         }
     }
 
+    //
+    // Get the entry from the last published snapshot of the cache
+    // entries. This doesn't lock the cache or any other mutex, the
+    // lookup only registers itself as a reader of the snapshot so that
+    // publishSnapshot doesn't release it while it's searched.
+    //
+    ValuePtr
+    getSnapshotImpl(const Key& key) const
+    {
+        while(true)
+        {
+            int current = _snapshotSlot.load();
+            SnapshotSlot& slot = _snapshotSlots[current];
+            ++slot.readers;
+            if(_snapshotSlot.load() == current)
+            {
+                ValuePtr value;
+                if(slot.snapshot)
+                {
+                    typename ValueMap::const_iterator p = slot.snapshot->entries.find(key);
+                    if(p != slot.snapshot->entries.end())
+                    {
+                        value = p->second;
+                    }
+                }
+                --slot.readers;
+                return value;
+            }
+
+            //
+            // A new snapshot was published in the meantime, the slot might
+            // be being updated.
+            //
+            --slot.readers;
+        }
+    }
+
     virtual ValuePtr
     addImpl(const Key& key, const ValuePtr& entry)
     {
         typename ValueMap::value_type v(key, entry);
         _entriesHint = _entries.insert(_entriesHint, v);
+        _snapshotStale = true;
         return entry;
     }
 
@@ -122,6 +220,7 @@ protected:
         {
             _entries.erase(p);
             _entriesHint = _entries.end();
+            _snapshotStale = true;
         }
         else
         {
@@ -132,6 +231,16 @@ protected:
     TraceLevelsPtr _traceLevels;
     ValueMap _entries;
     typename ValueMap::iterator _entriesHint;
+
+private:
+
+    //
+    // The current snapshot is _snapshotSlots[_snapshotSlot], the other
+    // slot is only updated by publishSnapshot once its readers are gone.
+    //
+    bool _snapshotStale;
+    mutable SnapshotSlot _snapshotSlots[2];
+    IceUtilInternal::Atomic _snapshotSlot;
 };
 
 template<typename T>
@@ -43,6 +43,40 @@ const string internalObjectsDbName = "internal-objects";
 const string internalObjectsByTypeDbName = "internal-objectsByType";
 const string serialsDbName = "serials";
 
+void
+addObjectIds(const ObjectDescriptorSeq& objects, set<Ice::Identity>& ids)
+{
+    for(ObjectDescriptorSeq::const_iterator p = objects.begin(); p != objects.end(); ++p)
+    {
+        ids.insert(p->id);
+    }
+}
+
+void
+addAdapterIds(const CommunicatorDescriptorPtr& desc, set<string>& ids, set<Ice::Identity>& objectIds)
+{
+    for(AdapterDescriptorSeq::const_iterator p = desc->adapters.begin(); p != desc->adapters.end(); ++p)
+    {
+        ids.insert(p->id);
+        ids.insert(p->replicaGroupId);
+        addObjectIds(p->objects, objectIds);
+    }
+}
+
+void
+addAdapterIds(const ServerInfo& info, set<string>& ids, set<Ice::Identity>& objectIds)
+{
+    addAdapterIds(info.descriptor, ids, objectIds);
+    IceBoxDescriptorPtr iceBox = IceBoxDescriptorPtr::dynamicCast(info.descriptor);
+    if(iceBox)
+    {
+        for(ServiceInstanceDescriptorSeq::const_iterator p = iceBox->services.begin(); p != iceBox->services.end(); ++p)
+        {
+            addAdapterIds(p->descriptor, ids, objectIds);
+        }
+    }
+}
+
 struct ObjectLoadCI : binary_function<pair<Ice::ObjectPrx, float>&, pair<Ice::ObjectPrx, float>&, bool>
 {
     bool operator()(const pair<Ice::ObjectPrx, float>& lhs, const pair<Ice::ObjectPrx, float>& rhs)
@@ -187,6 +221,86 @@ findByType(const IceDB::ReadOnlyTxn& txn,
 
 }
 
+//
+// Mark the cache update in progress, see Database::getLocatorAdapterInfo.
+// The caches are updated with the database locked, the updates are never
+// concurrent. The cache snapshots are published once the update is done.
+//
+class Database::CacheUpdate
+{
+public:
+
+    CacheUpdate(Database& database) : _database(database)
+    {
+        ++_database._cacheUpdates;
+
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_database._cacheLookupsMonitor);
+        while(_database._cacheLookups.load() > 0)
+        {
+            _database._cacheLookupsMonitor.wait();
+        }
+    }
+
+    ~CacheUpdate()
+    {
+        _database._adapterCache.publishSnapshot();
+        _database._objectCache.publishSnapshot();
+        ++_database._cacheUpdates;
+    }
+
+private:
+
+    Database& _database;
+};
+
+//
+// Register a lookup which doesn't lock the database. The lookup can only
+// proceed if no update is in progress, the next update waits for it.
+//
+class Database::CacheLookup
+{
+public:
+
+    CacheLookup(Database& database) : _database(database), _started(true)
+    {
+        ++_database._cacheLookups;
+        if(_database._cacheUpdates.load() % 2 != 0)
+        {
+            _started = false;
+            finish();
+        }
+    }
+
+    ~CacheLookup()
+    {
+        if(_started)
+        {
+            finish();
+        }
+    }
+
+    bool
+    started() const
+    {
+        return _started;
+    }
+
+private:
+
+    void
+    finish()
+    {
+        if(--_database._cacheLookups == 0 && _database._cacheUpdates.load() % 2 != 0)
+        {
+            IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_database._cacheLookupsMonitor);
+            _database._cacheLookupsMonitor.notifyAll();
+        }
+    }
+
+    Database& _database;
+    bool _started;
+};
+
 Database::Database(const Ice::ObjectAdapterPtr& registryAdapter,
                    const IceStorm::TopicManagerPrx& topicManager,
                    const string& instanceName,
@@ -206,6 +320,8 @@ Database::Database(const Ice::ObjectAdapterPtr& registryAdapter,
     _objectCache(_communicator),
     _allocatableObjectCache(_communicator),
     _serverCache(_communicator, _instanceName, _nodeCache, _adapterCache, _objectCache, _allocatableObjectCache),
+    _cacheUpdates(0),
+    _cacheLookups(0),
     _dbLock(_communicator->getProperties()->getProperty("IceGrid.Registry.LMDB.Path") + "/icedb.lock"),
     _env(_communicator->getProperties()->getProperty("IceGrid.Registry.LMDB.Path"), 8,
          IceDB::getMapSize(_communicator->getProperties()->getPropertyAsInt("IceGrid.Registry.LMDB.MapSize"))),
@@ -257,7 +373,8 @@ Database::Database(const Ice::ObjectAdapterPtr& registryAdapter,
     _objectCache.setTraceLevels(_traceLevels);
     _allocatableObjectCache.setTraceLevels(_traceLevels);
 
-    _nodeObserverTopic = new NodeObserverTopic(_topicManager, _internalAdapter);
+    _locatorCacheTopic = new LocatorCacheTopic(_adapterCache, _traceLevels);
+    _nodeObserverTopic = new NodeObserverTopic(_topicManager, _internalAdapter, _locatorCacheTopic);
     _registryObserverTopic = new RegistryObserverTopic(_topicManager);
 
     _serverCache.setNodeObserverTopic(_nodeObserverTopic);
@@ -408,21 +525,26 @@ Database::syncApplications(const ApplicationInfoSeq& newApplications, Ice::Long
                 map<string, ApplicationInfo>::const_iterator q = oldApplications.find(p->descriptor.name);
                 if(q != oldApplications.end())
                 {
+                    if(q->second.uuid == p->uuid && q->second.revision == p->revision)
+                    {
+                        names.insert(p->descriptor.name);
+                        continue; // The application didn't change, no need to reload it.
+                    }
                     ApplicationHelper previous(_communicator, q->second.descriptor);
-                    ApplicationHelper helper(_communicator, p->descriptor);
+                    ApplicationHelper helper(_communicator, p->descriptor, previous);
                     reload(previous, helper, entries, p->uuid, p->revision, false);
                 }
                 else
                 {
                     load(ApplicationHelper(_communicator, p->descriptor), entries, p->uuid, p->revision);
                 }
+                names.insert(p->descriptor.name);
             }
             catch(const DeploymentException& ex)
             {
                 Ice::Warning warn(_traceLevels->logger);
                 warn << "invalid application `" << p->descriptor.name << "':\n" << ex.reason;
             }
-            names.insert(p->descriptor.name);
         }
 
         for(map<string, ApplicationInfo>::iterator s = oldApplications.begin(); s != oldApplications.end(); ++s)
@@ -726,7 +848,7 @@ Database::updateApplication(const ApplicationUpdateInfo& updt, bool noRestart, A
         }
 
         previous.reset(new ApplicationHelper(_communicator, oldApp.descriptor));
-        helper.reset(new ApplicationHelper(_communicator, previous->update(update.descriptor), true));
+        helper.reset(new ApplicationHelper(_communicator, previous->update(update.descriptor), *previous, true));
 
         startUpdating(update.descriptor.name, oldApp.uuid, oldApp.revision + 1);
     }
@@ -763,7 +885,7 @@ Database::syncApplicationDescriptor(const ApplicationDescriptor& newDesc, bool n
         }
 
         previous.reset(new ApplicationHelper(_communicator, oldApp.descriptor));
-        helper.reset(new ApplicationHelper(_communicator, newDesc, true));
+        helper.reset(new ApplicationHelper(_communicator, newDesc, *previous, true));
 
         update.updateTime = IceUtil::Time::now().toMilliSeconds();
         update.updateUser = _lockUserId;
@@ -1009,12 +1131,16 @@ Database::setAdapterDirectProxy(const string& adapterId, const string& replicaGr
         info.replicaGroupId = replicaGroupId;
 
         bool updated = false;
+        set<string> changed;
         try
         {
             IceDB::ReadWriteTxn txn(_env);
 
             AdapterInfo oldInfo;
             bool found = _adapters.get(txn, adapterId, oldInfo);
+            changed.insert(adapterId);
+            changed.insert(replicaGroupId);
+            changed.insert(oldInfo.replicaGroupId);
             if(proxy)
             {
                 updated = found;
@@ -1073,6 +1199,8 @@ Database::setAdapterDirectProxy(const string& adapterId, const string& replicaGr
         {
             serial = _adapterObserverTopic->adapterRemoved(dbSerial, adapterId);
         }
+
+        _locatorCacheTopic->adaptersChanged(changed);
     }
     _adapterObserverTopic->waitForSyncedSubscribers(serial);
 }
@@ -1173,6 +1301,8 @@ Database::removeAdapter(const string& adapterId)
             out << "removed " << (infos.empty() ? "adapter" : "replica group") << " `" << adapterId << "' (serial = `" << dbSerial << "')";
         }
 
+        set<string> changed;
+        changed.insert(adapterId);
         if(infos.empty())
         {
             serial = _adapterObserverTopic->adapterRemoved(dbSerial, adapterId);
@@ -1182,8 +1312,10 @@ Database::removeAdapter(const string& adapterId)
             for(AdapterInfoSeq::const_iterator p = infos.begin(); p != infos.end(); ++p)
             {
                 serial = _adapterObserverTopic->adapterUpdated(dbSerial, *p);
+                changed.insert(p->id);
             }
         }
+        _locatorCacheTopic->adaptersChanged(changed);
     }
     _adapterObserverTopic->waitForSyncedSubscribers(serial);
 }
@@ -1205,10 +1337,25 @@ Database::getLocatorAdapterInfo(const string& id,
                                 bool& roundRobin,
                                 const set<string>& excludes)
 {
+    //
+    // The adapter is looked up without locking the database unless an
+    // update is in progress. Updates wait for the lookup to complete so
+    // it's never called during an update and it's never retried (which
+    // would advance the round robin load balancing twice).
+    //
     string filter;
     {
-        Lock sync(*this); // Make sure this isn't call during an update.
-        _adapterCache.get(id)->getLocatorAdapterInfo(adpts, count, replicaGroup, roundRobin, filter, excludes);
+        CacheLookup lookup(*this);
+        if(lookup.started())
+        {
+            _adapterCache.getFromSnapshot(id)->getLocatorAdapterInfo(adpts, count, replicaGroup, roundRobin, filter,
+                                                                     excludes);
+        }
+        else
+        {
+            Lock sync(*this);
+            _adapterCache.get(id)->getLocatorAdapterInfo(adpts, count, replicaGroup, roundRobin, filter, excludes);
+        }
     }
 
     if(_pluginFacade->hasReplicaGroupFilters() && !adpts.empty())
@@ -1485,6 +1632,7 @@ Database::addObject(const ObjectInfo& info)
         }
 
         serial = _objectObserverTopic->objectAdded(dbSerial, info);
+        _locatorCacheTopic->objectChanged(id);
 
         if(_traceLevels->object > 0)
         {
@@ -1541,6 +1689,7 @@ Database::addOrUpdateObject(const ObjectInfo& info, Ice::Long dbSerial)
         {
             serial = _objectObserverTopic->objectAdded(dbSerial, info);
         }
+        _locatorCacheTopic->objectChanged(id);
 
         if(_traceLevels->object > 0)
         {
@@ -1587,6 +1736,7 @@ Database::removeObject(const Ice::Identity& id, Ice::Long dbSerial)
         }
 
         serial = _objectObserverTopic->objectRemoved(dbSerial, id);
+        _locatorCacheTopic->objectChanged(id);
 
         if(_traceLevels->object > 0)
         {
@@ -1637,6 +1787,7 @@ Database::updateObject(const Ice::ObjectPrx& proxy)
         }
 
         serial = _objectObserverTopic->objectUpdated(dbSerial, info);
+        _locatorCacheTopic->objectChanged(id);
         if(_traceLevels->object > 0)
         {
             Ice::Trace out(_traceLevels->logger, _traceLevels->objectCat);
@@ -1709,7 +1860,7 @@ Database::getObjectProxy(const Ice::Identity& id)
         //
         // Only return proxies for non allocatable objects.
         //
-        return _objectCache.get(id)->getProxy();
+        return _objectCache.getFromSnapshot(id)->getProxy();
     }
     catch(const ObjectNotRegisteredException&)
     {
@@ -1806,7 +1957,7 @@ Database::getObjectInfo(const Ice::Identity& id)
 {
     try
     {
-        ObjectEntryPtr object = _objectCache.get(id);
+        ObjectEntryPtr object = _objectCache.getFromSnapshot(id);
         return object->getObjectInfo();
     }
     catch(const ObjectNotRegisteredException&)
@@ -2135,6 +2286,10 @@ Database::checkReplicaGroupForRemove(const string& replicaGroup)
 void
 Database::load(const ApplicationHelper& app, ServerEntrySeq& entries, const string& uuid, int revision)
 {
+    CacheUpdate update(*this);
+
+    set<string> changed;
+    set<Ice::Identity> changedObjects;
     const NodeDescriptorDict& nodes = app.getInstance().nodes;
     const string application = app.getInstance().name;
     for(NodeDescriptorDict::const_iterator n = nodes.begin(); n != nodes.end(); ++n)
@@ -2151,22 +2306,36 @@ Database::load(const ApplicationHelper& app, ServerEntrySeq& entries, const stri
         {
             _objectCache.add(toObjectInfo(_communicator, *o, r->id), application, "");
         }
+        addObjectIds(r->objects, changedObjects);
     }
 
     map<string, ServerInfo> servers = app.getServerInfos(uuid, revision);
     for(map<string, ServerInfo>::const_iterator p = servers.begin(); p != servers.end(); ++p)
     {
         entries.push_back(_serverCache.add(p->second));
+        addAdapterIds(p->second, changed, changedObjects);
     }
+
+    //
+    // The locator clients might have cached that the adapters and objects
+    // don't exist.
+    //
+    _locatorCacheTopic->adaptersChanged(changed);
+    _locatorCacheTopic->objectsChanged(changedObjects);
 }
 
 void
 Database::unload(const ApplicationHelper& app, ServerEntrySeq& entries)
 {
+    CacheUpdate update(*this);
+
+    set<string> changed;
+    set<Ice::Identity> changedObjects;
     map<string, ServerInfo> servers = app.getServerInfos("", 0);
     for(map<string, ServerInfo>::const_iterator p = servers.begin(); p != servers.end(); ++p)
     {
         entries.push_back(_serverCache.remove(p->first, false));
+        addAdapterIds(p->second, changed, changedObjects);
     }
 
     const ReplicaGroupDescriptorSeq& adpts = app.getInstance().replicaGroups;
@@ -2177,7 +2346,11 @@ Database::unload(const ApplicationHelper& app, ServerEntrySeq& entries)
             _objectCache.remove(o->id);
         }
         _adapterCache.removeReplicaGroup(r->id);
+        changed.insert(r->id);
+        addObjectIds(r->objects, changedObjects);
     }
+    _locatorCacheTopic->adaptersChanged(changed);
+    _locatorCacheTopic->objectsChanged(changedObjects);
 
     const NodeDescriptorDict& nodes = app.getInstance().nodes;
     const string application = app.getInstance().name;
@@ -2195,6 +2368,8 @@ Database::reload(const ApplicationHelper& oldApp,
                  int revision,
                  bool noRestart)
 {
+    CacheUpdate update(*this);
+
     const string application = oldApp.getInstance().name;
 
     //
@@ -2203,17 +2378,22 @@ Database::reload(const ApplicationHelper& oldApp,
     map<string, ServerInfo> oldServers = oldApp.getServerInfos(uuid, revision);
     map<string, ServerInfo> newServers = newApp.getServerInfos(uuid, revision);
     vector<pair<bool, ServerInfo> > load;
+    set<string> changed;
+    set<Ice::Identity> changedObjects;
     for(map<string, ServerInfo>::const_iterator p = newServers.begin(); p != newServers.end(); ++p)
     {
         map<string, ServerInfo>::const_iterator q = oldServers.find(p->first);
         if(q == oldServers.end())
         {
             load.push_back(make_pair(false, p->second));
+            addAdapterIds(p->second, changed, changedObjects);
         }
         else if(isServerUpdated(p->second, q->second))
         {
             _serverCache.preUpdate(p->second, noRestart);
             load.push_back(make_pair(true, p->second));
+            addAdapterIds(q->second, changed, changedObjects);
+            addAdapterIds(p->second, changed, changedObjects);
         }
         else
         {
@@ -2228,6 +2408,7 @@ Database::reload(const ApplicationHelper& oldApp,
         if(q == newServers.end())
         {
             entries.push_back(_serverCache.remove(p->first, noRestart));
+            addAdapterIds(p->second, changed, changedObjects);
         }
     }
 
@@ -2254,6 +2435,8 @@ Database::reload(const ApplicationHelper& oldApp,
         {
             _adapterCache.removeReplicaGroup(r->id);
         }
+        changed.insert(r->id);
+        addObjectIds(r->objects, changedObjects);
     }
 
     //
@@ -2294,6 +2477,7 @@ Database::reload(const ApplicationHelper& oldApp,
         {
             _objectCache.add(toObjectInfo(_communicator, *o, r->id), application, "");
         }
+        addObjectIds(r->objects, changedObjects);
     }
 
     //
@@ -2310,6 +2494,14 @@ Database::reload(const ApplicationHelper& oldApp,
             entries.push_back(_serverCache.add(q->second));
         }
     }
+
+    //
+    // Notify the locator clients of the changes of the replica groups
+    // and of the adapters and objects of the added, updated or removed
+    // servers.
+    //
+    _locatorCacheTopic->adaptersChanged(changed);
+    _locatorCacheTopic->objectsChanged(changedObjects);
 }
 
 Ice::Long
@@ -2608,7 +2800,7 @@ Database::finishApplicationUpdate(const ApplicationUpdateInfo& update,
                 Lock sync(*this);
                 entries.clear();
                 ApplicationHelper previous(_communicator, newDesc);
-                ApplicationHelper helper(_communicator, oldApp.descriptor);
+                ApplicationHelper helper(_communicator, oldApp.descriptor, previous);
 
                 ApplicationInfo info = oldApp;
                 info.revision = update.revision + 1;
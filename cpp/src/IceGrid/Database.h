@@ -73,6 +73,7 @@ public:
     void destroy();
 
     ObserverTopicPtr getObserverTopic(TopicName) const;
+    const LocatorCacheTopicPtr& getLocatorCacheTopic() const { return _locatorCacheTopic; }
 
     int lock(AdminSessionI*, const std::string&);
     void unlock(AdminSessionI*);
@@ -195,6 +196,11 @@ private:
 
     friend struct AddComponent;
 
+    class CacheUpdate;
+    class CacheLookup;
+    friend class CacheUpdate;
+    friend class CacheLookup;
+
     static const std::string _applicationDbName;
     static const std::string _objectDbName;
     static const std::string _internalObjectDbName;
@@ -216,6 +222,16 @@ private:
     AllocatableObjectCache _allocatableObjectCache;
     ServerCache _serverCache;
 
+    //
+    // Incremented before and after updating the caches, an odd value
+    // indicates that an update is in progress. An update waits for the
+    // lookups which don't lock the database to complete.
+    //
+    IceUtilInternal::Atomic _cacheUpdates;
+    IceUtilInternal::Atomic _cacheLookups;
+    IceUtil::Monitor<IceUtil::Mutex> _cacheLookupsMonitor;
+
+    LocatorCacheTopicPtr _locatorCacheTopic;
     RegistryObserverTopicPtr _registryObserverTopic;
     NodeObserverTopicPtr _nodeObserverTopic;
     ApplicationObserverTopicPtr _applicationObserverTopic;
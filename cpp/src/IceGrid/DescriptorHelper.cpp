@@ -344,6 +344,25 @@ getDictRemovedElts(const Dict& ldict, const Dict& rdict)
     return removed;
 }
 
+template<typename Dict, typename EqFunc> bool
+isDictEqual(const Dict& ldict, const Dict& rdict, EqFunc eq)
+{
+    if(ldict.size() != rdict.size())
+    {
+        return false;
+    }
+
+    for(typename Dict::const_iterator p = ldict.begin(); p != ldict.end(); ++p)
+    {
+        typename Dict::const_iterator q = rdict.find(p->first);
+        if(q == rdict.end() || !eq(p->second, q->second))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 template <typename Dict> Dict
 updateDictElts(const Dict& dict, const Dict& update, const Ice::StringSeq& remove)
 {
@@ -359,6 +378,26 @@ updateDictElts(const Dict& dict, const Dict& update, const Ice::StringSeq& remov
     return result;
 }
 
+//
+// Create the helper of a server, the helper of the previous server with
+// the same id is reused if the server definition didn't change.
+//
+template<typename Desc> ServerInstanceHelper
+createServerInstanceHelper(const Desc& desc, const Resolver& resolve, bool instantiate,
+                           const map<string, ServerInstanceHelper>* previous)
+{
+    if(instantiate && previous)
+    {
+        ServerInstanceHelper helper(desc, resolve, false);
+        map<string, ServerInstanceHelper>::const_iterator p = previous->find(helper.getId());
+        if(p != previous->end() && p->second == helper)
+        {
+            return p->second;
+        }
+    }
+    return ServerInstanceHelper(desc, resolve, instantiate);
+}
+
 void
 validateProxyOptions(const Resolver& resolver, const string& proxyOptions)
 {
@@ -2136,7 +2175,8 @@ ServerInstanceHelper::getReplicaGroups(set<string>& replicaGroups) const
 NodeHelper::NodeHelper(const string& name,
                        const NodeDescriptor& descriptor,
                        const Resolver& appResolve,
-                       bool instantiate) :
+                       bool instantiate,
+                       const NodeHelper* previous) :
     _name(name),
     _def(descriptor),
     _instantiated(instantiate)
@@ -2168,9 +2208,20 @@ NodeHelper::NodeHelper(const string& name,
         resolve.addPropertySets(_instance.propertySets);
     }
 
+    //
+    // The servers of the previous node can only be reused if the node
+    // definitions used to instantiate them didn't change.
+    //
+    if(previous && (!instantiate || !previous->_instantiated || previous->_def.variables != _def.variables ||
+                    previous->_def.propertySets != _def.propertySets))
+    {
+        previous = 0;
+    }
+
     for(ServerInstanceDescriptorSeq::const_iterator p = _def.serverInstances.begin(); p != _def.serverInstances.end(); ++p)
     {
-        ServerInstanceHelper helper(*p, resolve, instantiate);
+        ServerInstanceHelper helper = createServerInstanceHelper(*p, resolve, instantiate,
+                                                                 previous ? &previous->_serverInstances : 0);
         if(!_serverInstances.insert(make_pair(helper.getId(), helper)).second)
         {
             resolve.exception("duplicate server `" + helper.getId() + "' in node `" + _name + "'");
@@ -2183,7 +2234,8 @@ NodeHelper::NodeHelper(const string& name,
 
     for(ServerDescriptorSeq::const_iterator q = _def.servers.begin(); q != _def.servers.end(); ++q)
     {
-        ServerInstanceHelper helper(*q, resolve, instantiate);
+        ServerInstanceHelper helper = createServerInstanceHelper(*q, resolve, instantiate,
+                                                                 previous ? &previous->_servers : 0);
         if(!_servers.insert(make_pair(helper.getId(), helper)).second)
         {
             resolve.exception("duplicate server `" + helper.getId() + "' in node `" + _name + "'");
@@ -2655,13 +2707,29 @@ ApplicationHelper::ApplicationHelper(const Ice::CommunicatorPtr& communicator,
                                      bool instantiate) :
     _communicator(communicator),
     _def(appDesc)
+{
+    init(enableWarning, instantiate, 0);
+}
+
+ApplicationHelper::ApplicationHelper(const Ice::CommunicatorPtr& communicator,
+                                     const ApplicationDescriptor& appDesc,
+                                     const ApplicationHelper& previous,
+                                     bool enableWarning) :
+    _communicator(communicator),
+    _def(appDesc)
+{
+    init(enableWarning, true, &previous);
+}
+
+void
+ApplicationHelper::init(bool enableWarning, bool instantiate, const ApplicationHelper* previous)
 {
     if(_def.name.empty())
     {
         throw DeploymentException("invalid application: empty name");
     }
 
-    Resolver resolve(_def, communicator, enableWarning);
+    Resolver resolve(_def, _communicator, enableWarning);
 
     if(instantiate)
     {
@@ -2720,13 +2788,50 @@ ApplicationHelper::ApplicationHelper(const Ice::CommunicatorPtr& communicator,
         resolve.addPropertySets(_instance.propertySets);
     }
 
+    //
+    // The servers of the previous application can only be reused if the
+    // application definitions used to instantiate them didn't change.
+    //
+    if(previous)
+    {
+        set<string> replicaGroups;
+        set<string> previousReplicaGroups;
+        GetReplicaGroupId rk;
+        transform(_def.replicaGroups.begin(), _def.replicaGroups.end(),
+                  inserter(replicaGroups, replicaGroups.begin()), rk);
+        transform(previous->_def.replicaGroups.begin(), previous->_def.replicaGroups.end(),
+                  inserter(previousReplicaGroups, previousReplicaGroups.begin()), rk);
+
+        TemplateDescriptorEqual eq;
+        if(!instantiate ||
+           previous->_instance.name != _def.name || // Not instantiated or another application.
+           previous->_def.variables != _def.variables ||
+           previous->_def.propertySets != _def.propertySets ||
+           previousReplicaGroups != replicaGroups ||
+           !isDictEqual(previous->_def.serverTemplates, _def.serverTemplates, eq) ||
+           !isDictEqual(previous->_def.serviceTemplates, _def.serviceTemplates, eq))
+        {
+            previous = 0;
+        }
+    }
+
     //
     // Create the node helpers.
     //
     NodeHelperDict::const_iterator n;
     for(NodeDescriptorDict::const_iterator p = _def.nodes.begin(); p != _def.nodes.end(); ++p)
     {
-        n = _nodes.insert(make_pair(p->first, NodeHelper(p->first, p->second, resolve, instantiate))).first;
+        const NodeHelper* previousNode = 0;
+        if(previous)
+        {
+            n = previous->_nodes.find(p->first);
+            if(n != previous->_nodes.end())
+            {
+                previousNode = &n->second;
+            }
+        }
+        NodeHelper helper(p->first, p->second, resolve, instantiate, previousNode);
+        n = _nodes.insert(make_pair(p->first, helper)).first;
         if(instantiate)
         {
             _instance.nodes.insert(make_pair(n->first, n->second.getInstance()));
@@ -3115,6 +3220,10 @@ ApplicationHelper::print(Output& out, const ApplicationInfo& info) const
             {
                 out << "adaptive" ;
             }
+            else if(LatencyLoadBalancingPolicyPtr::dynamicCast(p->loadBalancing))
+            {
+                out << "latency";
+            }
             else
             {
                 out << "<unknown load balancing policy>";
@@ -3366,5 +3475,9 @@ IceGrid::isServerUpdated(const ServerInfo& lhs, const ServerInfo& rhs, bool igno
     {
         return true;
     }
+    if(lhs.descriptor.get() == rhs.descriptor.get())
+    {
+        return false; // The instance is shared with the previous application helper.
+    }
     return !descriptorEqual(lhs.descriptor, rhs.descriptor, ignoreProps);
 }
@@ -271,7 +271,7 @@ class NodeHelper
 {
 public:
 
-    NodeHelper(const std::string&, const NodeDescriptor&, const Resolver&, bool);
+    NodeHelper(const std::string&, const NodeDescriptor&, const Resolver&, bool, const NodeHelper* = 0);
     virtual ~NodeHelper() { }
 
     virtual bool operator==(const NodeHelper&) const;
@@ -311,6 +311,14 @@ public:
 
     ApplicationHelper(const Ice::CommunicatorPtr&, const ApplicationDescriptor&, bool = false, bool = true);
 
+    //
+    // Instantiate the application descriptor, the servers which are not
+    // updated are not instantiated again, their instance is shared with
+    // the given helper of the previous application descriptor.
+    //
+    ApplicationHelper(const Ice::CommunicatorPtr&, const ApplicationDescriptor&, const ApplicationHelper&,
+                      bool = false);
+
     ApplicationUpdateDescriptor diff(const ApplicationHelper&) const;
     ApplicationDescriptor update(const ApplicationUpdateDescriptor&) const;
     ApplicationDescriptor instantiateServer(const std::string&, const ServerInstanceDescriptor&) const;
@@ -327,6 +335,8 @@ public:
 
 private:
 
+    void init(bool, bool, const ApplicationHelper*);
+
     Ice::CommunicatorPtr _communicator;
     ApplicationDescriptor _def;
     ApplicationDescriptor _instance;
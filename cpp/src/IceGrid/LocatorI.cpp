@@ -825,8 +825,14 @@ LocatorI::LocatorI(const Ice::CommunicatorPtr& communicator,
 void
 LocatorI::findObjectById_async(const Ice::AMD_Locator_findObjectByIdPtr& cb,
                                const Ice::Identity& id,
-                               const Ice::Current&) const
+                               const Ice::Current& current) const
 {
+    //
+    // If the client subscribed its locator cache with this connection,
+    // it's notified of the changes of this object.
+    //
+    _database->getLocatorCacheTopic()->objectLookedUp(current.con, id);
+
     try
     {
         cb->ice_response(_database->getObjectProxy(id));
@@ -846,6 +852,12 @@ LocatorI::findAdapterById_async(const Ice::AMD_Locator_findAdapterByIdPtr& cb,
                                 const string& id,
                                 const Ice::Current& current) const
 {
+    //
+    // If the client subscribed its locator cache with this connection,
+    // it's notified of the changes of this adapter.
+    //
+    _database->getLocatorCacheTopic()->adapterLookedUp(current.con, id);
+
     LocatorIPtr self = const_cast<LocatorI*>(this);
     bool replicaGroup = false;
     try
@@ -272,6 +272,112 @@ private:
     AdapterDynamicInfo _info;
 };
 
+//
+// The dispatch load of the servers sampled by a keep alive. The load is
+// reported to the registry once all the servers answered or failed.
+//
+class ServerLoadReport : public IceUtil::Shared, private IceUtil::Mutex
+{
+public:
+
+    ServerLoadReport(const NodeIPtr& node, const NodeSessionPrx& session, size_t count) :
+        _node(node), _session(session), _count(count)
+    {
+    }
+
+    void
+    sampled(const string& id, const IceMX::MetricsView& view)
+    {
+        ServerLoad load;
+        if(_node->sampleServerLoad(id, view, load))
+        {
+            IceUtil::Mutex::Lock sync(*this);
+            _loads.push_back(load);
+        }
+        finished();
+    }
+
+    void
+    failed(const string& id, const Ice::Exception& ex)
+    {
+        TraceLevelsPtr traceLevels = _node->getTraceLevels();
+        if(traceLevels->server > 2)
+        {
+            Ice::Trace out(traceLevels->logger, traceLevels->serverCat);
+            out << "couldn't sample the dispatch metrics of server `" << id << "':\n" << ex;
+        }
+        finished();
+    }
+
+    void
+    exception(const Ice::Exception&)
+    {
+        //
+        // Either the registry doesn't support server load reports or the
+        // session is lost, in which case the keep alive thread creates a
+        // new session.
+        //
+    }
+
+private:
+
+    void
+    finished()
+    {
+        ServerLoadSeq loads;
+        {
+            IceUtil::Mutex::Lock sync(*this);
+            if(--_count > 0 || _loads.empty())
+            {
+                return;
+            }
+            loads.swap(_loads);
+        }
+
+        try
+        {
+            _session->begin_reportServerLoads(loads, newCallback_NodeSession_reportServerLoads(
+                                                  this, &ServerLoadReport::exception));
+        }
+        catch(const Ice::LocalException&)
+        {
+        }
+    }
+
+    const NodeIPtr _node;
+    const NodeSessionPrx _session;
+    size_t _count;
+    ServerLoadSeq _loads;
+};
+typedef IceUtil::Handle<ServerLoadReport> ServerLoadReportPtr;
+
+class ServerLoadCallback : public IceUtil::Shared
+{
+public:
+
+    ServerLoadCallback(const ServerLoadReportPtr& report, const string& id) : _report(report), _id(id)
+    {
+    }
+
+    void
+    response(const IceMX::MetricsView& view, Ice::Long)
+    {
+        _report->sampled(_id, view);
+    }
+
+    void
+    exception(const Ice::Exception& ex)
+    {
+        _report->failed(_id, ex);
+    }
+
+private:
+
+    const ServerLoadReportPtr _report;
+    const string _id;
+};
+typedef IceUtil::Handle<ServerLoadCallback> ServerLoadCallbackPtr;
+
 }
 
 NodeI::Update::Update(const NodeIPtr& node, const NodeObserverPrx& observer) : _node(node), _observer(observer)
@@ -307,6 +413,8 @@ NodeI::NodeI(const Ice::ObjectAdapterPtr& adapter,
     _proxy(proxy),
     _redirectErrToOut(false),
     _allowEndpointsOverride(false),
+    _reportServerLoad(false),
+    _prestartServers(0),
     _waitTime(0),
     _instanceName(instanceName),
     _userAccountMapper(mapper),
@@ -324,6 +432,8 @@ NodeI::NodeI(const Ice::ObjectAdapterPtr& adapter,
     const_cast<string&>(_outputDir) = props->getProperty("IceGrid.Node.Output");
     const_cast<bool&>(_redirectErrToOut) = props->getPropertyAsInt("IceGrid.Node.RedirectErrToOut") > 0;
     const_cast<bool&>(_allowEndpointsOverride) = props->getPropertyAsInt("IceGrid.Node.AllowEndpointsOverride") > 0;
+    const_cast<bool&>(_reportServerLoad) = props->getPropertyAsInt("IceGrid.Node.ReportServerLoad") > 0;
+    const_cast<int&>(_prestartServers) = props->getPropertyAsInt("IceGrid.Node.PrestartServers");
 
     //
     // Parse the properties override property.
@@ -829,6 +939,154 @@ NodeI::allowEndpointsOverride() const
     return _allowEndpointsOverride;
 }
 
+bool
+NodeI::reportServerLoad() const
+{
+    return _reportServerLoad;
+}
+
+bool
+NodeI::prestartServer(const string& id)
+{
+    //
+    // Up to IceGrid.Node.PrestartServers on-demand servers are started
+    // when loaded, so that the first request doesn't wait for the server
+    // activation.
+    //
+    IceUtil::Mutex::Lock sync(_prestartLock);
+    if(_prestartedServers.find(id) != _prestartedServers.end())
+    {
+        return true;
+    }
+    else if(static_cast<int>(_prestartedServers.size()) >= _prestartServers)
+    {
+        return false;
+    }
+    _prestartedServers.insert(id);
+    return true;
+}
+
+void
+NodeI::removePrestartedServer(const string& id)
+{
+    IceUtil::Mutex::Lock sync(_prestartLock);
+    _prestartedServers.erase(id);
+}
+
+void
+NodeI::reportServerLoads(const NodeSessionPrx& session)
+{
+    vector<ServerIPtr> servers;
+    {
+        IceUtil::Mutex::Lock sync(_serversLock);
+        for(map<string, set<ServerIPtr> >::const_iterator p = _serversByApplication.begin();
+            p != _serversByApplication.end(); ++p)
+        {
+            servers.insert(servers.end(), p->second.begin(), p->second.end());
+        }
+    }
+
+    vector<pair<string, Ice::ObjectPrx> > processes;
+    for(vector<ServerIPtr>::const_iterator p = servers.begin(); p != servers.end(); ++p)
+    {
+        Ice::ObjectPrx process = (*p)->getProcess();
+        if(process)
+        {
+            processes.push_back(make_pair((*p)->getId(), process));
+        }
+    }
+
+    {
+        //
+        // Forget the samples of the servers which are no longer active.
+        //
+        IceUtil::Mutex::Lock sync(_serverLoadsLock);
+        map<string, pair<Ice::Long, Ice::Long> > samples;
+        for(vector<pair<string, Ice::ObjectPrx> >::const_iterator p = processes.begin(); p != processes.end(); ++p)
+        {
+            map<string, pair<Ice::Long, Ice::Long> >::const_iterator q = _dispatchSamples.find(p->first);
+            if(q != _dispatchSamples.end())
+            {
+                samples.insert(*q);
+            }
+        }
+        _dispatchSamples.swap(samples);
+    }
+
+    if(processes.empty())
+    {
+        return;
+    }
+
+    //
+    // Sample the dispatch metrics of the active servers in parallel. The
+    // keep alive thread doesn't wait for the responses, the load is
+    // reported by the last response.
+    //
+    ServerLoadReportPtr report = new ServerLoadReport(this, session, processes.size());
+    for(vector<pair<string, Ice::ObjectPrx> >::const_iterator p = processes.begin(); p != processes.end(); ++p)
+    {
+        IceMX::MetricsAdminPrx admin = IceMX::MetricsAdminPrx::uncheckedCast(
+            p->second->ice_facet("Metrics")->ice_invocationTimeout(1000));
+        ServerLoadCallbackPtr cb = new ServerLoadCallback(report, p->first);
+        try
+        {
+            admin->begin_getMetricsView(serverLoadMetricsView, IceMX::newCallback_MetricsAdmin_getMetricsView(
+                                            cb, &ServerLoadCallback::response, &ServerLoadCallback::exception));
+        }
+        catch(const Ice::LocalException& ex)
+        {
+            cb->exception(ex);
+        }
+    }
+}
+
+bool
+NodeI::sampleServerLoad(const string& id, const IceMX::MetricsView& view, ServerLoad& load)
+{
+    IceMX::MetricsView::const_iterator q = view.find("Dispatch");
+    if(q == view.end() || q->second.empty())
+    {
+        return false;
+    }
+
+    //
+    // The latency is computed from the dispatches completed since the
+    // previous sample. If the server was restarted, its metrics are
+    // sampled from the start.
+    //
+    const IceMX::MetricsPtr& m = q->second.front();
+    pair<Ice::Long, Ice::Long> sample(m->total - m->current, m->totalLifetime);
+    pair<Ice::Long, Ice::Long> previous(0, 0);
+    {
+        IceUtil::Mutex::Lock sync(_serverLoadsLock);
+        map<string, pair<Ice::Long, Ice::Long> >::iterator r = _dispatchSamples.find(id);
+        if(r == _dispatchSamples.end())
+        {
+            _dispatchSamples.insert(make_pair(id, sample));
+        }
+        else
+        {
+            if(r->second.first <= sample.first)
+            {
+                previous = r->second;
+            }
+            r->second = sample;
+        }
+    }
+
+    load.id = id;
+    load.latency = -1.0f;
+    if(sample.first > previous.first)
+    {
+        // The total lifetime is in microseconds.
+        load.latency = static_cast<float>(sample.second - previous.second) / 1000.0f /
+            static_cast<float>(sample.first - previous.first);
+    }
+    load.dispatching = m->current;
+    return true;
+}
+
 NodeSessionPrx
 NodeI::registerWithRegistry(const InternalRegistryPrx& registry)
 {
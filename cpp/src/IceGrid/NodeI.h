@@ -11,6 +11,7 @@
 #include <IceGrid/PlatformInfo.h>
 #include <IceGrid/UserAccountMapper.h>
 #include <IceGrid/FileCache.h>
+#include <Ice/Metrics.h>
 #include <set>
 
 namespace IceGrid
@@ -33,6 +34,12 @@ class NodeSessionManager;
 class NodeI;
 typedef IceUtil::Handle<NodeI> NodeIPtr;
 
+//
+// The metrics view of the server dispatches sampled by the node to
+// report the load of the servers.
+//
+const std::string serverLoadMetricsView = "IceGridLoad";
+
 class NodeI : public Node, public IceUtil::Monitor<IceUtil::Mutex>
 {
 public:
@@ -120,6 +127,11 @@ public:
     std::string getOutputDir() const;
     bool getRedirectErrToOut() const;
     bool allowEndpointsOverride() const;
+    bool reportServerLoad() const;
+    bool prestartServer(const std::string&);
+    void removePrestartedServer(const std::string&);
+    void reportServerLoads(const NodeSessionPrx&);
+    bool sampleServerLoad(const std::string&, const IceMX::MetricsView&, ServerLoad&);
 
     NodeSessionPrx registerWithRegistry(const InternalRegistryPrx&);
     void checkConsistency(const NodeSessionPrx&);
@@ -165,6 +177,8 @@ private:
     const std::string _outputDir;
     const bool _redirectErrToOut;
     const bool _allowEndpointsOverride;
+    const bool _reportServerLoad;
+    const int _prestartServers;
     const Ice::Int _waitTime;
     const std::string _instanceName;
     const UserAccountMapperPrx _userAccountMapper;
@@ -188,6 +202,16 @@ private:
     IceUtil::Mutex _serversLock;
     std::map<std::string, std::set<ServerIPtr> > _serversByApplication;
     std::set<std::string> _patchInProgress;
+
+    //
+    // The number of completed dispatches and their total duration of
+    // each server, from the previous dispatch metrics sample.
+    //
+    IceUtil::Mutex _serverLoadsLock;
+    std::map<std::string, std::pair<Ice::Long, Ice::Long> > _dispatchSamples;
+
+    IceUtil::Mutex _prestartLock;
+    std::set<std::string> _prestartedServers;
 };
 typedef IceUtil::Handle<NodeI> NodeIPtr;
 
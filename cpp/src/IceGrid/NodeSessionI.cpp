@@ -195,6 +195,36 @@ NodeSessionI::keepAlive(const LoadInfo& load, const Ice::Current&)
     }
 }
 
+void
+NodeSessionI::reportServerLoads(const ServerLoadSeq& loads, const Ice::Current&)
+{
+    {
+        Lock sync(*this);
+        if(_destroy)
+        {
+            throw Ice::ObjectNotExistException(__FILE__, __LINE__);
+        }
+    }
+
+    for(ServerLoadSeq::const_iterator p = loads.begin(); p != loads.end(); ++p)
+    {
+        try
+        {
+            _database->getServer(p->id)->updateDispatchLoad(p->latency, p->dispatching);
+        }
+        catch(const ServerNotExistException&)
+        {
+            // This might happen if the application is updated concurrently.
+        }
+    }
+
+    if(_traceLevels->node > 2)
+    {
+        Ice::Trace out(_traceLevels->logger, _traceLevels->nodeCat);
+        out << "node `" << _info->name << "' reported the load of " << loads.size() << " server(s)";
+    }
+}
+
 void
 NodeSessionI::setReplicaObserver(const ReplicaObserverPrx& observer, const Ice::Current&)
 {
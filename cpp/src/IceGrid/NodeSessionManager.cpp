@@ -207,6 +207,10 @@ NodeSessionKeepAliveThread::keepAlive(const NodeSessionPrx& session)
     try
     {
         session->keepAlive(_node->getPlatformInfo().getLoadInfo());
+        if(_node->reportServerLoad())
+        {
+            _node->reportServerLoads(session);
+        }
         return true;
     }
     catch(const Ice::LocalException& ex)
@@ -110,6 +110,17 @@ ObjectCache::get(const Ice::Identity& id) const
     return entry;
 }
 
+ObjectEntryPtr
+ObjectCache::getFromSnapshot(const Ice::Identity& id) const
+{
+    ObjectEntryPtr entry = getSnapshotImpl(id);
+    if(!entry)
+    {
+        throw ObjectNotRegisteredException(id);
+    }
+    return entry;
+}
+
 void
 ObjectCache::remove(const Ice::Identity& id)
 {
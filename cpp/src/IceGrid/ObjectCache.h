@@ -44,6 +44,7 @@ public:
 
     void add(const ObjectInfo&, const std::string&, const std::string&);
     ObjectEntryPtr get(const Ice::Identity&) const;
+    ObjectEntryPtr getFromSnapshot(const Ice::Identity&) const;
     void remove(const Ice::Identity&);
 
     std::vector<ObjectEntryPtr> getObjectsByType(const std::string&);
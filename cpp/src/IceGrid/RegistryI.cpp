@@ -687,9 +687,11 @@ RegistryI::setupLocator(const RegistryPrx& registry, const QueryPrx& query)
 
     locatorId.name = "Locator";
     _clientAdapter->add(locator, locatorId);
+    _clientAdapter->addFacet(_database->getLocatorCacheTopic(), locatorId, "LocatorCache");
 
     locatorId.name = "Locator-" + _replicaName;
     _clientAdapter->add(locator, locatorId);
+    _clientAdapter->addFacet(_database->getLocatorCacheTopic(), locatorId, "LocatorCache");
 
     return LocatorPrx::uncheckedCast(_registryAdapter->addWithUUID(locator));
 }
@@ -68,6 +68,12 @@ namespace IceGrid
         const ServerEntryPtr _entry;
     };
 
+    //
+    // The weight of a new dispatch latency sample in the moving average
+    // of the dispatch latency of a server.
+    //
+    const float dispatchLatencyWeight = 0.3f;
+
 }
 
 CheckUpdateResult::CheckUpdateResult(const string& server,
@@ -360,7 +366,9 @@ ServerEntry::ServerEntry(ServerCache& cache, const string& id) :
     _deactivationTimeout(-1),
     _synchronizing(false),
     _updated(false),
-    _noRestart(false)
+    _noRestart(false),
+    _dispatchLatency(-1.0f),
+    _dispatching(0)
 {
 }
 
@@ -665,6 +673,36 @@ ServerEntry::getLoad(LoadSample sample) const
     }
 }
 
+void
+ServerEntry::updateDispatchLoad(float latency, int dispatching)
+{
+    Lock sync(*this);
+    if(latency >= 0.f)
+    {
+        if(_dispatchLatency < 0.f)
+        {
+            _dispatchLatency = latency;
+        }
+        else
+        {
+            _dispatchLatency = dispatchLatencyWeight * latency + (1.0f - dispatchLatencyWeight) * _dispatchLatency;
+        }
+    }
+    _dispatching = dispatching;
+}
+
+float
+ServerEntry::getDispatchScore() const
+{
+    Lock sync(*this);
+
+    //
+    // A server without a reported latency scores 0 so that it gets
+    // requests and reports a latency.
+    //
+    return _dispatchLatency < 0.f ? 0.f : _dispatchLatency * static_cast<float>(1 + _dispatching);
+}
+
 void
 ServerEntry::syncImpl()
 {
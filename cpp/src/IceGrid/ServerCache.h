@@ -87,6 +87,8 @@ public:
     AdapterPrx getAdapter(const std::string&, bool);
     AdapterPrx getAdapter(int&, int&, const std::string&, bool);
     float getLoad(LoadSample) const;
+    void updateDispatchLoad(float, int);
+    float getDispatchScore() const;
 
     bool canRemove();
     CheckUpdateResultPtr checkUpdate(const ServerInfo&, bool);
@@ -127,6 +129,9 @@ private:
     std::vector<SynchronizationCallbackPtr> _callbacks;
 
     SessionIPtr _allocationSession;
+
+    float _dispatchLatency; // The moving average of the dispatch latency, or -1 if not reported yet.
+    int _dispatching;
 };
 typedef IceUtil::Handle<ServerEntry> ServerEntryPtr;
 typedef std::vector<ServerEntryPtr> ServerEntrySeq;
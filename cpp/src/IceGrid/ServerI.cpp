@@ -227,9 +227,11 @@ class DelayedStart : public IceUtil::TimerTask
 {
 public:
 
-    DelayedStart(const ServerIPtr& server, const TraceLevelsPtr& traceLevels) :
+    DelayedStart(const ServerIPtr& server, const TraceLevelsPtr& traceLevels,
+                 ServerI::ServerActivation activation = ServerI::Always) :
         _server(server),
-        _traceLevels(traceLevels)
+        _traceLevels(traceLevels),
+        _activation(activation)
     {
     }
 
@@ -237,14 +239,25 @@ public:
     {
         try
         {
-            _server->start(ServerI::Always);
+            _server->start(_activation);
         }
         catch(const ServerStartException& ex)
         {
-            Ice::Error out(_traceLevels->logger);
-            out << "couldn't reactivate server `" << _server->getId()
-                << "' with `always' activation mode after failure:\n"
-                << ex.reason;
+            if(_activation == ServerI::Always)
+            {
+                Ice::Error out(_traceLevels->logger);
+                out << "couldn't reactivate server `" << _server->getId()
+                    << "' with `always' activation mode after failure:\n"
+                    << ex.reason;
+            }
+            else if(_traceLevels->server > 0)
+            {
+                //
+                // The server might already be activated on demand.
+                //
+                Ice::Trace out(_traceLevels->logger, _traceLevels->serverCat);
+                out << "couldn't pre-start server `" << _server->getId() << "':\n" << ex.reason;
+            }
         }
         catch(const Ice::ObjectNotExistException&)
         {
@@ -255,6 +268,7 @@ private:
 
     const ServerIPtr _server;
     const TraceLevelsPtr _traceLevels;
+    const ServerI::ServerActivation _activation;
 };
 
 class ResetPropertiesCB : public IceUtil::Shared
@@ -822,6 +836,7 @@ ServerI::ServerI(const NodeIPtr& node, const ServerPrx& proxy, const string& ser
     _state(ServerI::Inactive),
     _activation(ServerI::Disabled),
     _failureTime(IceUtil::Time::now(IceUtil::Time::Monotonic)), // Ensure that _activation is init. in updateImpl().
+    _prestarted(false),
     _pid(0)
 {
     assert(_node->getActivator());
@@ -945,11 +960,13 @@ ServerI::setEnabled(bool enabled, const ::Ice::Current&)
             _failureTime = IceUtil::Time();
             _activation = toServerActivation(_desc->activation);
             activate = _state == Inactive && _activation == Always;
+            releasePrestart();
         }
         else if(!enabled && (_activation != Disabled || _failureTime != IceUtil::Time()))
         {
             _failureTime = IceUtil::Time();
             _activation = Disabled;
+            releasePrestart();
             if(_timerTask)
             {
                 _node->getTimer()->cancel(_timerTask);
@@ -1133,6 +1150,7 @@ ServerI::start(ServerActivation activation, const AMD_Server_startPtr& amdCB)
             {
                 _activation = _previousActivation;
                 _failureTime = IceUtil::Time();
+                releasePrestart();
             }
         }
 
@@ -1565,6 +1583,22 @@ ServerI::disableOnFailure()
         _previousActivation = _activation;
         _activation = Disabled;
         _failureTime = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        releasePrestart();
+    }
+}
+
+void
+ServerI::releasePrestart()
+{
+    //
+    // Release the pre-start slot of the server once it's no longer
+    // activated on demand, another on-demand server of the node can
+    // then be pre-started.
+    //
+    if(_prestarted && _activation != OnDemand)
+    {
+        _prestarted = false;
+        _node->removePrestartedServer(_id);
     }
 }
 
@@ -2208,6 +2242,7 @@ ServerI::updateImpl(const InternalServerDescriptorPtr& descriptor)
     {
         _activation = toServerActivation(_desc->activation);
         _failureTime = IceUtil::Time();
+        releasePrestart();
     }
 
     if(_timerTask)
@@ -2926,6 +2961,11 @@ ServerI::setStateNoSync(InternalServerState st, const std::string& reason)
             // IGNORE
         }
         _desc = 0;
+        if(_prestarted)
+        {
+            _prestarted = false;
+            _node->removePrestartedServer(_id);
+        }
     }
     else if(_state == Inactive)
     {
@@ -2942,6 +2982,25 @@ ServerI::setStateNoSync(InternalServerState st, const std::string& reason)
                 // Ignore, timer is destroyed because node is shutting down.
             }
         }
+        else if(_activation == OnDemand && !_prestarted && _node->prestartServer(_id))
+        {
+            //
+            // Pre-start the on-demand server once loaded to save the
+            // activation latency of the first request. If the server is
+            // deactivated, it's activated on demand again.
+            //
+            _prestarted = true;
+            assert(!_timerTask);
+            _timerTask = new DelayedStart(this, _node->getTraceLevels(), OnDemand);
+            try
+            {
+                _node->getTimer()->schedule(_timerTask, IceUtil::Time());
+            }
+            catch(const IceUtil::Exception&)
+            {
+                // Ignore, timer is destroyed because node is shutting down.
+            }
+        }
         else if(_activation == Disabled && _disableOnFailure > 0 && _failureTime != IceUtil::Time())
         {
             //
@@ -3199,6 +3258,15 @@ ServerI::getProperties(const InternalServerDescriptorPtr& desc)
         }
     }
 
+    //
+    // Enable the metrics view of the dispatches which the node samples to
+    // report the load of the server.
+    //
+    if(_node->reportServerLoad() && desc->processRegistered)
+    {
+        props.push_back(createProperty("IceMX.Metrics." + serverLoadMetricsView + ".Map.Dispatch.GroupBy", "none"));
+    }
+
     //
     // Add the locator proxy property and the node properties override
     //
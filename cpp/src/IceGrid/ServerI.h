@@ -136,6 +136,7 @@ private:
     bool checkActivation();
     void checkDestroyed() const;
     void disableOnFailure();
+    void releasePrestart();
 
     void setState(InternalServerState, const std::string& = std::string());
     ServerCommandPtr nextCommand();
@@ -171,6 +172,7 @@ private:
     ServerActivation _previousActivation;
     IceUtil::TimerTaskPtr _timerTask;
     bool _waitForReplication;
+    bool _prestarted;
     std::string _stdErrFile;
     std::string _stdOutFile;
     Ice::StringSeq _logs;
@@ -5,6 +5,8 @@
 #include <Ice/Ice.h>
 #include <IceGrid/Topics.h>
 #include <IceGrid/DescriptorHelper.h>
+#include <IceGrid/AdapterCache.h>
+#include <IceGrid/TraceLevels.h>
 
 using namespace std;
 using namespace IceGrid;
@@ -22,6 +24,258 @@ Ice::EncodingVersion encodings[] = {
     { 1, 1 }
 };
 
+class FlushTask : public IceUtil::TimerTask
+{
+public:
+
+    FlushTask(const NodeObserverTopicPtr& topic) : _topic(topic)
+    {
+    }
+
+    virtual void
+    runTimerTask()
+    {
+        _topic->flush();
+    }
+
+private:
+
+    const NodeObserverTopicPtr _topic;
+};
+
+//
+// Keep the given number of servers and adapters in the node and return
+// the others.
+//
+NodeDynamicInfo
+splitNode(NodeDynamicInfo& node, size_t size)
+{
+    NodeDynamicInfo rest;
+    rest.info = node.info;
+    if(node.servers.size() > size)
+    {
+        rest.servers.assign(node.servers.begin() + size, node.servers.end());
+        node.servers.erase(node.servers.begin() + size, node.servers.end());
+    }
+    size -= node.servers.size();
+    if(node.adapters.size() > size)
+    {
+        rest.adapters.assign(node.adapters.begin() + size, node.adapters.end());
+        node.adapters.erase(node.adapters.begin() + size, node.adapters.end());
+    }
+    return rest;
+}
+
+void
+sendUpdates(const NodeObserverPrx& observer, const NodeDynamicInfo& node, const Ice::Context& ctx)
+{
+    for(ServerDynamicInfoSeq::const_iterator p = node.servers.begin(); p != node.servers.end(); ++p)
+    {
+        observer->updateServer(node.info.name, *p, ctx);
+    }
+    for(AdapterDynamicInfoSeq::const_iterator p = node.adapters.begin(); p != node.adapters.end(); ++p)
+    {
+        observer->updateAdapter(node.info.name, *p, ctx);
+    }
+}
+
+}
+
+LocatorCacheTopic::LocatorCacheTopic(const AdapterCache& adapterCache, const TraceLevelsPtr& traceLevels) :
+    _adapterCache(adapterCache),
+    _traceLevels(traceLevels)
+{
+}
+
+void
+LocatorCacheTopic::subscribe(const Ice::LocatorCacheObserverPrx& observer, const Ice::StringSeq& adapterIds,
+                             const Ice::IdentitySeq& objectIds, const Ice::Current& current)
+{
+    if(!observer || !current.con)
+    {
+        return;
+    }
+
+    Lock sync(*this);
+    reap();
+
+    //
+    // The observer is called back over the connection of the
+    // subscription with oneway requests, the client clears its cache
+    // if this connection is closed.
+    //
+    Subscriber& subscriber = _subscribers[current.con];
+    subscriber.observer = Ice::LocatorCacheObserverPrx::uncheckedCast(
+        current.con->createProxy(observer->ice_getIdentity())->ice_oneway());
+    subscriber.adapters.insert(adapterIds.begin(), adapterIds.end());
+    subscriber.objects.insert(objectIds.begin(), objectIds.end());
+
+    if(_traceLevels->locator > 1)
+    {
+        Ice::Trace out(_traceLevels->logger, _traceLevels->locatorCat);
+        out << "subscribed locator cache with " << adapterIds.size() << " adapter(s) and " << objectIds.size()
+            << " object(s)\n" << current.con->toString();
+    }
+}
+
+void
+LocatorCacheTopic::adapterLookedUp(const Ice::ConnectionPtr& con, const string& id)
+{
+    if(!con)
+    {
+        return;
+    }
+
+    Lock sync(*this);
+    map<Ice::ConnectionPtr, Subscriber>::iterator p = _subscribers.find(con);
+    if(p != _subscribers.end())
+    {
+        p->second.adapters.insert(id);
+    }
+}
+
+void
+LocatorCacheTopic::adaptersChanged(const set<string>& ids)
+{
+    //
+    // Clients look up server adapters through their replica group, the
+    // replica group of a changed server adapter changed as well.
+    //
+    set<string> changed;
+    for(set<string>::const_iterator p = ids.begin(); p != ids.end(); ++p)
+    {
+        if(p->empty())
+        {
+            continue;
+        }
+        changed.insert(*p);
+        try
+        {
+            ServerAdapterEntryPtr adapter = ServerAdapterEntryPtr::dynamicCast(_adapterCache.get(*p));
+            if(adapter && !adapter->getReplicaGroupId().empty())
+            {
+                changed.insert(adapter->getReplicaGroupId());
+            }
+        }
+        catch(const AdapterNotExistException&)
+        {
+        }
+    }
+
+    Lock sync(*this);
+    reap();
+    for(map<Ice::ConnectionPtr, Subscriber>::const_iterator p = _subscribers.begin(); p != _subscribers.end(); ++p)
+    {
+        Ice::StringSeq notified;
+        for(set<string>::const_iterator q = changed.begin(); q != changed.end(); ++q)
+        {
+            if(p->second.adapters.find(*q) != p->second.adapters.end())
+            {
+                notified.push_back(*q);
+            }
+        }
+        if(notified.empty())
+        {
+            continue;
+        }
+
+        if(_traceLevels->locator > 1)
+        {
+            Ice::Trace out(_traceLevels->logger, _traceLevels->locatorCat);
+            out << "notifying locator cache of " << notified.size() << " changed adapter(s)\n" << p->first->toString();
+        }
+
+        try
+        {
+            p->second.observer->begin_adaptersChanged(notified);
+        }
+        catch(const Ice::LocalException&)
+        {
+            // The connection is reaped with the next update.
+        }
+    }
+}
+
+void
+LocatorCacheTopic::objectLookedUp(const Ice::ConnectionPtr& con, const Ice::Identity& id)
+{
+    if(!con)
+    {
+        return;
+    }
+
+    Lock sync(*this);
+    map<Ice::ConnectionPtr, Subscriber>::iterator p = _subscribers.find(con);
+    if(p != _subscribers.end())
+    {
+        p->second.objects.insert(id);
+    }
+}
+
+void
+LocatorCacheTopic::objectChanged(const Ice::Identity& id)
+{
+    set<Ice::Identity> ids;
+    ids.insert(id);
+    objectsChanged(ids);
+}
+
+void
+LocatorCacheTopic::objectsChanged(const set<Ice::Identity>& ids)
+{
+    Lock sync(*this);
+    reap();
+    for(map<Ice::ConnectionPtr, Subscriber>::const_iterator p = _subscribers.begin(); p != _subscribers.end(); ++p)
+    {
+        Ice::IdentitySeq notified;
+        for(set<Ice::Identity>::const_iterator q = ids.begin(); q != ids.end(); ++q)
+        {
+            if(p->second.objects.find(*q) != p->second.objects.end())
+            {
+                notified.push_back(*q);
+            }
+        }
+        if(notified.empty())
+        {
+            continue;
+        }
+
+        if(_traceLevels->locator > 1)
+        {
+            Ice::Trace out(_traceLevels->logger, _traceLevels->locatorCat);
+            out << "notifying locator cache of " << notified.size() << " changed object(s)\n" << p->first->toString();
+        }
+
+        try
+        {
+            p->second.observer->begin_objectsChanged(notified);
+        }
+        catch(const Ice::LocalException&)
+        {
+            // The connection is reaped with the next update.
+        }
+    }
+}
+
+void
+LocatorCacheTopic::reap()
+{
+    //
+    // Remove the subscribers whose connection is closed.
+    //
+    map<Ice::ConnectionPtr, Subscriber>::iterator p = _subscribers.begin();
+    while(p != _subscribers.end())
+    {
+        try
+        {
+            p->first->throwException();
+            ++p;
+        }
+        catch(const Ice::LocalException&)
+        {
+            _subscribers.erase(p++);
+        }
+    }
 }
 
 ObserverTopic::ObserverTopic(const IceStorm::TopicManagerPrx& topicManager, const string& name, Ice::Long dbSerial) :
@@ -357,8 +611,16 @@ RegistryObserverTopic::initObserver(const Ice::ObjectPrx& obsv)
 }
 
 NodeObserverTopic::NodeObserverTopic(const IceStorm::TopicManagerPrx& topicManager,
-                                     const Ice::ObjectAdapterPtr& adapter) :
-    ObserverTopic(topicManager, "NodeObserver")
+                                     const Ice::ObjectAdapterPtr& adapter,
+                                     const LocatorCacheTopicPtr& locatorCacheTopic) :
+    ObserverTopic(topicManager, "NodeObserver"),
+    _locatorCacheTopic(locatorCacheTopic),
+    _window(IceUtil::Time::milliSeconds(adapter->getCommunicator()->getProperties()->getPropertyAsInt(
+                "IceGrid.Registry.AdminSessionObserverWindow"))),
+    _pageSize(adapter->getCommunicator()->getProperties()->getPropertyAsInt(
+                  "IceGrid.Registry.AdminSessionObserverPageSize")),
+    _timer(_window > IceUtil::Time() ? new IceUtil::Timer() : 0),
+    _flushScheduled(false)
 {
     _publishers = getPublishers<NodeObserverPrx>();
     try
@@ -384,6 +646,7 @@ NodeObserverTopic::nodeUp(const NodeDynamicInfo& info, const Ice::Current&)
     {
         return;
     }
+    flushNoSync();
     updateSerial();
     _nodes.insert(make_pair(info.info.name, info));
     for(ServerDynamicInfoSeq::const_iterator p = info.servers.begin(); p != info.servers.end(); ++p)
@@ -461,6 +724,22 @@ NodeObserverTopic::updateServer(const string& node, const ServerDynamicInfo& ser
         _serverStatus.erase(server.id);
     }
 
+    if(_timer)
+    {
+        const pair<string, string> key = make_pair(node, server.id);
+        if(_pendingServers.find(key) == _pendingServers.end())
+        {
+            _pendingUpdates.push_back(make_pair(true, key));
+        }
+        _pendingServers[key] = server;
+        if(!_flushScheduled)
+        {
+            _timer->schedule(new FlushTask(this), _window);
+            _flushScheduled = true;
+        }
+        return;
+    }
+
     try
     {
         for(vector<NodeObserverPrx>::const_iterator q = _publishers.begin(); q != _publishers.end(); ++q)
@@ -478,6 +757,14 @@ NodeObserverTopic::updateServer(const string& node, const ServerDynamicInfo& ser
 void
 NodeObserverTopic::updateAdapter(const string& node, const AdapterDynamicInfo& adapter, const Ice::Current&)
 {
+    //
+    // The endpoints of the server adapter changed, notify the locator
+    // clients which cached them.
+    //
+    set<string> ids;
+    ids.insert(adapter.id);
+    _locatorCacheTopic->adaptersChanged(ids);
+
     Lock sync(*this);
     if(_topics.empty())
     {
@@ -517,6 +804,22 @@ NodeObserverTopic::updateAdapter(const string& node, const AdapterDynamicInfo& a
         adapters.push_back(adapter);
     }
 
+    if(_timer)
+    {
+        const pair<string, string> key = make_pair(node, adapter.id);
+        if(_pendingAdapters.find(key) == _pendingAdapters.end())
+        {
+            _pendingUpdates.push_back(make_pair(false, key));
+        }
+        _pendingAdapters[key] = adapter;
+        if(!_flushScheduled)
+        {
+            _timer->schedule(new FlushTask(this), _window);
+            _flushScheduled = true;
+        }
+        return;
+    }
+
     try
     {
         for(vector<NodeObserverPrx>::const_iterator q = _publishers.begin(); q != _publishers.end(); ++q)
@@ -540,6 +843,7 @@ NodeObserverTopic::nodeDown(const string& name)
         return;
     }
 
+    flushNoSync();
     updateSerial();
 
     if(_nodes.find(name) == _nodes.end())
@@ -572,13 +876,107 @@ void
 NodeObserverTopic::initObserver(const Ice::ObjectPrx& obsv)
 {
     NodeObserverPrx observer = NodeObserverPrx::uncheckedCast(obsv);
+    const Ice::Context ctx = getContext(_serial);
+
+    //
+    // Without a page size, all the nodes are sent with nodeInit. Otherwise,
+    // nodeInit and nodeUp carry at most a page of servers and adapters, the
+    // servers and adapters of a node which don't fit are sent with
+    // updateServer and updateAdapter.
+    //
+    if(_pageSize <= 0)
+    {
+        NodeDynamicInfoSeq nodes;
+        nodes.reserve(_nodes.size());
+        for(map<string, NodeDynamicInfo>::const_iterator p = _nodes.begin(); p != _nodes.end(); ++p)
+        {
+            nodes.push_back(p->second);
+        }
+        observer->nodeInit(nodes, ctx);
+        return;
+    }
+
+    const size_t pageSize = static_cast<size_t>(_pageSize);
     NodeDynamicInfoSeq nodes;
-    nodes.reserve(_nodes.size());
-    for(map<string, NodeDynamicInfo>::const_iterator p = _nodes.begin(); p != _nodes.end(); ++p)
+    NodeDynamicInfoSeq rest;
+    size_t size = 0;
+    map<string, NodeDynamicInfo>::const_iterator p = _nodes.begin();
+    for(; p != _nodes.end() && size < pageSize; ++p)
     {
         nodes.push_back(p->second);
+        rest.push_back(splitNode(nodes.back(), pageSize - size));
+        size += nodes.back().servers.size() + nodes.back().adapters.size();
+    }
+    observer->nodeInit(nodes, ctx);
+    for(NodeDynamicInfoSeq::const_iterator q = rest.begin(); q != rest.end(); ++q)
+    {
+        sendUpdates(observer, *q, ctx);
+    }
+
+    for(; p != _nodes.end(); ++p)
+    {
+        NodeDynamicInfo node = p->second;
+        NodeDynamicInfo nodeRest = splitNode(node, pageSize);
+        observer->nodeUp(node, ctx);
+        sendUpdates(observer, nodeRest, ctx);
+    }
+}
+
+void
+NodeObserverTopic::destroy()
+{
+    ObserverTopic::destroy();
+
+    //
+    // The timer must be destroyed without the topic locked, a flush task
+    // might be running.
+    //
+    if(_timer)
+    {
+        _timer->destroy();
+    }
+}
+
+void
+NodeObserverTopic::flush()
+{
+    Lock sync(*this);
+    _flushScheduled = false;
+    flushNoSync();
+}
+
+void
+NodeObserverTopic::flushNoSync()
+{
+    if(!_topics.empty())
+    {
+        try
+        {
+            for(vector<pair<bool, pair<string, string> > >::const_iterator p = _pendingUpdates.begin();
+                p != _pendingUpdates.end(); ++p)
+            {
+                for(vector<NodeObserverPrx>::const_iterator q = _publishers.begin(); q != _publishers.end(); ++q)
+                {
+                    if(p->first)
+                    {
+                        (*q)->updateServer(p->second.first, _pendingServers[p->second]);
+                    }
+                    else
+                    {
+                        (*q)->updateAdapter(p->second.first, _pendingAdapters[p->second]);
+                    }
+                }
+            }
+        }
+        catch(const Ice::LocalException& ex)
+        {
+            Ice::Warning out(_logger);
+            out << "unexpected exception while publishing `updateServer' or `updateAdapter' update:\n" << ex;
+        }
     }
-    observer->nodeInit(nodes, getContext(_serial));
+    _pendingUpdates.clear();
+    _pendingServers.clear();
+    _pendingAdapters.clear();
 }
 
 bool
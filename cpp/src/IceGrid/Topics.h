@@ -6,6 +6,7 @@
 #define ICEGRID_TOPICS_H
 
 #include <IceUtil/Mutex.h>
+#include <IceUtil/Timer.h>
 #include <IceStorm/IceStorm.h>
 #include <IceGrid/Internal.h>
 #include <IceGrid/Registry.h>
@@ -14,6 +15,50 @@
 namespace IceGrid
 {
 
+class AdapterCache;
+
+class TraceLevels;
+typedef IceUtil::Handle<TraceLevels> TraceLevelsPtr;
+
+//
+// The LocatorCache facet of the locator. The registry notifies the
+// subscribed clients of the changes of the adapters, replica groups and
+// well-known objects they looked up over the connection of the
+// subscription, so that they can keep them in their locator cache for a
+// long time.
+//
+class LocatorCacheTopic : public Ice::LocatorCache, public IceUtil::Mutex
+{
+public:
+
+    LocatorCacheTopic(const AdapterCache&, const TraceLevelsPtr&);
+
+    virtual void subscribe(const Ice::LocatorCacheObserverPrx&, const Ice::StringSeq&, const Ice::IdentitySeq&,
+                           const Ice::Current&);
+
+    void adapterLookedUp(const Ice::ConnectionPtr&, const std::string&);
+    void adaptersChanged(const std::set<std::string>&);
+    void objectLookedUp(const Ice::ConnectionPtr&, const Ice::Identity&);
+    void objectChanged(const Ice::Identity&);
+    void objectsChanged(const std::set<Ice::Identity>&);
+
+private:
+
+    void reap();
+
+    struct Subscriber
+    {
+        Ice::LocatorCacheObserverPrx observer;
+        std::set<std::string> adapters;
+        std::set<Ice::Identity> objects;
+    };
+
+    const AdapterCache& _adapterCache;
+    const TraceLevelsPtr _traceLevels;
+    std::map<Ice::ConnectionPtr, Subscriber> _subscribers;
+};
+typedef IceUtil::Handle<LocatorCacheTopic> LocatorCacheTopicPtr;
+
 class ObserverTopic : public IceUtil::Monitor<IceUtil::Mutex>, public virtual Ice::Object
 {
 public:
@@ -23,7 +68,7 @@ public:
 
     int subscribe(const Ice::ObjectPrx&, const std::string& = std::string());
     void unsubscribe(const Ice::ObjectPrx&, const std::string& = std::string());
-    void destroy();
+    virtual void destroy();
 
     void receivedUpdate(const std::string&, int, const std::string&);
 
@@ -80,11 +125,19 @@ private:
 };
 typedef IceUtil::Handle<RegistryObserverTopic> RegistryObserverTopicPtr;
 
+//
+// The server and adapter updates of the nodes are coalesced if the
+// IceGrid.Registry.AdminSessionObserverWindow property is set: only the
+// last update of each server and adapter received during the window is
+// published to the admin session observers. The initial nodeInit update
+// of an observer is limited to IceGrid.Registry.AdminSessionObserverPageSize
+// servers and adapters, the remaining nodes are sent with nodeUp updates.
+//
 class NodeObserverTopic : public ObserverTopic, public NodeObserver
 {
 public:
 
-    NodeObserverTopic(const IceStorm::TopicManagerPrx&, const Ice::ObjectAdapterPtr&);
+    NodeObserverTopic(const IceStorm::TopicManagerPrx&, const Ice::ObjectAdapterPtr&, const LocatorCacheTopicPtr&);
 
     virtual void nodeInit(const NodeDynamicInfoSeq&, const Ice::Current&);
     virtual void nodeUp(const NodeDynamicInfo&, const Ice::Current&);
@@ -96,15 +149,34 @@ public:
 
     void nodeDown(const std::string&);
     virtual void initObserver(const Ice::ObjectPrx&);
+    virtual void destroy();
 
     bool isServerEnabled(const std::string&) const;
 
+    void flush();
+
 private:
 
+    void flushNoSync();
+
     const NodeObserverPrx _externalPublisher;
+    const LocatorCacheTopicPtr _locatorCacheTopic;
+    const IceUtil::Time _window;
+    const int _pageSize;
+    const IceUtil::TimerPtr _timer;
     std::vector<NodeObserverPrx> _publishers;
     std::map<std::string, NodeDynamicInfo> _nodes;
     std::map<std::string, bool> _serverStatus;
+
+    //
+    // The updates not published yet: the node and id of the updated
+    // servers (true) and adapters (false) in the order of their first
+    // update, and their last update.
+    //
+    std::vector<std::pair<bool, std::pair<std::string, std::string> > > _pendingUpdates;
+    std::map<std::pair<std::string, std::string>, ServerDynamicInfo> _pendingServers;
+    std::map<std::pair<std::string, std::string>, AdapterDynamicInfo> _pendingAdapters;
+    bool _flushScheduled;
 };
 typedef IceUtil::Handle<NodeObserverTopic> NodeObserverTopicPtr;
 
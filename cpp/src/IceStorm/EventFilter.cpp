@@ -0,0 +1,344 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IceStorm/EventFilter.h>
+
+#include <cctype>
+#include <cstring>
+
+using namespace std;
+using namespace IceStorm;
+
+namespace
+{
+
+class OpFilter : public EventFilter
+{
+public:
+
+    OpFilter(const string& op, bool equal) :
+        _op(op),
+        _equal(equal)
+    {
+    }
+
+    virtual bool
+    match(const EventData& event) const
+    {
+        return (event.op == _op) == _equal;
+    }
+
+private:
+
+    const string _op;
+    const bool _equal;
+};
+
+class ContextFilter : public EventFilter
+{
+public:
+
+    ContextFilter(const string& key, const string& value, bool equal) :
+        _key(key),
+        _value(value),
+        _equal(equal)
+    {
+    }
+
+    virtual bool
+    match(const EventData& event) const
+    {
+        Ice::Context::const_iterator p = event.context.find(_key);
+        return (p != event.context.end() && p->second == _value) == _equal;
+    }
+
+private:
+
+    const string _key;
+    const string _value;
+    const bool _equal;
+};
+
+class ContextKeyFilter : public EventFilter
+{
+public:
+
+    ContextKeyFilter(const string& key) :
+        _key(key)
+    {
+    }
+
+    virtual bool
+    match(const EventData& event) const
+    {
+        return event.context.find(_key) != event.context.end();
+    }
+
+private:
+
+    const string _key;
+};
+
+class NotFilter : public EventFilter
+{
+public:
+
+    NotFilter(const EventFilterPtr& filter) :
+        _filter(filter)
+    {
+    }
+
+    virtual bool
+    match(const EventData& event) const
+    {
+        return !_filter->match(event);
+    }
+
+private:
+
+    const EventFilterPtr _filter;
+};
+
+class AndFilter : public EventFilter
+{
+public:
+
+    AndFilter(const vector<EventFilterPtr>& filters) :
+        _filters(filters)
+    {
+    }
+
+    virtual bool
+    match(const EventData& event) const
+    {
+        for(vector<EventFilterPtr>::const_iterator p = _filters.begin(); p != _filters.end(); ++p)
+        {
+            if(!(*p)->match(event))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+
+    const vector<EventFilterPtr> _filters;
+};
+
+class OrFilter : public EventFilter
+{
+public:
+
+    OrFilter(const vector<EventFilterPtr>& filters) :
+        _filters(filters)
+    {
+    }
+
+    virtual bool
+    match(const EventData& event) const
+    {
+        for(vector<EventFilterPtr>::const_iterator p = _filters.begin(); p != _filters.end(); ++p)
+        {
+            if((*p)->match(event))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+
+    const vector<EventFilterPtr> _filters;
+};
+
+//
+// Recursive descent parser for the filter expressions, see EventFilter.h
+// for the grammar.
+//
+class Parser
+{
+public:
+
+    Parser(const string& expression) :
+        _expression(expression),
+        _pos(0)
+    {
+    }
+
+    EventFilterPtr
+    parse()
+    {
+        EventFilterPtr filter = parseExpression();
+        skipWhitespace();
+        if(_pos < _expression.size())
+        {
+            error("unexpected `" + _expression.substr(_pos) + "'");
+        }
+        return filter;
+    }
+
+private:
+
+    EventFilterPtr
+    parseExpression()
+    {
+        vector<EventFilterPtr> terms(1, parseTerm());
+        while(consume("||"))
+        {
+            terms.push_back(parseTerm());
+        }
+        return terms.size() == 1 ? terms[0] : new OrFilter(terms);
+    }
+
+    EventFilterPtr
+    parseTerm()
+    {
+        vector<EventFilterPtr> factors(1, parseFactor());
+        while(consume("&&"))
+        {
+            factors.push_back(parseFactor());
+        }
+        return factors.size() == 1 ? factors[0] : new AndFilter(factors);
+    }
+
+    EventFilterPtr
+    parseFactor()
+    {
+        if(consume("!"))
+        {
+            return new NotFilter(parseFactor());
+        }
+
+        if(consume("("))
+        {
+            EventFilterPtr filter = parseExpression();
+            expect(")");
+            return filter;
+        }
+
+        string identifier = parseIdentifier();
+        if(identifier == "op")
+        {
+            bool equal = parseComparison();
+            return new OpFilter(parseString(), equal);
+        }
+        else if(identifier == "ctx")
+        {
+            expect("[");
+            string key = parseString();
+            expect("]");
+            if(consume("=="))
+            {
+                return new ContextFilter(key, parseString(), true);
+            }
+            else if(consume("!="))
+            {
+                return new ContextFilter(key, parseString(), false);
+            }
+            return new ContextKeyFilter(key);
+        }
+
+        error(identifier.empty() ? "expected `op', `ctx', `!' or `('" : "unknown identifier `" + identifier + "'");
+        return 0; // Keep the compiler happy.
+    }
+
+    bool
+    parseComparison()
+    {
+        if(consume("=="))
+        {
+            return true;
+        }
+        expect("!=");
+        return false;
+    }
+
+    string
+    parseIdentifier()
+    {
+        skipWhitespace();
+        size_t start = _pos;
+        while(_pos < _expression.size() && (isalnum(static_cast<unsigned char>(_expression[_pos])) ||
+                                            _expression[_pos] == '_'))
+        {
+            ++_pos;
+        }
+        return _expression.substr(start, _pos - start);
+    }
+
+    string
+    parseString()
+    {
+        skipWhitespace();
+        if(_pos == _expression.size() || (_expression[_pos] != '\'' && _expression[_pos] != '"'))
+        {
+            error("expected a quoted string");
+        }
+
+        size_t end = _expression.find(_expression[_pos], _pos + 1);
+        if(end == string::npos)
+        {
+            error("unterminated string");
+        }
+
+        string value = _expression.substr(_pos + 1, end - _pos - 1);
+        _pos = end + 1;
+        return value;
+    }
+
+    bool
+    consume(const char* token)
+    {
+        skipWhitespace();
+        size_t length = strlen(token);
+        if(_expression.compare(_pos, length, token) == 0)
+        {
+            _pos += length;
+            return true;
+        }
+        return false;
+    }
+
+    void
+    expect(const char* token)
+    {
+        if(!consume(token))
+        {
+            error("expected `" + string(token) + "'");
+        }
+    }
+
+    void
+    skipWhitespace()
+    {
+        while(_pos < _expression.size() && isspace(static_cast<unsigned char>(_expression[_pos])))
+        {
+            ++_pos;
+        }
+    }
+
+    void
+    error(const string& reason)
+    {
+        throw BadQoS("invalid filter `" + _expression + "': " + reason);
+    }
+
+    const string _expression;
+    size_t _pos;
+};
+
+}
+
+EventFilterPtr
+EventFilter::create(const QoS& qos)
+{
+    QoS::const_iterator p = qos.find(filterQoSKey);
+    if(p == qos.end())
+    {
+        return 0;
+    }
+    return Parser(p->second).parse();
+}
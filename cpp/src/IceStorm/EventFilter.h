@@ -0,0 +1,54 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef EVENT_FILTER_H
+#define EVENT_FILTER_H
+
+#include <IceStorm/IceStormInternal.h>
+
+namespace IceStorm
+{
+
+//
+// The QoS entry which holds the filter expression of a subscriber.
+//
+const std::string filterQoSKey = "filter";
+
+class EventFilter;
+typedef IceUtil::Handle<EventFilter> EventFilterPtr;
+
+//
+// A filter on the events queued with a subscriber, compiled once from the
+// filter QoS of the subscriber. The events which don't match the filter
+// are discarded before being queued and are never sent to the subscriber.
+//
+// The filter expression tests the operation name and the context of the
+// events:
+//
+// expression := term ('||' term)*
+// term       := factor ('&&' factor)*
+// factor     := '!' factor | '(' expression ')' | test
+// test       := 'op' ('==' | '!=') string
+//             | 'ctx' '[' string ']' [('==' | '!=') string]
+// string     := a single or double quoted string
+//
+// A context test without a comparison checks if the context holds the key.
+// For example: op == 'priceUpdated' && ctx['symbol'] == 'ZRC'
+//
+class EventFilter : public IceUtil::Shared
+{
+public:
+
+    //
+    // Return the filter of the given QoS, or null if the QoS doesn't have
+    // a filter. Raises BadQoS if the filter expression is invalid.
+    //
+    static EventFilterPtr create(const QoS&);
+
+    virtual bool match(const EventData&) const = 0;
+};
+
+} // End namespace IceStorm
+
+#endif
@@ -0,0 +1,311 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IceStorm/EventLog.h>
+#include <IceStorm/Instance.h>
+#include <IceUtil/StringUtil.h>
+#include <Ice/LoggerUtil.h>
+#include <Ice/Properties.h>
+
+#include <algorithm>
+#include <sstream>
+
+using namespace std;
+using namespace IceStorm;
+using namespace IceStormInternal;
+
+namespace IceStormInternal
+{
+extern IceDB::IceContext dbContext;
+}
+
+namespace
+{
+
+typedef IceDB::ReadOnlyCursor<EventRecordKey, EventRecord, IceDB::IceContext, Ice::OutputStream> EventLogCursor;
+typedef IceDB::ReadWriteCursor<EventRecordKey, EventRecord, IceDB::IceContext, Ice::OutputStream> EventLogRWCursor;
+
+//
+// The maximum number of events read at once to replay the events of the
+// log.
+//
+const size_t replayPageSize = 1000;
+
+//
+// Position the cursor on the first record with a key greater than or
+// equal to the given key.
+//
+bool
+seek(IceDB::CursorBase& cursor, const EventRecordKey& key)
+{
+    unsigned char kbuf[IceDB::maxKeySize];
+    MDB_val mkey = { IceDB::maxKeySize, kbuf };
+    if(!IceDB::Codec<EventRecordKey, IceDB::IceContext, Ice::OutputStream>::write(key, mkey, dbContext))
+    {
+        throw IceDB::KeyTooLongException(__FILE__, __LINE__, mkey.mv_size);
+    }
+
+    MDB_val mdata;
+    int rc = mdb_cursor_get(cursor.mcursor(), &mkey, &mdata, MDB_SET_RANGE);
+    if(rc == MDB_NOTFOUND)
+    {
+        return false;
+    }
+    else if(rc != MDB_SUCCESS)
+    {
+        throw IceDB::LMDBException(__FILE__, __LINE__, rc);
+    }
+    return true;
+}
+
+Ice::Long
+parseQoS(const QoS& qos, const string& name, Ice::Long defaultValue)
+{
+    QoS::const_iterator p = qos.find(name);
+    if(p == qos.end())
+    {
+        return defaultValue;
+    }
+
+    istringstream is(IceUtilInternal::trim(p->second));
+    Ice::Long value;
+    if(!(is >> value) || !is.eof())
+    {
+        throw BadQoS("invalid " + name + " (numeric value required): " + p->second);
+    }
+    return value;
+}
+
+}
+
+EventLog::EventLog(const PersistentInstancePtr& instance, const string& name, const Ice::Identity& id,
+                   int maxEvents, const IceUtil::Time& maxAge) :
+    _instance(instance),
+    _name(name),
+    _id(id),
+    _maxEvents(maxEvents),
+    _maxAge(maxAge),
+    _eventLogMap(instance->eventLogMap()),
+    _first(1),
+    _next(1)
+{
+    //
+    // Find the sequence numbers of the oldest and most recent events
+    // retained by the log.
+    //
+    IceDB::ReadOnlyTxn txn(_instance->eventLogEnv());
+    EventLogCursor cursor(_eventLogMap, txn);
+
+    EventRecordKey key;
+    key.topic = _id;
+    key.sequence = 0;
+
+    EventRecordKey k;
+    EventRecord v;
+    if(seek(cursor, key) && cursor.get(k, v, MDB_GET_CURRENT) && k.topic == _id)
+    {
+        _first = k.sequence;
+
+        key.sequence = ICE_INT64(0x7FFFFFFFFFFFFFFF);
+        bool found = seek(cursor, key) ? cursor.get(k, v, MDB_PREV) : cursor.get(k, v, MDB_LAST);
+        assert(found && k.topic == _id);
+        _next = k.sequence + 1;
+    }
+}
+
+EventLogPtr
+EventLog::create(const PersistentInstancePtr& instance, const string& name, const Ice::Identity& id)
+{
+    Ice::PropertiesPtr properties = instance->properties();
+    const string prefix = instance->serviceName() + ".Topic." + name + ".Retention.";
+    int maxEvents = properties->getPropertyAsInt(prefix + "MaxEvents");
+    int maxAge = properties->getPropertyAsInt(prefix + "MaxAge");
+    if(maxEvents <= 0 && maxAge <= 0)
+    {
+        return 0;
+    }
+    return new EventLog(instance, name, id, max(maxEvents, 0), IceUtil::Time::seconds(max(maxAge, 0)));
+}
+
+EventDataSeq
+EventLog::append(const EventDataSeq& events)
+{
+    //
+    // The events might be shared with the caller, the sequence number is
+    // added to the context of copies of the events. If the transaction
+    // fails, the sequence numbers of the events are skipped.
+    //
+    EventDataSeq numbered;
+    for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+    {
+        Ice::Context context = (*p)->context;
+        ostringstream os;
+        os << _next++;
+        context[sequenceContextKey] = os.str();
+        numbered.push_back(new EventData((*p)->op, (*p)->mode, (*p)->data, context));
+    }
+
+    try
+    {
+        IceDB::ReadWriteTxn txn(_instance->eventLogEnv());
+
+        EventRecordKey key;
+        key.topic = _id;
+        key.sequence = _next - static_cast<Ice::Long>(numbered.size());
+
+        EventRecord record;
+        record.timestamp = IceUtil::Time::now().toMilliSeconds();
+        for(EventDataSeq::const_iterator p = numbered.begin(); p != numbered.end(); ++p, ++key.sequence)
+        {
+            record.op = (*p)->op;
+            record.mode = (*p)->mode;
+            record.data = (*p)->data;
+            record.context = (*p)->context;
+            _eventLogMap.put(txn, key, record);
+        }
+
+        trim(txn);
+
+        txn.commit();
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        //
+        // The events are still delivered to the current subscribers.
+        //
+        Ice::Error error(_instance->communicator()->getLogger());
+        error << "failed to append events to the log of topic `" << _name << "':\n" << ex;
+    }
+    return numbered;
+}
+
+Ice::Long
+EventLog::replayFrom(const QoS& qos) const
+{
+    if(qos.find("replayFrom") == qos.end() && qos.find("replaySince") == qos.end())
+    {
+        return 0;
+    }
+    return max(parseQoS(qos, "replayFrom", _first), _first);
+}
+
+bool
+EventLog::replay(const QoS& qos, Ice::Long& from, EventDataSeq& events) const
+{
+    //
+    // The events are read with a cursor rather than with the sequence
+    // numbers of the oldest and most recent events, which can change if
+    // the topic mutex isn't locked.
+    //
+    Ice::Long since = parseQoS(qos, "replaySince", 0);
+
+    IceDB::ReadOnlyTxn txn(_instance->eventLogEnv());
+    EventLogCursor cursor(_eventLogMap, txn);
+
+    EventRecordKey key;
+    key.topic = _id;
+    key.sequence = from;
+
+    EventRecordKey k;
+    EventRecord v;
+    bool found = seek(cursor, key) && cursor.get(k, v, MDB_GET_CURRENT);
+    for(size_t count = 0; found && k.topic == _id; ++count)
+    {
+        if(count == replayPageSize)
+        {
+            return true;
+        }
+        if(v.timestamp >= since)
+        {
+            events.push_back(new EventData(v.op, v.mode, v.data, v.context));
+        }
+        from = k.sequence + 1;
+        found = cursor.get(k, v, MDB_NEXT);
+    }
+    return false;
+}
+
+void
+EventLog::checkQoS(const QoS& qos)
+{
+    parseQoS(qos, "replayFrom", 0);
+    parseQoS(qos, "replaySince", 0);
+}
+
+void
+EventLog::destroy()
+{
+    try
+    {
+        IceDB::ReadWriteTxn txn(_instance->eventLogEnv());
+        {
+            EventLogRWCursor cursor(_eventLogMap, txn);
+
+            EventRecordKey key;
+            key.topic = _id;
+            key.sequence = 0;
+
+            EventRecordKey k;
+            EventRecord v;
+            bool found = seek(cursor, key) && cursor.get(k, v, MDB_GET_CURRENT);
+            while(found && k.topic == _id)
+            {
+                cursor.del();
+                found = cursor.get(k, v, MDB_NEXT);
+            }
+        }
+        txn.commit();
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        Ice::Error error(_instance->communicator()->getLogger());
+        error << "failed to remove the events of topic `" << _name << "':\n" << ex;
+    }
+    _first = _next;
+}
+
+bool
+EventLog::getEvent(const IceDB::Txn& txn, Ice::Long sequence, EventRecord& record) const
+{
+    EventRecordKey key;
+    key.topic = _id;
+    key.sequence = sequence;
+    return _eventLogMap.get(txn, key, record);
+}
+
+void
+EventLog::trim(const IceDB::ReadWriteTxn& txn)
+{
+    EventRecordKey key;
+    key.topic = _id;
+
+    Ice::Long first = _first;
+    if(_maxEvents > 0)
+    {
+        for(; _next - first > _maxEvents; ++first)
+        {
+            key.sequence = first;
+            _eventLogMap.del(txn, key);
+        }
+    }
+
+    if(_maxAge > IceUtil::Time())
+    {
+        Ice::Long oldest = (IceUtil::Time::now() - _maxAge).toMilliSeconds();
+        for(; first < _next - 1; ++first)
+        {
+            EventRecord record;
+            if(getEvent(txn, first, record))
+            {
+                if(record.timestamp >= oldest)
+                {
+                    break;
+                }
+                key.sequence = first;
+                _eventLogMap.del(txn, key);
+            }
+        }
+    }
+    _first = first;
+}
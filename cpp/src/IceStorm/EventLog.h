@@ -0,0 +1,110 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <IceStorm/IceStormInternal.h>
+#include <IceStorm/Util.h>
+#include <IceUtil/Time.h>
+
+namespace IceStorm
+{
+
+class PersistentInstance;
+typedef IceUtil::Handle<PersistentInstance> PersistentInstancePtr;
+
+//
+// The context entry which carries the sequence number of the events
+// delivered by a topic with an event log.
+//
+const std::string sequenceContextKey = "IceStorm.Sequence";
+
+//
+// The event log of a topic, enabled with the
+// <service>.Topic.<name>.Retention.MaxEvents and
+// <service>.Topic.<name>.Retention.MaxAge properties. The events
+// published or forwarded on the topic are appended to the log and
+// numbered, the oldest events are removed from the log once it holds
+// more than MaxEvents events or once they are older than MaxAge seconds.
+// The most recent event is always retained to keep the numbering of the
+// events across restarts.
+//
+// The logs of the topics are stored in their own database environment,
+// in the eventlog directory of <service>.LMDB.Path, with the map size
+// set by <service>.LMDB.EventLog.MapSize. Events which don't fit are
+// still delivered but not retained, the subscriber records aren't
+// affected.
+//
+// A subscriber which subscribes with the replayFrom QoS (a sequence
+// number) or the replaySince QoS (a time in milliseconds since the
+// epoch) first receives the events retained since, then the events
+// published after it subscribed.
+//
+// The log isn't thread-safe, it's protected by the mutex of its topic.
+// Only replay() can be called without the mutex.
+//
+class EventLog : public IceUtil::Shared
+{
+public:
+
+    EventLog(const PersistentInstancePtr&, const std::string&, const Ice::Identity&, int, const IceUtil::Time&);
+
+    //
+    // Return the event log of the topic, or null if the topic doesn't
+    // retain its events.
+    //
+    static IceUtil::Handle<EventLog> create(const PersistentInstancePtr&, const std::string&, const Ice::Identity&);
+
+    //
+    // Append the events to the log. Return copies of the events with
+    // their sequence number context entry.
+    //
+    EventDataSeq append(const EventDataSeq&);
+
+    //
+    // Return the sequence number of the first event requested with the
+    // replay QoS of a subscriber, or 0 if the subscriber doesn't request
+    // the replay of the retained events.
+    //
+    Ice::Long replayFrom(const QoS&) const;
+
+    //
+    // Read a page of the retained events requested with the replay QoS
+    // of a subscriber, starting with the given sequence number which is
+    // updated to the sequence number of the next event to read. Return
+    // true if there are more events to read.
+    //
+    bool replay(const QoS&, Ice::Long&, EventDataSeq&) const;
+
+    //
+    // Raise BadQoS if the replay QoS of a subscriber is invalid.
+    //
+    static void checkQoS(const QoS&);
+
+    //
+    // Remove all the events of the topic from the database.
+    //
+    void destroy();
+
+private:
+
+    bool getEvent(const IceDB::Txn&, Ice::Long, EventRecord&) const;
+    void trim(const IceDB::ReadWriteTxn&);
+
+    const PersistentInstancePtr _instance;
+    const std::string _name;
+    const Ice::Identity _id;
+    const int _maxEvents;
+    const IceUtil::Time _maxAge;
+
+    EventLogMap _eventLogMap;
+    Ice::Long _first; // The sequence number of the oldest event.
+    Ice::Long _next; // The sequence number of the next event.
+};
+typedef IceUtil::Handle<EventLog> EventLogPtr;
+
+} // End namespace IceStorm
+
+#endif
@@ -0,0 +1,198 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IceStorm/FanOut.h>
+#include <IceStorm/Subscriber.h>
+#include <Ice/Properties.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace IceStorm;
+
+namespace
+{
+
+class FanOutThread : public IceUtil::Thread
+{
+public:
+
+    FanOutThread(const string& name, FanOutPool* pool) :
+        IceUtil::Thread(name),
+        _pool(pool)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        while(true)
+        {
+            FanOutJobPtr job = _pool->nextJob();
+            if(!job)
+            {
+                break;
+            }
+            job->run();
+        }
+    }
+
+private:
+
+    FanOutPool* _pool; // The pool joins its threads before being destroyed.
+};
+
+void
+queueEvents(const vector<SubscriberPtr>& subscribers, size_t begin, size_t end, bool forwarded,
+            const EventDataSeq& events, vector<SubscriberPtr>& reap)
+{
+    for(size_t i = begin; i < end; ++i)
+    {
+        if(!subscribers[i]->queue(forwarded, events) && subscribers[i]->reap())
+        {
+            reap.push_back(subscribers[i]);
+        }
+    }
+}
+
+}
+
+FanOutJob::FanOutJob(bool forwarded, const EventDataSeq& events, const SubscriberSnapshotPtr& snapshot,
+                     size_t shardSize) :
+    _forwarded(forwarded),
+    _events(events),
+    _snapshot(snapshot),
+    _shardSize(shardSize),
+    _next(0),
+    _pending((snapshot->subscribers.size() + shardSize - 1) / shardSize)
+{
+}
+
+void
+FanOutJob::run()
+{
+    const vector<SubscriberPtr>& subscribers = _snapshot->subscribers;
+    while(true)
+    {
+        size_t begin;
+        size_t end;
+        {
+            Lock sync(*this);
+            if(_next >= subscribers.size())
+            {
+                return;
+            }
+            begin = _next;
+            end = min(begin + _shardSize, subscribers.size());
+            _next = end;
+        }
+
+        vector<SubscriberPtr> reap;
+        queueEvents(subscribers, begin, end, _forwarded, _events, reap);
+
+        Lock sync(*this);
+        _reap.insert(_reap.end(), reap.begin(), reap.end());
+        if(--_pending == 0)
+        {
+            notifyAll();
+        }
+    }
+}
+
+void
+FanOutJob::wait(vector<SubscriberPtr>& reap)
+{
+    Lock sync(*this);
+    while(_pending > 0)
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::wait();
+    }
+    reap.swap(_reap);
+}
+
+FanOutPool::FanOutPool(const string& name, const Ice::PropertiesPtr& properties) :
+    _shardSize(static_cast<size_t>(max(properties->getPropertyAsIntWithDefault(name + ".FanOut.ShardSize", 256), 1))),
+    _destroyed(false)
+{
+    int threads = properties->getPropertyAsIntWithDefault(name + ".FanOut.Threads", 0);
+    for(int i = 0; i < threads; ++i)
+    {
+        IceUtil::ThreadPtr thread = new FanOutThread(name + ".FanOut", this);
+        thread->start();
+        _threads.push_back(thread);
+    }
+}
+
+void
+FanOutPool::queue(bool forwarded, const EventDataSeq& events, const SubscriberSnapshotPtr& snapshot,
+                  vector<SubscriberPtr>& reap)
+{
+    const vector<SubscriberPtr>& subscribers = snapshot->subscribers;
+    if(_threads.empty() || subscribers.size() <= _shardSize)
+    {
+        queueEvents(subscribers, 0, subscribers.size(), forwarded, events, reap);
+        return;
+    }
+
+    FanOutJobPtr job = new FanOutJob(forwarded, events, snapshot, _shardSize);
+    {
+        Lock sync(*this);
+        if(!_destroyed)
+        {
+            //
+            // Hand the job to a pool thread for each shard other than the
+            // one processed by the publishing thread.
+            //
+            size_t shards = (subscribers.size() + _shardSize - 1) / _shardSize;
+            for(size_t i = 1; i < shards && i <= _threads.size(); ++i)
+            {
+                _jobs.push_back(job);
+            }
+            notifyAll();
+        }
+    }
+
+    //
+    // The publishing thread processes the shards which aren't claimed by
+    // the pool threads, the job completes even if all the pool threads
+    // are busy.
+    //
+    job->run();
+    job->wait(reap);
+}
+
+FanOutJobPtr
+FanOutPool::nextJob()
+{
+    Lock sync(*this);
+    while(_jobs.empty() && !_destroyed)
+    {
+        wait();
+    }
+
+    if(_destroyed)
+    {
+        return 0;
+    }
+
+    FanOutJobPtr job = _jobs.front();
+    _jobs.pop_front();
+    return job;
+}
+
+void
+FanOutPool::destroy()
+{
+    {
+        Lock sync(*this);
+        _destroyed = true;
+        _jobs.clear();
+        notifyAll();
+    }
+
+    for(vector<IceUtil::ThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+}
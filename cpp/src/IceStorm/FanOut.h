@@ -0,0 +1,115 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef FAN_OUT_H
+#define FAN_OUT_H
+
+#include <IceStorm/IceStormInternal.h>
+#include <IceUtil/Monitor.h>
+#include <IceUtil/Thread.h>
+#include <Ice/PropertiesF.h>
+
+#include <deque>
+
+namespace IceStorm
+{
+
+class Subscriber;
+typedef IceUtil::Handle<Subscriber> SubscriberPtr;
+
+//
+// An immutable snapshot of the subscribers of a topic. The topic shares
+// its snapshot with the publishing threads and only creates a new one
+// once its subscribers change, instead of copying the subscribers for
+// each published event.
+//
+class SubscriberSnapshot : public IceUtil::Shared
+{
+public:
+
+    SubscriberSnapshot(const std::vector<SubscriberPtr>& s) :
+        subscribers(s)
+    {
+    }
+
+    const std::vector<SubscriberPtr> subscribers;
+};
+typedef IceUtil::Handle<SubscriberSnapshot> SubscriberSnapshotPtr;
+
+//
+// The events published on a topic with many subscribers. The subscribers
+// are split in shards of consecutive subscribers, each shard is claimed
+// by one of the threads which run the job.
+//
+class FanOutJob : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    FanOutJob(bool, const EventDataSeq&, const SubscriberSnapshotPtr&, size_t);
+
+    //
+    // Queue the events with the shards which are not claimed yet.
+    //
+    void run();
+
+    //
+    // Wait for the events to be queued with all the shards and return
+    // the subscribers which must be reaped.
+    //
+    void wait(std::vector<SubscriberPtr>&);
+
+private:
+
+    const bool _forwarded;
+    const EventDataSeq _events;
+    const SubscriberSnapshotPtr _snapshot;
+    const size_t _shardSize;
+
+    size_t _next; // The first subscriber of the next shard to claim.
+    size_t _pending; // The number of shards not processed yet.
+    std::vector<SubscriberPtr> _reap;
+};
+typedef IceUtil::Handle<FanOutJob> FanOutJobPtr;
+
+//
+// The fan-out thread pool, configured with <service>.FanOut.Threads.
+// The events published on a topic with more than <service>.FanOut.ShardSize
+// subscribers are queued with the subscribers in parallel, by the pool
+// threads and the publishing thread. The publishing thread waits for the
+// events to be queued with all the subscribers, so the events of a
+// publisher are still queued in order with each subscriber.
+//
+class FanOutPool : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    FanOutPool(const std::string&, const Ice::PropertiesPtr&);
+
+    //
+    // Queue the events with the subscribers of the snapshot and return
+    // the subscribers which must be reaped.
+    //
+    void queue(bool, const EventDataSeq&, const SubscriberSnapshotPtr&, std::vector<SubscriberPtr>&);
+
+    //
+    // Return the next job to run, or null once the pool is destroyed.
+    // Called by the pool threads.
+    //
+    FanOutJobPtr nextJob();
+
+    void destroy();
+
+private:
+
+    const size_t _shardSize;
+
+    std::vector<IceUtil::ThreadPtr> _threads;
+    std::deque<FanOutJobPtr> _jobs;
+    bool _destroyed;
+};
+typedef IceUtil::Handle<FanOutPool> FanOutPoolPtr;
+
+} // End namespace IceStorm
+
+#endif
@@ -0,0 +1,159 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IceStorm/GroupCommit.h>
+#include <IceStorm/Instance.h>
+#include <IceStorm/Observers.h>
+#include <IceStorm/Util.h>
+#include <Ice/LocalException.h>
+#include <Ice/LoggerUtil.h>
+
+using namespace std;
+using namespace IceStorm;
+using namespace IceStormElection;
+using namespace IceStormInternal;
+
+GroupCommit::GroupCommit(PersistentInstance* instance, const IceUtil::Time& window) :
+    _instance(instance),
+    _window(window)
+{
+}
+
+SubscriberUpdateGroupPtr
+GroupCommit::submit(const Ice::Identity& topic, const SubscriberUpdate& update)
+{
+    Lock sync(*this);
+    if(!_next)
+    {
+        _next = new SubscriberUpdateGroup();
+    }
+    _next->topics.push_back(topic);
+    _next->updates.push_back(update);
+    return _next;
+}
+
+void
+GroupCommit::wait(const SubscriberUpdateGroupPtr& group)
+{
+    Lock sync(*this);
+    while(!group->committed)
+    {
+        if(!_current && group == _next)
+        {
+            //
+            // This thread commits the group. The other threads keep
+            // submitting updates to the group until the end of the group
+            // commit window.
+            //
+            _current = group;
+            if(_window > IceUtil::Time())
+            {
+                IceUtil::Time end = IceUtil::Time::now(IceUtil::Time::Monotonic) + _window;
+                IceUtil::Time remaining = _window;
+                while(remaining > IceUtil::Time())
+                {
+                    timedWait(remaining);
+                    remaining = end - IceUtil::Time::now(IceUtil::Time::Monotonic);
+                }
+            }
+            _next = 0;
+
+            sync.release();
+            try
+            {
+                commit(group);
+            }
+            catch(const IceUtil::Exception& ex)
+            {
+                group->exception.reset(ex.ice_clone());
+            }
+            catch(...)
+            {
+                group->exception.reset(new Ice::UnknownException(__FILE__, __LINE__));
+            }
+            sync.acquire();
+
+            group->committed = true;
+            _current = 0;
+            notifyAll();
+        }
+        else
+        {
+            IceUtil::Monitor<IceUtil::Mutex>::wait();
+        }
+    }
+
+    if(group->exception)
+    {
+        group->exception->ice_throw();
+    }
+}
+
+void
+GroupCommit::flush()
+{
+    SubscriberUpdateGroupPtr group;
+    {
+        Lock sync(*this);
+        group = _next ? _next : _current;
+    }
+
+    if(group)
+    {
+        try
+        {
+            wait(group);
+        }
+        catch(const IceUtil::Exception&)
+        {
+            // The exception is raised to the threads which submitted the updates.
+        }
+    }
+}
+
+void
+GroupCommit::commit(const SubscriberUpdateGroupPtr& group)
+{
+    SubscriberMap subscriberMap = _instance->subscriberMap();
+    LLUMap lluMap = _instance->lluMap();
+
+    LogUpdate llu;
+    try
+    {
+        IceDB::ReadWriteTxn txn(_instance->dbEnv());
+
+        for(size_t i = 0; i < group->updates.size(); ++i)
+        {
+            const SubscriberUpdate& update = group->updates[i];
+
+            SubscriberRecordKey key;
+            key.topic = group->topics[i];
+            if(update.add)
+            {
+                key.id = update.record.id;
+                subscriberMap.put(txn, key, update.record);
+            }
+            else
+            {
+                for(Ice::IdentitySeq::const_iterator p = update.subscribers.begin(); p != update.subscribers.end(); ++p)
+                {
+                    key.id = *p;
+                    subscriberMap.del(txn, key);
+                }
+            }
+        }
+
+        llu = getIncrementedLLU(txn, lluMap);
+
+        txn.commit();
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        Ice::Error error(_instance->communicator()->getLogger());
+        error << "LMDB error: " << ex;
+        throw;
+    }
+
+    _instance->observers()->updateSubscribers(llu, group->updates);
+}
@@ -0,0 +1,83 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef GROUP_COMMIT_H
+#define GROUP_COMMIT_H
+
+#include <IceStorm/Election.h>
+#include <IceUtil/Monitor.h>
+#include <Ice/UniquePtr.h>
+
+namespace IceStorm
+{
+
+class PersistentInstance;
+
+//
+// The subscriber updates of a group commit.
+//
+class SubscriberUpdateGroup : public IceUtil::Shared
+{
+public:
+
+    SubscriberUpdateGroup() :
+        committed(false)
+    {
+    }
+
+    std::vector<Ice::Identity> topics; // The identity of the topic of each update.
+    IceStormElection::SubscriberUpdateSeq updates;
+    bool committed;
+    IceInternal::UniquePtr<IceUtil::Exception> exception; // Set if the commit failed.
+};
+typedef IceUtil::Handle<SubscriberUpdateGroup> SubscriberUpdateGroupPtr;
+
+//
+// Group commit of the subscriber updates, enabled with the
+// <service>.GroupCommit.Window property. Instead of updating the database
+// and replicating each subscribe and unsubscribe in turn, the updates
+// submitted while a group is being committed are queued with the next
+// group. A group is committed with a single transaction and a single LLU
+// increment, and replicated with a single updateSubscribers call to each
+// replica. The first thread which waits for a group commits it, after
+// waiting for the group commit window to collect more updates.
+//
+class GroupCommit : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    GroupCommit(PersistentInstance*, const IceUtil::Time&);
+
+    //
+    // Queue the update with the next group. The updates of a topic must
+    // be submitted with the topic locked to be committed in order.
+    //
+    SubscriberUpdateGroupPtr submit(const Ice::Identity&, const IceStormElection::SubscriberUpdate&);
+
+    //
+    // Wait for the group to be committed and replicated, raises the
+    // exception of the commit if it failed.
+    //
+    void wait(const SubscriberUpdateGroupPtr&);
+
+    //
+    // Wait for the updates submitted so far to be committed.
+    //
+    void flush();
+
+private:
+
+    void commit(const SubscriberUpdateGroupPtr&);
+
+    PersistentInstance* _instance; // The instance owns the group commit.
+    const IceUtil::Time _window;
+
+    SubscriberUpdateGroupPtr _next; // The group collecting the submitted updates.
+    SubscriberUpdateGroupPtr _current; // The group being committed.
+};
+typedef IceUtil::Handle<GroupCommit> GroupCommitPtr;
+
+} // End namespace IceStorm
+
+#endif
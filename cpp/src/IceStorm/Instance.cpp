@@ -7,11 +7,16 @@
 #include <IceStorm/Observers.h>
 #include <IceStorm/NodeI.h>
 #include <IceStorm/InstrumentationI.h>
+#include <IceStorm/FanOut.h>
+#include <IceStorm/GroupCommit.h>
+#include <IceStorm/Partitioner.h>
 #include <IceUtil/Timer.h>
+#include <IceUtil/FileUtil.h>
 
 #include <Ice/InstrumentationI.h>
 #include <Ice/Communicator.h>
 #include <Ice/Properties.h>
+#include <Ice/LocalException.h>
 #include <Ice/TraceUtil.h>
 
 using namespace std;
@@ -65,6 +70,38 @@ PersistentInstance::PersistentInstance(
         _subscriberMap = SubscriberMap(txn, "subscribers", dbContext, MDB_CREATE, compareSubscriberRecordKey);
 
         txn.commit();
+
+        //
+        // The event logs are stored in their own environment so that they
+        // can't use up the map of the subscriber records.
+        //
+        Ice::PropertiesPtr properties = communicator->getProperties();
+        bool retention = false;
+        Ice::PropertyDict topics = properties->getPropertiesForPrefix(name + ".Topic.");
+        for(Ice::PropertyDict::const_iterator p = topics.begin(); p != topics.end() && !retention; ++p)
+        {
+            retention = p->first.find(".Retention.") != string::npos;
+        }
+        if(retention)
+        {
+            const string path = properties->getPropertyWithDefault(name + ".LMDB.Path", name) + "/eventlog";
+            if(!IceUtilInternal::directoryExists(path) && IceUtilInternal::mkdir(path, 0777) != 0)
+            {
+                throw Ice::FileException(__FILE__, __LINE__, IceInternal::getSystemErrno(), path);
+            }
+            const int mapSize = properties->getPropertyAsInt(name + ".LMDB.EventLog.MapSize");
+            _eventLogEnv.reset(new IceDB::Env(path, 1, IceDB::getMapSize(mapSize)));
+
+            IceDB::ReadWriteTxn eventLogTxn(*_eventLogEnv);
+            _eventLogMap = EventLogMap(eventLogTxn, "events", dbContext, MDB_CREATE, compareEventRecordKey);
+            eventLogTxn.commit();
+        }
+
+        int window = communicator->getProperties()->getPropertyAsIntWithDefault(name + ".GroupCommit.Window", -1);
+        if(window >= 0)
+        {
+            _groupCommit = new GroupCommit(this, IceUtil::Time::milliSeconds(window));
+        }
     }
     catch(...)
     {
@@ -75,10 +112,20 @@ PersistentInstance::PersistentInstance(
     }
 }
 
+GroupCommitPtr
+PersistentInstance::groupCommit() const
+{
+    return _groupCommit;
+}
+
 void
 PersistentInstance::destroy()
 {
     _dbEnv.close();
+    if(_eventLogEnv)
+    {
+        _eventLogEnv->close();
+    }
     dbContext.communicator = 0;
 
     Instance::destroy();
@@ -108,6 +155,9 @@ Instance::Instance(
     _sendTimeout(communicator->getProperties()->getPropertyAsIntWithDefault(name + ".Send.Timeout", 60 * 1000)),
     _sendQueueSizeMax(communicator->getProperties()->getPropertyAsIntWithDefault(name + ".Send.QueueSizeMax", -1)),
     _sendQueueSizeMaxPolicy(RemoveSubscriber),
+    _conflationKey(communicator->getProperties()->getProperty(name + ".Send.ConflationKey")),
+    // default 0, adaptive batching is disabled.
+    _sendBatchSizeMax(communicator->getProperties()->getPropertyAsIntWithDefault(name + ".Send.BatchSizeMax", 0)),
     _topicReaper(new TopicReaper())
 {
     try
@@ -126,11 +176,24 @@ Instance::Instance(
             if(!p.empty())
             {
                 const_cast<Ice::ObjectPrx&>(_publisherReplicaProxy) = communicator->stringToProxy("dummy:" + p);
+                if(properties->getPropertyAsInt(name + ".Partitioned") > 0)
+                {
+                    const_cast<PartitionerPtr&>(_partitioner) =
+                        new Partitioner(_publisherReplicaProxy->ice_getEndpoints(),
+                                        publishAdapter->getPublishedEndpoints());
+                    if(!_partitioner->isReplica())
+                    {
+                        Ice::Warning warn(_traceLevels->logger);
+                        warn << "the published endpoints of `" << name << ".Publish' don't match `" << name
+                             << ".ReplicatedPublishEndpoints', the events won't be routed to the topic leaders";
+                    }
+                }
             }
         }
         _observers = new Observers(this);
         _batchFlusher = new IceUtil::Timer();
         _timer = new IceUtil::Timer();
+        _fanOutPool = new FanOutPool(name, properties);
 
         string policy = properties->getProperty(name + ".Send.QueueSizeMaxPolicy");
         if(policy == "RemoveSubscriber")
@@ -141,6 +204,20 @@ Instance::Instance(
         {
             const_cast<SendQueueSizeMaxPolicy&>(_sendQueueSizeMaxPolicy) = DropEvents;
         }
+        else if(policy == "Conflate")
+        {
+            if(_conflationKey.empty())
+            {
+                Ice::Warning warn(_traceLevels->logger);
+                warn << "`" << name << ".Send.QueueSizeMaxPolicy' is set to `Conflate' but `" << name
+                     << ".Send.ConflationKey' is not set, events will be dropped instead";
+                const_cast<SendQueueSizeMaxPolicy&>(_sendQueueSizeMaxPolicy) = DropEvents;
+            }
+            else
+            {
+                const_cast<SendQueueSizeMaxPolicy&>(_sendQueueSizeMaxPolicy) = Conflate;
+            }
+        }
         else if(!policy.empty())
         {
             Ice::Warning warn(_traceLevels->logger);
@@ -253,6 +330,12 @@ Instance::timer() const
     return _timer;
 }
 
+FanOutPoolPtr
+Instance::fanOutPool() const
+{
+    return _fanOutPool;
+}
+
 Ice::ObjectPrx
 Instance::topicReplicaProxy() const
 {
@@ -265,6 +348,12 @@ Instance::publisherReplicaProxy() const
     return _publisherReplicaProxy;
 }
 
+PartitionerPtr
+Instance::partitioner() const
+{
+    return _partitioner;
+}
+
 IceStorm::Instrumentation::TopicManagerObserverPtr
 Instance::observer() const
 {
@@ -307,6 +396,18 @@ Instance::sendQueueSizeMaxPolicy() const
     return _sendQueueSizeMaxPolicy;
 }
 
+string
+Instance::conflationKey() const
+{
+    return _conflationKey;
+}
+
+int
+Instance::sendBatchSizeMax() const
+{
+    return _sendBatchSizeMax;
+}
+
 void
 Instance::shutdown()
 {
@@ -334,6 +435,11 @@ Instance::destroy()
         _batchFlusher->destroy();
     }
 
+    if(_fanOutPool)
+    {
+        _fanOutPool->destroy();
+    }
+
     // The node instance must be cleared as the node holds the
     // replica (TopicManager) which holds the instance causing a
     // cyclic reference.
@@ -8,6 +8,7 @@
 #include <Ice/CommunicatorF.h>
 #include <Ice/ObjectAdapterF.h>
 #include <Ice/PropertiesF.h>
+#include <Ice/UniquePtr.h>
 #include <IceUtil/Time.h>
 #include <IceStorm/Election.h>
 #include <IceStorm/Instrumentation.h>
@@ -38,6 +39,15 @@ namespace IceStorm
 class TraceLevels;
 typedef IceUtil::Handle<TraceLevels> TraceLevelsPtr;
 
+class GroupCommit;
+typedef IceUtil::Handle<GroupCommit> GroupCommitPtr;
+
+class FanOutPool;
+typedef IceUtil::Handle<FanOutPool> FanOutPoolPtr;
+
+class Partitioner;
+typedef IceUtil::Handle<Partitioner> PartitionerPtr;
+
 class TopicReaper : public IceUtil::Shared, private IceUtil::Mutex
 {
 public:
@@ -58,7 +68,8 @@ public:
     enum SendQueueSizeMaxPolicy
     {
         RemoveSubscriber,
-        DropEvents
+        DropEvents,
+        Conflate
     };
 
     Instance(const std::string&, const std::string&, const Ice::CommunicatorPtr&, const Ice::ObjectAdapterPtr&,
@@ -79,8 +90,10 @@ public:
     TraceLevelsPtr traceLevels() const;
     IceUtil::TimerPtr batchFlusher() const;
     IceUtil::TimerPtr timer() const;
+    FanOutPoolPtr fanOutPool() const;
     Ice::ObjectPrx topicReplicaProxy() const;
     Ice::ObjectPrx publisherReplicaProxy() const;
+    PartitionerPtr partitioner() const;
     IceStorm::Instrumentation::TopicManagerObserverPtr observer() const;
     TopicReaperPtr topicReaper() const;
 
@@ -89,6 +102,8 @@ public:
     int sendTimeout() const;
     int sendQueueSizeMax() const;
     SendQueueSizeMaxPolicy sendQueueSizeMaxPolicy() const;
+    std::string conflationKey() const;
+    int sendBatchSizeMax() const;
 
     void shutdown();
     virtual void destroy();
@@ -108,13 +123,17 @@ private:
     const int _sendTimeout;
     const int _sendQueueSizeMax;
     const SendQueueSizeMaxPolicy _sendQueueSizeMaxPolicy;
+    const std::string _conflationKey;
+    const int _sendBatchSizeMax;
     const Ice::ObjectPrx _topicReplicaProxy;
     const Ice::ObjectPrx _publisherReplicaProxy;
+    const PartitionerPtr _partitioner;
     const TopicReaperPtr _topicReaper;
     IceStormElection::NodeIPtr _node;
     IceStormElection::ObserversPtr _observers;
     IceUtil::TimerPtr _batchFlusher;
     IceUtil::TimerPtr _timer;
+    FanOutPoolPtr _fanOutPool;
     IceStorm::Instrumentation::TopicManagerObserverPtr _observer;
 
 };
@@ -135,6 +154,14 @@ public:
     LLUMap lluMap() const { return _lluMap; }
     SubscriberMap subscriberMap() const { return _subscriberMap; }
 
+    //
+    // The database environment of the topic event logs, only opened if a
+    // topic retains its events.
+    //
+    const IceDB::Env& eventLogEnv() const { return *_eventLogEnv; }
+    EventLogMap eventLogMap() const { return _eventLogMap; }
+    GroupCommitPtr groupCommit() const; // Null if group commit is disabled.
+
     virtual void destroy();
 
 private:
@@ -143,6 +170,9 @@ private:
     IceDB::Env _dbEnv;
     LLUMap _lluMap;
     SubscriberMap _subscriberMap;
+    IceInternal::UniquePtr<IceDB::Env> _eventLogEnv;
+    EventLogMap _eventLogMap;
+    GroupCommitPtr _groupCommit;
 };
 typedef IceUtil::Handle<PersistentInstance> PersistentInstancePtr;
 
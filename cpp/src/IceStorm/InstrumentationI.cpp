@@ -234,6 +234,31 @@ TopicObserverI::forwarded()
 namespace
 {
 
+struct FanOutUpdate
+{
+    FanOutUpdate(Ice::Long durationP) : duration(durationP)
+    {
+    }
+
+    void operator()(const TopicMetricsPtr& v)
+    {
+        v->fanOutTime = (v->fanOutTime ? *v->fanOutTime : 0) + duration;
+    }
+
+    Ice::Long duration;
+};
+
+}
+
+void
+TopicObserverI::fanOut(Ice::Long duration)
+{
+    forEach(FanOutUpdate(duration));
+}
+
+namespace
+{
+
 struct QueuedUpdate
 {
     QueuedUpdate(int countP) : count(countP)
@@ -313,6 +338,37 @@ SubscriberObserverI::delivered(int count)
     forEach(DeliveredUpdate(count));
 }
 
+namespace
+{
+
+struct FilteredUpdate
+{
+    FilteredUpdate(int countP) : count(countP)
+    {
+    }
+
+    void operator()(const SubscriberMetricsPtr& v)
+    {
+        v->filtered = (v->filtered ? *v->filtered : 0) + count;
+    }
+
+    int count;
+};
+
+}
+
+void
+SubscriberObserverI::filtered(int count)
+{
+    forEach(FilteredUpdate(count));
+}
+
+void
+SubscriberObserverI::batched(int count)
+{
+    sample(count);
+}
+
 TopicManagerObserverI::TopicManagerObserverI(const IceInternal::MetricsAdminIPtr& metrics) :
     _metrics(metrics),
     _topics(metrics, "Topic"),
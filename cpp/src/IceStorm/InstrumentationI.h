@@ -10,6 +10,25 @@
 #include <IceStorm/Instrumentation.h>
 #include <IceStorm/Metrics.h>
 
+namespace IceInternal
+{
+
+//
+// The histogram of the subscriber map records the size of the batches
+// of events sent to the subscribers.
+//
+template<> struct LatencyHistogramDefault<IceMX::SubscriberMetrics>
+{
+    static const int value = 1;
+};
+
+template<> struct LatencyHistogramSampled<IceMX::SubscriberMetrics>
+{
+    static const bool value = true;
+};
+
+}
+
 namespace IceStorm
 {
 
@@ -20,6 +39,7 @@ public:
 
     virtual void published();
     virtual void forwarded();
+    virtual void fanOut(Ice::Long);
 };
 
 class SubscriberObserverI : public IceStorm::Instrumentation::SubscriberObserver,
@@ -30,6 +50,8 @@ public:
     virtual void queued(int);
     virtual void outstanding(int);
     virtual void delivered(int);
+    virtual void filtered(int);
+    virtual void batched(int);
 };
 
 class TopicManagerObserverI : public IceStorm::Instrumentation::TopicManagerObserver
@@ -12,10 +12,15 @@ IceStormService_targetdir       := $(libdir)
 IceStormService_dependencies    := IceGrid Glacier2 IceBox IceDB
 IceStormService_cppflags        := $(if $(lmdb_includedir),-I$(lmdb_includedir))
 IceStormService_devinstall      := no
-IceStormService_sources         := $(addprefix $(currentdir)/,Instance.cpp \
+IceStormService_sources         := $(addprefix $(currentdir)/,EventFilter.cpp \
+                                                             EventLog.cpp \
+                                                             FanOut.cpp \
+                                                             GroupCommit.cpp \
+                                                             Instance.cpp \
                                                              InstrumentationI.cpp \
                                                              NodeI.cpp \
                                                              Observers.cpp \
+                                                             Partitioner.cpp \
                                                              Service.cpp \
                                                              Subscriber.cpp \
                                                              TopicI.cpp \
@@ -172,6 +172,17 @@ Observers::removeSubscriber(const LogUpdate& llu, const string& name, const Ice:
     wait("removeSubscriber");
 }
 
+void
+Observers::updateSubscribers(const LogUpdate& llu, const SubscriberUpdateSeq& updates)
+{
+    Lock sync(*this);
+    for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
+    {
+        p->result = p->observer->begin_updateSubscribers(llu, updates);
+    }
+    wait("updateSubscribers");
+}
+
 void
 Observers::wait(const string& op)
 {
@@ -41,6 +41,7 @@ public:
     void destroyTopic(const LogUpdate&, const std::string&);
     void addSubscriber(const LogUpdate&, const std::string&, const IceStorm::SubscriberRecord&);
     void removeSubscriber(const LogUpdate&, const std::string&, const Ice::IdentitySeq&);
+    void updateSubscribers(const LogUpdate&, const SubscriberUpdateSeq&);
     void getReapedSlaves(std::vector<int>&);
 
 private:
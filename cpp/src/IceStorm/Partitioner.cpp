@@ -0,0 +1,172 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IceStorm/Partitioner.h>
+#include <Ice/Endpoint.h>
+
+#include <sstream>
+
+using namespace std;
+using namespace IceStorm;
+
+namespace
+{
+
+//
+// The number of virtual nodes of each replica on the ring, to spread the
+// topics evenly across the replicas.
+//
+const int virtualNodes = 64;
+
+//
+// The hash must be the same on all the replicas, the FNV-1a hash is used
+// rather than a standard library hash.
+//
+unsigned int
+hash(const string& s)
+{
+    unsigned int h = 2166136261U;
+    for(string::const_iterator p = s.begin(); p != s.end(); ++p)
+    {
+        h ^= static_cast<unsigned char>(*p);
+        h *= 16777619U;
+    }
+    return h;
+}
+
+//
+// The endpoints with the same host and port are the endpoints of the same
+// replica, for example the tcp and udp publish endpoints.
+//
+string
+replicaKey(const Ice::EndpointPtr& endpoint)
+{
+    for(Ice::EndpointInfoPtr p = endpoint->getInfo(); p; p = p->underlying)
+    {
+        Ice::IPEndpointInfoPtr ipInfo = ICE_DYNAMIC_CAST(Ice::IPEndpointInfo, p);
+        if(ipInfo)
+        {
+            ostringstream os;
+            os << ipInfo->host << ':' << ipInfo->port;
+            return os.str();
+        }
+    }
+    return endpoint->toString();
+}
+
+}
+
+Partitioner::Partitioner(const Ice::EndpointSeq& endpoints, const Ice::EndpointSeq& local)
+{
+    map<string, size_t> replicas;
+    vector<string> keys;
+    for(Ice::EndpointSeq::const_iterator p = endpoints.begin(); p != endpoints.end(); ++p)
+    {
+        string key = replicaKey(*p);
+        map<string, size_t>::const_iterator q = replicas.find(key);
+        if(q == replicas.end())
+        {
+            q = replicas.insert(make_pair(key, _replicas.size())).first;
+            _replicas.push_back(Ice::EndpointSeq());
+            keys.push_back(key);
+        }
+        _replicas[q->second].push_back(*p);
+    }
+
+    _replica = _replicas.size();
+    for(Ice::EndpointSeq::const_iterator p = local.begin(); p != local.end() && _replica == _replicas.size(); ++p)
+    {
+        map<string, size_t>::const_iterator q = replicas.find(replicaKey(*p));
+        if(q != replicas.end())
+        {
+            _replica = q->second;
+        }
+    }
+
+    for(size_t i = 0; i < keys.size(); ++i)
+    {
+        for(int j = 0; j < virtualNodes; ++j)
+        {
+            ostringstream os;
+            os << keys[i] << '#' << j;
+
+            //
+            // On a collision, the replica with the smallest key owns the
+            // virtual node so that all the replicas build the same ring.
+            //
+            unsigned int h = hash(os.str());
+            map<unsigned int, size_t>::iterator p = _ring.find(h);
+            if(p == _ring.end())
+            {
+                _ring.insert(make_pair(h, i));
+            }
+            else if(keys[i] < keys[p->second])
+            {
+                p->second = i;
+            }
+        }
+    }
+}
+
+bool
+Partitioner::isReplica() const
+{
+    return _replica < _replicas.size();
+}
+
+Ice::ObjectPrx
+Partitioner::partition(const Ice::ObjectPrx& proxy, const string& topic) const
+{
+    if(_replicas.size() <= 1)
+    {
+        return proxy;
+    }
+
+    //
+    // Walk the ring from the hash of the topic name, the leader is the
+    // replica of the first virtual node and the followers are the other
+    // replicas in the order of their first virtual node.
+    //
+    Ice::EndpointSeq endpoints;
+    vector<bool> added(_replicas.size(), false);
+    size_t count = 0;
+    map<unsigned int, size_t>::const_iterator start = _ring.lower_bound(hash(topic));
+    map<unsigned int, size_t>::const_iterator p = start;
+    do
+    {
+        if(p == _ring.end())
+        {
+            p = _ring.begin();
+        }
+        if(!added[p->second])
+        {
+            added[p->second] = true;
+            endpoints.insert(endpoints.end(), _replicas[p->second].begin(), _replicas[p->second].end());
+            ++count;
+        }
+        ++p;
+    }
+    while(count < _replicas.size() && p != start);
+
+    return proxy->ice_endpoints(endpoints);
+}
+
+Ice::ObjectPrx
+Partitioner::leader(const Ice::ObjectPrx& proxy, const string& topic) const
+{
+    if(_replicas.size() <= 1 || !isReplica())
+    {
+        return 0;
+    }
+
+    size_t replica = leader(topic);
+    return replica == _replica ? Ice::ObjectPrx() : proxy->ice_endpoints(_replicas[replica]);
+}
+
+size_t
+Partitioner::leader(const string& topic) const
+{
+    map<unsigned int, size_t>::const_iterator p = _ring.lower_bound(hash(topic));
+    return p == _ring.end() ? _ring.begin()->second : p->second;
+}
@@ -0,0 +1,76 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef PARTITIONER_H
+#define PARTITIONER_H
+
+#include <Ice/Endpoint.h>
+#include <Ice/Proxy.h>
+
+#include <map>
+
+namespace IceStorm
+{
+
+//
+// Partition the topics of a replicated IceStorm across the replicas,
+// enabled with the <service>.Partitioned property.
+//
+// The replicas are the members of a consistent hash ring built from the
+// <service>.ReplicatedPublishEndpoints property, the endpoints with the
+// same host and port belong to the same replica. A topic is led by the
+// first replica found on the ring from the hash of its name, the other
+// replicas follow in ring order. The publisher proxy of a topic lists the
+// endpoints of its leader first and the endpoints of the followers after,
+// so publishers which use the Ordered endpoint selection type send the
+// events of a topic to its leader and fail over to the next replica on
+// the ring. Adding or removing a replica only moves the topics of the
+// ring segments it owns.
+//
+// The endpoint selection type isn't marshaled with the proxy, so the
+// replicas also route the events server-side: a replica which receives
+// the events of a topic it doesn't lead forwards them to the leader, and
+// publishes them itself if the leader can't be reached.
+//
+class Partitioner : public IceUtil::Shared
+{
+public:
+
+    //
+    // The replicated publish endpoints, and the published endpoints of
+    // this replica.
+    //
+    Partitioner(const Ice::EndpointSeq&, const Ice::EndpointSeq&);
+
+    //
+    // Return false if this replica isn't one of the replicated publish
+    // endpoints, the events are never routed in this case.
+    //
+    bool isReplica() const;
+
+    //
+    // Return the replicated proxy with the endpoints ordered for the
+    // given topic.
+    //
+    Ice::ObjectPrx partition(const Ice::ObjectPrx&, const std::string&) const;
+
+    //
+    // Return the proxy with the endpoints of the replica which leads the
+    // given topic, or null if it's this replica.
+    //
+    Ice::ObjectPrx leader(const Ice::ObjectPrx&, const std::string&) const;
+
+private:
+
+    size_t leader(const std::string&) const;
+
+    std::vector<Ice::EndpointSeq> _replicas;
+    std::map<unsigned int, size_t> _ring; // The hash of each virtual node, and the index of its replica.
+    size_t _replica; // The index of this replica, _replicas.size() if unknown.
+};
+typedef IceUtil::Handle<Partitioner> PartitionerPtr;
+
+} // End namespace IceStorm
+
+#endif
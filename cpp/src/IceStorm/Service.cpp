@@ -470,9 +470,14 @@ ServiceI::validateProperties(const string& name, const PropertiesPtr& properties
         "ReplicatedTopicManagerEndpoints",
         "ReplicatedPublishEndpoints",
         "Nodes.*",
+        "Partitioned",
         "Transient",
         "NodeId",
         "Flush.Timeout",
+        "FanOut.Threads",
+        "FanOut.ShardSize",
+        "Topic.*.Retention.MaxEvents",
+        "Topic.*.Retention.MaxAge",
         "InstanceName",
         "Election.MasterTimeout",
         "Election.ElectionTimeout",
@@ -523,9 +528,13 @@ ServiceI::validateProperties(const string& name, const PropertiesPtr& properties
         "Send.Timeout",
         "Send.QueueSizeMax",
         "Send.QueueSizeMaxPolicy",
+        "Send.ConflationKey",
+        "Send.BatchSizeMax",
+        "GroupCommit.Window",
         "Discard.Interval",
         "LMDB.Path",
-        "LMDB.MapSize"
+        "LMDB.MapSize",
+        "LMDB.EventLog.MapSize"
     };
 
     vector<string> unknownProps;
@@ -88,6 +88,13 @@ toSubscriberState(Subscriber::SubscriberState s)
     }
 }
 
+IceInternal::EncodedRequestPtr
+getEncodedRequest(const EventDataPtr& event)
+{
+    EncodedEventData* encoded = dynamic_cast<EncodedEventData*>(event.get());
+    return encoded ? encoded->request : IceInternal::EncodedRequestPtr();
+}
+
 }
 
 // Each of the various Subscriber types.
@@ -114,9 +121,27 @@ private:
 
     const Ice::ObjectPrx _obj;
     const IceUtil::Time _interval;
+    IceUtil::Time _lastFlush; // The time of the last flush of the batch.
 };
 typedef IceUtil::Handle<SubscriberBatch> SubscriberBatchPtr;
 
+//
+// The number of events sent with a batch, passed as the cookie of the
+// batch flush.
+//
+class BatchCookie : public Ice::LocalObject
+{
+public:
+
+    BatchCookie(int countP) :
+        count(countP)
+    {
+    }
+
+    const int count;
+};
+typedef IceUtil::Handle<BatchCookie> BatchCookiePtr;
+
 class SubscriberOneway : public Subscriber
 {
 public:
@@ -131,9 +156,19 @@ public:
     }
     void sent(bool);
 
+    void batchException(const Ice::Exception& ex, const BatchCookiePtr&)
+    {
+        error(true, ex);
+    }
+    void batchSent(bool, const BatchCookiePtr&);
+
 private:
 
+    void sendBatch();
+    void sentEvents(int);
+
     const Ice::ObjectPrx _obj;
+    const Ice::ObjectPrx _batchObj; // The batch oneway proxy if adaptive batching is enabled.
 };
 typedef IceUtil::Handle<SubscriberOneway> SubscriberOnewayPtr;
 
@@ -209,7 +244,27 @@ SubscriberBatch::flush()
     if(_outstanding == 0)
     {
         ++_outstanding;
-        _instance->batchFlusher()->schedule(new FlushTimerTask(this), _interval);
+
+        IceUtil::Time delay = _interval;
+        if(_instance->sendBatchSizeMax() > 0)
+        {
+            //
+            // With adaptive batching, the flush interval is the latency
+            // budget of the events. The events are flushed immediately
+            // if the subscriber was idle for the flush interval or if a
+            // full batch is queued, otherwise the events queued until
+            // the end of the interval are sent with the batch.
+            //
+            if(static_cast<int>(_events.size()) >= _instance->sendBatchSizeMax())
+            {
+                delay = IceUtil::Time();
+            }
+            else
+            {
+                delay = max(_lastFlush + _interval - IceUtil::Time::now(IceUtil::Time::Monotonic), IceUtil::Time());
+            }
+        }
+        _instance->batchFlusher()->schedule(new FlushTimerTask(this), delay);
     }
 }
 
@@ -227,13 +282,25 @@ SubscriberBatch::doFlush()
     }
 
     EventDataSeq v;
-    v.swap(_events);
+    if(_instance->sendBatchSizeMax() > 0)
+    {
+        while(!_events.empty() && static_cast<int>(v.size()) < _instance->sendBatchSizeMax())
+        {
+            v.push_back(dequeue());
+        }
+        _lastFlush = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    }
+    else
+    {
+        dequeueAll(v);
+    }
     assert(!v.empty());
 
     if(_observer)
     {
         _outstandingCount = static_cast<Ice::Int>(v.size());
         _observer->outstanding(_outstandingCount);
+        _observer->batched(_outstandingCount);
     }
 
     try
@@ -241,7 +308,16 @@ SubscriberBatch::doFlush()
         vector<Ice::Byte> dummy;
         for(EventDataSeq::const_iterator p = v.begin(); p != v.end(); ++p)
         {
-            _obj->ice_invoke((*p)->op, (*p)->mode, (*p)->data, dummy, (*p)->context);
+            IceInternal::EncodedRequestPtr request = getEncodedRequest(*p);
+            if(request)
+            {
+                _obj->end_ice_invoke(dummy, _obj->_iceI_begin_ice_invoke(request, IceInternal::dummyCallback, 0,
+                                                                         true));
+            }
+            else
+            {
+                _obj->ice_invoke((*p)->op, (*p)->mode, (*p)->data, dummy, (*p)->context);
+            }
         }
 
         Ice::AsyncResultPtr result = _obj->begin_ice_flushBatchRequests(
@@ -268,6 +344,14 @@ SubscriberBatch::doFlush()
     {
         _lock.notify();
     }
+    else if(_outstanding == 0 && !_events.empty())
+    {
+        //
+        // The batch was sent synchronously and events are left over
+        // from a full batch.
+        //
+        flush();
+    }
 
     // This is significantly faster than the async version, but it can
     // block the calling thread. Bad news!
@@ -311,7 +395,12 @@ SubscriberOneway::SubscriberOneway(
     int retryCount,
     const Ice::ObjectPrx& obj) :
     Subscriber(instance, rec, proxy, retryCount, 5),
-    _obj(obj)
+    _obj(obj),
+    //
+    // Datagram subscribers are not batched, a batch could exceed the
+    // maximum size of a datagram.
+    //
+    _batchObj(instance->sendBatchSizeMax() > 1 && obj->ice_isOneway() ? obj->ice_batchOneway() : Ice::ObjectPrx())
 {
 }
 
@@ -331,12 +420,27 @@ SubscriberOneway::flush()
     // Send up to _maxOutstanding pending events.
     while(_outstanding < _maxOutstanding && !_events.empty())
     {
+        //
+        // If several events are queued, the subscriber lags behind the
+        // publishers and the queued events are sent with a batch. The
+        // batch grows with the queue up to the maximum batch size. If
+        // the subscriber keeps up, each event is sent when queued.
+        //
+        if(_batchObj && _events.size() > 1)
+        {
+            sendBatch();
+            if(_state != SubscriberStateOnline)
+            {
+                return;
+            }
+            continue;
+        }
+
         //
         // Dequeue the head event, count one more outstanding AMI
         // request.
         //
-        EventDataPtr e = _events.front();
-        _events.erase(_events.begin());
+        EventDataPtr e = dequeue();
         if(_observer)
         {
             _observer->outstanding(1);
@@ -344,10 +448,12 @@ SubscriberOneway::flush()
 
         try
         {
-            Ice::AsyncResultPtr result = _obj->begin_ice_invoke(
-                e->op, e->mode, e->data, e->context, Ice::newCallback_Object_ice_invoke(this,
-                                                                                        &SubscriberOneway::exception,
-                                                                                        &SubscriberOneway::sent));
+            Ice::Callback_Object_ice_invokePtr cb = Ice::newCallback_Object_ice_invoke(this,
+                                                                                     &SubscriberOneway::exception,
+                                                                                     &SubscriberOneway::sent);
+            IceInternal::EncodedRequestPtr request = getEncodedRequest(e);
+            Ice::AsyncResultPtr result = request ? _obj->_iceI_begin_ice_invoke(request, cb, 0) :
+                                                   _obj->begin_ice_invoke(e->op, e->mode, e->data, e->context, cb);
             if(!result->sentSynchronously())
             {
                 ++_outstanding;
@@ -377,7 +483,71 @@ SubscriberOneway::sent(bool sentSynchronously)
     {
         return;
     }
+    sentEvents(1);
+}
+
+void
+SubscriberOneway::batchSent(bool sentSynchronously, const BatchCookiePtr& cookie)
+{
+    if(sentSynchronously)
+    {
+        return;
+    }
+    sentEvents(cookie->count);
+}
 
+void
+SubscriberOneway::sendBatch()
+{
+    //
+    // Dequeue the events of the batch, count one more outstanding AMI
+    // request for the batch flush.
+    //
+    EventDataSeq v;
+    while(!_events.empty() && static_cast<int>(v.size()) < _instance->sendBatchSizeMax())
+    {
+        v.push_back(dequeue());
+    }
+
+    Ice::Int count = static_cast<Ice::Int>(v.size());
+    if(_observer)
+    {
+        _observer->outstanding(count);
+        _observer->batched(count);
+    }
+
+    try
+    {
+        vector<Ice::Byte> dummy;
+        for(EventDataSeq::const_iterator p = v.begin(); p != v.end(); ++p)
+        {
+            _batchObj->ice_invoke((*p)->op, (*p)->mode, (*p)->data, dummy, (*p)->context);
+        }
+
+        Ice::Callback_Object_ice_flushBatchRequestsPtr cb =
+            Ice::newCallback_Object_ice_flushBatchRequests(this,
+                                                           &SubscriberOneway::batchException,
+                                                           &SubscriberOneway::batchSent);
+        Ice::AsyncResultPtr result = _batchObj->begin_ice_flushBatchRequests(cb, new BatchCookie(count));
+        if(!result->sentSynchronously())
+        {
+            ++_outstanding;
+        }
+        else if(_observer)
+        {
+            _observer->delivered(count);
+        }
+    }
+    catch(const Ice::Exception& ex)
+    {
+        ++_outstanding; // Decremented by error().
+        error(true, ex);
+    }
+}
+
+void
+SubscriberOneway::sentEvents(int count)
+{
     IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
 
     // Decrement the _outstanding count.
@@ -385,7 +555,7 @@ SubscriberOneway::sent(bool sentSynchronously)
     assert(_outstanding >= 0 && _outstanding < _maxOutstanding);
     if(_observer)
     {
-        _observer->delivered(1);
+        _observer->delivered(count);
     }
 
     if(_events.empty() && _outstanding == 0 && _shutdown)
@@ -430,8 +600,7 @@ SubscriberTwoway::flush()
         // Dequeue the head event, count one more outstanding AMI
         // request.
         //
-        EventDataPtr e = _events.front();
-        _events.erase(_events.begin());
+        EventDataPtr e = dequeue();
         ++_outstanding;
         if(_observer)
         {
@@ -440,8 +609,16 @@ SubscriberTwoway::flush()
 
         try
         {
-            _obj->begin_ice_invoke(e->op, e->mode, e->data, e->context,
-                                   Ice::newCallback(static_cast<Subscriber*>(this), &Subscriber::completed));
+            Ice::CallbackPtr cb = Ice::newCallback(static_cast<Subscriber*>(this), &Subscriber::completed);
+            IceInternal::EncodedRequestPtr request = getEncodedRequest(e);
+            if(request)
+            {
+                _obj->_iceI_begin_ice_invoke(request, cb, 0);
+            }
+            else
+            {
+                _obj->begin_ice_invoke(e->op, e->mode, e->data, e->context, cb);
+            }
         }
         catch(const Ice::Exception& ex)
         {
@@ -472,27 +649,32 @@ SubscriberLink::flush()
         return;
     }
 
+    //
+    // Forward the queued events which don't exceed the cost of the link,
+    // up to the maximum batch size if adaptive batching is enabled. The
+    // events queued while the batch is forwarded are forwarded with the
+    // next batch.
+    //
+    const size_t batchSizeMax = _instance->sendBatchSizeMax() > 0 ?
+        static_cast<size_t>(_instance->sendBatchSizeMax()) : _events.size();
     EventDataSeq v;
-    v.swap(_events);
-
-    EventDataSeq::iterator p = v.begin();
-    while(p != v.end())
+    while(!_events.empty() && v.size() < batchSizeMax)
     {
+        EventDataPtr e = dequeue();
         if(_rec.cost != 0)
         {
             int cost = 0;
-            Ice::Context::const_iterator q = (*p)->context.find("cost");
-            if(q != (*p)->context.end())
+            Ice::Context::const_iterator q = e->context.find("cost");
+            if(q != e->context.end())
             {
                 cost = atoi(q->second.c_str());
             }
             if(cost > _rec.cost)
             {
-                p = v.erase(p);
                 continue;
             }
         }
-        ++p;
+        v.push_back(e);
     }
 
     if(!v.empty())
@@ -504,6 +686,7 @@ SubscriberLink::flush()
             {
                 _outstandingCount = static_cast<Ice::Int>(v.size());
                 _observer->outstanding(_outstandingCount);
+                _observer->batched(_outstandingCount);
             }
             _obj->begin_forward(v, Ice::newCallback(static_cast<Subscriber*>(this), &Subscriber::completed));
         }
@@ -516,6 +699,43 @@ SubscriberLink::flush()
 
 }
 
+EncodedEventData::EncodedEventData(const Ice::CommunicatorPtr& communicator, const string& op, Ice::OperationMode mode,
+                                   const pair<const Ice::Byte*, const Ice::Byte*>& data, const Ice::Context& context) :
+    EventData(op, mode, Ice::ByteSeq(data.first, data.second), context),
+    request(new IceInternal::EncodedRequest(communicator, op, mode, data, context))
+{
+}
+
+EventDataSeq
+IceStorm::encodeEvents(const Ice::CommunicatorPtr& communicator, const EventDataSeq& events, size_t subscribers)
+{
+    if(subscribers < 2)
+    {
+        return events;
+    }
+
+    EventDataSeq encoded;
+    for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+    {
+        if(dynamic_cast<EncodedEventData*>(p->get()))
+        {
+            encoded.push_back(*p);
+        }
+        else
+        {
+            pair<const Ice::Byte*, const Ice::Byte*> data(static_cast<const Ice::Byte*>(0),
+                                                          static_cast<const Ice::Byte*>(0));
+            if(!(*p)->data.empty())
+            {
+                data.first = &(*p)->data[0];
+                data.second = data.first + (*p)->data.size();
+            }
+            encoded.push_back(new EncodedEventData(communicator, (*p)->op, (*p)->mode, data, (*p)->context));
+        }
+    }
+    return encoded;
+}
+
 SubscriberPtr
 Subscriber::create(
     const InstancePtr& instance,
@@ -680,8 +900,59 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
 
     case SubscriberStateOnline:
     {
-        for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+        //
+        // Discard the events which don't match the filter of the
+        // subscriber, they are never sent to the subscriber.
+        //
+        EventDataSeq matched;
+        if(_filter)
         {
+            for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+            {
+                if(_filter->match(**p))
+                {
+                    matched.push_back(*p);
+                }
+            }
+
+            if(_observer && matched.size() < events.size())
+            {
+                _observer->filtered(static_cast<Ice::Int>(events.size() - matched.size()));
+            }
+
+            if(matched.empty())
+            {
+                break;
+            }
+        }
+        const EventDataSeq& queued = _filter ? matched : events;
+
+        //
+        // With the Conflate policy, an event replaces the queued event
+        // with the same conflation key at its position in the queue, the
+        // queue holds at most one event for each key.
+        //
+        const bool conflate = _instance->sendQueueSizeMaxPolicy() == Instance::Conflate && !_rec.link;
+        const string conflationKey = conflate ? _instance->conflationKey() : string();
+        Ice::Int conflated = 0;
+        for(EventDataSeq::const_iterator p = queued.begin(); p != queued.end(); ++p)
+        {
+            Ice::Context::const_iterator key;
+            if(conflate)
+            {
+                key = (*p)->context.find(conflationKey);
+                if(key != (*p)->context.end())
+                {
+                    map<string, Ice::Long>::const_iterator q = _conflated.find(key->second);
+                    if(q != _conflated.end())
+                    {
+                        _events[static_cast<size_t>(q->second - _dequeued)] = *p;
+                        ++conflated;
+                        continue;
+                    }
+                }
+            }
+
             if(static_cast<int>(_events.size()) == _instance->sendQueueSizeMax())
             {
                 if(_instance->sendQueueSizeMaxPolicy() == Instance::RemoveSubscriber)
@@ -689,17 +960,22 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
                     error(false, IceStorm::SendQueueSizeMaxReached(__FILE__, __LINE__));
                     return false;
                 }
-                else // DropEvents
+                else // DropEvents or Conflate
                 {
-                    _events.pop_front();
+                    dequeue();
                 }
             }
+
+            if(conflate && key != (*p)->context.end())
+            {
+                _conflated.insert(make_pair(key->second, _dequeued + static_cast<Ice::Long>(_events.size())));
+            }
             _events.push_back(*p);
         }
 
         if(_observer)
         {
-            _observer->queued(static_cast<Ice::Int>(events.size()));
+            _observer->queued(static_cast<Ice::Int>(queued.size()) - conflated);
         }
         flush();
         break;
@@ -854,13 +1130,13 @@ Subscriber::error(bool dec, const Ice::Exception& e)
         // clear all queued events.
         _next = now + _instance->discardInterval();
         ++_currentRetry;
-        _events.clear();
+        clearEvents();
         setState(SubscriberStateOffline);
     }
     // Errored out.
     else if(_state < SubscriberStateError)
     {
-        _events.clear();
+        clearEvents();
         setState(SubscriberStateError);
 
         TraceLevelsPtr traceLevels = _instance->traceLevels();
@@ -963,10 +1239,12 @@ Subscriber::Subscriber(
     _maxOutstanding(maxOutstanding),
     _proxy(proxy),
     _proxyReplica(proxy),
+    _filter(EventFilter::create(rec.theQoS)),
     _shutdown(false),
     _state(SubscriberStateOnline),
     _outstanding(0),
     _outstandingCount(1),
+    _dequeued(0),
     _currentRetry(0)
 {
     if(_proxy && _instance->publisherReplicaProxy())
@@ -1010,6 +1288,44 @@ stateToString(Subscriber::SubscriberState state)
 
 }
 
+EventDataPtr
+Subscriber::dequeue()
+{
+    assert(!_events.empty());
+    EventDataPtr event = _events.front();
+    _events.pop_front();
+
+    if(!_conflated.empty())
+    {
+        Ice::Context::const_iterator key = event->context.find(_instance->conflationKey());
+        if(key != event->context.end())
+        {
+            map<string, Ice::Long>::iterator p = _conflated.find(key->second);
+            if(p != _conflated.end() && p->second == _dequeued)
+            {
+                _conflated.erase(p);
+            }
+        }
+    }
+    ++_dequeued;
+    return event;
+}
+
+void
+Subscriber::dequeueAll(EventDataSeq& events)
+{
+    _dequeued += static_cast<Ice::Long>(_events.size());
+    _conflated.clear();
+    events.swap(_events);
+}
+
+void
+Subscriber::clearEvents()
+{
+    EventDataSeq events;
+    dequeueAll(events);
+}
+
 void
 Subscriber::setState(Subscriber::SubscriberState state)
 {
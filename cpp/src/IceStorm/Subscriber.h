@@ -7,6 +7,7 @@
 
 #include <IceStorm/IceStormInternal.h>
 #include <IceStorm/SubscriberRecord.h>
+#include <IceStorm/EventFilter.h>
 #include <IceStorm/Instrumentation.h>
 #include <Ice/ObserverHelper.h>
 #include <IceUtil/RecMutex.h>
@@ -20,6 +21,27 @@ typedef IceUtil::Handle<Instance> InstancePtr;
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
+//
+// An event which is marshaled once for all the subscribers of the topic.
+// The subscriber connections share the encoded event and only write the
+// header of each request before it.
+//
+class EncodedEventData : public EventData
+{
+public:
+
+    EncodedEventData(const Ice::CommunicatorPtr&, const std::string&, Ice::OperationMode,
+                     const std::pair<const Ice::Byte*, const Ice::Byte*>&, const Ice::Context&);
+
+    const IceInternal::EncodedRequestPtr request;
+};
+
+//
+// Return the events to queue with the given number of subscribers, the
+// events are encoded once if they are sent to more than one subscriber.
+//
+EventDataSeq encodeEvents(const Ice::CommunicatorPtr&, const EventDataSeq&, size_t);
+
 class Subscriber : public IceUtil::Shared
 {
 public:
@@ -60,6 +82,10 @@ protected:
 
     void setState(SubscriberState);
 
+    EventDataPtr dequeue(); // Dequeue the head event.
+    void dequeueAll(EventDataSeq&); // Dequeue all the events.
+    void clearEvents(); // Discard all the events.
+
     Subscriber(const InstancePtr&, const IceStorm::SubscriberRecord&, const Ice::ObjectPrx&, int, int);
 
     // Immutable
@@ -69,6 +95,7 @@ protected:
     const int _maxOutstanding; // The maximum number of oustanding events.
     const Ice::ObjectPrx _proxy; // The per subscriber object proxy, if any.
     const Ice::ObjectPrx _proxyReplica; // The replicated per subscriber object proxy, if any.
+    const EventFilterPtr _filter; // The filter of the events to queue, if any.
 
     IceUtil::Monitor<IceUtil::RecMutex> _lock;
 
@@ -79,6 +106,8 @@ protected:
     int _outstanding; // The current number of outstanding responses.
     int _outstandingCount; // The current number of outstanding events when batching events (only used for metrics).
     EventDataSeq _events; // The queue of events to send.
+    std::map<std::string, Ice::Long> _conflated; // The position of the queued event of each conflation key.
+    Ice::Long _dequeued; // The number of events dequeued, the position of the head event.
 
     // The next time to try sending a new event if we're offline.
     IceUtil::Time _next;
@@ -8,6 +8,8 @@
 #include <IceStorm/TraceLevels.h>
 #include <IceStorm/NodeI.h>
 #include <IceStorm/Observers.h>
+#include <IceStorm/GroupCommit.h>
+#include <IceStorm/Partitioner.h>
 #include <IceStorm/Util.h>
 #include <Ice/LoggerUtil.h>
 #include <algorithm>
@@ -27,6 +29,32 @@ logError(const Ice::CommunicatorPtr& com, const IceDB::LMDBException& ex)
     error << "LMDB error: " << ex;
 }
 
+//
+// Queue the retained events with the subscriber by pages, starting with
+// the given sequence number which is updated to the sequence number of
+// the next event to replay.
+//
+void
+replayEvents(const EventLogPtr& eventLog, const QoS& qos, Ice::Long& from, const SubscriberPtr& subscriber)
+{
+    bool more = true;
+    while(more)
+    {
+        EventDataSeq replayed;
+        more = eventLog->replay(qos, from, replayed);
+        if(!replayed.empty())
+        {
+            subscriber->queue(false, replayed);
+        }
+    }
+}
+
+//
+// The context entry set on the events forwarded to the leader of a
+// partitioned topic, so that they are never forwarded again.
+//
+const string partitionForwardedKey = "_IceStormForwarded";
+
 //
 // The servant has a 1-1 association with a topic. It is used to
 // receive events from Publishers.
@@ -35,8 +63,8 @@ class PublisherI : public Ice::BlobjectArray
 {
 public:
 
-    PublisherI(const TopicImplPtr& topic, const PersistentInstancePtr& instance) :
-        _topic(topic), _instance(instance)
+    PublisherI(const TopicImplPtr& topic, const PersistentInstancePtr& instance, const Ice::ObjectPrx& leader) :
+        _topic(topic), _instance(instance), _leader(leader)
     {
     }
 
@@ -45,8 +73,39 @@ public:
                Ice::ByteSeq&,
                const Ice::Current& current)
     {
+        Ice::Context::const_iterator forwarded = current.ctx.find(partitionForwardedKey);
+        if(_leader && forwarded == current.ctx.end())
+        {
+            //
+            // Forward the event to the replica which leads the topic. If
+            // it can't be reached, the event is published by this replica.
+            //
+            try
+            {
+                Ice::Context ctx = current.ctx;
+                ctx[partitionForwardedKey] = "";
+                Ice::ByteSeq outParams;
+                Ice::ObjectPrx leader = current.requestId == 0 ? _leader->ice_oneway() : _leader;
+                leader->ice_invoke(current.operation, current.mode, inParams, outParams, ctx);
+                return true;
+            }
+            catch(const Ice::LocalException& ex)
+            {
+                TraceLevelsPtr traceLevels = _instance->traceLevels();
+                if(traceLevels->topic > 0)
+                {
+                    Ice::Trace out(traceLevels->logger, traceLevels->topicCat);
+                    out << "couldn't forward event to the leader of topic `" << _topic->getName() << "':\n" << ex;
+                }
+            }
+        }
+
         // The publish call does a cached read.
         EventDataPtr event = new EventData(current.operation, current.mode, Ice::ByteSeq(), current.ctx);
+        if(forwarded != current.ctx.end())
+        {
+            event->context.erase(partitionForwardedKey);
+        }
 
         //
         // COMPILERBUG: gcc 4.0.1 doesn't like this.
@@ -66,6 +125,7 @@ private:
 
     const TopicImplPtr _topic;
     const PersistentInstancePtr _instance;
+    const Ice::ObjectPrx _leader; // The leader of the partitioned topic, null if it's this replica.
 };
 
 //
@@ -380,7 +440,14 @@ TopicImpl::TopicImpl(
             linkid.name = _name + ".link";
         }
 
-        _publisherPrx = _instance->publishAdapter()->add(new PublisherI(this, instance), pubid);
+        _eventLog = EventLog::create(instance, _name, _id);
+
+        Ice::ObjectPrx leader;
+        if(_instance->partitioner())
+        {
+            leader = _instance->partitioner()->leader(_instance->publisherReplicaProxy()->ice_identity(pubid), _name);
+        }
+        _publisherPrx = _instance->publishAdapter()->add(new PublisherI(this, instance, leader), pubid);
         _linkPrx = TopicLinkPrx::uncheckedCast(
             _instance->publishAdapter()->add(new TopicLinkI(this, instance), linkid));
 
@@ -409,6 +476,7 @@ TopicImpl::TopicImpl(
                 //
                 SubscriberPtr subscriber = Subscriber::create(_instance, *p);
                 _subscribers.push_back(subscriber);
+                _snapshot = 0;
             }
             catch(const Ice::Exception& ex)
             {
@@ -449,7 +517,15 @@ TopicImpl::getPublisher() const
     // Immutable
     if(_instance->publisherReplicaProxy())
     {
-        return _instance->publisherReplicaProxy()->ice_identity(_publisherPrx->ice_getIdentity());
+        Ice::ObjectPrx publisher = _instance->publisherReplicaProxy()->ice_identity(_publisherPrx->ice_getIdentity());
+        if(_instance->partitioner())
+        {
+            //
+            // List the endpoints of the replica which leads the topic first.
+            //
+            publisher = _instance->partitioner()->partition(publisher, _name);
+        }
+        return publisher;
     }
     return _publisherPrx;
 }
@@ -536,37 +612,142 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
     record.cost = 0;
 
     vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), record.id);
-    if(p != _subscribers.end())
+    if(p != _subscribers.end() || _pendingSubscribers.find(record.id) != _pendingSubscribers.end())
     {
         throw AlreadySubscribed();
     }
 
+    if(_eventLog)
+    {
+        EventLog::checkQoS(qos);
+    }
+
     LogUpdate llu;
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
-    try
+
+    GroupCommitPtr groupCommit = _instance->groupCommit();
+    if(groupCommit)
     {
-        IceDB::ReadWriteTxn txn(_instance->dbEnv());
+        //
+        // Wait for the group commit of the subscriber record with the
+        // mutex unlocked, so that other subscribers of the topic can
+        // join the group meanwhile.
+        //
+        SubscriberUpdate update;
+        update.topic = _name;
+        update.add = true;
+        update.record = record;
+        SubscriberUpdateGroupPtr group = groupCommit->submit(_id, update);
+        _pendingSubscribers.insert(make_pair(record.id, true));
+
+        sync.release();
+        try
+        {
+            groupCommit->wait(group);
+        }
+        catch(...)
+        {
+            sync.acquire();
+            _pendingSubscribers.erase(record.id);
+            subscriber->destroy();
+            throw;
+        }
+        sync.acquire();
 
-        SubscriberRecordKey key;
-        key.topic = _id;
-        key.id = subscriber->id();
+        map<Ice::Identity, bool>::iterator q = _pendingSubscribers.find(record.id);
+        bool unsubscribed = !q->second;
+        _pendingSubscribers.erase(q);
+        if(_destroyed)
+        {
+            subscriber->destroy();
+            throw Ice::ObjectNotExistException(__FILE__, __LINE__);
+        }
+        else if(unsubscribed)
+        {
+            subscriber->destroy();
+            return subscriber->proxy();
+        }
+    }
+    else
+    {
+        try
+        {
+            IceDB::ReadWriteTxn txn(_instance->dbEnv());
 
-        _subscriberMap.put(txn, key, record);
+            SubscriberRecordKey key;
+            key.topic = _id;
+            key.id = subscriber->id();
 
-        llu = getIncrementedLLU(txn, _lluMap);
+            _subscriberMap.put(txn, key, record);
 
-        txn.commit();
+            llu = getIncrementedLLU(txn, _lluMap);
+
+            txn.commit();
+        }
+        catch(const IceDB::LMDBException& ex)
+        {
+            logError(_instance->communicator(), ex);
+            throw; // will become UnknownException in caller
+        }
     }
-    catch(const IceDB::LMDBException& ex)
+
+    if(!groupCommit)
     {
-        logError(_instance->communicator(), ex);
-        throw; // will become UnknownException in caller
+        _instance->observers()->addSubscriber(llu, _name, record);
     }
 
-    _subscribers.push_back(subscriber);
+    //
+    // The retained events are read and queued with the subscriber by
+    // pages with the mutex unlocked, the events published meanwhile are
+    // appended to the log and read with the next pages. The last page is
+    // read with the mutex locked, so the subscriber receives each event
+    // once, either replayed or published after it's added to the topic.
+    //
+    Ice::Long from = _eventLog ? _eventLog->replayFrom(qos) : 0;
+    if(from > 0)
+    {
+        _pendingSubscribers.insert(make_pair(record.id, true));
+        sync.release();
+        try
+        {
+            replayEvents(_eventLog, qos, from, subscriber);
+        }
+        catch(const IceDB::LMDBException& ex)
+        {
+            logError(_instance->communicator(), ex);
+            from = 0;
+        }
+        sync.acquire();
 
-    _instance->observers()->addSubscriber(llu, _name, record);
+        map<Ice::Identity, bool>::iterator q = _pendingSubscribers.find(record.id);
+        bool unsubscribed = !q->second;
+        _pendingSubscribers.erase(q);
+        if(_destroyed)
+        {
+            subscriber->destroy();
+            throw Ice::ObjectNotExistException(__FILE__, __LINE__);
+        }
+        else if(unsubscribed)
+        {
+            subscriber->destroy();
+            return subscriber->proxy();
+        }
+
+        try
+        {
+            if(from > 0)
+            {
+                replayEvents(_eventLog, qos, from, subscriber);
+            }
+        }
+        catch(const IceDB::LMDBException& ex)
+        {
+            logError(_instance->communicator(), ex);
+        }
+    }
+    _subscribers.push_back(subscriber);
+    _snapshot = 0;
 
     return subscriber->proxy();
 }
@@ -602,7 +783,42 @@ TopicImpl::unsubscribe(const Ice::ObjectPrx& subscriber)
     IceUtil::Mutex::Lock sync(_subscribersMutex);
     Ice::IdentitySeq ids;
     ids.push_back(id);
-    removeSubscribers(ids);
+
+    //
+    // If the subscriber is waiting for the group commit of its
+    // subscription or for the replay of the retained events, it's not
+    // added once the subscription is committed or the events replayed.
+    //
+    map<Ice::Identity, bool>::iterator p = _pendingSubscribers.find(id);
+    if(p != _pendingSubscribers.end())
+    {
+        p->second = false;
+    }
+
+    GroupCommitPtr groupCommit = _instance->groupCommit();
+    if(!groupCommit)
+    {
+        removeSubscribers(ids);
+        return;
+    }
+
+    SubscriberUpdate update;
+    update.topic = _name;
+    update.add = false;
+    update.subscribers = ids;
+    SubscriberUpdateGroupPtr group = groupCommit->submit(_id, update);
+
+    sync.release();
+    groupCommit->wait(group);
+    sync.acquire();
+
+    vector<SubscriberPtr>::iterator q = find(_subscribers.begin(), _subscribers.end(), id);
+    if(q != _subscribers.end())
+    {
+        (*q)->destroy();
+        _subscribers.erase(q);
+        _snapshot = 0;
+    }
 }
 
 TopicLinkPrx
@@ -611,8 +827,12 @@ TopicImpl::getLinkProxy()
     // immutable
     if(_instance->publisherReplicaProxy())
     {
-        return TopicLinkPrx::uncheckedCast(_instance->publisherReplicaProxy()->ice_identity(
-                                               _linkPrx->ice_getIdentity()));
+        Ice::ObjectPrx link = _instance->publisherReplicaProxy()->ice_identity(_linkPrx->ice_getIdentity());
+        if(_instance->partitioner())
+        {
+            link = _instance->partitioner()->partition(link, _name);
+        }
+        return TopicLinkPrx::uncheckedCast(link);
     }
     return _linkPrx;
 }
@@ -675,6 +895,7 @@ TopicImpl::link(const TopicPrx& topic, Ice::Int cost)
     }
 
     _subscribers.push_back(subscriber);
+    _snapshot = 0;
 
     _instance->observers()->addSubscriber(llu, _name, record);
 }
@@ -861,6 +1082,7 @@ TopicImpl::update(const SubscriberRecordSeq& records)
             {
                 (*p)->destroy();
                 p = _subscribers.erase(p);
+                _snapshot = 0;
             }
             else
             {
@@ -885,6 +1107,7 @@ TopicImpl::update(const SubscriberRecordSeq& records)
         {
             SubscriberPtr subscriber = Subscriber::create(_instance, *p);
             _subscribers.push_back(subscriber);
+            _snapshot = 0;
         }
     }
 }
@@ -961,10 +1184,12 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
         CachedReadHelper unlock(_instance->node(), __FILE__, __LINE__);
 
         //
-        // Copy of the subscriber list so that event publishing can occur
-        // in parallel.
+        // Snapshot of the subscriber list so that event publishing can
+        // occur in parallel.
         //
-        vector<SubscriberPtr> copy;
+        SubscriberSnapshotPtr snapshot;
+        IceStorm::Instrumentation::TopicObserverPtr observer;
+        EventDataSeq numbered; // The events numbered by the event log.
         {
             IceUtil::Mutex::Lock sync(_subscribersMutex);
             if(_observer)
@@ -977,20 +1202,36 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
                 {
                     _observer->published();
                 }
+                observer = _observer.get();
+            }
+            if(_eventLog)
+            {
+                numbered = _eventLog->append(events);
             }
-            copy = _subscribers;
+            if(!_snapshot)
+            {
+                _snapshot = new SubscriberSnapshot(_subscribers);
+            }
+            snapshot = _snapshot;
         }
 
         //
         // Queue each event, gathering a list of those subscribers that
         // must be reaped.
         //
-        for(vector<SubscriberPtr>::const_iterator p = copy.begin(); p != copy.end(); ++p)
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        vector<SubscriberPtr> reaped;
+        _instance->fanOutPool()->queue(forwarded,
+                                       encodeEvents(_instance->communicator(), _eventLog ? numbered : events,
+                                                    snapshot->subscribers.size()),
+                                       snapshot, reaped);
+        if(observer)
         {
-            if(!(*p)->queue(forwarded, events) && (*p)->reap())
-            {
-                reap.push_back((*p)->id());
-            }
+            observer->fanOut((IceUtil::Time::now(IceUtil::Time::Monotonic) - start).toMicroSeconds());
+        }
+        for(vector<SubscriberPtr>::const_iterator p = reaped.begin(); p != reaped.end(); ++p)
+        {
+            reap.push_back((*p)->id());
         }
 
         // If there are no subscribers in error then we're done.
@@ -1084,6 +1325,7 @@ TopicImpl::observerAddSubscriber(const LogUpdate& llu, const SubscriberRecord& r
     }
 
     _subscribers.push_back(subscriber);
+    _snapshot = 0;
 }
 
 void
@@ -1141,6 +1383,58 @@ TopicImpl::observerRemoveSubscriber(const LogUpdate& llu, const Ice::IdentitySeq
         {
             (*p)->destroy();
             _subscribers.erase(p);
+            _snapshot = 0;
+        }
+    }
+}
+
+void
+TopicImpl::observerApplySubscriberUpdate(const LogUpdate& llu, const SubscriberUpdate& update)
+{
+    TraceLevelsPtr traceLevels = _instance->traceLevels();
+    if(traceLevels->topic > 0)
+    {
+        Ice::Trace out(traceLevels->logger, traceLevels->topicCat);
+        out << _name << ": " << (update.add ? "add" : "remove") << " replica observer: ";
+        if(update.add)
+        {
+            out << _instance->communicator()->identityToString(update.record.id);
+        }
+        else
+        {
+            for(Ice::IdentitySeq::const_iterator id = update.subscribers.begin(); id != update.subscribers.end(); ++id)
+            {
+                if(id != update.subscribers.begin())
+                {
+                    out << ",";
+                }
+                out << _instance->communicator()->identityToString(*id);
+            }
+        }
+        out << " llu: " << llu.generation << "/" << llu.iteration;
+    }
+
+    IceUtil::Mutex::Lock sync(_subscribersMutex);
+
+    if(update.add)
+    {
+        if(find(_subscribers.begin(), _subscribers.end(), update.record.id) == _subscribers.end())
+        {
+            _subscribers.push_back(Subscriber::create(_instance, update.record));
+            _snapshot = 0;
+        }
+    }
+    else
+    {
+        for(Ice::IdentitySeq::const_iterator id = update.subscribers.begin(); id != update.subscribers.end(); ++id)
+        {
+            vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), *id);
+            if(p != _subscribers.end())
+            {
+                (*p)->destroy();
+                _subscribers.erase(p);
+                _snapshot = 0;
+            }
         }
     }
 }
@@ -1195,6 +1489,15 @@ TopicImpl::updateSubscriberObservers()
 LogUpdate
 TopicImpl::destroyInternal(const LogUpdate& origLLU, bool master)
 {
+    //
+    // Wait for the subscriber updates of the topic waiting for a group
+    // commit, their records are erased with the topic records.
+    //
+    GroupCommitPtr groupCommit = _instance->groupCommit();
+    if(groupCommit)
+    {
+        groupCommit->flush();
+    }
 
     // Clear out the database records related to this topic.
     LogUpdate llu;
@@ -1238,6 +1541,12 @@ TopicImpl::destroyInternal(const LogUpdate& origLLU, bool master)
         throw; // will become UnknownException in caller
     }
 
+    // Erase the events retained by the topic.
+    if(_eventLog)
+    {
+        _eventLog->destroy();
+    }
+
     _instance->publishAdapter()->remove(_linkPrx->ice_getIdentity());
     _instance->publishAdapter()->remove(_publisherPrx->ice_getIdentity());
     _instance->topicReaper()->add(_name);
@@ -1248,6 +1557,7 @@ TopicImpl::destroyInternal(const LogUpdate& origLLU, bool master)
         (*p)->destroy();
     }
     _subscribers.clear();
+    _snapshot = 0;
 
     _instance->topicAdapter()->remove(_id);
 
@@ -1310,6 +1620,7 @@ TopicImpl::removeSubscribers(const Ice::IdentitySeq& ids)
             {
                 (*p)->destroy();
                 _subscribers.erase(p);
+                _snapshot = 0;
             }
         }
 
@@ -9,6 +9,8 @@
 #include <IceStorm/Election.h>
 #include <IceStorm/Instrumentation.h>
 #include <IceStorm/Util.h>
+#include <IceStorm/FanOut.h>
+#include <IceStorm/EventLog.h>
 #include <Ice/ObserverHelper.h>
 #include <list>
 
@@ -55,6 +57,7 @@ public:
     // Observer methods.
     void observerAddSubscriber(const IceStormElection::LogUpdate&, const SubscriberRecord&);
     void observerRemoveSubscriber(const IceStormElection::LogUpdate&, const Ice::IdentitySeq&);
+    void observerApplySubscriberUpdate(const IceStormElection::LogUpdate&, const IceStormElection::SubscriberUpdate&);
     void observerDestroyTopic(const IceStormElection::LogUpdate&);
 
     Ice::ObjectPtr getServant() const;
@@ -94,8 +97,23 @@ private:
     //
     std::vector<SubscriberPtr> _subscribers;
 
+    //
+    // The snapshot of the subscribers used by the publishing threads,
+    // reset when the subscribers change.
+    //
+    SubscriberSnapshotPtr _snapshot;
+
     bool _destroyed; // Has this Topic been destroyed?
 
+    EventLogPtr _eventLog; // The event log, if the topic retains its events.
+
+    //
+    // The subscribers waiting for the group commit of their subscription
+    // or for the replay of the retained events, set to false if the
+    // subscriber unsubscribes meanwhile.
+    //
+    std::map<Ice::Identity, bool> _pendingSubscribers;
+
     LLUMap _lluMap;
     SubscriberMap _subscriberMap;
 };
@@ -200,6 +200,22 @@ public:
         }
     }
 
+    virtual void updateSubscribers(const LogUpdate& llu, const SubscriberUpdateSeq& updates, const Ice::Current&)
+    {
+        try
+        {
+            ObserverUpdateHelper unlock(_instance->node(), llu.generation, __FILE__, __LINE__);
+            _impl->observerUpdateSubscribers(llu, updates);
+        }
+        catch(const ObserverInconsistencyException& e)
+        {
+            Ice::Warning warn(_instance->traceLevels()->logger);
+            warn << "ReplicaObserverI::update: ObserverInconsistencyException: " << e.reason;
+            _instance->node()->recovery(llu.generation);
+            throw;
+        }
+    }
+
 private:
 
     const PersistentInstancePtr _instance;
@@ -581,6 +597,68 @@ TopicManagerImpl::observerRemoveSubscriber(const LogUpdate& llu, const string& n
     topic->observerRemoveSubscriber(llu, id);
 }
 
+void
+TopicManagerImpl::observerUpdateSubscribers(const LogUpdate& llu, const SubscriberUpdateSeq& updates)
+{
+    vector<TopicImplPtr> topics;
+    {
+        Lock sync(*this);
+
+        for(SubscriberUpdateSeq::const_iterator p = updates.begin(); p != updates.end(); ++p)
+        {
+            map<string, TopicImplPtr>::iterator q = _topics.find(p->topic);
+            if(q == _topics.end())
+            {
+                throw ObserverInconsistencyException("no topic: " + p->topic);
+            }
+            topics.push_back(q->second);
+        }
+    }
+
+    //
+    // Update the database with a single transaction like the master, then
+    // the subscribers of the topics.
+    //
+    try
+    {
+        IceDB::ReadWriteTxn txn(_instance->dbEnv());
+
+        for(size_t i = 0; i < updates.size(); ++i)
+        {
+            SubscriberRecordKey key;
+            key.topic = topics[i]->id();
+            if(updates[i].add)
+            {
+                key.id = updates[i].record.id;
+                _subscriberMap.put(txn, key, updates[i].record);
+            }
+            else
+            {
+                for(Ice::IdentitySeq::const_iterator p = updates[i].subscribers.begin();
+                    p != updates[i].subscribers.end(); ++p)
+                {
+                    key.id = *p;
+                    _subscriberMap.del(txn, key);
+                }
+            }
+        }
+
+        _lluMap.put(txn, lluDbKey, llu);
+
+        txn.commit();
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        logError(_instance->communicator(), ex);
+        throw; // will become UnknownException in caller
+    }
+
+    for(size_t i = 0; i < updates.size(); ++i)
+    {
+        topics[i]->observerApplySubscriberUpdate(llu, updates[i]);
+    }
+}
+
 void
 TopicManagerImpl::getContent(LogUpdate& llu, TopicContentSeq& content)
 {
@@ -49,6 +49,7 @@ public:
     void observerAddSubscriber(const IceStormElection::LogUpdate&, const std::string&,
                                const IceStorm::SubscriberRecord&);
     void observerRemoveSubscriber(const IceStormElection::LogUpdate&, const std::string&, const Ice::IdentitySeq&);
+    void observerUpdateSubscribers(const IceStormElection::LogUpdate&, const IceStormElection::SubscriberUpdateSeq&);
 
     // Sync methods.
     void getContent(IceStormElection::LogUpdate&, IceStormElection::TopicContentSeq&);
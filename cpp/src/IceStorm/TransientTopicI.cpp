@@ -250,10 +250,12 @@ TransientTopicImpl::subscribe(const QoS& origQoS, const Ice::ObjectPrx& obj, con
         // subscriber list and remove it from the database.
         (*p)->destroy();
         _subscribers.erase(p);
+        _snapshot = 0;
     }
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
     _subscribers.push_back(subscriber);
+    _snapshot = 0;
 }
 
 Ice::ObjectPrx
@@ -310,6 +312,7 @@ TransientTopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPr
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
     _subscribers.push_back(subscriber);
+    _snapshot = 0;
 
     return subscriber->proxy();
 }
@@ -349,6 +352,7 @@ TransientTopicImpl::unsubscribe(const Ice::ObjectPrx& subscriber, const Ice::Cur
     {
         (*p)->destroy();
         _subscribers.erase(p);
+        _snapshot = 0;
     }
 }
 
@@ -393,6 +397,7 @@ TransientTopicImpl::link(const TopicPrx& topic, Ice::Int cost, const Ice::Curren
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
     _subscribers.push_back(subscriber);
+    _snapshot = 0;
 }
 
 void
@@ -434,6 +439,7 @@ TransientTopicImpl::unlink(const TopicPrx& topic, const Ice::Current&)
     {
         (*p)->destroy();
         _subscribers.erase(p);
+        _snapshot = 0;
     }
 }
 
@@ -504,6 +510,7 @@ TransientTopicImpl::destroy(const Ice::Current&)
         (*p)->destroy();
     }
     _subscribers.clear();
+    _snapshot = 0;
 }
 
 void
@@ -529,26 +536,31 @@ void
 TransientTopicImpl::publish(bool forwarded, const EventDataSeq& events)
 {
     //
-    // Copy of the subscriber list so that event publishing can occur
-    // in parallel.
+    // Snapshot of the subscriber list so that event publishing can
+    // occur in parallel.
     //
-    vector<SubscriberPtr> copy;
+    SubscriberSnapshotPtr snapshot;
     {
         Lock sync(*this);
-        copy = _subscribers;
+        if(!_snapshot)
+        {
+            _snapshot = new SubscriberSnapshot(_subscribers);
+        }
+        snapshot = _snapshot;
     }
 
     //
     // Queue each event, gathering a list of those subscribers that
     // must be reaped.
     //
+    vector<SubscriberPtr> reaped;
+    _instance->fanOutPool()->queue(forwarded,
+                                   encodeEvents(_instance->communicator(), events, snapshot->subscribers.size()),
+                                   snapshot, reaped);
     vector<Ice::Identity> e;
-    for(vector<SubscriberPtr>::const_iterator p = copy.begin(); p != copy.end(); ++p)
+    for(vector<SubscriberPtr>::const_iterator p = reaped.begin(); p != reaped.end(); ++p)
     {
-        if(!(*p)->queue(forwarded, events) && (*p)->reap())
-        {
-            e.push_back((*p)->id());
-        }
+        e.push_back((*p)->id());
     }
 
     //
@@ -583,6 +595,7 @@ TransientTopicImpl::publish(bool forwarded, const EventDataSeq& events)
                 //
                 subscriber->destroy();
                 _subscribers.erase(q);
+                _snapshot = 0;
             }
         }
     }
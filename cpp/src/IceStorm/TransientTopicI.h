@@ -6,6 +6,7 @@
 #define TRANSIENT_TOPIC_I_H
 
 #include <IceStorm/IceStormInternal.h>
+#include <IceStorm/FanOut.h>
 
 namespace IceStorm
 {
@@ -66,6 +67,12 @@ private:
     //
     std::vector<SubscriberPtr> _subscribers;
 
+    //
+    // The snapshot of the subscribers used by the publishing threads,
+    // reset when the subscribers change.
+    //
+    SubscriberSnapshotPtr _snapshot;
+
     bool _destroyed; // Has this Topic been destroyed?
 };
 
@@ -0,0 +1,105 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+void
+allTests(Test::TestHelper* helper)
+{
+    Ice::CommunicatorPtr communicator = helper->communicator();
+
+    ControllerPrxPtr controller =
+        ICE_CHECKED_CAST(ControllerPrx, communicator->stringToProxy("controller:" + helper->getTestEndpoint(2)));
+    test(controller);
+
+    cout << "testing max dispatches... " << flush;
+    {
+        TestIntfPrxPtr prx = ICE_CHECKED_CAST(TestIntfPrx,
+                                              communicator->stringToProxy("test:" + helper->getTestEndpoint(0)));
+        test(prx);
+        controller->reset();
+
+        //
+        // The server stops reading requests from the connection while 2
+        // dispatches are in progress. A request read by another thread of
+        // the pool just before the connection is held can still be
+        // dispatched, but the dispatches never use the 6 threads.
+        //
+        for(int i = 0; i < 5; ++i)
+        {
+#ifdef ICE_CPP11_MAPPING
+            vector<future<void>> results;
+            for(int j = 0; j < 20; ++j)
+            {
+                results.push_back(prx->sleepAsync(20));
+            }
+            for(vector<future<void>>::iterator p = results.begin(); p != results.end(); ++p)
+            {
+                p->get();
+            }
+#else
+            vector<Ice::AsyncResultPtr> results;
+            for(int j = 0; j < 20; ++j)
+            {
+                results.push_back(prx->begin_sleep(20));
+            }
+            for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+            {
+                prx->end_sleep(*p);
+            }
+#endif
+        }
+        test(controller->getDispatchCount() == 100);
+        const int maxConcurrency = controller->getMaxConcurrency();
+        test(maxConcurrency >= 2 && maxConcurrency <= 4);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing max queue wait... " << flush;
+    {
+        TestIntfPrxPtr prx = ICE_CHECKED_CAST(TestIntfPrx,
+                                              communicator->stringToProxy("test:" + helper->getTestEndpoint(1)));
+        test(prx);
+        controller->reset();
+
+        //
+        // The requests of a batch are dispatched one after the other, the
+        // requests which waited for the first one for more than
+        // MaxQueueWait are rejected without calling the servant.
+        //
+        TestIntfPrxPtr batch = prx->ice_batchOneway();
+        batch->sleep(300);
+        for(int i = 0; i < 5; ++i)
+        {
+            batch->sleep(0);
+        }
+        batch->ice_flushBatchRequests();
+
+        //
+        // The server has a single thread, the ping is read once the batch
+        // is dispatched.
+        //
+        prx->ice_ping();
+        test(controller->getDispatchCount() == 1);
+
+        //
+        // Requests which don't wait are dispatched.
+        //
+        for(int i = 0; i < 5; ++i)
+        {
+            batch->sleep(0);
+        }
+        batch->ice_flushBatchRequests();
+        prx->sleep(0);
+        test(controller->getDispatchCount() == 7);
+    }
+    cout << "ok" << endl;
+
+    controller->shutdown();
+}
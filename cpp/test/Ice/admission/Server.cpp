@@ -0,0 +1,55 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <TestI.h>
+
+using namespace std;
+
+class Server : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Server::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    CountersPtr counters = new Counters();
+
+    //
+    // At most 2 dispatches in progress although the thread pool has 6 threads.
+    //
+    properties->setProperty("TestAdapter.Endpoints", getTestEndpoint(0));
+    properties->setProperty("TestAdapter.ThreadPool.Size", "6");
+    properties->setProperty("TestAdapter.ThreadPool.SizeWarn", "0");
+    properties->setProperty("TestAdapter.MaxDispatches", "2");
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    adapter->add(ICE_MAKE_SHARED(TestI, counters), Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    //
+    // Requests which waited for more than 100ms are rejected.
+    //
+    properties->setProperty("QueueWaitAdapter.Endpoints", getTestEndpoint(1));
+    properties->setProperty("QueueWaitAdapter.ThreadPool.Size", "1");
+    properties->setProperty("QueueWaitAdapter.MaxQueueWait", "100");
+    adapter = communicator->createObjectAdapter("QueueWaitAdapter");
+    adapter->add(ICE_MAKE_SHARED(TestI, counters), Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    properties->setProperty("ControllerAdapter.Endpoints", getTestEndpoint(2));
+    adapter = communicator->createObjectAdapter("ControllerAdapter");
+    adapter->add(ICE_MAKE_SHARED(ControllerI, counters), Ice::stringToIdentity("controller"));
+    adapter->activate();
+
+    serverReady();
+    communicator->waitForShutdown();
+}
+
+DEFINE_TEST(Server)
@@ -0,0 +1,97 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+Counters::Counters() :
+    _count(0),
+    _current(0),
+    _max(0)
+{
+}
+
+void
+Counters::start()
+{
+    Lock sync(*this);
+    ++_count;
+    if(++_current > _max)
+    {
+        _max = _current;
+    }
+}
+
+void
+Counters::finish()
+{
+    Lock sync(*this);
+    --_current;
+}
+
+int
+Counters::getDispatchCount()
+{
+    Lock sync(*this);
+    return _count;
+}
+
+int
+Counters::getMaxConcurrency()
+{
+    Lock sync(*this);
+    return _max;
+}
+
+void
+Counters::reset()
+{
+    Lock sync(*this);
+    _count = 0;
+    _max = _current;
+}
+
+TestI::TestI(const CountersPtr& counters) :
+    _counters(counters)
+{
+}
+
+void
+TestI::sleep(Ice::Int ms, const Ice::Current&)
+{
+    _counters->start();
+    IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(ms));
+    _counters->finish();
+}
+
+ControllerI::ControllerI(const CountersPtr& counters) :
+    _counters(counters)
+{
+}
+
+Ice::Int
+ControllerI::getDispatchCount(const Ice::Current&)
+{
+    return _counters->getDispatchCount();
+}
+
+Ice::Int
+ControllerI::getMaxConcurrency(const Ice::Current&)
+{
+    return _counters->getMaxConcurrency();
+}
+
+void
+ControllerI::reset(const Ice::Current&)
+{
+    _counters->reset();
+}
+
+void
+ControllerI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
@@ -0,0 +1,61 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+#include <IceUtil/Mutex.h>
+
+class Counters : public IceUtil::Shared, public IceUtil::Mutex
+{
+public:
+
+    Counters();
+
+    void start();
+    void finish();
+
+    int getDispatchCount();
+    int getMaxConcurrency();
+    void reset();
+
+private:
+
+    int _count;
+    int _current;
+    int _max;
+};
+typedef IceUtil::Handle<Counters> CountersPtr;
+
+class TestI : public Test::TestIntf
+{
+public:
+
+    TestI(const CountersPtr&);
+
+    virtual void sleep(Ice::Int, const Ice::Current&);
+
+private:
+
+    const CountersPtr _counters;
+};
+
+class ControllerI : public Test::Controller
+{
+public:
+
+    ControllerI(const CountersPtr&);
+
+    virtual Ice::Int getDispatchCount(const Ice::Current&);
+    virtual Ice::Int getMaxConcurrency(const Ice::Current&);
+    virtual void reset(const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    const CountersPtr _counters;
+};
+
+#endif
@@ -0,0 +1,109 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <IceUtil/InputUtil.h>
+#include <TestHelper.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+Ice::Long
+getDeadline(const Ice::Context& ctx)
+{
+    Ice::Context::const_iterator p = ctx.find("_deadline");
+    test(p != ctx.end());
+    Ice::Long remaining;
+    test(IceUtilInternal::stringToInt64(p->second, remaining));
+    return remaining;
+}
+
+}
+
+void
+allTests(Test::TestHelper* helper)
+{
+    Ice::CommunicatorPtr communicator = helper->communicator();
+    const string sref = "test:" + helper->getTestEndpoint();
+    TestIntfPrxPtr prx = ICE_CHECKED_CAST(TestIntfPrx, communicator->stringToProxy(sref));
+    test(prx);
+
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("Ice.PropagateDeadline", "1");
+    initData.properties->setProperty("Ice.RetryIntervals", "200");
+    Ice::CommunicatorHolder ich(initData);
+    TestIntfPrxPtr deadlinePrx = ICE_UNCHECKED_CAST(TestIntfPrx, ich->stringToProxy(sref));
+
+    cout << "testing deadline propagation... " << flush;
+    {
+        test(prx->remainingTime() == -1);
+        test(prx->ice_invocationTimeout(1000)->remainingTime() == -1);
+
+        test(deadlinePrx->remainingTime() == -1);
+        test(deadlinePrx->ice_invocationTimeout(-2)->remainingTime() == -1);
+        Ice::Int remaining = deadlinePrx->ice_invocationTimeout(1000)->remainingTime();
+        test(remaining > 0 && remaining <= 1000);
+#ifdef ICE_CPP11_MAPPING
+        remaining = deadlinePrx->ice_invocationTimeout(1000)->remainingTimeAsync().get();
+#else
+        TestIntfPrxPtr to = deadlinePrx->ice_invocationTimeout(1000);
+        remaining = to->end_remainingTime(to->begin_remainingTime());
+#endif
+        test(remaining > 0 && remaining <= 1000);
+
+        //
+        // The invocations made by the servant inherit the deadline.
+        //
+        remaining = deadlinePrx->ice_invocationTimeout(1000)->forwardRemainingTime(prx);
+        test(remaining > 0 && remaining <= 1000);
+        test(deadlinePrx->forwardRemainingTime(prx) == -1);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing forwarded contexts... " << flush;
+    {
+        Ice::Context ctx;
+        ctx["_deadline"] = "100000";
+
+        //
+        // The deadline of an explicit context is removed or replaced with
+        // the deadline of the invocation.
+        //
+        Ice::Context result = prx->getContext(ctx);
+        test(result.find("_deadline") == result.end());
+        result = prx->ice_context(ctx)->getContext();
+        test(result.find("_deadline") == result.end());
+        test(getDeadline(deadlinePrx->ice_invocationTimeout(1000)->getContext(ctx)) <= 1000);
+        test(getDeadline(deadlinePrx->ice_invocationTimeout(1000)->ice_context(ctx)->getContext()) <= 1000);
+
+        //
+        // The deadline of the dispatch context forwarded by the servant is
+        // refreshed with the time remaining.
+        //
+        result = deadlinePrx->ice_invocationTimeout(1000)->forwardContext(prx, 300);
+        Ice::Long remaining = getDeadline(result);
+        test(remaining > 0 && remaining <= 750);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing deadline of retried requests... " << flush;
+    {
+        //
+        // The request is retried 200ms after the connection is closed, the
+        // retry carries the time remaining when it's sent.
+        //
+        Ice::IntSeq remainingTimes = deadlinePrx->ice_invocationTimeout(1000)->closeOnce();
+        test(remainingTimes.size() == 2);
+        test(remainingTimes[0] > 0 && remainingTimes[0] <= 1000);
+        test(remainingTimes[1] > 0 && remainingTimes[1] <= remainingTimes[0] - 150);
+    }
+    cout << "ok" << endl;
+
+    prx->shutdown();
+}
@@ -0,0 +1,63 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+Ice::Int
+TestI::remainingTime(const Ice::Current&)
+{
+    return Ice::getDispatchRemainingTime();
+}
+
+Ice::Context
+TestI::getContext(const Ice::Current& current)
+{
+    return current.ctx;
+}
+
+Ice::Int
+#ifdef ICE_CPP11_MAPPING
+TestI::forwardRemainingTime(shared_ptr<Test::TestIntfPrx> prx, const Ice::Current&)
+#else
+TestI::forwardRemainingTime(const Test::TestIntfPrx& prx, const Ice::Current&)
+#endif
+{
+    return prx->remainingTime();
+}
+
+Ice::Context
+#ifdef ICE_CPP11_MAPPING
+TestI::forwardContext(shared_ptr<Test::TestIntfPrx> prx, Ice::Int delay, const Ice::Current& current)
+#else
+TestI::forwardContext(const Test::TestIntfPrx& prx, Ice::Int delay, const Ice::Current& current)
+#endif
+{
+    IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(delay));
+    return prx->getContext(current.ctx);
+}
+
+Ice::IntSeq
+TestI::closeOnce(const Ice::Current& current)
+{
+    Lock sync(*this);
+    _remainingTimes.push_back(Ice::getDispatchRemainingTime());
+    if(_remainingTimes.size() == 1)
+    {
+        current.con->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, Forcefully));
+        return Ice::IntSeq();
+    }
+
+    Ice::IntSeq remainingTimes;
+    remainingTimes.swap(_remainingTimes);
+    return remainingTimes;
+}
+
+void
+TestI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
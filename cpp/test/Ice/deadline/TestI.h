@@ -0,0 +1,32 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+#include <IceUtil/Mutex.h>
+
+class TestI : public Test::TestIntf, public IceUtil::Mutex
+{
+public:
+
+    virtual Ice::Int remainingTime(const Ice::Current&);
+    virtual Ice::Context getContext(const Ice::Current&);
+#ifdef ICE_CPP11_MAPPING
+    virtual Ice::Int forwardRemainingTime(std::shared_ptr<Test::TestIntfPrx>, const Ice::Current&);
+    virtual Ice::Context forwardContext(std::shared_ptr<Test::TestIntfPrx>, Ice::Int, const Ice::Current&);
+#else
+    virtual Ice::Int forwardRemainingTime(const Test::TestIntfPrx&, const Ice::Current&);
+    virtual Ice::Context forwardContext(const Test::TestIntfPrx&, Ice::Int, const Ice::Current&);
+#endif
+    virtual Ice::IntSeq closeOnce(const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    Ice::IntSeq _remainingTimes;
+};
+
+#endif
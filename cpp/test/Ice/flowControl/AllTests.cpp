@@ -0,0 +1,93 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+void
+allTests(Test::TestHelper* helper)
+{
+    Ice::CommunicatorPtr communicator = helper->communicator();
+    TestIntfPrxPtr prx = ICE_CHECKED_CAST(TestIntfPrx,
+                                          communicator->stringToProxy("test:" + helper->getTestEndpoint()));
+    test(prx);
+
+    cout << "testing flow control... " << flush;
+    {
+        prx->op(); // The reply is received after the initial credit.
+
+        //
+        // The request larger than the 1KB window uses up the credit, the
+        // next oneway request waits for the credit returned once the
+        // server dispatched the requests.
+        //
+        TestIntfPrxPtr oneway = prx->ice_oneway();
+        oneway->sleep(500);
+        oneway->sendData(Ice::ByteSeq(2 * 1024));
+#ifdef ICE_CPP11_MAPPING
+        auto sent = make_shared<promise<bool>>();
+        oneway->opAsync(nullptr,
+                        [](exception_ptr) { test(false); },
+                        [sent](bool sentSynchronously) { sent->set_value(sentSynchronously); });
+        test(!sent->get_future().get());
+#else
+        Ice::AsyncResultPtr r = oneway->begin_op();
+        test(!r->sentSynchronously());
+        r->waitForSent();
+        oneway->end_op(r);
+#endif
+        prx->op();
+
+        //
+        // All the credit is returned once the requests are dispatched.
+        //
+#ifdef ICE_CPP11_MAPPING
+        sent = make_shared<promise<bool>>();
+        oneway->opAsync(nullptr,
+                        [](exception_ptr) { test(false); },
+                        [sent](bool sentSynchronously) { sent->set_value(sentSynchronously); });
+        test(sent->get_future().get());
+#else
+        r = oneway->begin_op();
+        test(r->sentSynchronously());
+        oneway->end_op(r);
+#endif
+    }
+    cout << "ok" << endl;
+
+    cout << "testing clients without flow control... " << flush;
+    {
+        //
+        // The adapter doesn't grant credit to clients which don't ask for
+        // it, their requests are sent without waiting.
+        //
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.FlowControl", "0");
+        Ice::CommunicatorHolder ich(initData);
+        TestIntfPrxPtr oneway = ICE_UNCHECKED_CAST(TestIntfPrx, ich->stringToProxy(prx->ice_toString()))->ice_oneway();
+        oneway->ice_getConnection();
+        oneway->sleep(500);
+        oneway->sendData(Ice::ByteSeq(2 * 1024));
+#ifdef ICE_CPP11_MAPPING
+        auto sent = make_shared<promise<bool>>();
+        oneway->opAsync(nullptr,
+                        [](exception_ptr) { test(false); },
+                        [sent](bool sentSynchronously) { sent->set_value(sentSynchronously); });
+        test(sent->get_future().get());
+#else
+        Ice::AsyncResultPtr r = oneway->begin_op();
+        test(r->sentSynchronously());
+        oneway->end_op(r);
+#endif
+        oneway->ice_twoway()->op();
+    }
+    cout << "ok" << endl;
+
+    prx->shutdown();
+}
@@ -0,0 +1,30 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+void
+TestI::op(const Ice::Current&)
+{
+}
+
+void
+TestI::sleep(Ice::Int ms, const Ice::Current&)
+{
+    IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(ms));
+}
+
+void
+TestI::sendData(ICE_IN(Ice::ByteSeq), const Ice::Current&)
+{
+}
+
+void
+TestI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
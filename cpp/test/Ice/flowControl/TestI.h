@@ -0,0 +1,20 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+
+class TestI : public Test::TestIntf
+{
+public:
+
+    virtual void op(const Ice::Current&);
+    virtual void sleep(Ice::Int, const Ice::Current&);
+    virtual void sendData(ICE_IN(Ice::ByteSeq), const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+};
+
+#endif
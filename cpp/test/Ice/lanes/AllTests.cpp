@@ -0,0 +1,146 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+Ice::Int
+getCount(const StringIntDict& counts, const string& lane)
+{
+    StringIntDict::const_iterator p = counts.find(lane);
+    return p == counts.end() ? 0 : p->second;
+}
+
+//
+// Block the single thread of the adapter thread pool, the requests sent
+// until the thread is released wait to be read.
+//
+void
+block(const TestIntfPrxPtr& prx, const ControllerPrxPtr& controller)
+{
+    prx->ice_oneway()->block();
+    controller->waitForBlocked();
+}
+
+}
+
+void
+allTests(Test::TestHelper* helper)
+{
+    Ice::CommunicatorPtr communicator = helper->communicator();
+
+    ControllerPrxPtr controller =
+        ICE_CHECKED_CAST(ControllerPrx, communicator->stringToProxy("controller:" + helper->getTestEndpoint(2)));
+    test(controller);
+
+    cout << "testing lane operations and context... " << flush;
+    {
+        TestIntfPrxPtr prx = ICE_CHECKED_CAST(TestIntfPrx,
+                                              communicator->stringToProxy("test:" + helper->getTestEndpoint(0)));
+        test(prx);
+        StringIntDict counts = controller->getLaneDispatchCounts();
+
+        prx->slow();
+        prx->fast();
+        prx->mark();
+        prx->other();
+
+        //
+        // The lane named by the context entry overrides the operation
+        // lane, unless it isn't a configured lane.
+        //
+        Ice::Context ctx;
+        ctx["lane"] = "slow";
+        prx->other(ctx);
+        prx->fast(ctx);
+        ctx["lane"] = "bogus";
+        prx->fast(ctx);
+
+        StringIntDict newCounts = controller->getLaneDispatchCounts();
+        test(getCount(newCounts, "slow") == getCount(counts, "slow") + 3);
+        test(getCount(newCounts, "fast") == getCount(counts, "fast") + 3);
+        test(getCount(newCounts, "Default") == getCount(counts, "Default") + 1);
+        controller->reset();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing weighted dispatch... " << flush;
+    {
+        TestIntfPrxPtr prx = ICE_UNCHECKED_CAST(TestIntfPrx,
+                                                communicator->stringToProxy("test:" + helper->getTestEndpoint(0)));
+        TestIntfPrxPtr slowPrx = prx->ice_connectionId("slow")->ice_oneway();
+        TestIntfPrxPtr fastPrx = prx->ice_connectionId("fast")->ice_oneway();
+        slowPrx->ice_getConnection();
+        fastPrx->ice_getConnection();
+
+        //
+        // The slow requests are sent first. Once the thread is released, it
+        // reads a request from each connection before dispatching the next
+        // queued request, the fast lane gets most of the dispatches while
+        // both lanes have requests queued.
+        //
+        block(prx, controller);
+        for(int i = 0; i < 20; ++i)
+        {
+            slowPrx->slow();
+        }
+        for(int i = 0; i < 20; ++i)
+        {
+            fastPrx->fast();
+        }
+        controller->release();
+
+        StringSeq operations = controller->waitForDispatches(40);
+        test(operations.size() == 40);
+        test(count(operations.begin(), operations.begin() + 20, "fast") >= 14);
+        controller->reset();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing lane bound... " << flush;
+    {
+        TestIntfPrxPtr prx = ICE_UNCHECKED_CAST(TestIntfPrx,
+                                                communicator->stringToProxy("test:" + helper->getTestEndpoint(1)));
+        TestIntfPrxPtr slowPrx = prx->ice_connectionId("slow")->ice_oneway();
+        TestIntfPrxPtr fastPrx = prx->ice_connectionId("fast")->ice_oneway();
+        slowPrx->ice_getConnection();
+        fastPrx->ice_getConnection();
+
+        //
+        // The connection of the slow requests stops reading each time it
+        // queues a slow request, until the request is dispatched. The mark
+        // request sent after them is only read and dispatched once all the
+        // slow requests are dispatched, although the fast lane gets most of
+        // the dispatches.
+        //
+        block(prx, controller);
+        for(int i = 0; i < 6; ++i)
+        {
+            slowPrx->slow();
+        }
+        slowPrx->mark();
+        for(int i = 0; i < 12; ++i)
+        {
+            fastPrx->fast();
+        }
+        controller->release();
+
+        StringSeq operations = controller->waitForDispatches(19);
+        test(operations.size() == 19);
+        StringSeq::const_iterator mark = find(operations.begin(), operations.end(), "mark");
+        test(mark != operations.end());
+        test(count(operations.begin(), mark, "slow") == 6);
+        controller->reset();
+    }
+    cout << "ok" << endl;
+
+    controller->shutdown();
+}
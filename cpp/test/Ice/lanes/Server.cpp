@@ -0,0 +1,68 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <TestI.h>
+
+using namespace std;
+
+class Server : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Server::run(int argc, char** argv)
+{
+    Ice::PropertiesPtr properties = createTestProperties(argc, argv);
+    properties->setProperty("Ice.Admin.Enabled", "1");
+    properties->setProperty("IceMX.Metrics.View.Map.Dispatch.GroupBy", "lane");
+    Ice::CommunicatorHolder communicator = initialize(argc, argv, properties);
+    properties = communicator->getProperties();
+    DispatchesPtr dispatches = new Dispatches();
+
+    //
+    // The fast lane gets 4 dispatches for each dispatch of the slow lane
+    // while both have requests queued. A single thread reads and dispatches
+    // the requests.
+    //
+    properties->setProperty("TestAdapter.Endpoints", getTestEndpoint(0));
+    properties->setProperty("TestAdapter.ThreadPool.Size", "1");
+    properties->setProperty("TestAdapter.Lanes", "slow fast");
+    properties->setProperty("TestAdapter.Lane.slow.Operations", "slow");
+    properties->setProperty("TestAdapter.Lane.fast.Operations", "fast mark");
+    properties->setProperty("TestAdapter.Lane.fast.Weight", "4");
+    properties->setProperty("TestAdapter.LaneContext", "lane");
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    adapter->add(ICE_MAKE_SHARED(TestI, dispatches), Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    //
+    // The slow lane queues a single request, the connection which queued
+    // it stops reading until it's dispatched.
+    //
+    properties->setProperty("BoundedAdapter.Endpoints", getTestEndpoint(1));
+    properties->setProperty("BoundedAdapter.ThreadPool.Size", "1");
+    properties->setProperty("BoundedAdapter.Lanes", "slow fast");
+    properties->setProperty("BoundedAdapter.Lane.slow.Operations", "slow");
+    properties->setProperty("BoundedAdapter.Lane.slow.MaxQueued", "1");
+    properties->setProperty("BoundedAdapter.Lane.fast.Operations", "fast mark");
+    properties->setProperty("BoundedAdapter.Lane.fast.Weight", "10");
+    adapter = communicator->createObjectAdapter("BoundedAdapter");
+    adapter->add(ICE_MAKE_SHARED(TestI, dispatches), Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    properties->setProperty("ControllerAdapter.Endpoints", getTestEndpoint(2));
+    adapter = communicator->createObjectAdapter("ControllerAdapter");
+    adapter->add(ICE_MAKE_SHARED(ControllerI, dispatches), Ice::stringToIdentity("controller"));
+    adapter->activate();
+
+    serverReady();
+    communicator->waitForShutdown();
+}
+
+DEFINE_TEST(Server)
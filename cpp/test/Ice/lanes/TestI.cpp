@@ -0,0 +1,159 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+Dispatches::Dispatches() :
+    _blocked(false),
+    _released(false)
+{
+}
+
+void
+Dispatches::add(const string& operation)
+{
+    Lock sync(*this);
+    _operations.push_back(operation);
+    notifyAll();
+}
+
+Test::StringSeq
+Dispatches::waitFor(int count)
+{
+    Lock sync(*this);
+    while(_operations.size() < static_cast<size_t>(count))
+    {
+        wait();
+    }
+    return _operations;
+}
+
+void
+Dispatches::reset()
+{
+    Lock sync(*this);
+    _operations.clear();
+    _blocked = false;
+    _released = false;
+}
+
+void
+Dispatches::block()
+{
+    Lock sync(*this);
+    _blocked = true;
+    notifyAll();
+    while(!_released)
+    {
+        wait();
+    }
+}
+
+void
+Dispatches::waitForBlocked()
+{
+    Lock sync(*this);
+    while(!_blocked)
+    {
+        wait();
+    }
+}
+
+void
+Dispatches::release()
+{
+    Lock sync(*this);
+    _released = true;
+    notifyAll();
+}
+
+TestI::TestI(const DispatchesPtr& dispatches) :
+    _dispatches(dispatches)
+{
+}
+
+void
+TestI::block(const Ice::Current&)
+{
+    _dispatches->block();
+}
+
+void
+TestI::slow(const Ice::Current& current)
+{
+    _dispatches->add(current.operation);
+}
+
+void
+TestI::fast(const Ice::Current& current)
+{
+    _dispatches->add(current.operation);
+}
+
+void
+TestI::mark(const Ice::Current& current)
+{
+    _dispatches->add(current.operation);
+}
+
+void
+TestI::other(const Ice::Current& current)
+{
+    _dispatches->add(current.operation);
+}
+
+ControllerI::ControllerI(const DispatchesPtr& dispatches) :
+    _dispatches(dispatches)
+{
+}
+
+void
+ControllerI::waitForBlocked(const Ice::Current&)
+{
+    _dispatches->waitForBlocked();
+}
+
+void
+ControllerI::release(const Ice::Current&)
+{
+    _dispatches->release();
+}
+
+Test::StringSeq
+ControllerI::waitForDispatches(Ice::Int count, const Ice::Current&)
+{
+    return _dispatches->waitFor(count);
+}
+
+void
+ControllerI::reset(const Ice::Current&)
+{
+    _dispatches->reset();
+}
+
+Test::StringIntDict
+ControllerI::getLaneDispatchCounts(const Ice::Current& current)
+{
+    IceMX::MetricsAdminPtr metrics =
+        ICE_DYNAMIC_CAST(IceMX::MetricsAdmin, current.adapter->getCommunicator()->findAdminFacet("Metrics"));
+    Ice::Long timestamp;
+    IceMX::MetricsView view = metrics->getMetricsView("View", timestamp, current);
+
+    Test::StringIntDict counts;
+    const IceMX::MetricsMap& dispatch = view["Dispatch"];
+    for(IceMX::MetricsMap::const_iterator p = dispatch.begin(); p != dispatch.end(); ++p)
+    {
+        counts[(*p)->id] = static_cast<Ice::Int>((*p)->total);
+    }
+    return counts;
+}
+
+void
+ControllerI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
@@ -0,0 +1,68 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+#include <IceUtil/Monitor.h>
+
+class Dispatches : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    Dispatches();
+
+    void add(const std::string&);
+    Test::StringSeq waitFor(int);
+    void reset();
+
+    void block();
+    void waitForBlocked();
+    void release();
+
+private:
+
+    Test::StringSeq _operations;
+    bool _blocked;
+    bool _released;
+};
+typedef IceUtil::Handle<Dispatches> DispatchesPtr;
+
+class TestI : public Test::TestIntf
+{
+public:
+
+    TestI(const DispatchesPtr&);
+
+    virtual void block(const Ice::Current&);
+    virtual void slow(const Ice::Current&);
+    virtual void fast(const Ice::Current&);
+    virtual void mark(const Ice::Current&);
+    virtual void other(const Ice::Current&);
+
+private:
+
+    const DispatchesPtr _dispatches;
+};
+
+class ControllerI : public Test::Controller
+{
+public:
+
+    ControllerI(const DispatchesPtr&);
+
+    virtual void waitForBlocked(const Ice::Current&);
+    virtual void release(const Ice::Current&);
+    virtual Test::StringSeq waitForDispatches(Ice::Int, const Ice::Current&);
+    virtual void reset(const Ice::Current&);
+    virtual Test::StringIntDict getLaneDispatchCounts(const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    const DispatchesPtr _dispatches;
+};
+
+#endif
@@ -627,6 +627,93 @@ allTests(Test::TestHelper* helper, const string& ref)
     }
     cout << "ok" << endl;
 
+    cout << "testing locator cache refresh and negative caching... " << flush;
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.LocatorCacheRefreshAhead", "50");
+        initData.properties->setProperty("Ice.LocatorCacheNegativeTimeout", "1");
+        Ice::CommunicatorPtr ic = Ice::initialize(initData);
+
+        count = locator->getRequestCount();
+        for(int i = 0; i < 2; ++i)
+        {
+            try
+            {
+                ic->stringToProxy("test@TestAdapter6")->ice_ping();
+                test(false);
+            }
+            catch(const Ice::NotRegisteredException& ex)
+            {
+                test(ex.kindOfObject == "object adapter");
+                test(ex.id == "TestAdapter6");
+            }
+        }
+        test(++count == locator->getRequestCount()); // The unknown adapter is cached.
+
+        registry->setAdapterDirectProxy("TestAdapter6", locator->findAdapterById("TestAdapter"));
+        ++count;
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1200));
+        ic->stringToProxy("test@TestAdapter6")->ice_ping(); // The unknown adapter entry expired.
+        test(++count == locator->getRequestCount());
+
+        ic->stringToProxy("test@TestAdapter6")->ice_locatorCacheTimeout(2)->ice_ping(); // 2s timeout.
+        test(count == locator->getRequestCount());
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1200));
+
+        //
+        // More than half of the timeout elapsed, the following request
+        // uses the cached endpoints and refreshes them in the background.
+        //
+        ic->stringToProxy("test@TestAdapter6")->ice_locatorCacheTimeout(2)->ice_ping(); // 2s timeout.
+        for(int i = 0; i < 100 && locator->getRequestCount() == count; ++i)
+        {
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+        }
+        test(++count == locator->getRequestCount());
+        ic->stringToProxy("test@TestAdapter6")->ice_locatorCacheTimeout(2)->ice_ping(); // 2s timeout.
+        test(count == locator->getRequestCount());
+
+        registry->setAdapterDirectProxy("TestAdapter6", 0);
+        ic->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing locator cache size limit... " << flush;
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.LocatorCacheSizeMax", "2");
+        Ice::CommunicatorPtr ic = Ice::initialize(initData);
+
+        Ice::ObjectPrxPtr adapter = locator->findAdapterById("TestAdapter");
+        registry->setAdapterDirectProxy("TestAdapter7", adapter);
+        registry->setAdapterDirectProxy("TestAdapter8", adapter);
+
+        count = locator->getRequestCount();
+        ic->stringToProxy("test@TestAdapter")->ice_ping();
+        ic->stringToProxy("test@TestAdapter7")->ice_ping();
+        test(count + 2 == locator->getRequestCount());
+        ic->stringToProxy("test@TestAdapter")->ice_ping(); // Cached, TestAdapter7 is the least recently used.
+        test(count + 2 == locator->getRequestCount());
+
+        //
+        // Caching TestAdapter8 evicts TestAdapter7, which is looked up
+        // again.
+        //
+        ic->stringToProxy("test@TestAdapter8")->ice_ping();
+        test(count + 3 == locator->getRequestCount());
+        ic->stringToProxy("test@TestAdapter")->ice_ping();
+        test(count + 3 == locator->getRequestCount());
+        ic->stringToProxy("test@TestAdapter7")->ice_ping();
+        test(count + 4 == locator->getRequestCount());
+
+        registry->setAdapterDirectProxy("TestAdapter7", 0);
+        registry->setAdapterDirectProxy("TestAdapter8", 0);
+        ic->destroy();
+    }
+    cout << "ok" << endl;
+
     cout << "testing proxy from server after shutdown... " << flush;
     hello = obj->getReplicatedHello();
     obj->shutdown();
@@ -5,6 +5,7 @@
 #include <Ice/Ice.h>
 #include <TestHelper.h>
 #include <fstream>
+#include <sstream>
 
 using namespace std;
 
@@ -41,6 +42,51 @@ Client1::run(int argc, char** argv)
     in.close();
     remove("log.txt");
     cout << "ok" << endl;
+
+    cout << "testing asynchronous logger with Ice.LogFile... " << flush;
+    properties = createTestProperties(argc, argv);
+    properties->load("config.client");
+    properties->setProperty("Ice.LogFile", "log.txt");
+    properties->setProperty("Ice.LogAsync", "1");
+    {
+        Ice::CommunicatorHolder ich = initialize(argc, argv, properties);
+        for(int i = 0; i < 100; ++i)
+        {
+            ostringstream os;
+            os << "message " << i;
+            ich->getLogger()->trace("info", os.str());
+        }
+        ich->getLogger()->warning("warning");
+    }
+
+    //
+    // Destroying the communicator writes the queued messages.
+    //
+    in.clear();
+    in.open("log.txt");
+    if(!in)
+    {
+        test(false);
+    }
+    for(int i = 0; i < 100; ++i)
+    {
+        ostringstream os;
+        os << "info: message " << i;
+        if(!getline(in, s))
+        {
+            test(false);
+        }
+        test(s.find(programName) != string::npos);
+        test(s.find(os.str()) != string::npos);
+    }
+    if(!getline(in, s))
+    {
+        test(false);
+    }
+    test(s.find("warning: warning") != string::npos);
+    in.close();
+    remove("log.txt");
+    cout << "ok" << endl;
 }
 
 DEFINE_TEST(Client1)
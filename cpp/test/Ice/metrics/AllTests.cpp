@@ -7,12 +7,67 @@
 #include <InstrumentationI.h>
 #include <Test.h>
 
+#if !defined(_WIN32) && !defined(ICE_OS_UWP) && TARGET_OS_IPHONE==0
+#   define ICE_TEST_OPEN_METRICS
+#   include <cstring>
+#   include <sys/socket.h>
+#   include <netdb.h>
+#   include <unistd.h>
+#endif
+
 using namespace std;
 using namespace Test;
 
 namespace
 {
 
+#ifdef ICE_TEST_OPEN_METRICS
+//
+// Send an HTTP GET request to the OpenMetrics exporter listening on the
+// loopback interface and return the response, delimited by the closure
+// of the connection.
+//
+string
+scrape(int port, const string& path)
+{
+    ostringstream os;
+    os << port;
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* addrs = 0;
+    test(getaddrinfo("localhost", os.str().c_str(), &hints, &addrs) == 0);
+
+    int fd = -1;
+    for(struct addrinfo* p = addrs; p && fd < 0; p = p->ai_next)
+    {
+        fd = socket(p->ai_family, p->ai_socktype, p->ai_protocol);
+        if(fd >= 0 && connect(fd, p->ai_addr, p->ai_addrlen) != 0)
+        {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addrs);
+    test(fd >= 0);
+
+    const string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    test(send(fd, request.data(), request.size(), 0) == static_cast<ssize_t>(request.size()));
+
+    string response;
+    char buf[4096];
+    ssize_t ret;
+    while((ret = recv(fd, buf, sizeof(buf), 0)) > 0)
+    {
+        response.append(buf, static_cast<size_t>(ret));
+    }
+    close(fd);
+    return response;
+}
+#endif
+
 class Callback : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mutex>
 {
 public:
@@ -396,6 +451,36 @@ checkFailure(const IceMX::MetricsAdminPrxPtr& m, const string& map, const string
     }
 }
 
+void
+checkHistograms(const IceMX::MetricsAdminPrxPtr& m, const string& map, const IceMX::MetricsMap& metrics)
+{
+    IceMX::MetricsHistogramSeq histograms = m->getMetricsHistograms("View", map);
+    test(histograms.size() == metrics.size());
+    for(IceMX::MetricsHistogramSeq::const_iterator p = histograms.begin(); p != histograms.end(); ++p)
+    {
+        IceMX::MetricsPtr metric;
+        for(IceMX::MetricsMap::const_iterator q = metrics.begin(); q != metrics.end(); ++q)
+        {
+            if((*q)->id == p->id)
+            {
+                metric = *q;
+            }
+        }
+        test(metric);
+        test(p->count == metric->total - metric->current);
+        test(p->bounds.size() == p->counts.size());
+
+        Ice::Long count = 0;
+        for(size_t i = 0; i < p->bounds.size(); ++i)
+        {
+            test(i == 0 || p->bounds[i] > p->bounds[i - 1]);
+            test(p->counts[i] > 0);
+            count += p->counts[i];
+        }
+        test(count == p->count);
+    }
+}
+
 map<string, IceMX::MetricsPtr>
 toMap(const IceMX::MetricsMap& mmap)
 {
@@ -904,6 +989,12 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
     test(dm1->current <= 1 && dm1->total == 1 && dm1->failures == 0 && dm1->userException == 0);
     test(dm1->size == 21 && dm1->replySize == 7);
 
+    //
+    // The adapter doesn't have dispatch lanes, dispatches don't have a queue
+    // time.
+    //
+    test(!dm1->queueTime);
+
     dm1 = ICE_DYNAMIC_CAST(IceMX::DispatchMetrics, map["opWithUserException"]);
     test(dm1->current <= 1 && dm1->total == 1 && dm1->failures == 0 && dm1->userException == 1);
     test(dm1->size == 38 && dm1->replySize == 23);
@@ -923,6 +1014,18 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
     checkFailure(serverMetrics, "Dispatch", dm1->id, "unknown", 1);
     test(dm1->size == 41 && dm1->replySize == 23);
 
+    waitForCurrent(serverMetrics, "View", "Dispatch", 0);
+    checkHistograms(serverMetrics, "Dispatch", serverMetrics->getMetricsView("View", timestamp)["Dispatch"]);
+    test(serverMetrics->getMetricsHistograms("View", "Connection").empty());
+    try
+    {
+        serverMetrics->getMetricsHistograms("UnknownView", "Dispatch");
+        test(false);
+    }
+    catch(const IceMX::UnknownMetricsView&)
+    {
+    }
+
     InvokeOp op(metrics);
 
     testAttribute(serverMetrics, serverProps, update.get(), "Dispatch", "parent", "TestAdapter", op);
@@ -960,6 +1063,8 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
     testAttribute(serverMetrics, serverProps, update.get(), "Dispatch", "context.entry2", "", op);
     testAttribute(serverMetrics, serverProps, update.get(), "Dispatch", "context.entry3", "", op);
 
+    testAttribute(serverMetrics, serverProps, update.get(), "Dispatch", "lane", "", op);
+
     cout << "ok" << endl;
 
     cout << "testing invocation metrics... " << flush;
@@ -1616,5 +1721,37 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
     }
     cout << "ok" << endl;
 
+#ifdef ICE_TEST_OPEN_METRICS
+    cout << "testing OpenMetrics exporter... " << flush;
+    {
+        const int exporterPort = helper->getTestPort(5);
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.Admin.Enabled", "1");
+        initData.properties->setProperty("IceMX.Metrics.View.Map.Invocation.GroupBy", "operation");
+        ostringstream os;
+        os << exporterPort;
+        initData.properties->setProperty("IceMX.OpenMetrics.Port", os.str());
+        Ice::CommunicatorHolder ich(initData);
+
+        ich->stringToProxy(communicator->proxyToString(metrics))->ice_ping();
+
+        //
+        // The exporter listens on the loopback interface by default.
+        //
+        string response = scrape(exporterPort, "/metrics");
+        test(response.find("HTTP/1.1 200 OK\r\n") == 0);
+        test(response.find("Content-Type: application/openmetrics-text") != string::npos);
+        test(response.find("# TYPE ice_invocation counter\n") != string::npos);
+        test(response.find("ice_invocation_total{view=\"View\",id=\"ice_ping\"} 1\n") != string::npos);
+        test(response.find("# TYPE ice_invocation_duration_seconds histogram\n") != string::npos);
+        test(response.size() >= 6 && response.substr(response.size() - 6) == "# EOF\n");
+
+        response = scrape(exporterPort, "/unknown");
+        test(response.find("HTTP/1.1 404 Not Found\r\n") == 0);
+    }
+    cout << "ok" << endl;
+#endif
+
     return metrics;
 }
@@ -0,0 +1,247 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <TestI.h>
+
+#include <cstdio>
+#include <fstream>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+struct TraceParent
+{
+    string traceId;
+    string spanId;
+    string flags;
+};
+
+//
+// Return the W3C trace context of the given request context.
+//
+TraceParent
+getTraceParent(const Ice::Context& ctx)
+{
+    Ice::Context::const_iterator p = ctx.find("traceparent");
+    test(p != ctx.end());
+
+    const string& value = p->second;
+    test(value.size() == 55 && value.substr(0, 3) == "00-" && value[35] == '-' && value[52] == '-');
+
+    TraceParent traceParent;
+    traceParent.traceId = value.substr(3, 32);
+    traceParent.spanId = value.substr(36, 16);
+    traceParent.flags = value.substr(53);
+    return traceParent;
+}
+
+struct Span
+{
+    string traceId;
+    string spanId;
+    string parentSpanId;
+    string name;
+    string kind;
+};
+
+//
+// Return the value of the first string field with the given name of a
+// span line, the span fields are written before the attributes and
+// events.
+//
+string
+getField(const string& line, const string& name)
+{
+    const string key = "\"" + name + "\":\"";
+    string::size_type pos = line.find(key);
+    if(pos == string::npos)
+    {
+        return string();
+    }
+    pos += key.size();
+    return line.substr(pos, line.find('"', pos) - pos);
+}
+
+vector<Span>
+readSpans(const string& file)
+{
+    ifstream in(file.c_str());
+    test(in.is_open());
+
+    vector<Span> spans;
+    string line;
+    while(getline(in, line))
+    {
+        test(line[0] == '{' && line[line.size() - 1] == '}');
+        test(line.find("\"status\":{\"code\":\"OK\"}") != string::npos);
+
+        Span span;
+        span.traceId = getField(line, "traceId");
+        span.spanId = getField(line, "spanId");
+        span.parentSpanId = getField(line, "parentSpanId");
+        span.name = getField(line, "name");
+        span.kind = getField(line, "kind");
+        spans.push_back(span);
+    }
+    return spans;
+}
+
+Span
+findSpan(const vector<Span>& spans, const string& kind, const string& name, const string& traceId)
+{
+    vector<Span>::const_iterator found = spans.end();
+    for(vector<Span>::const_iterator p = spans.begin(); p != spans.end(); ++p)
+    {
+        if(p->kind == kind && p->name == name && p->traceId == traceId)
+        {
+            test(found == spans.end());
+            found = p;
+        }
+    }
+    test(found != spans.end());
+    return *found;
+}
+
+size_t
+countSpans(const vector<Span>& spans, const string& traceId)
+{
+    size_t count = 0;
+    for(vector<Span>::const_iterator p = spans.begin(); p != spans.end(); ++p)
+    {
+        if(p->traceId == traceId)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+}
+
+void
+allTests(Test::TestHelper* helper)
+{
+    Ice::CommunicatorPtr communicator = helper->communicator();
+
+    remove("client.spans");
+    remove("server.spans");
+    remove("unsampled.spans");
+
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("IceMX.Tracing.File", "server.spans");
+    initData.properties->setProperty("TestAdapter.Endpoints", helper->getTestEndpoint(0));
+    Ice::CommunicatorPtr server = Ice::initialize(initData);
+    Ice::ObjectAdapterPtr adapter = server->createObjectAdapter("TestAdapter");
+    adapter->add(ICE_MAKE_SHARED(TestI), Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("IceMX.Tracing.File", "client.spans");
+    initData.properties->setProperty("CallbackAdapter.Endpoints", helper->getTestEndpoint(1));
+    Ice::CommunicatorPtr client = Ice::initialize(initData);
+    adapter = client->createObjectAdapter("CallbackAdapter");
+    Ice::ObjectPrxPtr obj = adapter->add(ICE_MAKE_SHARED(TestI), Ice::stringToIdentity("callback"));
+    TestIntfPrxPtr callback = ICE_UNCHECKED_CAST(TestIntfPrx, obj);
+    adapter->activate();
+
+    TestIntfPrxPtr prx = ICE_UNCHECKED_CAST(TestIntfPrx, client->stringToProxy("test:" + helper->getTestEndpoint(0)));
+
+    cout << "testing trace context propagation... " << flush;
+    TraceParent invocation;
+    TraceParent explicitParent;
+    TraceParent nested;
+    {
+        invocation = getTraceParent(prx->getContext());
+        test(invocation.flags == "01");
+
+        //
+        // Each invocation made outside a dispatch starts a new trace.
+        //
+        TraceParent other = getTraceParent(prx->getContext());
+        test(other.traceId != invocation.traceId);
+        test(other.spanId != invocation.spanId);
+
+        //
+        // The trace context of an explicit request context is the parent
+        // of the invocation.
+        //
+        Ice::Context ctx;
+        ctx["traceparent"] = "00-0123456789abcdef0123456789abcdef-0123456789abcdef-01";
+        explicitParent = getTraceParent(prx->getContext(ctx));
+        test(explicitParent.traceId == "0123456789abcdef0123456789abcdef");
+        test(explicitParent.spanId != "0123456789abcdef");
+
+        //
+        // The invocation made by the servant belongs to the trace of the
+        // dispatch.
+        //
+        nested = getTraceParent(prx->forward(callback));
+        test(nested.flags == "01");
+        test(nested.traceId != invocation.traceId);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing sampling... " << flush;
+    TraceParent unsampled;
+    {
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("IceMX.Tracing.File", "unsampled.spans");
+        initData.properties->setProperty("IceMX.Tracing.Sampling", "0");
+        Ice::CommunicatorHolder ich(initData);
+
+        //
+        // The sampling decision is propagated with the trace context, the
+        // server doesn't record the spans of unsampled traces.
+        //
+        TestIntfPrxPtr unsampledPrx = ICE_UNCHECKED_CAST(TestIntfPrx, ich->stringToProxy(prx->ice_toString()));
+        unsampled = getTraceParent(unsampledPrx->getContext());
+        test(unsampled.flags == "00");
+    }
+    test(readSpans("unsampled.spans").empty());
+    cout << "ok" << endl;
+
+    cout << "testing span files... " << flush;
+    {
+        //
+        // The remaining spans are written when the communicator is destroyed.
+        //
+        client->destroy();
+        server->destroy();
+
+        vector<Span> clientSpans = readSpans("client.spans");
+        vector<Span> serverSpans = readSpans("server.spans");
+
+        Span span = findSpan(clientSpans, "CLIENT", "getContext", invocation.traceId);
+        test(span.spanId == invocation.spanId && span.parentSpanId.empty());
+        span = findSpan(serverSpans, "SERVER", "getContext", invocation.traceId);
+        test(span.parentSpanId == invocation.spanId);
+
+        span = findSpan(clientSpans, "CLIENT", "getContext", explicitParent.traceId);
+        test(span.spanId == explicitParent.spanId && span.parentSpanId == "0123456789abcdef");
+        span = findSpan(serverSpans, "SERVER", "getContext", explicitParent.traceId);
+        test(span.parentSpanId == explicitParent.spanId);
+
+        Span forwardInvocation = findSpan(clientSpans, "CLIENT", "forward", nested.traceId);
+        test(forwardInvocation.parentSpanId.empty());
+        Span forwardDispatch = findSpan(serverSpans, "SERVER", "forward", nested.traceId);
+        test(forwardDispatch.parentSpanId == forwardInvocation.spanId);
+        span = findSpan(serverSpans, "CLIENT", "getContext", nested.traceId);
+        test(span.spanId == nested.spanId && span.parentSpanId == forwardDispatch.spanId);
+        span = findSpan(clientSpans, "SERVER", "getContext", nested.traceId);
+        test(span.parentSpanId == nested.spanId);
+
+        test(countSpans(serverSpans, unsampled.traceId) == 0);
+    }
+    cout << "ok" << endl;
+
+    remove("client.spans");
+    remove("server.spans");
+    remove("unsampled.spans");
+}
@@ -0,0 +1,7 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+$(test)_client_sources  = Test.ice Client.cpp AllTests.cpp TestI.cpp
+
+tests += $(test)
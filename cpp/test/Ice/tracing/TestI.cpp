@@ -0,0 +1,28 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+Ice::Context
+TestI::getContext(const Ice::Current& current)
+{
+    return current.ctx;
+}
+
+Ice::Context
+#ifdef ICE_CPP11_MAPPING
+TestI::forward(shared_ptr<Test::TestIntfPrx> prx, const Ice::Current&)
+#else
+TestI::forward(const Test::TestIntfPrx& prx, const Ice::Current&)
+#endif
+{
+    //
+    // The invocation is made from the dispatch thread, its span is a
+    // child of the dispatch span.
+    //
+    return prx->getContext();
+}
@@ -0,0 +1,22 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+
+class TestI : public Test::TestIntf
+{
+public:
+
+    virtual Ice::Context getContext(const Ice::Current&);
+#ifdef ICE_CPP11_MAPPING
+    virtual Ice::Context forward(std::shared_ptr<Test::TestIntfPrx>, const Ice::Current&);
+#else
+    virtual Ice::Context forward(const Test::TestIntfPrx&, const Ice::Current&);
+#endif
+};
+
+#endif
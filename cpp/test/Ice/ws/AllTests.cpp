@@ -0,0 +1,142 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <IceUtil/Random.h>
+#include <TestHelper.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+Ice::ByteSeq
+compressibleSeq(size_t size)
+{
+    Ice::ByteSeq seq(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        seq[i] = static_cast<Ice::Byte>(i % 7);
+    }
+    return seq;
+}
+
+Ice::ByteSeq
+randomSeq(size_t size)
+{
+    Ice::ByteSeq seq(size);
+    if(size > 0)
+    {
+        IceUtilInternal::generateRandom(reinterpret_cast<char*>(&seq[0]), size);
+    }
+    return seq;
+}
+
+}
+
+void
+allTests(Test::TestHelper* helper)
+{
+    Ice::CommunicatorPtr communicator = helper->communicator();
+#ifdef ICE_HAS_ZLIB
+    bool deflate = communicator->getProperties()->getPropertyAsInt("Ice.WS.PerMessageDeflate") > 0;
+#else
+    bool deflate = false;
+#endif
+
+    TestIntfPrxPtr proxy =
+        ICE_CHECKED_CAST(TestIntfPrx, communicator->stringToProxy("test:" + helper->getTestEndpoint(0, "ws")));
+
+    cout << "testing permessage-deflate negotiation... " << flush;
+    {
+        bool serverDeflate = proxy->isDeflateEnabled();
+
+        //
+        // The client only offers the extension if it's enabled.
+        //
+        Ice::Context headers = proxy->getHeaders();
+        Ice::Context::const_iterator p = headers.find("Sec-WebSocket-Extensions");
+        test((p != headers.end()) == deflate);
+        test(p == headers.end() || p->second.find("permessage-deflate") == 0);
+
+        //
+        // The server only accepts the offer if it's enabled.
+        //
+        Ice::WSConnectionInfoPtr info = ICE_DYNAMIC_CAST(Ice::WSConnectionInfo, proxy->ice_getConnection()->getInfo());
+        test(info);
+        p = info->headers.find("Sec-WebSocket-Extensions");
+        test((p != info->headers.end()) == (deflate && serverDeflate));
+        if(p != info->headers.end())
+        {
+            test(p->second.find("permessage-deflate") == 0);
+            test(p->second.find("server_no_context_takeover") != string::npos);
+            test(p->second.find("client_no_context_takeover") != string::npos);
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing framing... " << flush;
+    {
+        //
+        // Messages smaller than the compression threshold, around the
+        // WebSocket payload length encoding limits, and large messages
+        // which are inflated over several reads.
+        //
+        const size_t sizes[] = { 0, 1, 50, 99, 100, 125, 126, 1024, 65535, 65536, 256 * 1024, 512 * 1024 };
+        for(size_t i = 0; i < sizeof(sizes) / sizeof(size_t); ++i)
+        {
+            Ice::ByteSeq seq = compressibleSeq(sizes[i]);
+            test(proxy->echo(seq) == seq);
+
+            seq = randomSeq(sizes[i]);
+            test(proxy->echo(seq) == seq);
+        }
+
+        //
+        // Each message is compressed independently, interleave compressed
+        // and uncompressed messages over the same connection.
+        //
+        for(int i = 0; i < 50; ++i)
+        {
+            Ice::ByteSeq seq = i % 2 ? compressibleSeq(IceUtilInternal::random(100000)) :
+                randomSeq(IceUtilInternal::random(10000));
+            test(proxy->echo(seq) == seq);
+        }
+
+        //
+        // Queue several requests to make sure the frames of the messages
+        // sent back to back are correctly delimited.
+        //
+#ifdef ICE_CPP11_MAPPING
+        vector<future<Ice::ByteSeq> > results;
+        vector<Ice::ByteSeq> seqs;
+        for(int i = 0; i < 20; ++i)
+        {
+            seqs.push_back(compressibleSeq(1000 + static_cast<size_t>(i) * 5000));
+            results.push_back(proxy->echoAsync(seqs.back()));
+        }
+        for(size_t i = 0; i < results.size(); ++i)
+        {
+            test(results[i].get() == seqs[i]);
+        }
+#else
+        vector<Ice::AsyncResultPtr> results;
+        vector<Ice::ByteSeq> seqs;
+        for(int i = 0; i < 20; ++i)
+        {
+            seqs.push_back(compressibleSeq(1000 + static_cast<size_t>(i) * 5000));
+            results.push_back(proxy->begin_echo(seqs.back()));
+        }
+        for(size_t i = 0; i < results.size(); ++i)
+        {
+            test(proxy->end_echo(results[i]) == seqs[i]);
+        }
+#endif
+    }
+    cout << "ok" << endl;
+
+    proxy->shutdown();
+}
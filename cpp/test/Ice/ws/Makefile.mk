@@ -0,0 +1,11 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+ifeq ($(os),Linux)
+ifeq ($(shell pkg-config --exists zlib 2> /dev/null && echo yes),yes)
+$(test)_cppflags        += -DICE_HAS_ZLIB
+endif
+endif
+
+tests += $(test)
@@ -0,0 +1,42 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+Ice::ByteSeq
+#ifdef ICE_CPP11_MAPPING
+TestI::echo(Ice::ByteSeq seq, const Ice::Current&)
+#else
+TestI::echo(const Ice::ByteSeq& seq, const Ice::Current&)
+#endif
+{
+    return seq;
+}
+
+bool
+TestI::isDeflateEnabled(ICE_MAYBE_UNUSED const Ice::Current& current)
+{
+#ifdef ICE_HAS_ZLIB
+    Ice::PropertiesPtr properties = current.adapter->getCommunicator()->getProperties();
+    return properties->getPropertyAsInt("Ice.WS.PerMessageDeflate") > 0;
+#else
+    return false;
+#endif
+}
+
+Ice::Context
+TestI::getHeaders(const Ice::Current& current)
+{
+    Ice::WSConnectionInfoPtr info = ICE_DYNAMIC_CAST(Ice::WSConnectionInfo, current.con->getInfo());
+    return info ? info->headers : Ice::Context();
+}
+
+void
+TestI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
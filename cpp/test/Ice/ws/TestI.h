@@ -0,0 +1,24 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+
+class TestI : public Test::TestIntf
+{
+public:
+
+#ifdef ICE_CPP11_MAPPING
+    virtual Ice::ByteSeq echo(Ice::ByteSeq, const Ice::Current&);
+#else
+    virtual Ice::ByteSeq echo(const Ice::ByteSeq&, const Ice::Current&);
+#endif
+    virtual bool isDeflateEnabled(const Ice::Current&);
+    virtual Ice::Context getHeaders(const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+};
+
+#endif
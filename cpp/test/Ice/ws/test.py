@@ -0,0 +1,13 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+deflate = { "Ice.WS.PerMessageDeflate" : 1 }
+
+TestSuite(__name__, [
+    ClientServerTestCase(),
+    ClientServerTestCase(name="client/server with permessage-deflate",
+                         client=Client(props=deflate), server=Server(props=deflate)),
+    ClientServerTestCase(name="permessage-deflate client/server", client=Client(props=deflate)),
+    ClientServerTestCase(name="client/permessage-deflate server", server=Server(props=deflate)),
+], options={ "protocol" : ["ws"] })
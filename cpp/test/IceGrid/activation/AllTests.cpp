@@ -689,6 +689,54 @@ allTests(Test::TestHelper* helper)
     }
     cout << "ok" << endl;
 
+    cout << "testing on-demand server pre-start... " << flush;
+    try
+    {
+        //
+        // node-3 pre-starts one on-demand server, server3 is activated
+        // before its first request.
+        //
+        admin->startServer("node-3");
+        waitForServerState(admin, "server3", IceGrid::Active);
+        test(admin->getServerState("server3") == IceGrid::Active);
+        TestIntfPrx::checkedCast(communicator->stringToProxy("server3"))->ice_ping();
+
+        //
+        // Disabling server3 releases its slot, the next on-demand server
+        // deployed on node-3 is pre-started.
+        //
+        admin->enableServer("server3", false);
+        admin->stopServer("server3");
+        test(admin->getServerState("server3") == IceGrid::Inactive);
+
+        IceGrid::ServerInstanceDescriptor server;
+        server._cpp_template = "Server";
+        server.parameterValues["id"] = "server3-prestart";
+        IceGrid::NodeUpdateDescriptor nodeUpdate;
+        nodeUpdate.name = "node-3";
+        nodeUpdate.serverInstances.push_back(server);
+        IceGrid::ApplicationUpdateDescriptor update;
+        update.name = "Test";
+        update.nodes.push_back(nodeUpdate);
+        admin->updateApplication(update);
+        waitForServerState(admin, "server3-prestart", IceGrid::Active);
+        test(admin->getServerState("server3-prestart") == IceGrid::Active);
+        test(admin->getServerState("server3") == IceGrid::Inactive);
+
+        admin->stopServer("node-3");
+    }
+    catch(const IceGrid::DeploymentException& ex)
+    {
+        cerr << ex.reason << endl;
+        test(false);
+    }
+    catch(const Ice::LocalException& ex)
+    {
+        cerr << ex << endl;
+        test(false);
+    }
+    cout << "ok" << endl;
+
     cout << "testing large number of servers... " << flush;
     {
         IceGrid::ApplicationInfo info = admin->getApplicationInfo("Test");
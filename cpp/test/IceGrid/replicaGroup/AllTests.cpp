@@ -485,6 +485,111 @@ allTests(Test::TestHelper* helper)
     }
     cout << "ok" << endl;
 
+    cout << "testing replication with latency load balancing... " << flush;
+    {
+        map<string, string> params;
+        params["replicaGroup"] = "Latency";
+        params["id"] = "Server1";
+        instantiateServer(admin, "Server", "localnode", params);
+        params["id"] = "Server2";
+        params["delay"] = "200";
+        instantiateServer(admin, "Server", "localnode", params);
+
+        //
+        // Dispatch requests on both servers, the node reports the dispatch
+        // latency of its servers with each keep alive (every 2s).
+        //
+        for(int i = 0; i < 3; ++i)
+        {
+            TestIntfPrx::uncheckedCast(comm->stringToProxy("Server1"))->getReplicaId();
+            TestIntfPrx::uncheckedCast(comm->stringToProxy("Server2"))->getReplicaId();
+        }
+        IceUtil::ThreadControl::sleep(IceUtil::Time::seconds(5));
+
+        //
+        // With two replicas, the registry always picks the replica with the
+        // lowest latency.
+        //
+        TestIntfPrx obj = TestIntfPrx::uncheckedCast(comm->stringToProxy("Latency"));
+        obj = TestIntfPrx::uncheckedCast(obj->ice_locatorCacheTimeout(0));
+        obj = TestIntfPrx::uncheckedCast(obj->ice_connectionCached(false));
+        for(int i = 0; i < 10; ++i)
+        {
+            test(obj->getReplicaId() == "Server1.ReplicatedAdapter");
+        }
+        removeServer(admin, "Server1");
+        removeServer(admin, "Server2");
+    }
+    cout << "ok" << endl;
+
+    cout << "testing locator cache subscription... " << flush;
+    {
+        Ice::InitializationData initData;
+        initData.properties = comm->getProperties()->clone();
+        initData.properties->setProperty("Ice.LocatorCacheSubscription", "1");
+        Ice::CommunicatorPtr subscriber = Ice::initialize(initData);
+
+        map<string, string> params;
+        params["replicaGroup"] = "Ordered";
+        params["id"] = "Server1";
+        params["priority"] = "2";
+        instantiateServer(admin, "Server", "localnode", params);
+
+        //
+        // The first locator request subscribes the locator cache.
+        //
+        TestIntfPrx obj = TestIntfPrx::uncheckedCast(subscriber->stringToProxy("Ordered")->ice_locatorCacheTimeout(0));
+        test(obj->getReplicaId() == "Server1.ReplicatedAdapter");
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(500));
+
+        obj = TestIntfPrx::uncheckedCast(obj->ice_locatorCacheTimeout(-1));
+        obj = TestIntfPrx::uncheckedCast(obj->ice_connectionCached(false));
+        test(obj->getReplicaId() == "Server1.ReplicatedAdapter");
+
+        //
+        // Adding a replica with a higher priority to the replica group
+        // removes the replica group from the locator cache.
+        //
+        params["id"] = "Server2";
+        params["priority"] = "1";
+        instantiateServer(admin, "Server", "localnode", params);
+        int nRetry = 0;
+        while(obj->getReplicaId() != "Server2.ReplicatedAdapter" && ++nRetry < 100)
+        {
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+        }
+        test(nRetry < 100);
+
+        //
+        // The subscription uses its own connection, the adapter and ACM
+        // settings of the locator connection are unchanged.
+        //
+        Ice::ConnectionPtr locatorConnection = subscriber->getDefaultLocator()->ice_getConnection();
+        test(!locatorConnection->getAdapter());
+        test(locatorConnection->getACM().close != Ice::CloseOff);
+
+        //
+        // Updating a well-known object removes it from the locator cache.
+        //
+        admin->addObjectWithType(comm->stringToProxy("wellKnown@Server1.ReplicatedAdapter"), "::Test::TestIntf");
+        obj = TestIntfPrx::uncheckedCast(subscriber->stringToProxy("wellKnown")->ice_locatorCacheTimeout(-1));
+        obj = TestIntfPrx::uncheckedCast(obj->ice_connectionCached(false));
+        test(obj->getReplicaId() == "Server1.ReplicatedAdapter");
+        admin->updateObject(comm->stringToProxy("wellKnown@Server2.ReplicatedAdapter"));
+        nRetry = 0;
+        while(obj->getReplicaId() != "Server2.ReplicatedAdapter" && ++nRetry < 100)
+        {
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+        }
+        test(nRetry < 100);
+        admin->removeObject(Ice::stringToIdentity("wellKnown"));
+
+        subscriber->destroy();
+        removeServer(admin, "Server1");
+        removeServer(admin, "Server2");
+    }
+    cout << "ok" << endl;
+
     cout << "testing filters... " << flush;
     {
         map<string, string> params;
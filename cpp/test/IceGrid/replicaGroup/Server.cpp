@@ -24,6 +24,7 @@ Server::run(int argc, char** argv)
     Ice::ObjectPtr object = new TestI(properties);
     adpt->add(object, Ice::stringToIdentity(properties->getProperty("Ice.ProgramName")));
     adpt->add(object, Ice::stringToIdentity(properties->getProperty("Identity")));
+    adpt->add(object, Ice::stringToIdentity("wellKnown"));
     try
     {
         adpt->activate();
@@ -5,7 +5,8 @@
 
 registryProps = {
     "Ice.Plugin.RegistryPlugin" : "RegistryPlugin:createRegistryPlugin",
-    "IceGrid.Registry.DynamicRegistration" : 1
+    "IceGrid.Registry.DynamicRegistration" : 1,
+    "IceGrid.Registry.NodeSessionTimeout" : 4
 }
 registryTraceProps = {
     "IceGrid.Registry.Trace.Locator": 2,
@@ -15,6 +16,10 @@ registryTraceProps = {
     "Ice.Trace.Protocol": 1,
 }
 
+nodeProps = {
+    "IceGrid.Node.ReportServerLoad" : 1
+}
+
 clientProps = {
     "Ice.RetryIntervals" : "0 50 100 250"
 }
@@ -26,6 +31,7 @@ clientTraceProps = {
 if isinstance(platform, Windows) or os.getuid() != 0:
     TestSuite(__file__,
               [IceGridTestCase(icegridregistry=[IceGridRegistryMaster(props=registryProps, traceProps=registryTraceProps)],
+                               icegridnode=IceGridNode(props=nodeProps),
                                client=IceGridClient(props=clientProps, traceProps=clientTraceProps))],
               libDirs=["registryplugin", "testservice"],
               multihost=False)
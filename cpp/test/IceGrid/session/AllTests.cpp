@@ -288,7 +288,7 @@ class NodeObserverI : public NodeObserver, public ObserverBase
 {
 public:
 
-    NodeObserverI(const string& name) : ObserverBase(name)
+    NodeObserverI(const string& name) : ObserverBase(name), pageSize(0)
     {
     }
 
@@ -296,10 +296,13 @@ public:
     nodeInit(const NodeDynamicInfoSeq& info, const Ice::Current&)
     {
         Lock sync(*this);
+        size_t size = 0;
         for(NodeDynamicInfoSeq::const_iterator p = info.begin(); p != info.end(); ++p)
         {
             this->nodes[p->info.name] = filter(*p);
+            size += p->servers.size() + p->adapters.size();
         }
+        this->pageSize = max(this->pageSize, size);
         updated("init");
     }
 
@@ -308,6 +311,7 @@ public:
     {
         Lock sync(*this);
         this->nodes[info.info.name] = filter(info);
+        this->pageSize = max(this->pageSize, info.servers.size() + info.adapters.size());
         updated("node `" + info.info.name + "' up");
     }
 
@@ -351,6 +355,8 @@ public:
             servers.push_back(info);
         }
 
+        this->serverUpdates.push_back(info.id);
+
         ostringstream os;
         os << "server `" << info.id << "' on node `" << node << "' state updated: " << info.state
            << " (pid = " << info.pid << ")";
@@ -428,6 +434,8 @@ public:
     }
 
     map<string, NodeDynamicInfo> nodes;
+    size_t pageSize;
+    vector<string> serverUpdates;
 };
 typedef IceUtil::Handle<NodeObserverI> NodeObserverIPtr;
 
@@ -480,6 +488,120 @@ testFailedAndPrintObservers(const char* expr, const char* file, unsigned int lin
 #undef test
 #define test(ex) ((ex) ? ((void)0) : testFailedAndPrintObservers(#ex, __FILE__, __LINE__))
 
+void
+testObserverWindow(const Ice::CommunicatorPtr& communicator,
+                   const IceGrid::RegistryPrx& registry,
+                   const AdminSessionPrx& session,
+                   const AdminPrx& admin)
+{
+    cout << "testing node observer window and page size... " << flush;
+
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    ApplicationDescriptor testApp;
+    testApp.name = "TestApp";
+    NodeDescriptor node;
+    for(int i = 1; i <= 3; ++i)
+    {
+        ostringstream id;
+        id << "Server" << i;
+        ServerDescriptorPtr server = new ServerDescriptor();
+        server->id = id.str();
+        server->exe = properties->getProperty("ServerDir") + "/server";
+        server->pwd = properties->getProperty("TestDir");
+        server->applicationDistrib = false;
+        server->allocatable = false;
+        AdapterDescriptor adapter;
+        adapter.name = "Server";
+        adapter.id = id.str() + "Adapter";
+        adapter.registerProcess = false;
+        adapter.serverLifetime = true;
+        server->adapters.push_back(adapter);
+        addProperty(server, "Server.Endpoints", "default");
+        addProperty(server, "Ice.Admin.Endpoints", "tcp -h 127.0.0.1");
+        node.servers.push_back(server);
+    }
+    testApp.nodes["localnode"] = node;
+
+    session->startUpdate();
+    admin->addApplication(testApp);
+    session->finishUpdate();
+    admin->startServer("Server1");
+    admin->startServer("Server2");
+    admin->startServer("Server3");
+
+    //
+    // Wait for the updates of the servers to be published.
+    //
+    IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1500));
+
+    AdminSessionPrx session1 = registry->createAdminSession("admin1", "test1");
+    session1->ice_getConnection()->setACM(registry->getACMTimeout(), IceUtil::None, Ice::HeartbeatOnIdle);
+
+    Ice::ObjectAdapterPtr adpt1 = communicator->createObjectAdapter("");
+    NodeObserverIPtr nodeObs1 = new NodeObserverI("nodeObs1");
+    Ice::ObjectPrx no1 = adpt1->addWithUUID(nodeObs1);
+    adpt1->activate();
+    registry->ice_getConnection()->setAdapter(adpt1);
+    session1->setObserversByIdentity(Ice::Identity(),
+                                     no1->ice_getIdentity(),
+                                     Ice::Identity(),
+                                     Ice::Identity(),
+                                     Ice::Identity());
+
+    //
+    // The registry page size is 1, the servers and adapters which don't
+    // fit in the nodeInit page are sent with updateServer and updateAdapter.
+    //
+    nodeObs1->waitForUpdate(__FILE__, __LINE__); // init
+    while(true)
+    {
+        {
+            IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*nodeObs1);
+            if(nodeObs1->nodes["localnode"].servers.size() == 3 && nodeObs1->nodes["localnode"].adapters.size() == 3)
+            {
+                test(nodeObs1->pageSize == 1);
+                nodeObs1->serverUpdates.clear();
+                break;
+            }
+        }
+        nodeObs1->waitForUpdate(__FILE__, __LINE__); // serverUpdate or adapterUpdate
+    }
+
+    //
+    // The updates received within the observer window are coalesced, the
+    // observer only gets the last update of each server in the order of
+    // their first update.
+    //
+    admin->enableServer("Server2", false);
+    admin->enableServer("Server1", false);
+    admin->enableServer("Server2", true);
+    nodeObs1->waitForUpdate(__FILE__, __LINE__); // serverUpdate
+    nodeObs1->waitForUpdate(__FILE__, __LINE__); // serverUpdate
+    IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1500));
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*nodeObs1);
+        test(nodeObs1->serverUpdates.size() == 2);
+        test(nodeObs1->serverUpdates[0] == "Server2" && nodeObs1->serverUpdates[1] == "Server1");
+        const ServerDynamicInfoSeq& servers = nodeObs1->nodes["localnode"].servers;
+        for(ServerDynamicInfoSeq::const_iterator p = servers.begin(); p != servers.end(); ++p)
+        {
+            test(p->enabled == (p->id != "Server1"));
+        }
+    }
+
+    session1->destroy();
+    adpt1->destroy();
+
+    admin->stopServer("Server1");
+    admin->stopServer("Server2");
+    admin->stopServer("Server3");
+    session->startUpdate();
+    admin->removeApplication("TestApp");
+    session->finishUpdate();
+
+    cout << "ok" << endl;
+}
+
 #if defined(_AIX) && defined(__GNUC__) && !defined(__ibmxl__)
 // Strange optimization bug with catching ExtendedPermissionDeniedException with GCC 8.1 on AIX
 __attribute__((optimize("O0")))
@@ -501,6 +623,13 @@ allTests(Test::TestHelper* helper)
     AdminPrx admin = session->getAdmin();
     test(admin);
 
+    if(communicator->getProperties()->getPropertyAsInt("TestObserverWindow") > 0)
+    {
+        testObserverWindow(communicator, registry, session, admin);
+        session->destroy();
+        return;
+    }
+
     cout << "starting router... " << flush;
     try
     {
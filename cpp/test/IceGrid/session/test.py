@@ -45,12 +45,27 @@ clientProps10 = lambda process, current: {
     "Ice.Default.EncodingVersion" : "1.0"
 }
 
+clientPropsWindow = lambda process, current: {
+    "ServerDir" : current.getBuildDir("server"),
+    "TestDir" : "{testdir}",
+    "TestObserverWindow" : 1
+}
+
 icegridregistry = [IceGridRegistryMaster(props=registryProps)]
 
+registryPropsWindow = dict(registryProps)
+registryPropsWindow.update({
+    'IceGrid.Registry.AdminSessionObserverWindow' : 1000,
+    'IceGrid.Registry.AdminSessionObserverPageSize' : 1,
+})
+icegridregistryWindow = [IceGridRegistryMaster(props=registryPropsWindow)]
+
 if isinstance(platform, Windows) or os.getuid() != 0:
     TestSuite(__file__,
           [ IceGridSessionTestCase("with default encoding", icegridregistry=icegridregistry,
                                    client=IceGridClient(props=clientProps)),
             IceGridSessionTestCase("with 1.0 encoding", icegridregistry=icegridregistry,
-                                   client=IceGridClient(props=clientProps10))],
+                                   client=IceGridClient(props=clientProps10)),
+            IceGridSessionTestCase("with observer window", icegridregistry=icegridregistryWindow,
+                                   client=IceGridClient(props=clientPropsWindow))],
             runOnMainThread=True, multihost=False)
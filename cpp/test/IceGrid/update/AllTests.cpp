@@ -1089,6 +1089,124 @@ allTests(Test::TestHelper* helper)
         cout << "ok" << endl;
     }
 
+    {
+        cout << "testing server reuse and re-instantiation... " << flush;
+
+        ServerDescriptorPtr server = new ServerDescriptor();
+        server->id = "${name}";
+        server->exe = "${test.dir}/server";
+        server->pwd = ".";
+        server->applicationDistrib = false;
+        server->allocatable = false;
+        addProperty(server, "Ice.Admin.Endpoints", "tcp -h 127.0.0.1");
+        addProperty(server, "Value", "${value}");
+        AdapterDescriptor adapter;
+        adapter.name = "Server";
+        adapter.id = "${server}";
+        adapter.registerProcess = false;
+        adapter.serverLifetime = false;
+        addProperty(server, "Server.Endpoints", "default");
+        server->adapters.push_back(adapter);
+
+        TemplateDescriptor templ;
+        templ.parameters.push_back("name");
+        templ.parameters.push_back("value");
+        templ.descriptor = server;
+
+        ApplicationDescriptor testApp;
+        testApp.name = "TestApp";
+        testApp.variables["test.dir"] = properties->getProperty("ServerDir");
+        testApp.variables["valueA"] = "a";
+        testApp.variables["valueB"] = "b";
+        testApp.serverTemplates["ServerTemplate"] = templ;
+        testApp.propertySets["SetA"].properties.push_back(createProperty("SetProp", "a"));
+        testApp.propertySets["SetB"].properties.push_back(createProperty("SetProp", "b"));
+
+        ServerInstanceDescriptor instanceA;
+        instanceA._cpp_template = "ServerTemplate";
+        instanceA.parameterValues["name"] = "ServerA";
+        instanceA.parameterValues["value"] = "${valueA}";
+        instanceA.propertySet.references.push_back("SetA");
+        testApp.nodes["localnode"].serverInstances.push_back(instanceA);
+
+        ServerInstanceDescriptor instanceB;
+        instanceB._cpp_template = "ServerTemplate";
+        instanceB.parameterValues["name"] = "ServerB";
+        instanceB.parameterValues["value"] = "${valueB}";
+        instanceB.propertySet.references.push_back("SetB");
+        testApp.nodes["localnode"].serverInstances.push_back(instanceB);
+
+        try
+        {
+            admin->addApplication(testApp);
+            admin->startServer("ServerA");
+            admin->startServer("ServerB");
+        }
+        catch(const DeploymentException& ex)
+        {
+            cerr << ex.reason << endl;
+            test(false);
+        }
+        catch(const Ice::Exception& ex)
+        {
+            cerr << ex << endl;
+            test(false);
+        }
+
+        int pidA = admin->getServerPid("ServerA");
+        int pidB = admin->getServerPid("ServerB");
+
+        ApplicationUpdateDescriptor empty;
+        empty.name = "TestApp";
+        ApplicationUpdateDescriptor update;
+
+        //
+        // An update which doesn't change the instantiated servers must reuse them.
+        //
+        update = empty;
+        update.description = new BoxedString("updated");
+        update.propertySets["Unused"].properties.push_back(createProperty("SetProp", "unused"));
+        admin->updateApplication(update);
+        test(admin->getServerState("ServerA") == Active && admin->getServerPid("ServerA") == pidA);
+        test(admin->getServerState("ServerB") == Active && admin->getServerPid("ServerB") == pidB);
+
+        //
+        // A variable change must only re-instantiate the servers using it.
+        //
+        update = empty;
+        update.variables["valueA"] = "a1";
+        admin->updateApplication(update);
+        test(hasProperty(admin->getServerInfo("ServerA").descriptor, "Value", "a1"));
+        test(hasProperty(admin->getServerInfo("ServerB").descriptor, "Value", "b"));
+        test(admin->getServerState("ServerB") == Active && admin->getServerPid("ServerB") == pidB);
+
+        //
+        // Same for a property set change.
+        //
+        update = empty;
+        update.propertySets["SetA"].properties.push_back(createProperty("SetProp", "a1"));
+        admin->updateApplication(update);
+        test(hasProperty(admin->getServerInfo("ServerA").descriptor, "SetProp", "a1"));
+        test(hasProperty(admin->getServerInfo("ServerB").descriptor, "SetProp", "b"));
+        test(admin->getServerState("ServerB") == Active && admin->getServerPid("ServerB") == pidB);
+
+        //
+        // A template change must re-instantiate all its instances.
+        //
+        update = empty;
+        addProperty(server, "TemplateProp", "updated");
+        update.serverTemplates["ServerTemplate"] = templ;
+        admin->updateApplication(update);
+        test(hasProperty(admin->getServerInfo("ServerA").descriptor, "TemplateProp", "updated"));
+        test(hasProperty(admin->getServerInfo("ServerB").descriptor, "TemplateProp", "updated"));
+        test(hasProperty(admin->getServerInfo("ServerA").descriptor, "Value", "a1"));
+        test(hasProperty(admin->getServerInfo("ServerB").descriptor, "Value", "b"));
+
+        admin->removeApplication("TestApp");
+
+        cout << "ok" << endl;
+    }
+
     {
         cout << "testing server node move... " << flush;
 
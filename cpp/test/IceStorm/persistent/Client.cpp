@@ -11,6 +11,40 @@ using namespace Ice;
 using namespace IceStorm;
 using namespace Test;
 
+class ReplayI : public Ice::Blobject, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    virtual bool
+    ice_invoke(ICE_IN(vector<Byte>), vector<Byte>&, const Current& current)
+    {
+        Lock sync(*this);
+        Context::const_iterator p = current.ctx.find("IceStorm.Sequence");
+        _events.push_back(make_pair(current.operation, p != current.ctx.end() ? p->second : string()));
+        notifyAll();
+        return true;
+    }
+
+    vector<pair<string, string> >
+    waitForEvents(size_t count)
+    {
+        Lock sync(*this);
+        IceUtil::Time timeout = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::seconds(30);
+        while(_events.size() < count)
+        {
+            IceUtil::Time remaining = timeout - IceUtil::Time::now(IceUtil::Time::Monotonic);
+            test(remaining > IceUtil::Time());
+            timedWait(remaining);
+        }
+        return _events;
+    }
+
+private:
+
+    vector<pair<string, string> > _events;
+};
+ICE_DEFINE_PTR(ReplayIPtr, ReplayI);
+
 class Client : public Test::TestHelper
 {
 public:
@@ -48,6 +82,23 @@ Client::run(int argc, char** argv)
     string action(argv[1]);
     if(action == "create")
     {
+        //
+        // Publish events on topic0, which retains its 3 most recent
+        // events.
+        //
+        cerr << "publishing events... " << flush;
+        {
+            ObjectPrx publisher = manager->create("topic0")->getPublisher();
+            for(int i = 0; i < 5; ++i)
+            {
+                ostringstream op;
+                op << "event" << i;
+                vector<Byte> outParams;
+                publisher->ice_invoke(op.str(), ICE_ENUM(OperationMode, Normal), vector<Byte>(), outParams);
+            }
+        }
+        cerr << "ok" << endl;
+
         //
         // Create topics
         //
@@ -57,7 +108,7 @@ Client::run(int argc, char** argv)
         {
             ostringstream topicName;
             topicName << "topic" << i;
-            TopicPrx topic = manager->create(topicName.str());
+            TopicPrx topic = i == 0 ? manager->retrieve(topicName.str()) : manager->create(topicName.str());
             if(linkTo)
             {
                 topic->link(linkTo, i + 1);
@@ -86,6 +137,35 @@ Client::run(int argc, char** argv)
     else
     {
         test(action == "check");
+
+        //
+        // Replay the events retained by topic0 before the restart.
+        //
+        cerr << "testing event replay... " << flush;
+        ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("ReplayAdapter", "default");
+        ReplayIPtr replay = ICE_MAKE_SHARED(ReplayI);
+        ObjectPrx subscriber = adapter->add(replay, stringToIdentity("replay"));
+        adapter->activate();
+
+        TopicPrx topic = manager->retrieve("topic0");
+        IceStorm::QoS qos;
+        qos["replayFrom"] = "0";
+        topic->subscribeAndGetPublisher(qos, subscriber);
+
+        vector<pair<string, string> > events = replay->waitForEvents(3);
+        test(events.size() == 3);
+        for(size_t i = 0; i < events.size(); ++i)
+        {
+            ostringstream op;
+            op << "event" << i + 2;
+            ostringstream sequence;
+            sequence << i + 3;
+            test(events[i].first == op.str());
+            test(events[i].second == sequence.str());
+        }
+
+        topic->unsubscribe(subscriber);
+        cerr << "ok" << endl;
     }
 }
 
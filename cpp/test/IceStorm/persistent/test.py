@@ -3,8 +3,12 @@
 # Copyright (c) ZeroC, Inc. All rights reserved.
 #
 
-icestorm1 = IceStorm(createDb=True, cleanDb=False)
-icestorm2 = IceStorm(createDb=False, cleanDb=True)
+#
+# topic0 retains its 3 most recent events across the restart.
+#
+props = { "IceStorm.Topic.topic0.Retention.MaxEvents" : 3 }
+icestorm1 = IceStorm(createDb=True, cleanDb=False, props=props)
+icestorm2 = IceStorm(createDb=False, cleanDb=True, props=props)
 
 
 def test(value):
@@ -27,6 +27,7 @@ Publisher::run(int argc, char** argv)
     Ice::CommunicatorHolder communicator = initialize(argc, argv);
     IceUtilInternal::Options opts;
     opts.addOpt("", "cycle");
+    opts.addOpt("", "partitioned");
 
     try
     {
@@ -80,6 +81,27 @@ Publisher::run(int argc, char** argv)
     }
     assert(topic);
 
+    if(opts.isSet("partitioned"))
+    {
+        //
+        // All the replicas must return the same publisher endpoints for
+        // the topic, with the endpoints of the replica which leads the
+        // topic first.
+        //
+        Ice::EndpointSeq endpoints = topic->getPublisher()->ice_getEndpoints();
+        Ice::EndpointSeq managerEndpoints = manager->ice_getEndpoints();
+        for(Ice::EndpointSeq::const_iterator p = managerEndpoints.begin(); p != managerEndpoints.end(); ++p)
+        {
+            IceStorm::TopicManagerPrx replica = manager->ice_endpoints(Ice::EndpointSeq(1, *p));
+            Ice::EndpointSeq replicaEndpoints = replica->retrieve("single")->getPublisher()->ice_getEndpoints();
+            test(replicaEndpoints.size() == endpoints.size());
+            for(size_t i = 0; i < endpoints.size(); ++i)
+            {
+                test(replicaEndpoints[i]->toString() == endpoints[i]->toString());
+            }
+        }
+    }
+
     //
     // Get a publisher object, create a twoway proxy and then cast to
     // a Single object.
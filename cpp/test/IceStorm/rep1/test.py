@@ -18,6 +18,14 @@ props = {
 
 icestorm = [ IceStorm(replica=i, nreplicas=3, props = props) for i in range(0,3) ]
 
+#
+# Partition the topics across the replicas, the replicas forward the
+# events of a topic to its leader.
+#
+partitionedProps = dict(props)
+partitionedProps.update({ "IceStorm.Partitioned" : 1 })
+partitioned = [ IceStorm(replica=i, nreplicas=3, props = partitionedProps) for i in range(0,3) ]
+
 class IceStormRep1TestCase(IceStormTestCase):
 
     def runClientSide(self, current):
@@ -282,4 +290,36 @@ class IceStormRep1TestCase(IceStormTestCase):
         self.stopIceStorm(current)
         current.writeln("ok")
 
-TestSuite(__file__, [ IceStormRep1TestCase("replicated", icestorm=icestorm) ], multihost=False)
+class IceStormRep1PartitionedTestCase(IceStormTestCase):
+
+    def runClientSide(self, current):
+
+        def runtest(s="", p=""):
+            ClientServerTestCase(client=Publisher(args=p.split(" ")),
+                                 server=Subscriber(args=s.split(" "))).run(current)
+
+        self.runadmin(current, "create single")
+
+        current.write("running partitioned publishing test... ")
+        sys.stdout.flush()
+        runtest("--twoway", "--partitioned")
+        current.writeln("ok")
+
+        current.write("running partitioned publishing test without replica... ")
+        sys.stdout.flush()
+        for replica in range(0, 3):
+            self.icestorm[replica].shutdown(current)
+            self.icestorm[replica].stop(current, True)
+            runtest("--twoway")
+            self.icestorm[replica].start(current)
+        current.writeln("ok")
+
+        current.write("stopping replicas... ")
+        sys.stdout.flush()
+        self.stopIceStorm(current)
+        current.writeln("ok")
+
+TestSuite(__file__, [
+    IceStormRep1TestCase("replicated", icestorm=icestorm),
+    IceStormRep1PartitionedTestCase("partitioned", icestorm=partitioned),
+], multihost=False)
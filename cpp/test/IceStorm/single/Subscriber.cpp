@@ -93,6 +93,13 @@ public:
         cout << "ok" << endl;
     }
 
+    int
+    count()
+    {
+        Lock sync(*this);
+        return _count;
+    }
+
 private:
 
     const string _name;
@@ -215,6 +222,34 @@ Subscriber::run(int argc, char** argv)
         subscriberIdentities.push_back(object->ice_getIdentity());
         topic->subscribeAndGetPublisher(qos, object);
     }
+    {
+        subscribers.push_back(new SingleI("filtered"));
+        IceStorm::QoS qos;
+        qos["filter"] = "op == 'event' && (!ctx['skip'] || ctx['skip'] != \"true\")";
+        Ice::ObjectPrx object = adapter->addWithUUID(subscribers.back());
+        subscriberIdentities.push_back(object->ice_getIdentity());
+        topic->subscribeAndGetPublisher(qos, object);
+    }
+    SingleIPtr filteredOut = new SingleI("filtered out");
+    {
+        IceStorm::QoS qos;
+        qos["filter"] = "op != 'event'";
+        Ice::ObjectPrx object = adapter->addWithUUID(filteredOut);
+        subscriberIdentities.push_back(object->ice_getIdentity());
+        topic->subscribeAndGetPublisher(qos, object);
+    }
+    {
+        IceStorm::QoS qos;
+        qos["filter"] = "op == 'event' &&";
+        try
+        {
+            topic->subscribeAndGetPublisher(qos, adapter->addWithUUID(new SingleI("invalid filter")));
+            test(false);
+        }
+        catch(const IceStorm::BadQoS&)
+        {
+        }
+    }
     {
         // Use a separate adapter to ensure a separate connection is used for the subscriber
         // (otherwise, if multiple UDP subscribers use the same connection we might get high
@@ -253,6 +288,13 @@ Subscriber::run(int argc, char** argv)
     {
         (*p)->waitForEvents();
     }
+
+    //
+    // The events are discarded by the filter before being queued with
+    // the subscriber, so they are all discarded once the other
+    // subscribers received them.
+    //
+    test(filteredOut->count() == 0);
 }
 
 DEFINE_TEST(Subscriber)
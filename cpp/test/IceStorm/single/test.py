@@ -15,6 +15,23 @@ persistent = IceStorm(props = props)
 transient = IceStorm(props = props, transient=True)
 replicated = [ IceStorm(replica=i, nreplicas=3, props = props) for i in range(0,3) ]
 
+#
+# Queue the events with each subscriber in parallel with the fan-out
+# thread pool.
+#
+fanOutProps = dict(props)
+fanOutProps.update({ "IceStorm.FanOut.Threads" : 2, "IceStorm.FanOut.ShardSize" : 1 })
+persistentFanOut = IceStorm(props = fanOutProps)
+transientFanOut = IceStorm(props = fanOutProps, transient=True)
+
+#
+# Commit and replicate the subscriber updates with group commits.
+#
+groupCommitProps = dict(props)
+groupCommitProps.update({ "IceStorm.GroupCommit.Window" : 10 })
+persistentGroupCommit = IceStorm(props = groupCommitProps)
+replicatedGroupCommit = [ IceStorm(replica=i, nreplicas=3, props = groupCommitProps) for i in range(0,3) ]
+
 sub = Subscriber(args=["{testcase.parent.name}"], props = { "Ice.UDP.RcvSize" : 1024 * 1024 }, readyCount=3)
 pub = Publisher(args=["{testcase.parent.name}"])
 
@@ -31,4 +48,12 @@ TestSuite(__file__, [
     IceStormSingleTestCase("persistent", icestorm=persistent, client=ClientServerTestCase(client=pub, server=sub)),
     IceStormSingleTestCase("transient", icestorm=transient, client=ClientServerTestCase(client=pub, server=sub)),
     IceStormSingleTestCase("replicated", icestorm=replicated, client=ClientServerTestCase(client=pub, server=sub)),
+    IceStormSingleTestCase("persistent fan-out", icestorm=persistentFanOut,
+                           client=ClientServerTestCase(client=pub, server=sub)),
+    IceStormSingleTestCase("transient fan-out", icestorm=transientFanOut,
+                           client=ClientServerTestCase(client=pub, server=sub)),
+    IceStormSingleTestCase("persistent group commit", icestorm=persistentGroupCommit,
+                           client=ClientServerTestCase(client=pub, server=sub)),
+    IceStormSingleTestCase("replicated group commit", icestorm=replicatedGroupCommit,
+                           client=ClientServerTestCase(client=pub, server=sub)),
 ], multihost=False)
@@ -28,6 +28,7 @@ Publisher::run(int argc, char** argv)
     opts.addOpt("", "events", IceUtilInternal::Options::NeedArg);
     opts.addOpt("", "oneway");
     opts.addOpt("", "maxQueueTest");
+    opts.addOpt("", "conflationKeys", IceUtilInternal::Options::NeedArg);
 
     try
     {
@@ -55,6 +56,7 @@ Publisher::run(int argc, char** argv)
 
     bool oneway = opts.isSet("oneway");
     bool maxQueueTest = opts.isSet("maxQueueTest");
+    int conflationKeys = opts.isSet("conflationKeys") ? atoi(opts.optArg("conflationKeys").c_str()) : 0;
 
     PropertiesPtr properties = communicator->getProperties();
     const char* managerProxyProperty = "IceStormAdmin.TopicManager.Default";
@@ -95,7 +97,18 @@ Publisher::run(int argc, char** argv)
             // Sleep one seconds to give some time to IceStorm to connect to the subscriber
             IceUtil::ThreadControl::sleep(IceUtil::Time::seconds(1));
         }
-        proxy->pub(i);
+        if(conflationKeys > 0)
+        {
+            Ice::Context ctx;
+            ostringstream key;
+            key << i % conflationKeys;
+            ctx["key"] = key.str();
+            proxy->pub(i, ctx);
+        }
+        else
+        {
+            proxy->pub(i);
+        }
     }
 
     if(oneway)
@@ -252,6 +252,43 @@ private:
     int _expected;
 };
 
+class ConflateEventI : public EventI
+{
+public:
+
+    ConflateEventI(const CommunicatorPtr& communicator, int keys, int total) :
+        EventI(communicator, total), _keys(keys)
+    {
+    }
+
+    virtual void
+    pub(int counter, const Ice::Current&)
+    {
+        Lock sync(*this);
+
+        //
+        // The first event is sent before the subscriber falls behind, the
+        // queue then only holds the most recent event of each key.
+        //
+        if(_count > 0 && counter < _total - _keys)
+        {
+            cerr << "failed! received conflated event: " << counter << endl;
+            _communicator->shutdown();
+            return;
+        }
+
+        if(++_count == _keys + 1)
+        {
+            _count = _total;
+            _communicator->shutdown();
+        }
+    }
+
+private:
+
+    const int _keys;
+};
+
 class ControllerEventI: public EventI
 {
 public:
@@ -317,6 +354,7 @@ Subscriber::run(int argc, char** argv)
     opts.addOpt("", "erratic", IceUtilInternal::Options::NeedArg);
     opts.addOpt("", "maxQueueDropEvents", IceUtilInternal::Options::NeedArg);
     opts.addOpt("", "maxQueueRemoveSub", IceUtilInternal::Options::NeedArg);
+    opts.addOpt("", "maxQueueConflate", IceUtilInternal::Options::NeedArg);
 
     try
     {
@@ -360,6 +398,7 @@ Subscriber::run(int argc, char** argv)
     bool slow = opts.isSet("slow");
     int maxQueueDropEvents = opts.isSet("maxQueueDropEvents") ? atoi(opts.optArg("maxQueueDropEvents").c_str()) : 0;
     int maxQueueRemoveSub = opts.isSet("maxQueueRemoveSub") ? atoi(opts.optArg("maxQueueRemoveSub").c_str()) : 0;
+    int maxQueueConflate = opts.isSet("maxQueueConflate") ? atoi(opts.optArg("maxQueueConflate").c_str()) : 0;
     bool erratic = false;
     int erraticNum = 0;
     s = opts.optArg("erratic");
@@ -417,7 +456,7 @@ Subscriber::run(int argc, char** argv)
         item.qos = cmdLineQos;
         subs.push_back(item);
     }
-    else if(maxQueueDropEvents || maxQueueRemoveSub)
+    else if(maxQueueDropEvents || maxQueueRemoveSub || maxQueueConflate)
     {
         Subscription item1;
         item1.adapter = communicator->createObjectAdapterWithEndpoints("MaxQueueAdapter", "default");
@@ -425,6 +464,10 @@ Subscriber::run(int argc, char** argv)
         {
             item1.servant = new MaxQueueEventI(communicator.communicator(), maxQueueDropEvents, events, false);
         }
+        else if(maxQueueConflate)
+        {
+            item1.servant = new ConflateEventI(communicator.communicator(), maxQueueConflate, events);
+        }
         else
         {
             item1.servant = new MaxQueueEventI(communicator.communicator(), maxQueueRemoveSub, events, true);
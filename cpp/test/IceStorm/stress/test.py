@@ -127,6 +127,18 @@ class IceStormStressTestCase(IceStormTestCase):
             s.stop(current, True)
         current.writeln("ok")
 
+        current.write("Sending 5000 ordered events with max queue size conflate... ")
+        opts = " --IceStorm.Send.QueueSizeMax=2000 --IceStorm.Send.QueueSizeMaxPolicy=Conflate" + \
+               " --IceStorm.Send.ConflationKey=key"
+        for s in icestorm1:
+            s.start(current, args=opts.split(" "))
+        doTest(("TestIceStorm1", '--events 5000 --qos "reliability,ordered" --maxQueueConflate=10'),
+               '--events 5000 --maxQueueTest --conflationKeys=10')
+        for s in icestorm1:
+            s.shutdown(current)
+            s.stop(current, True)
+        current.writeln("ok")
+
         current.write("Sending 5000 ordered events with max queue size remove subscriber... ")
         opts = " --IceStorm.Send.QueueSizeMax=2000 --IceStorm.Send.QueueSizeMaxPolicy=RemoveSubscriber"
         for s in icestorm1:
@@ -138,6 +150,20 @@ class IceStormStressTestCase(IceStormTestCase):
             s.stop(current, True)
         current.writeln("ok")
 
+        current.write("Sending 20000 unordered events with adaptive batching across a link... ")
+        opts = " --IceStorm.Send.BatchSizeMax=100"
+        for s in self.icestorm:
+            s.start(current, args=opts.split(" "))
+        doTest([("TestIceStorm1", '--events 20000'),
+                ("TestIceStorm1", '--events 20000 --qos "reliability,batch"'),
+                ("TestIceStorm1", '--events 2 --slow'),
+                ("TestIceStorm2", '--events 20000')],
+               '--events 20000 --oneway')
+        for s in self.icestorm:
+            s.shutdown(current)
+            s.stop(current, True)
+        current.writeln("ok")
+
 TestSuite(__file__, [
 
     IceStormStressTestCase("persistent", icestorm=[IceStorm("TestIceStorm1", quiet=True),
@@ -890,6 +890,19 @@ namespace IceInternal
             }
         }
 
+        override public IceMX.MetricsHistogram[] getMetricsHistograms(string viewName, string mapName, Ice.Current c)
+        {
+            lock(this)
+            {
+                getMetricsView(viewName); // Throws if unknown view.
+
+                //
+                // Latency histograms are not recorded by the C# run time.
+                //
+                return new IceMX.MetricsHistogram[0];
+            }
+        }
+
         public void registerMap<T>(string map, Action updater)
             where T : IceMX.Metrics, new()
         {
@@ -244,6 +244,19 @@ public class MetricsAdminI extends IceMX._MetricsAdminDisp implements Ice.Proper
         return new IceMX.MetricsFailures();
     }
 
+    @Override
+    synchronized public IceMX.MetricsHistogram[]
+    getMetricsHistograms(String viewName, String mapName, Ice.Current current)
+        throws IceMX.UnknownMetricsView
+    {
+        getMetricsView(viewName); // Throws if unknown view.
+
+        //
+        // Latency histograms are not recorded by the Java run time.
+        //
+        return new IceMX.MetricsHistogram[0];
+    }
+
     public <T extends IceMX.Metrics> void
     registerMap(String map, Class<T> cl, Runnable updater)
     {
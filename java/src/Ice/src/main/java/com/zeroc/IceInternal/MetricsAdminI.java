@@ -251,6 +251,19 @@ public class MetricsAdminI implements com.zeroc.IceMX.MetricsAdmin,
         return new com.zeroc.IceMX.MetricsFailures();
     }
 
+    @Override
+    synchronized public com.zeroc.IceMX.MetricsHistogram[] getMetricsHistograms(String viewName, String mapName,
+                                                                                 com.zeroc.Ice.Current current)
+        throws com.zeroc.IceMX.UnknownMetricsView
+    {
+        getMetricsView(viewName); // Throws if unknown view.
+
+        //
+        // Latency histograms are not recorded by the Java run time.
+        //
+        return new com.zeroc.IceMX.MetricsHistogram[0];
+    }
+
     public <T extends com.zeroc.IceMX.Metrics> void registerMap(String map, Class<T> cl, Runnable updater)
     {
         boolean updated;
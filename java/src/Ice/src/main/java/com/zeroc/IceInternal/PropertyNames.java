@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ./config/PropertyNames.xml, Fri Sep  6 18:11:04 2019
+// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Oct 19 18:32:35 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -61,6 +61,14 @@ public final class PropertyNames
         new Property("Ice\\.Admin\\.ThreadPool\\.Serialize", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("Ice\\.Admin\\.MaxDispatches", false, null),
+        new Property("Ice\\.Admin\\.MaxQueueWait", false, null),
+        new Property("Ice\\.Admin\\.Lanes", false, null),
+        new Property("Ice\\.Admin\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("Ice\\.Admin\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("Ice\\.Admin\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("Ice\\.Admin\\.LaneContext", false, null),
+        new Property("Ice\\.Admin\\.FlowControl\\.Window", false, null),
         new Property("Ice\\.Admin\\.MessageSizeMax", false, null),
         new Property("Ice\\.Admin\\.DelayCreation", false, null),
         new Property("Ice\\.Admin\\.Enabled", false, null),
@@ -114,12 +122,19 @@ public final class PropertyNames
         new Property("Ice\\.Default\\.Timeout", false, null),
         new Property("Ice\\.EventLog\\.Source", false, null),
         new Property("Ice\\.FactoryAssemblies", false, null),
+        new Property("Ice\\.FlowControl", false, null),
         new Property("Ice\\.HTTPProxyHost", false, null),
         new Property("Ice\\.HTTPProxyPort", false, null),
         new Property("Ice\\.ImplicitContext", false, null),
         new Property("Ice\\.InitPlugins", false, null),
         new Property("Ice\\.IPv4", false, null),
         new Property("Ice\\.IPv6", false, null),
+        new Property("Ice\\.LocatorCacheNegativeTimeout", false, null),
+        new Property("Ice\\.LocatorCacheRefreshAhead", false, null),
+        new Property("Ice\\.LocatorCacheSizeMax", false, null),
+        new Property("Ice\\.LocatorCacheSubscription", false, null),
+        new Property("Ice\\.LogAsync", false, null),
+        new Property("Ice\\.LogAsync\\.QueueSize", false, null),
         new Property("Ice\\.LogFile", false, null),
         new Property("Ice\\.LogFile\\.SizeMax", false, null),
         new Property("Ice\\.LogStdErr\\.Convert", false, null),
@@ -140,6 +155,7 @@ public final class PropertyNames
         new Property("Ice\\.PrintProcessId", false, null),
         new Property("Ice\\.PrintStackTraces", false, null),
         new Property("Ice\\.ProgramName", false, null),
+        new Property("Ice\\.PropagateDeadline", false, null),
         new Property("Ice\\.RetryIntervals", false, null),
         new Property("Ice\\.ServerIdleTime", false, null),
         new Property("Ice\\.SOCKSProxyHost", false, null),
@@ -176,6 +192,7 @@ public final class PropertyNames
         new Property("Ice\\.TCP\\.Backlog", false, null),
         new Property("Ice\\.TCP\\.RcvSize", false, null),
         new Property("Ice\\.TCP\\.SndSize", false, null),
+        new Property("Ice\\.WS\\.PerMessageDeflate", false, null),
         new Property("Ice\\.UseApplicationClassLoader", false, null),
         new Property("Ice\\.UseOSLog", false, null),
         new Property("Ice\\.UseSyslog", false, null),
@@ -201,6 +218,12 @@ public final class PropertyNames
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.Accept", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.Reject", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+", false, null),
+        new Property("IceMX\\.OpenMetrics\\.Host", false, null),
+        new Property("IceMX\\.OpenMetrics\\.Path", false, null),
+        new Property("IceMX\\.OpenMetrics\\.Port", false, null),
+        new Property("IceMX\\.OpenMetrics\\.Timeout", false, null),
+        new Property("IceMX\\.Tracing\\.File", false, null),
+        new Property("IceMX\\.Tracing\\.Sampling", false, null),
         null
     };
 
@@ -242,6 +265,14 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.Serialize", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceDiscovery\\.Multicast\\.MaxDispatches", false, null),
+        new Property("IceDiscovery\\.Multicast\\.MaxQueueWait", false, null),
+        new Property("IceDiscovery\\.Multicast\\.Lanes", false, null),
+        new Property("IceDiscovery\\.Multicast\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceDiscovery\\.Multicast\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceDiscovery\\.Multicast\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceDiscovery\\.Multicast\\.LaneContext", false, null),
+        new Property("IceDiscovery\\.Multicast\\.FlowControl\\.Window", false, null),
         new Property("IceDiscovery\\.Multicast\\.MessageSizeMax", false, null),
         new Property("IceDiscovery\\.Reply\\.ACM\\.Timeout", false, null),
         new Property("IceDiscovery\\.Reply\\.ACM\\.Heartbeat", false, null),
@@ -279,6 +310,14 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.Serialize", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceDiscovery\\.Reply\\.MaxDispatches", false, null),
+        new Property("IceDiscovery\\.Reply\\.MaxQueueWait", false, null),
+        new Property("IceDiscovery\\.Reply\\.Lanes", false, null),
+        new Property("IceDiscovery\\.Reply\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceDiscovery\\.Reply\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceDiscovery\\.Reply\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceDiscovery\\.Reply\\.LaneContext", false, null),
+        new Property("IceDiscovery\\.Reply\\.FlowControl\\.Window", false, null),
         new Property("IceDiscovery\\.Reply\\.MessageSizeMax", false, null),
         new Property("IceDiscovery\\.Locator\\.ACM\\.Timeout", false, null),
         new Property("IceDiscovery\\.Locator\\.ACM\\.Heartbeat", false, null),
@@ -316,6 +355,14 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.Serialize", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceDiscovery\\.Locator\\.MaxDispatches", false, null),
+        new Property("IceDiscovery\\.Locator\\.MaxQueueWait", false, null),
+        new Property("IceDiscovery\\.Locator\\.Lanes", false, null),
+        new Property("IceDiscovery\\.Locator\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceDiscovery\\.Locator\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceDiscovery\\.Locator\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceDiscovery\\.Locator\\.LaneContext", false, null),
+        new Property("IceDiscovery\\.Locator\\.FlowControl\\.Window", false, null),
         new Property("IceDiscovery\\.Locator\\.MessageSizeMax", false, null),
         new Property("IceDiscovery\\.Lookup", false, null),
         new Property("IceDiscovery\\.Timeout", false, null),
@@ -366,6 +413,14 @@ public final class PropertyNames
         new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.Serialize", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.MaxDispatches", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.MaxQueueWait", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.Lanes", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.LaneContext", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.FlowControl\\.Window", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.MessageSizeMax", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ACM\\.Timeout", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ACM\\.Heartbeat", false, null),
@@ -403,6 +458,14 @@ public final class PropertyNames
         new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.Serialize", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.MaxDispatches", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.MaxQueueWait", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.Lanes", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.LaneContext", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.FlowControl\\.Window", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.MessageSizeMax", false, null),
         new Property("IceLocatorDiscovery\\.Lookup", false, null),
         new Property("IceLocatorDiscovery\\.Timeout", false, null),
@@ -491,6 +554,14 @@ public final class PropertyNames
         new Property("IceBridge\\.Source\\.ThreadPool\\.Serialize", false, null),
         new Property("IceBridge\\.Source\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceBridge\\.Source\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceBridge\\.Source\\.MaxDispatches", false, null),
+        new Property("IceBridge\\.Source\\.MaxQueueWait", false, null),
+        new Property("IceBridge\\.Source\\.Lanes", false, null),
+        new Property("IceBridge\\.Source\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceBridge\\.Source\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceBridge\\.Source\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceBridge\\.Source\\.LaneContext", false, null),
+        new Property("IceBridge\\.Source\\.FlowControl\\.Window", false, null),
         new Property("IceBridge\\.Source\\.MessageSizeMax", false, null),
         new Property("IceBridge\\.Target\\.Endpoints", false, null),
         new Property("IceBridge\\.InstanceName", false, null),
@@ -543,6 +614,14 @@ public final class PropertyNames
         new Property("IceGridAdmin\\.Server\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGridAdmin\\.Server\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGridAdmin\\.Server\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGridAdmin\\.Server\\.MaxDispatches", false, null),
+        new Property("IceGridAdmin\\.Server\\.MaxQueueWait", false, null),
+        new Property("IceGridAdmin\\.Server\\.Lanes", false, null),
+        new Property("IceGridAdmin\\.Server\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceGridAdmin\\.Server\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceGridAdmin\\.Server\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceGridAdmin\\.Server\\.LaneContext", false, null),
+        new Property("IceGridAdmin\\.Server\\.FlowControl\\.Window", false, null),
         new Property("IceGridAdmin\\.Server\\.MessageSizeMax", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Address", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Interface", false, null),
@@ -583,6 +662,14 @@ public final class PropertyNames
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.MaxDispatches", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.MaxQueueWait", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.Lanes", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.LaneContext", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.FlowControl\\.Window", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.MessageSizeMax", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ACM\\.Timeout", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ACM\\.Heartbeat", false, null),
@@ -620,6 +707,14 @@ public final class PropertyNames
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.MaxDispatches", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.MaxQueueWait", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.Lanes", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.LaneContext", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.FlowControl\\.Window", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.MessageSizeMax", false, null),
         new Property("IceGridAdmin\\.Trace\\.Observers", false, null),
         new Property("IceGridAdmin\\.Trace\\.SaveToRegistry", false, null),
@@ -664,6 +759,14 @@ public final class PropertyNames
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.AdminRouter\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.AdminRouter\\.MaxQueueWait", false, null),
+        new Property("IceGrid\\.AdminRouter\\.Lanes", false, null),
+        new Property("IceGrid\\.AdminRouter\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceGrid\\.AdminRouter\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceGrid\\.AdminRouter\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceGrid\\.AdminRouter\\.LaneContext", false, null),
+        new Property("IceGrid\\.AdminRouter\\.FlowControl\\.Window", false, null),
         new Property("IceGrid\\.AdminRouter\\.MessageSizeMax", false, null),
         new Property("IceGrid\\.InstanceName", false, null),
         new Property("IceGrid\\.Node\\.ACM\\.Timeout", false, null),
@@ -702,6 +805,14 @@ public final class PropertyNames
         new Property("IceGrid\\.Node\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Node\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Node\\.MaxQueueWait", false, null),
+        new Property("IceGrid\\.Node\\.Lanes", false, null),
+        new Property("IceGrid\\.Node\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceGrid\\.Node\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceGrid\\.Node\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceGrid\\.Node\\.LaneContext", false, null),
+        new Property("IceGrid\\.Node\\.FlowControl\\.Window", false, null),
         new Property("IceGrid\\.Node\\.MessageSizeMax", false, null),
         new Property("IceGrid\\.Node\\.AllowRunningServersAsRoot", false, null),
         new Property("IceGrid\\.Node\\.AllowEndpointsOverride", false, null),
@@ -711,9 +822,11 @@ public final class PropertyNames
         new Property("IceGrid\\.Node\\.Name", false, null),
         new Property("IceGrid\\.Node\\.Output", false, null),
         new Property("IceGrid\\.Node\\.ProcessorSocketCount", false, null),
+        new Property("IceGrid\\.Node\\.PrestartServers", false, null),
         new Property("IceGrid\\.Node\\.PrintServersReady", false, null),
         new Property("IceGrid\\.Node\\.PropertiesOverride", false, null),
         new Property("IceGrid\\.Node\\.RedirectErrToOut", false, null),
+        new Property("IceGrid\\.Node\\.ReportServerLoad", false, null),
         new Property("IceGrid\\.Node\\.Trace\\.Activator", false, null),
         new Property("IceGrid\\.Node\\.Trace\\.Adapter", false, null),
         new Property("IceGrid\\.Node\\.Trace\\.Admin", false, null),
@@ -780,7 +893,17 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.MaxQueueWait", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.Lanes", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.LaneContext", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.FlowControl\\.Window", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionObserverPageSize", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionObserverWindow", false, null),
         new Property("IceGrid\\.Registry\\.AdminSSLPermissionsVerifier\\.EndpointSelection", false, null),
         new Property("IceGrid\\.Registry\\.AdminSSLPermissionsVerifier\\.ConnectionCached", false, null),
         new Property("IceGrid\\.Registry\\.AdminSSLPermissionsVerifier\\.PreferSecure", false, null),
@@ -827,6 +950,14 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.MaxQueueWait", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.Lanes", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.LaneContext", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.FlowControl\\.Window", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.MessageSizeMax", false, null),
         new Property("IceGrid\\.Registry\\.CryptPasswords", false, null),
         new Property("IceGrid\\.Registry\\.DefaultTemplates", false, null),
@@ -866,6 +997,14 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.MaxQueueWait", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.Lanes", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.LaneContext", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.FlowControl\\.Window", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.MessageSizeMax", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.Enabled", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.Address", false, null),
@@ -908,6 +1047,14 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.MaxQueueWait", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.Lanes", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.LaneContext", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.FlowControl\\.Window", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.MessageSizeMax", false, null),
         new Property("IceGrid\\.Registry\\.LMDB\\.MapSize", false, null),
         new Property("IceGrid\\.Registry\\.LMDB\\.Path", false, null),
@@ -962,6 +1109,14 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.MaxQueueWait", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.Lanes", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.LaneContext", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.FlowControl\\.Window", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.MessageSizeMax", false, null),
         new Property("IceGrid\\.Registry\\.SessionFilters", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ACM\\.Timeout", false, null),
@@ -1000,6 +1155,14 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.MaxQueueWait", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.Lanes", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.LaneContext", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.FlowControl\\.Window", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.MessageSizeMax", false, null),
         new Property("IceGrid\\.Registry\\.SessionTimeout", false, null),
         new Property("IceGrid\\.Registry\\.SSLPermissionsVerifier\\.EndpointSelection", false, null),
@@ -1068,6 +1231,14 @@ public final class PropertyNames
         new Property("IcePatch2\\.ThreadPool\\.Serialize", false, null),
         new Property("IcePatch2\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IcePatch2\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IcePatch2\\.MaxDispatches", false, null),
+        new Property("IcePatch2\\.MaxQueueWait", false, null),
+        new Property("IcePatch2\\.Lanes", false, null),
+        new Property("IcePatch2\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("IcePatch2\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("IcePatch2\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("IcePatch2\\.LaneContext", false, null),
+        new Property("IcePatch2\\.FlowControl\\.Window", false, null),
         new Property("IcePatch2\\.MessageSizeMax", false, null),
         new Property("IcePatch2\\.Directory", false, null),
         new Property("IcePatch2\\.InstanceName", false, null),
@@ -1186,6 +1357,14 @@ public final class PropertyNames
         new Property("Glacier2\\.Client\\.ThreadPool\\.Serialize", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("Glacier2\\.Client\\.MaxDispatches", false, null),
+        new Property("Glacier2\\.Client\\.MaxQueueWait", false, null),
+        new Property("Glacier2\\.Client\\.Lanes", false, null),
+        new Property("Glacier2\\.Client\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("Glacier2\\.Client\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("Glacier2\\.Client\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("Glacier2\\.Client\\.LaneContext", false, null),
+        new Property("Glacier2\\.Client\\.FlowControl\\.Window", false, null),
         new Property("Glacier2\\.Client\\.MessageSizeMax", false, null),
         new Property("Glacier2\\.Client\\.AlwaysBatch", false, null),
         new Property("Glacier2\\.Client\\.Buffered", false, null),
@@ -1261,6 +1440,14 @@ public final class PropertyNames
         new Property("Glacier2\\.Server\\.ThreadPool\\.Serialize", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("Glacier2\\.Server\\.MaxDispatches", false, null),
+        new Property("Glacier2\\.Server\\.MaxQueueWait", false, null),
+        new Property("Glacier2\\.Server\\.Lanes", false, null),
+        new Property("Glacier2\\.Server\\.Lane\\.[^\\s]+\\.Operations", false, null),
+        new Property("Glacier2\\.Server\\.Lane\\.[^\\s]+\\.Weight", false, null),
+        new Property("Glacier2\\.Server\\.Lane\\.[^\\s]+\\.MaxQueued", false, null),
+        new Property("Glacier2\\.Server\\.LaneContext", false, null),
+        new Property("Glacier2\\.Server\\.FlowControl\\.Window", false, null),
         new Property("Glacier2\\.Server\\.MessageSizeMax", false, null),
         new Property("Glacier2\\.Server\\.AlwaysBatch", false, null),
         new Property("Glacier2\\.Server\\.Buffered", false, null),
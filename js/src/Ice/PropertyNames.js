@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ./config/PropertyNames.xml, Fri Sep  6 18:11:04 2019
+// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Oct 19 18:32:35 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -64,6 +64,14 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Admin\.ThreadPool\.Serialize/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.ThreadPriority/", false, null),
+    new Property("/^Ice\.Admin\.MaxDispatches/", false, null),
+    new Property("/^Ice\.Admin\.MaxQueueWait/", false, null),
+    new Property("/^Ice\.Admin\.Lanes/", false, null),
+    new Property("/^Ice\.Admin\.Lane\..\.Operations/", false, null),
+    new Property("/^Ice\.Admin\.Lane\..\.Weight/", false, null),
+    new Property("/^Ice\.Admin\.Lane\..\.MaxQueued/", false, null),
+    new Property("/^Ice\.Admin\.LaneContext/", false, null),
+    new Property("/^Ice\.Admin\.FlowControl\.Window/", false, null),
     new Property("/^Ice\.Admin\.MessageSizeMax/", false, null),
     new Property("/^Ice\.Admin\.DelayCreation/", false, null),
     new Property("/^Ice\.Admin\.Enabled/", false, null),
@@ -117,12 +125,19 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Default\.Timeout/", false, null),
     new Property("/^Ice\.EventLog\.Source/", false, null),
     new Property("/^Ice\.FactoryAssemblies/", false, null),
+    new Property("/^Ice\.FlowControl/", false, null),
     new Property("/^Ice\.HTTPProxyHost/", false, null),
     new Property("/^Ice\.HTTPProxyPort/", false, null),
     new Property("/^Ice\.ImplicitContext/", false, null),
     new Property("/^Ice\.InitPlugins/", false, null),
     new Property("/^Ice\.IPv4/", false, null),
     new Property("/^Ice\.IPv6/", false, null),
+    new Property("/^Ice\.LocatorCacheNegativeTimeout/", false, null),
+    new Property("/^Ice\.LocatorCacheRefreshAhead/", false, null),
+    new Property("/^Ice\.LocatorCacheSizeMax/", false, null),
+    new Property("/^Ice\.LocatorCacheSubscription/", false, null),
+    new Property("/^Ice\.LogAsync/", false, null),
+    new Property("/^Ice\.LogAsync\.QueueSize/", false, null),
     new Property("/^Ice\.LogFile/", false, null),
     new Property("/^Ice\.LogFile\.SizeMax/", false, null),
     new Property("/^Ice\.LogStdErr\.Convert/", false, null),
@@ -143,6 +158,7 @@ PropertyNames.IceProps =
     new Property("/^Ice\.PrintProcessId/", false, null),
     new Property("/^Ice\.PrintStackTraces/", false, null),
     new Property("/^Ice\.ProgramName/", false, null),
+    new Property("/^Ice\.PropagateDeadline/", false, null),
     new Property("/^Ice\.RetryIntervals/", false, null),
     new Property("/^Ice\.ServerIdleTime/", false, null),
     new Property("/^Ice\.SOCKSProxyHost/", false, null),
@@ -179,6 +195,7 @@ PropertyNames.IceProps =
     new Property("/^Ice\.TCP\.Backlog/", false, null),
     new Property("/^Ice\.TCP\.RcvSize/", false, null),
     new Property("/^Ice\.TCP\.SndSize/", false, null),
+    new Property("/^Ice\.WS\.PerMessageDeflate/", false, null),
     new Property("/^Ice\.UseApplicationClassLoader/", false, null),
     new Property("/^Ice\.UseOSLog/", false, null),
     new Property("/^Ice\.UseSyslog/", false, null),